@@ -1819,6 +1819,25 @@ var authCommandsLib = {
               {runOnDb: adminDbName, roles: {__system: 1}, expectFail: true},
           ]
         },
+        {
+          testname: "balancerDryRun",
+          command: {balancerDryRun: 1},
+          skipStandalone: true,
+          testcases: [
+              {
+                runOnDb: adminDbName,
+                privileges: [{resource: {db: 'config', collection: 'settings'}, actions: ['find']}],
+              },
+          ]
+        },
+        {
+          testname: "_configsvrBalancerDryRun",
+          command: {_configsvrBalancerDryRun: 1},
+          skipSharded: true,
+          testcases: [
+              {runOnDb: adminDbName, roles: {__system: 1}, expectFail: true},
+          ]
+        },
         {
           testname: "balancerStatus",
           command: {balancerStatus: 1},
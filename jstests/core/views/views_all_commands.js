@@ -60,6 +60,7 @@
     let viewsCommandTests = {
         _configsvrAddShard: {skip: isAnInternalCommand},
         _configsvrAddShardToZone: {skip: isAnInternalCommand},
+        _configsvrBalancerDryRun: {skip: isAnInternalCommand},
         _configsvrBalancerStart: {skip: isAnInternalCommand},
         _configsvrBalancerStatus: {skip: isAnInternalCommand},
         _configsvrBalancerStop: {skip: isAnInternalCommand},
@@ -99,6 +100,7 @@
         authSchemaUpgrade: {skip: isUnrelated},
         authenticate: {skip: isUnrelated},
         availableQueryOptions: {skip: isAnInternalCommand},
+        balancerDryRun: {skip: isUnrelated},
         balancerStart: {skip: isUnrelated},
         balancerStatus: {skip: isUnrelated},
         balancerStop: {skip: isUnrelated},
@@ -179,6 +181,7 @@
                 assert.eq(hash1, hash3, "hash should be the same again after removing 'view2'");
             }
         },
+        dbHashTree: {command: {dbHashTree: "view"}, expectFailure: true, skipSharded: true},
         dbStats: {skip: "TODO(SERVER-25948)"},
         delete: {command: {delete: "view", deletes: [{q: {x: 1}, limit: 1}]}, expectFailure: true},
         distinct: {command: {distinct: "view", key: "_id"}},
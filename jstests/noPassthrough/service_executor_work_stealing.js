@@ -0,0 +1,59 @@
+/**
+ * Tests that mongod serves concurrent clients with the work-stealing service executor, with and
+ * without NUMA pinning, and reports the executor's queue latency histogram in serverStatus.
+ */
+(function() {
+    'use strict';
+
+    [false, true].forEach(function(numaPinning) {
+        const conn = MongoRunner.runMongod({
+            serviceExecutor: "workStealing",
+            setParameter: {
+                workStealingServiceExecutorThreads: 2,
+                workStealingServiceExecutorNumaPinning: numaPinning
+            }
+        });
+        assert.neq(null,
+                   conn,
+                   "mongod failed to start with serviceExecutor=workStealing and " +
+                       "workStealingServiceExecutorNumaPinning=" + numaPinning);
+
+        const coll = conn.getDB("test").service_executor_work_stealing;
+
+        // More clients than workers, so that workers have to share and steal sessions.
+        const numClients = 8;
+        const numDocs = 200;
+        const awaitShells = [];
+        for (let i = 0; i < numClients; ++i) {
+            awaitShells.push(startParallelShell(
+                "const coll = db.getSiblingDB('test').service_executor_work_stealing;" +
+                    "for (let j = 0; j < " + numDocs + "; ++j) {" +
+                    "    assert.writeOK(coll.insert({client: " + i + ", j: j}));" +
+                    "    assert.neq(null, coll.findOne({client: " + i + ", j: j}));" +
+                    "}",
+                conn.port));
+        }
+        awaitShells.forEach(function(awaitShell) {
+            awaitShell();
+        });
+        assert.eq(numClients * numDocs, coll.count());
+
+        const stats = assert.commandWorked(conn.adminCommand({serverStatus: 1}))
+                          .network.serviceExecutorTaskStats;
+        assert.eq("workStealing", stats.executor, tojson(stats));
+        assert.gte(stats.threadsRunning, 2, tojson(stats));
+        assert.gt(stats.totalExecuted, numClients * numDocs, tojson(stats));
+
+        let histogramTotal = 0;
+        Object.keys(stats.queueLatencyMicros).forEach(function(bucket) {
+            histogramTotal += stats.queueLatencyMicros[bucket];
+        });
+        // The serverStatus command itself has been counted in the histogram but hasn't finished.
+        assert.gte(histogramTotal, stats.totalExecuted, tojson(stats));
+
+        MongoRunner.stopMongod(conn);
+    });
+
+    const conn = MongoRunner.runMongod({transportLayer: 'legacy', serviceExecutor: 'workStealing'});
+    assert.eq(null, conn, "the legacy transport layer does not support workStealing");
+}());
@@ -0,0 +1,58 @@
+/**
+ * Tests that splitVector estimates split points from a random sample of a large collection when
+ * asked to, and that the estimate is close to the split points found by scanning the index.
+ */
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod({setParameter: {splitVectorSampleSize: 1000}});
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const testDB = conn.getDB("test");
+    const coll = testDB.split_vector_sampling;
+
+    const numDocs = 20000;
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < numDocs; i++) {
+        bulk.insert({x: i, pad: "a".repeat(100)});
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(coll.createIndex({x: 1}));
+
+    const avgObjSize = coll.stats().avgObjSize;
+    const cmd = {
+        splitVector: coll.getFullName(),
+        keyPattern: {x: 1},
+        min: {x: MinKey},
+        max: {x: MaxKey},
+        maxChunkSizeBytes: avgObjSize * 4000
+    };
+
+    const scanned = assert.commandWorked(testDB.adminCommand(cmd));
+    assert(!scanned.sampled, tojson(scanned));
+    assert.eq(numDocs, scanned.keysExamined, tojson(scanned));
+    assert.eq(0, scanned.docsSampled, tojson(scanned));
+
+    const sampled = assert.commandWorked(testDB.adminCommand(Object.merge(cmd, {sample: true})));
+    if (!sampled.sampled) {
+        // Storage engines without random cursors always fall back to scanning the index.
+        assert.eq(numDocs, sampled.keysExamined, tojson(sampled));
+        MongoRunner.stopMongod(conn);
+        return;
+    }
+
+    assert.eq(0, sampled.keysExamined, tojson(sampled));
+    assert.eq(1000, sampled.docsSampled, tojson(sampled));
+    assert.eq(scanned.splitKeys.length, sampled.splitKeys.length, tojson(sampled));
+    for (let i = 0; i < scanned.splitKeys.length; i++) {
+        assert.between(scanned.splitKeys[i].x - 1500,
+                       sampled.splitKeys[i].x,
+                       scanned.splitKeys[i].x + 1500,
+                       "split point " + i + " is too far from the scanned one");
+        if (i > 0) {
+            assert.lt(sampled.splitKeys[i - 1].x, sampled.splitKeys[i].x, tojson(sampled));
+        }
+    }
+
+    MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,42 @@
+/**
+ * Tests that messages of every size are received intact when the ASIO transport layer reads ahead
+ * of the current message, with both service executors and with read-ahead disabled (the default).
+ */
+(function() {
+    'use strict';
+
+    function testRoundTrips(conn) {
+        const coll = conn.getDB("test").transportlayer_read_ahead;
+        coll.drop();
+
+        const sizes = [0, 1, 100, 16 * 1024, 64 * 1024, 4 * 1024 * 1024];
+        sizes.forEach(function(size) {
+            assert.writeOK(coll.insert({_id: size, payload: "x".repeat(size)}));
+        });
+        sizes.forEach(function(size) {
+            const doc = coll.findOne({_id: size});
+            assert.neq(null, doc, "document of size " + size + " not found");
+            assert.eq(size, doc.payload.length);
+        });
+
+        // Many small messages in quick succession.
+        for (let i = 0; i < 1000; ++i) {
+            assert.commandWorked(conn.adminCommand({ping: 1}));
+        }
+    }
+
+    ["synchronous", "adaptive"].forEach(function(serviceExecutor) {
+        [0, 20, 16 * 1024].forEach(function(readAheadBytes) {
+            const conn = MongoRunner.runMongod({
+                serviceExecutor: serviceExecutor,
+                setParameter: {transportLayerASIOReadAheadBytes: readAheadBytes}
+            });
+            assert.neq(null,
+                       conn,
+                       "mongod failed to start with serviceExecutor=" + serviceExecutor +
+                           " and transportLayerASIOReadAheadBytes=" + readAheadBytes);
+            testRoundTrips(conn);
+            MongoRunner.stopMongod(conn);
+        });
+    });
+}());
@@ -0,0 +1,98 @@
+// Test that the incremental dbHash is maintained across writes and that dbHashTree can be used to
+// locate the documents that differ between two collections.
+'use strict';
+
+(function() {
+    var rst = new ReplSetTest({name: 'dbhash_incremental', nodes: 2});
+    rst.startSet();
+    rst.initiate();
+
+    var primary = rst.getPrimary();
+    var secondary = rst.getSecondary();
+    var primaryDB = primary.getDB('test');
+    var secondaryDB = secondary.getDB('test');
+
+    function fill(coll) {
+        var bulk = coll.initializeUnorderedBulkOp();
+        for (var i = 0; i < 1000; i++) {
+            bulk.insert({_id: i, x: i});
+        }
+        assert.writeOK(bulk.execute());
+    }
+
+    function incrementalHash(db, collName) {
+        var res = db.runCommand({dbHash: 1, collections: [collName], incremental: true});
+        assert.commandWorked(res);
+        assert(res.incremental, tojson(res));
+        return res.collections[collName];
+    }
+
+    fill(primaryDB.coll);
+    rst.awaitReplication();
+
+    // The first call builds the trees; later calls must reflect writes applied after that.
+    assert.eq(incrementalHash(primaryDB, 'coll'), incrementalHash(secondaryDB, 'coll'));
+
+    assert.writeOK(primaryDB.coll.update({_id: 1}, {$set: {x: -1}}));
+    assert.writeOK(primaryDB.coll.remove({_id: 2}));
+    assert.writeOK(primaryDB.coll.insert({_id: 'new'}));
+    rst.awaitReplication();
+    assert.eq(incrementalHash(primaryDB, 'coll'), incrementalHash(secondaryDB, 'coll'));
+
+    // A tree built from a scan of the same documents must agree with the maintained one.
+    fill(primaryDB.copy);
+    assert.writeOK(primaryDB.copy.update({_id: 1}, {$set: {x: -1}}));
+    assert.writeOK(primaryDB.copy.remove({_id: 2}));
+    assert.writeOK(primaryDB.copy.insert({_id: 'new'}));
+    assert.eq(incrementalHash(primaryDB, 'coll'), incrementalHash(primaryDB, 'copy'));
+
+    // Introduce a single difference and find it by descending both trees.
+    assert.writeOK(primaryDB.copy.update({_id: 500}, {$set: {x: 'diverged'}}));
+    assert.neq(incrementalHash(primaryDB, 'coll'), incrementalHash(primaryDB, 'copy'));
+
+    function node(collName, level, index) {
+        var res = primaryDB.runCommand({dbHashTree: collName, level: level, index: index});
+        assert.commandWorked(res);
+        return res;
+    }
+
+    var level = 0;
+    var index = 0;
+    while (true) {
+        var a = node('coll', level, index);
+        var b = node('copy', level, index);
+        assert.neq(a.hash, b.hash);
+        assert.eq(a.count, b.count);
+        if (!a.children) {
+            break;
+        }
+        var differing = a.children.filter(function(child, i) {
+            return child.hash !== b.children[i].hash;
+        });
+        assert.eq(1, differing.length, tojson(differing));
+        index = differing[0].index;
+        level++;
+    }
+
+    var docHashes = {};
+    var res = primaryDB.runCommand({dbHashTree: 'coll', leaves: [index]});
+    assert.commandWorked(res);
+    res.documents.forEach(function(doc) {
+        docHashes[tojson(doc._id)] = doc.md5;
+    });
+
+    res = primaryDB.runCommand({dbHashTree: 'copy', leaves: [index]});
+    assert.commandWorked(res);
+    var diverged = res.documents.filter(function(doc) {
+        return docHashes[tojson(doc._id)] !== doc.md5;
+    });
+    assert.eq(1, diverged.length, tojson(diverged));
+    assert.eq(500, diverged[0]._id);
+
+    // Capped collections are not maintained and cannot be descended.
+    assert.commandWorked(primaryDB.createCollection('capped', {capped: true, size: 4096}));
+    assert.commandFailedWithCode(primaryDB.runCommand({dbHashTree: 'capped'}),
+                                 ErrorCodes.IllegalOperation);
+
+    rst.stopSet();
+})();
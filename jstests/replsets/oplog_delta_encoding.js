@@ -0,0 +1,43 @@
+/**
+ * Tests that a secondary fetching delta encoded oplog entries from its sync source applies the same
+ * operations as the primary.
+ */
+(function() {
+    "use strict";
+
+    const name = "oplog_delta_encoding";
+    const replSet = new ReplSetTest({
+        name: name,
+        nodes: [{}, {rsConfig: {priority: 0}, setParameter: {oplogFetcherUseDeltaEncoding: true}}]
+    });
+    replSet.startSet();
+    replSet.initiate();
+
+    const primary = replSet.getPrimary();
+    const secondary = replSet.getSecondary();
+    const primaryColl = primary.getDB(name).coll;
+
+    const bulk = primaryColl.initializeUnorderedBulkOp();
+    for (let i = 0; i < 1000; ++i) {
+        bulk.insert({_id: i, x: "a".repeat(i % 10)});
+    }
+    assert.writeOK(bulk.execute());
+    assert.writeOK(primaryColl.update({}, {$inc: {y: 1}}, {multi: true}));
+    assert.writeOK(primaryColl.remove({_id: {$lt: 100}}));
+    replSet.awaitReplication();
+
+    const secondaryColl = secondary.getDB(name).coll;
+    assert.eq(900, secondaryColl.find().itcount());
+    assert.eq(900, secondaryColl.find({y: 1}).itcount());
+
+    const primaryOplog = primary.getDB("local").oplog.rs;
+    const secondaryOplog = secondary.getDB("local").oplog.rs;
+    const lastPrimaryEntry = primaryOplog.find().sort({$natural: -1}).limit(1).next();
+    const lastSecondaryEntry = secondaryOplog.find().sort({$natural: -1}).limit(1).next();
+    assert.docEq(lastPrimaryEntry, lastSecondaryEntry);
+
+    const metrics = secondary.getDB("admin").serverStatus().metrics.repl.network;
+    assert.gt(metrics.deltaEncoding.bytesSaved, 0, tojson(metrics));
+
+    replSet.stopSet();
+})();
@@ -0,0 +1,50 @@
+/**
+ * Tests that reads on a secondary are served from the snapshot of the last applied batch while a
+ * batch of oplog entries is being applied, instead of waiting for the batch to finish.
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/check_log.js");
+
+    const name = "secondary_reads_during_batch_application";
+    const replSet = new ReplSetTest({name: name, nodes: [{}, {rsConfig: {priority: 0}}]});
+    replSet.startSet();
+    replSet.initiate();
+
+    const primary = replSet.getPrimary();
+    const secondary = replSet.getSecondary();
+
+    if (!primary.getDB("admin").serverStatus().storageEngine.supportsCommittedReads) {
+        jsTestLog("Skipping test since the storage engine does not support snapshot reads");
+        replSet.stopSet();
+        return;
+    }
+
+    const primaryDB = primary.getDB(name);
+    const secondaryDB = secondary.getDB(name);
+    secondaryDB.getMongo().setSlaveOk();
+
+    assert.writeOK(primaryDB.coll.insert({_id: 0}, {writeConcern: {w: 2}}));
+
+    // Hold the next batch open on the secondary. The batch holds the ParallelBatchWriterMode lock
+    // until the fail point is disabled.
+    assert.commandWorked(secondary.adminCommand(
+        {configureFailPoint: "pauseBatchApplicationBeforeCompletion", mode: "alwaysOn"}));
+    assert.writeOK(primaryDB.coll.insert({_id: 1}));
+    checkLog.contains(secondary, "pauseBatchApplicationBeforeCompletion fail point enabled");
+
+    // A read during the batch does not block, and does not see the partially applied batch.
+    const res = assert.commandWorked(
+        secondaryDB.runCommand({find: "coll", filter: {}, sort: {_id: 1}, maxTimeMS: 10 * 1000}));
+    assert.eq([{_id: 0}], res.cursor.firstBatch);
+    assert.eq(1, secondaryDB.coll.find().itcount());
+
+    assert.commandWorked(secondary.adminCommand(
+        {configureFailPoint: "pauseBatchApplicationBeforeCompletion", mode: "off"}));
+    replSet.awaitReplication();
+
+    assert.eq(2, secondaryDB.coll.find().itcount());
+
+    replSet.stopSet();
+})();
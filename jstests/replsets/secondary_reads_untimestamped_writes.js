@@ -0,0 +1,79 @@
+/**
+ * Tests that a read on a secondary waits for a batch containing writes that are not timestamped,
+ * such as those of an atomic applyOps or an index build, to finish. Reading from the snapshot of
+ * the previous batch would observe those writes before the rest of the batch is applied.
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/check_log.js");
+
+    const name = "secondary_reads_untimestamped_writes";
+    const replSet = new ReplSetTest({name: name, nodes: [{}, {rsConfig: {priority: 0}}]});
+    replSet.startSet();
+    replSet.initiate();
+
+    const primary = replSet.getPrimary();
+    const secondary = replSet.getSecondary();
+
+    if (!primary.getDB("admin").serverStatus().storageEngine.supportsCommittedReads) {
+        jsTestLog("Skipping test since the storage engine does not support snapshot reads");
+        replSet.stopSet();
+        return;
+    }
+
+    const primaryDB = primary.getDB(name);
+    const secondaryDB = secondary.getDB(name);
+    secondaryDB.getMongo().setSlaveOk();
+
+    assert.writeOK(primaryDB.coll.insert({_id: 0}, {writeConcern: {w: 2}}));
+
+    /**
+     * Holds the batch replicating 'writeFn' open on the secondary, checks that reads wait for it,
+     * then lets it complete.
+     */
+    function assertReadsWaitForBatch(writeFn) {
+        assert.commandWorked(secondary.adminCommand({clearLog: "global"}));
+        assert.commandWorked(secondary.adminCommand(
+            {configureFailPoint: "pauseBatchApplicationBeforeCompletion", mode: "alwaysOn"}));
+        writeFn();
+        checkLog.contains(secondary, "pauseBatchApplicationBeforeCompletion fail point enabled");
+
+        assert.commandFailedWithCode(
+            secondaryDB.runCommand({find: "coll", filter: {}, maxTimeMS: 2 * 1000}),
+            ErrorCodes.ExceededTimeLimit);
+
+        assert.commandWorked(secondary.adminCommand(
+            {configureFailPoint: "pauseBatchApplicationBeforeCompletion", mode: "off"}));
+        replSet.awaitReplication();
+    }
+
+    assertReadsWaitForBatch(function() {
+        assert.commandWorked(primaryDB.runCommand({
+            applyOps: [
+                {op: "i", ns: primaryDB.coll.getFullName(), o: {_id: 1}},
+                {op: "i", ns: primaryDB.coll.getFullName(), o: {_id: 2}}
+            ]
+        }));
+    });
+    assert.eq(3, secondaryDB.coll.find().itcount());
+
+    assertReadsWaitForBatch(function() {
+        assert.commandWorked(primaryDB.coll.createIndex({a: 1}));
+    });
+    assert.eq(2, secondaryDB.coll.getIndexes().length);
+
+    // Batches whose writes are all timestamped do not block reads.
+    assert.commandWorked(secondary.adminCommand({clearLog: "global"}));
+    assert.commandWorked(secondary.adminCommand(
+        {configureFailPoint: "pauseBatchApplicationBeforeCompletion", mode: "alwaysOn"}));
+    assert.writeOK(primaryDB.coll.insert({_id: 3}));
+    checkLog.contains(secondary, "pauseBatchApplicationBeforeCompletion fail point enabled");
+    assert.eq(3, secondaryDB.coll.find().maxTimeMS(10 * 1000).itcount());
+    assert.commandWorked(secondary.adminCommand(
+        {configureFailPoint: "pauseBatchApplicationBeforeCompletion", mode: "off"}));
+    replSet.awaitReplication();
+    assert.eq(4, secondaryDB.coll.find().itcount());
+
+    replSet.stopSet();
+})();
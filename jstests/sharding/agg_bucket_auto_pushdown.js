@@ -0,0 +1,56 @@
+// Tests that the shards group their documents ahead of a $bucketAuto stage, and that the merger
+// computes the same buckets from those groups as an unsharded $bucketAuto does from the documents.
+(function() {
+    'use strict';
+
+    const shardingTest = new ShardingTest({shards: 2});
+
+    const db = shardingTest.getDB("test");
+    const coll = db.sharded_agg_bucket_auto;
+    const unshardedColl = db.unsharded_agg_bucket_auto;
+
+    assert.commandWorked(shardingTest.s0.adminCommand({enableSharding: db.getName()}));
+    shardingTest.ensurePrimaryShard(db.getName(), 'shard0001');
+    assert.commandWorked(
+        shardingTest.s0.adminCommand({shardCollection: coll.getFullName(), key: {_id: 1}}));
+
+    const bulkOp = coll.initializeUnorderedBulkOp();
+    const unshardedBulkOp = unshardedColl.initializeUnorderedBulkOp();
+    for (let i = 0; i < 1000; ++i) {
+        const doc = {_id: i, x: (i * 7) % 23, y: i % 5};
+        bulkOp.insert(doc);
+        unshardedBulkOp.insert(doc);
+    }
+    assert.writeOK(bulkOp.execute());
+    assert.writeOK(unshardedBulkOp.execute());
+
+    assert.commandWorked(
+        shardingTest.s0.adminCommand({split: coll.getFullName(), middle: {_id: 500}}));
+    assert.commandWorked(shardingTest.s0.adminCommand({
+        moveChunk: coll.getFullName(),
+        find: {_id: 0},
+        to: shardingTest.getOther(shardingTest.getPrimaryShard(db.getName())).name
+    }));
+
+    function testBucketAuto(bucketAutoSpec) {
+        const pipeline = [{$bucketAuto: bucketAutoSpec}];
+        assert.eq(unshardedColl.aggregate(pipeline).toArray(), coll.aggregate(pipeline).toArray());
+
+        const explain = assert.commandWorked(coll.explain().aggregate(pipeline));
+        const shardsPart = explain.splitPipeline.shardsPart;
+        assert(shardsPart[shardsPart.length - 1].hasOwnProperty("$group"), tojson(explain));
+        const mergerStage = explain.splitPipeline.mergerPart.find(
+            (stage) => stage.hasOwnProperty("$bucketAuto"));
+        assert.eq(true, mergerStage.$bucketAuto.$doingMerge, tojson(explain));
+    }
+
+    testBucketAuto({groupBy: "$x", buckets: 4});
+    testBucketAuto({
+        groupBy: "$x",
+        buckets: 5,
+        output: {count: {$sum: 1}, totalY: {$sum: "$y"}, avgY: {$avg: "$y"}, maxY: {$max: "$y"}}
+    });
+    testBucketAuto({groupBy: "$y", buckets: 3, granularity: "R5"});
+
+    shardingTest.stop();
+})();
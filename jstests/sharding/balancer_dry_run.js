@@ -0,0 +1,42 @@
+/**
+ * Tests that balancerDryRun reports the migrations the balancer would schedule without moving
+ * anything, under both the chunk count and the cost-based balancer policies.
+ */
+(function() {
+    "use strict";
+
+    const st = new ShardingTest({shards: 2, other: {enableBalancer: false}});
+    const mongos = st.s0;
+    const ns = "test.foo";
+
+    assert.commandWorked(mongos.adminCommand({enableSharding: "test"}));
+    st.ensurePrimaryShard("test", st.shard0.shardName);
+    assert.commandWorked(mongos.adminCommand({shardCollection: ns, key: {x: 1}}));
+    for (let i = 1; i < 8; i++) {
+        assert.commandWorked(mongos.adminCommand({split: ns, middle: {x: i * 10}}));
+    }
+
+    const configDB = mongos.getDB("config");
+    const numChunksOnShard0 = () => configDB.chunks.count({ns: ns, shard: st.shard0.shardName});
+    assert.eq(8, numChunksOnShard0());
+
+    function checkDryRun() {
+        const res = assert.commandWorked(mongos.adminCommand({balancerDryRun: 1}));
+        assert.eq(1, res.migrations.length, tojson(res));
+        assert.eq(ns, res.migrations[0].ns, tojson(res));
+        assert.eq(st.shard0.shardName, res.migrations[0].from, tojson(res));
+        assert.eq(st.shard1.shardName, res.migrations[0].to, tojson(res));
+
+        // Nothing was actually moved
+        assert.eq(8, numChunksOnShard0());
+    }
+
+    checkDryRun();
+
+    // An empty collection is balanced by chunk count under the cost-based policy as well
+    assert.commandWorked(st.configRS.getPrimary().adminCommand(
+        {setParameter: 1, balancerUseCostBasedPolicy: true}));
+    checkDryRun();
+
+    st.stop();
+})();
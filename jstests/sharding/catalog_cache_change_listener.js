@@ -0,0 +1,39 @@
+/**
+ * Tests that a mongos with the catalog cache change listener enabled picks up chunk splits and
+ * migrations performed through another mongos without having to be sent a stale request first.
+ */
+(function() {
+    "use strict";
+
+    const st = new ShardingTest({
+        shards: 2,
+        mongos: 2,
+        other: {mongosOptions: {setParameter: {catalogCacheChangeListenerEnabled: true}}}
+    });
+
+    const ns = "test.foo";
+    const listeningMongos = st.s1;
+
+    assert.commandWorked(st.s0.adminCommand({enableSharding: "test"}));
+    st.ensurePrimaryShard("test", st.shard0.shardName);
+    assert.commandWorked(st.s0.adminCommand({shardCollection: ns, key: {_id: 1}}));
+
+    // Load the routing table on the listening mongos.
+    assert.eq(0, listeningMongos.getCollection(ns).find().itcount());
+
+    function waitForVersion(expectedVersion) {
+        assert.soon(function() {
+            const res = assert.commandWorked(listeningMongos.adminCommand({getShardVersion: ns}));
+            return timestampCmp(res.version, expectedVersion) === 0;
+        }, "mongos did not pick up version " + tojson(expectedVersion));
+    }
+
+    assert.commandWorked(st.s0.adminCommand({split: ns, middle: {_id: 0}}));
+    waitForVersion(assert.commandWorked(st.s0.adminCommand({getShardVersion: ns})).version);
+
+    assert.commandWorked(st.s0.adminCommand(
+        {moveChunk: ns, find: {_id: 0}, to: st.shard1.shardName, _waitForDelete: true}));
+    waitForVersion(assert.commandWorked(st.s0.adminCommand({getShardVersion: ns})).version);
+
+    st.stop();
+})();
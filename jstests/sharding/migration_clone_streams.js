@@ -0,0 +1,56 @@
+/**
+ * Tests that a chunk, which is large enough to be split into several clone streams, is migrated
+ * completely and that documents written during the clone are not lost.
+ */
+(function() {
+    'use strict';
+
+    load('./jstests/libs/chunk_manipulation_util.js');
+
+    var staticMongod = MongoRunner.runMongod({});  // For startParallelOps.
+
+    var st = new ShardingTest({
+        shards: 2,
+        other: {shardOptions: {setParameter: {migrationCloneStreams: 4}}, chunkSize: 64}
+    });
+
+    var mongos = st.s0;
+    var testDB = mongos.getDB('test');
+    var coll = testDB.foo;
+
+    assert.commandWorked(mongos.adminCommand({enableSharding: 'test'}));
+    st.ensurePrimaryShard('test', st.shard0.shardName);
+    assert.commandWorked(mongos.adminCommand({shardCollection: coll.getFullName(), key: {x: 1}}));
+
+    var numDocs = 10000;
+    var bulk = coll.initializeUnorderedBulkOp();
+    for (var i = 0; i < numDocs; i++) {
+        bulk.insert({_id: i, x: i});
+    }
+    assert.writeOK(bulk.execute());
+
+    // Hold the migration after the clone streams have been set up, write to the chunk and then
+    // let the clone proceed.
+    pauseMoveChunkAtStep(st.shard0, moveChunkStepNames.startedMoveChunk);
+
+    var joinMoveChunk = moveChunkParallel(staticMongod,
+                                          mongos.host,
+                                          {x: 0},
+                                          null,
+                                          coll.getFullName(),
+                                          st.shard1.shardName);
+
+    waitForMoveChunkStep(st.shard0, moveChunkStepNames.startedMoveChunk);
+    assert.writeOK(coll.insert({_id: numDocs, x: numDocs}));
+    assert.writeOK(coll.remove({_id: 0}));
+    unpauseMoveChunkAtStep(st.shard0, moveChunkStepNames.startedMoveChunk);
+
+    joinMoveChunk();
+
+    assert.eq(0, st.shard0.getCollection(coll.getFullName()).count());
+    assert.eq(numDocs, st.shard1.getCollection(coll.getFullName()).count());
+    assert.eq(numDocs, coll.find().itcount());
+
+    st.stop();
+    MongoRunner.stopMongod(staticMongod);
+})();
@@ -49,6 +49,7 @@
     let testCases = {
         _configsvrAddShard: {skip: "primary only"},
         _configsvrAddShardToZone: {skip: "primary only"},
+        _configsvrBalancerDryRun: {skip: "primary only"},
         _configsvrBalancerStart: {skip: "primary only"},
         _configsvrBalancerStatus: {skip: "primary only"},
         _configsvrBalancerStop: {skip: "primary only"},
@@ -89,6 +90,7 @@
         authSchemaUpgrade: {skip: "primary only"},
         authenticate: {skip: "does not return user data"},
         availableQueryOptions: {skip: "does not return user data"},
+        balancerDryRun: {skip: "primary only"},
         balancerStart: {skip: "primary only"},
         balancerStatus: {skip: "primary only"},
         balancerStop: {skip: "primary only"},
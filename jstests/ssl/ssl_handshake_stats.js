@@ -0,0 +1,68 @@
+// Tests that serverStatus reports TLS handshake counts and times for each direction, that a
+// reconnecting connection pool resumes its TLS session, and that outgoing session resumption can be
+// turned off at runtime.
+(function() {
+    'use strict';
+
+    load("jstests/ssl/libs/ssl_helpers.js");
+
+    const replTest = new ReplSetTest({nodes: 2, nodeOptions: requireSSL});
+    replTest.startSet();
+    replTest.initiate();
+
+    const primary = replTest.getPrimary();
+
+    function getHandshakes() {
+        const security = assert.commandWorked(primary.adminCommand({serverStatus: 1})).security;
+        assert(security.hasOwnProperty("handshakes"), tojson(security));
+        return security.handshakes;
+    }
+
+    const handshakes = getHandshakes();
+    for (let direction of ["incoming", "outgoing"]) {
+        for (let field of ["full", "resumed", "failed", "totalTimeMicros"]) {
+            assert(handshakes[direction].hasOwnProperty(field), tojson(handshakes));
+        }
+    }
+
+    // The shell and the secondary have connected to the primary, and the primary to the
+    // secondary for heartbeats.
+    assert.gt(handshakes.incoming.full + handshakes.incoming.resumed, 0, tojson(handshakes));
+    assert.gt(handshakes.outgoing.full + handshakes.outgoing.resumed, 0, tojson(handshakes));
+    assert.gt(handshakes.incoming.totalTimeMicros, 0, tojson(handshakes));
+
+    // Fails the primary's executor commands with a network error, so that its connection pool ends
+    // every connection to the secondary and heartbeats have to connect again, until 'counter' of
+    // the outgoing handshake counts has risen. Returns the counts from before and after.
+    function reconnectToSecondary(counter) {
+        const before = getHandshakes().outgoing;
+        assert.commandWorked(primary.adminCommand(
+            {configureFailPoint: "NetworkInterfaceASIOasyncRunCommandFail", mode: "alwaysOn"}));
+
+        let after;
+        try {
+            assert.soon(function() {
+                after = getHandshakes().outgoing;
+                return after[counter] > before[counter];
+            }, "primary did not reconnect to the secondary");
+        } finally {
+            assert.commandWorked(primary.adminCommand(
+                {configureFailPoint: "NetworkInterfaceASIOasyncRunCommandFail", mode: "off"}));
+        }
+        return {before: before, after: after};
+    }
+
+    // The session negotiated with the secondary is offered again on the new connection.
+    reconnectToSecondary("resumed");
+
+    // With resumption turned off every new connection does a full handshake.
+    assert.commandWorked(
+        primary.adminCommand({setParameter: 1, sslOutgoingSessionResumption: false}));
+    const counts = reconnectToSecondary("full");
+    assert.eq(counts.after.resumed, counts.before.resumed, tojson(counts));
+
+    assert.commandWorked(
+        primary.adminCommand({setParameter: 1, sslOutgoingSessionResumption: true}));
+
+    replTest.stopSet();
+})();
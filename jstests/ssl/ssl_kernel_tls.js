@@ -0,0 +1,43 @@
+// Tests that a server requiring TLS serves its clients through the stream that lets OpenSSL hand
+// record encryption to the kernel, and that it still turns away clients that don't speak TLS.
+(function() {
+    'use strict';
+
+    load("jstests/ssl/libs/ssl_helpers.js");
+
+    function testServer(options) {
+        const conn = MongoRunner.runMongod(options);
+        assert.neq(null, conn, "mongod failed to start with options " + tojson(options));
+
+        // Documents big enough that each reply spans many TLS records and partial writes.
+        const coll = conn.getDB("test").kernel_tls;
+        const big = "x".repeat(4 * 1024 * 1024);
+        for (let i = 0; i < 4; ++i) {
+            assert.writeOK(coll.insert({_id: i, big: big}));
+        }
+        const docs = coll.find().sort({_id: 1}).batchSize(1).toArray();
+        assert.eq(4, docs.length);
+        docs.forEach(function(doc, i) {
+            assert.eq(i, doc._id);
+            assert.eq(big, doc.big);
+        });
+
+        // The server only peeks at a new connection's first bytes before the TLS handshake, so a
+        // plaintext client must still be rejected without disturbing the other connections.
+        assert.neq(0, runMongoProgram("mongo", "--port", conn.port, "--eval", "db.isMaster()"));
+        assert.commandWorked(conn.adminCommand({isMaster: 1}));
+
+        const res = conn.adminCommand({getParameter: 1, sslKernelTLSOffload: 1});
+        MongoRunner.stopMongod(conn);
+        return res;
+    }
+
+    const res = testServer(requireSSL);
+
+    // The parameter only exists when the server was built against an OpenSSL that supports kernel
+    // TLS, and then the offload is on by default.
+    if (res.ok) {
+        assert.eq(true, res.sslKernelTLSOffload, tojson(res));
+        testServer(Object.merge(requireSSL, {setParameter: {sslKernelTLSOffload: false}}));
+    }
+})();
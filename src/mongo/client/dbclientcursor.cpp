@@ -51,6 +51,7 @@
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
+#include "mongo/util/net/op_msg.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -117,13 +118,23 @@ Message DBClientCursor::_assembleInit() {
                                                 nToSkip,
                                                 nextBatchSize(),
                                                 opts);
-        if (qr.isOK() && !qr.getValue()->isExplain() && !qr.getValue()->isExhaust()) {
+        if (qr.isOK() && !qr.getValue()->isExplain()) {
             BSONObj cmd = qr.getValue()->asFindCommand();
             if (auto readPref = query["$readPreference"]) {
                 // QueryRequest doesn't handle $readPreference.
                 cmd = BSONObjBuilder(std::move(cmd)).append(readPref).obj();
             }
-            return assembleCommandRequest(_client, ns.db(), opts, std::move(cmd));
+            auto toSend = assembleCommandRequest(_client, ns.db(), opts, std::move(cmd));
+            if (!qr.getValue()->isExhaust()) {
+                return toSend;
+            }
+
+            // The find command can only be streamed as an OP_MSG exhaust cursor, so fall back to
+            // an OP_QUERY exhaust query if the server doesn't speak OP_MSG.
+            if (toSend.operation() == dbMsg) {
+                OpMsg::setFlag(&toSend, OpMsg::kExhaustSupported);
+                return toSend;
+            }
         }
         // else use legacy OP_QUERY request.
     }
@@ -144,7 +155,11 @@ Message DBClientCursor::_assembleGetMore() {
                                   boost::none,   // awaitDataTimeout
                                   boost::none,   // term
                                   boost::none);  // lastKnownCommittedOptime
-        return assembleCommandRequest(_client, ns.db(), opts, gmr.toBSON());
+        auto toSend = assembleCommandRequest(_client, ns.db(), opts, gmr.toBSON());
+        if ((opts & QueryOption_Exhaust) && toSend.operation() == dbMsg) {
+            OpMsg::setFlag(&toSend, OpMsg::kExhaustSupported);
+        }
+        return toSend;
     } else {
         // Assemble a legacy getMore request.
         return makeGetMoreMessage(ns.ns(), cursorId, nextBatchSize(), opts);
@@ -239,6 +254,12 @@ void DBClientCursor::requestMore() {
 void DBClientCursor::exhaustReceiveMore() {
     verify(cursorId && batch.pos == batch.objs.size());
     verify(!haveLimit);
+    if (_useFindCommand && !_connectionHasPendingReplies) {
+        // The server ended the stream with the cursor still open, as a server that doesn't support
+        // exhaust does after every batch, so ask for the next batch and restart the stream.
+        requestMore();
+        return;
+    }
     Message response;
     verify(_client);
     if (!_client->recv(response, _lastRequestId)) {
@@ -281,6 +302,14 @@ void DBClientCursor::dataReceived(const Message& reply, bool& retry, string& hos
     }
 
     if (_useFindCommand) {
+        if (opts & QueryOption_Exhaust) {
+            // Every reply of an OP_MSG exhaust stream but the last is marked moreToCome, and each
+            // claims to be a reply to the one before it.
+            _connectionHasPendingReplies =
+                reply.operation() == dbMsg && OpMsg::isFlagSet(reply, OpMsg::kMoreToCome);
+            _lastRequestId = reply.header().getId();
+        }
+
         cursorId = 0;  // Don't try to kill cursor if we get back an error.
         auto cr = uassertStatusOK(CursorResponse::parseFromBSON(commandDataReceived(reply)));
         cursorId = cr.getCursorId();
@@ -92,6 +92,27 @@ public:
         return findHostWithMaxWait(readPref, Milliseconds::zero());
     }
 
+    /**
+     * Finds a host other than 'excludedHost' which matches readPref, without blocking or going
+     * over the network. Used to pick a second host to send a hedged read to.
+     *
+     * Returns FailedToSatisfyReadPreference if there is no such host.
+     */
+    virtual StatusWith<HostAndPort> findAlternateHost(const ReadPreferenceSetting& readPref,
+                                                      const HostAndPort& excludedHost) = 0;
+
+    /**
+     * Reports to the targeter how long an operation run on 'host' took to return, so that slow
+     * hosts can be avoided when choosing between several matching hosts.
+     */
+    virtual void noteOperationLatency(const HostAndPort& host, Milliseconds latency) = 0;
+
+    /**
+     * Returns the given percentile (0-100) of the operation latencies recently reported through
+     * noteOperationLatency, or a negative duration if not enough are known.
+     */
+    virtual Milliseconds getOperationLatencyPercentile(int percentile) = 0;
+
     /**
      * Reports to the targeter that a 'status' indicating a not master error was received when
      * communicating with 'host', and so it should update its bookkeeping to avoid giving out the
@@ -57,6 +57,19 @@ public:
         return _mock->findHostWithMaxWait(readPref, maxWait);
     }
 
+    StatusWith<HostAndPort> findAlternateHost(const ReadPreferenceSetting& readPref,
+                                              const HostAndPort& excludedHost) override {
+        return _mock->findAlternateHost(readPref, excludedHost);
+    }
+
+    void noteOperationLatency(const HostAndPort& host, Milliseconds latency) override {
+        _mock->noteOperationLatency(host, latency);
+    }
+
+    Milliseconds getOperationLatencyPercentile(int percentile) override {
+        return _mock->getOperationLatencyPercentile(percentile);
+    }
+
     void markHostNotMaster(const HostAndPort& host, const Status& status) override {
         _mock->markHostNotMaster(host, status);
     }
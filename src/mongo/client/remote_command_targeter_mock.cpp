@@ -36,7 +36,9 @@
 namespace mongo {
 
 RemoteCommandTargeterMock::RemoteCommandTargeterMock()
-    : _findHostReturnValue(Status(ErrorCodes::InternalError, "No return value set")) {}
+    : _findHostReturnValue(Status(ErrorCodes::InternalError, "No return value set")),
+      _findAlternateHostReturnValue(
+          Status(ErrorCodes::FailedToSatisfyReadPreference, "No alternate host set")) {}
 
 RemoteCommandTargeterMock::~RemoteCommandTargeterMock() = default;
 
@@ -63,6 +65,18 @@ StatusWith<HostAndPort> RemoteCommandTargeterMock::findHostWithMaxWait(
     return _findHostReturnValue;
 }
 
+StatusWith<HostAndPort> RemoteCommandTargeterMock::findAlternateHost(
+    const ReadPreferenceSetting& readPref, const HostAndPort& excludedHost) {
+    return _findAlternateHostReturnValue;
+}
+
+void RemoteCommandTargeterMock::noteOperationLatency(const HostAndPort& host,
+                                                     Milliseconds latency) {}
+
+Milliseconds RemoteCommandTargeterMock::getOperationLatencyPercentile(int percentile) {
+    return _operationLatencyPercentileReturnValue;
+}
+
 void RemoteCommandTargeterMock::markHostNotMaster(const HostAndPort& host, const Status& status) {}
 
 void RemoteCommandTargeterMock::markHostUnreachable(const HostAndPort& host, const Status& status) {
@@ -76,4 +90,14 @@ void RemoteCommandTargeterMock::setFindHostReturnValue(StatusWith<HostAndPort> r
     _findHostReturnValue = std::move(returnValue);
 }
 
+void RemoteCommandTargeterMock::setFindAlternateHostReturnValue(
+    StatusWith<HostAndPort> returnValue) {
+    _findAlternateHostReturnValue = std::move(returnValue);
+}
+
+void RemoteCommandTargeterMock::setOperationLatencyPercentileReturnValue(
+    Milliseconds returnValue) {
+    _operationLatencyPercentileReturnValue = returnValue;
+}
+
 }  // namespace mongo
@@ -60,6 +60,24 @@ public:
     StatusWith<HostAndPort> findHost(OperationContext* opCtx,
                                      const ReadPreferenceSetting& readPref) override;
 
+    /**
+     * Returns the return value last set by setFindAlternateHostReturnValue.
+     * Returns ErrorCodes::FailedToSatisfyReadPreference if it was never called.
+     */
+    StatusWith<HostAndPort> findAlternateHost(const ReadPreferenceSetting& readPref,
+                                              const HostAndPort& excludedHost) override;
+
+    /**
+     * No-op for the mock.
+     */
+    void noteOperationLatency(const HostAndPort& host, Milliseconds latency) override;
+
+    /**
+     * Returns the value last set by setOperationLatencyPercentileReturnValue, or -1ms if it was
+     * never called.
+     */
+    Milliseconds getOperationLatencyPercentile(int percentile) override;
+
     /**
      * No-op for the mock.
      */
@@ -80,9 +98,21 @@ public:
      */
     void setFindHostReturnValue(StatusWith<HostAndPort> returnValue);
 
+    /**
+     * Sets the return value for the next call to findAlternateHost.
+     */
+    void setFindAlternateHostReturnValue(StatusWith<HostAndPort> returnValue);
+
+    /**
+     * Sets the return value for the next call to getOperationLatencyPercentile.
+     */
+    void setOperationLatencyPercentileReturnValue(Milliseconds returnValue);
+
 private:
     ConnectionString _connectionStringReturnValue;
     StatusWith<HostAndPort> _findHostReturnValue;
+    StatusWith<HostAndPort> _findAlternateHostReturnValue;
+    Milliseconds _operationLatencyPercentileReturnValue{-1};
 };
 
 }  // namespace mongo
@@ -88,6 +88,28 @@ StatusWith<HostAndPort> RemoteCommandTargeterRS::findHost(OperationContext* opCt
     }
 }
 
+StatusWith<HostAndPort> RemoteCommandTargeterRS::findAlternateHost(
+    const ReadPreferenceSetting& readPref, const HostAndPort& excludedHost) {
+    auto host = _rsMonitor->getAlternateHost(readPref, excludedHost);
+    if (host.empty()) {
+        return {ErrorCodes::FailedToSatisfyReadPreference,
+                str::stream() << "Could not find a host other than " << excludedHost
+                              << " matching read preference "
+                              << readPref.toString()
+                              << " for set "
+                              << _rsName};
+    }
+    return host;
+}
+
+void RemoteCommandTargeterRS::noteOperationLatency(const HostAndPort& host, Milliseconds latency) {
+    _rsMonitor->noteOperationLatency(host, latency);
+}
+
+Milliseconds RemoteCommandTargeterRS::getOperationLatencyPercentile(int percentile) {
+    return _rsMonitor->getOperationLatencyPercentile(percentile);
+}
+
 void RemoteCommandTargeterRS::markHostNotMaster(const HostAndPort& host, const Status& status) {
     invariant(_rsMonitor);
 
@@ -52,6 +52,19 @@ StatusWith<HostAndPort> RemoteCommandTargeterStandalone::findHost(
     return _hostAndPort;
 }
 
+StatusWith<HostAndPort> RemoteCommandTargeterStandalone::findAlternateHost(
+    const ReadPreferenceSetting& readPref, const HostAndPort& excludedHost) {
+    return {ErrorCodes::FailedToSatisfyReadPreference,
+            "A standalone host has no alternate host to target"};
+}
+
+void RemoteCommandTargeterStandalone::noteOperationLatency(const HostAndPort& host,
+                                                           Milliseconds latency) {}
+
+Milliseconds RemoteCommandTargeterStandalone::getOperationLatencyPercentile(int percentile) {
+    return Milliseconds(-1);
+}
+
 void RemoteCommandTargeterStandalone::markHostNotMaster(const HostAndPort& host,
                                                         const Status& status) {
     dassert(host == _hostAndPort);
@@ -49,6 +49,13 @@ public:
     StatusWith<HostAndPort> findHostWithMaxWait(const ReadPreferenceSetting& readPref,
                                                 Milliseconds maxWait) override;
 
+    StatusWith<HostAndPort> findAlternateHost(const ReadPreferenceSetting& readPref,
+                                              const HostAndPort& excludedHost) override;
+
+    void noteOperationLatency(const HostAndPort& host, Milliseconds latency) override;
+
+    Milliseconds getOperationLatencyPercentile(int percentile) override;
+
     void markHostNotMaster(const HostAndPort& host, const Status& status) override;
 
     void markHostUnreachable(const HostAndPort& host, const Status& status) override;
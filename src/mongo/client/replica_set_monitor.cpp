@@ -87,6 +87,11 @@ const double socketTimeoutSecs = 5;
 const int64_t unknownLatency = numeric_limits<int64_t>::max();
 
 const ReadPreferenceSetting kPrimaryOnlyReadPreference(ReadPreference::PrimaryOnly, TagSet());
+
+// Number of recent operation latencies kept per set for computing latency percentiles, and the
+// number which must have been noted before any percentile is reported.
+const size_t kNumOperationLatencySamples = 128;
+const size_t kMinOperationLatencySamples = 16;
 const Milliseconds kFindHostMaxBackOffTime(500);
 
 // TODO: Move to ReplicaSetMonitorManager
@@ -105,10 +110,6 @@ bool opTimeGreater(const Node* lhs, const Node* rhs) {
     return lhs->opTime > rhs->opTime;
 }
 
-bool compareLatencies(const Node* lhs, const Node* rhs) {
-    // NOTE: this automatically compares Node::unknownLatency worse than all others.
-    return lhs->latencyMicros < rhs->latencyMicros;
-}
 
 bool hostsEqual(const Node& lhs, const HostAndPort& rhs) {
     return lhs.host == rhs;
@@ -328,6 +329,28 @@ void ReplicaSetMonitor::failedHost(const HostAndPort& host, const Status& status
     DEV _state->checkInvariants();
 }
 
+HostAndPort ReplicaSetMonitor::getAlternateHost(const ReadPreferenceSetting& readPref,
+                                                const HostAndPort& excludedHost) {
+    stdx::lock_guard<stdx::mutex> lk(_state->mutex);
+    return _state->getMatchingHost(readPref, excludedHost);
+}
+
+void ReplicaSetMonitor::noteOperationLatency(const HostAndPort& host, Milliseconds latency) {
+    stdx::lock_guard<stdx::mutex> lk(_state->mutex);
+    _state->noteOperationLatency(host, durationCount<Microseconds>(latency));
+}
+
+Milliseconds ReplicaSetMonitor::getOperationLatencyPercentile(int percentile) const {
+    stdx::lock_guard<stdx::mutex> lk(_state->mutex);
+    const int64_t latencyMicros = _state->getOperationLatencyPercentile(percentile);
+    if (latencyMicros < 0) {
+        return Milliseconds(-1);
+    }
+
+    // Round up, so that sub-millisecond latencies do not turn into a delay of zero.
+    return Milliseconds((latencyMicros + 999) / 1000);
+}
+
 bool ReplicaSetMonitor::isPrimary(const HostAndPort& host) const {
     stdx::lock_guard<stdx::mutex> lk(_state->mutex);
     Node* node = _state->findNode(host);
@@ -993,6 +1016,23 @@ void Node::update(const IsMasterReply& reply) {
     lastWriteDateUpdateTime = Date_t::now();
 }
 
+void Node::noteOperationLatency(int64_t operationLatencyMicrosSample, Date_t now) {
+    if (now - operationLatencyUpdateTime > kRefreshPeriod) {
+        operationLatencyMicros = operationLatencyMicrosSample;
+    } else {
+        // update latency with smoothed moving average (1/4th the delta), same as for isMaster
+        operationLatencyMicros += (operationLatencyMicrosSample - operationLatencyMicros) / 4;
+    }
+    operationLatencyUpdateTime = now;
+}
+
+int64_t Node::selectionLatencyMicros(Date_t now) const {
+    if (latencyMicros == unknownLatency || now - operationLatencyUpdateTime > kRefreshPeriod) {
+        return latencyMicros;
+    }
+    return latencyMicros + operationLatencyMicros;
+}
+
 SetState::SetState(StringData name, const std::set<HostAndPort>& seedNodes)
     : name(name.toString()),
       consecutiveFailedScans(0),
@@ -1024,33 +1064,38 @@ SetState::SetState(const MongoURI& uri)
     setUri = uri;
 }
 
-HostAndPort SetState::getMatchingHost(const ReadPreferenceSetting& criteria) const {
+HostAndPort SetState::getMatchingHost(const ReadPreferenceSetting& criteria,
+                                      const HostAndPort& excludedHost) const {
     switch (criteria.pref) {
         // "Prefered" read preferences are defined in terms of other preferences
         case ReadPreference::PrimaryPreferred: {
-            HostAndPort out =
-                getMatchingHost(ReadPreferenceSetting(ReadPreference::PrimaryOnly, criteria.tags));
+            HostAndPort out = getMatchingHost(
+                ReadPreferenceSetting(ReadPreference::PrimaryOnly, criteria.tags), excludedHost);
             // NOTE: the spec says we should use the primary even if tags don't match
             if (!out.empty())
                 return out;
-            return getMatchingHost(ReadPreferenceSetting(
-                ReadPreference::SecondaryOnly, criteria.tags, criteria.maxStalenessSeconds));
+            return getMatchingHost(
+                ReadPreferenceSetting(
+                    ReadPreference::SecondaryOnly, criteria.tags, criteria.maxStalenessSeconds),
+                excludedHost);
         }
 
         case ReadPreference::SecondaryPreferred: {
-            HostAndPort out = getMatchingHost(ReadPreferenceSetting(
-                ReadPreference::SecondaryOnly, criteria.tags, criteria.maxStalenessSeconds));
+            HostAndPort out = getMatchingHost(
+                ReadPreferenceSetting(
+                    ReadPreference::SecondaryOnly, criteria.tags, criteria.maxStalenessSeconds),
+                excludedHost);
             if (!out.empty())
                 return out;
             // NOTE: the spec says we should use the primary even if tags don't match
             return getMatchingHost(
-                ReadPreferenceSetting(ReadPreference::PrimaryOnly, criteria.tags));
+                ReadPreferenceSetting(ReadPreference::PrimaryOnly, criteria.tags), excludedHost);
         }
 
         case ReadPreference::PrimaryOnly: {
             // NOTE: isMaster implies isUp
             Nodes::const_iterator it = std::find_if(nodes.begin(), nodes.end(), isMaster);
-            if (it == nodes.end())
+            if (it == nodes.end() || it->host == excludedHost)
                 return HostAndPort();
             return it->host;
         }
@@ -1106,7 +1151,7 @@ HostAndPort SetState::getMatchingHost(const ReadPreferenceSetting& criteria) con
                 std::vector<const Node*> matchingNodes;
                 for (size_t i = 0; i < nodes.size(); i++) {
                     if (nodes[i].matches(criteria.pref) && nodes[i].matches(tag) &&
-                        matchNode(nodes[i])) {
+                        matchNode(nodes[i]) && nodes[i].host != excludedHost) {
                         matchingNodes.push_back(&nodes[i]);
                     }
                 }
@@ -1141,10 +1186,18 @@ HostAndPort SetState::getMatchingHost(const ReadPreferenceSetting& criteria) con
 
                 // If there are multiple nodes satisfying the minOpTime, next order by latency
                 // and don't consider hosts further than a threshold from the closest.
-                std::sort(matchingNodes.begin(), matchingNodes.end(), compareLatencies);
+                const Date_t now = Date_t::now();
+                std::sort(matchingNodes.begin(),
+                          matchingNodes.end(),
+                          [now](const Node* lhs, const Node* rhs) {
+                              // NOTE: this automatically compares Node::unknownLatency worse
+                              // than all others.
+                              return lhs->selectionLatencyMicros(now) <
+                                  rhs->selectionLatencyMicros(now);
+                          });
                 for (size_t i = 1; i < matchingNodes.size(); i++) {
-                    int64_t distance =
-                        matchingNodes[i]->latencyMicros - matchingNodes[0]->latencyMicros;
+                    int64_t distance = matchingNodes[i]->selectionLatencyMicros(now) -
+                        matchingNodes[0]->selectionLatencyMicros(now);
                     if (distance >= latencyThresholdMicros) {
                         // this node and all remaining ones are too far away
                         matchingNodes.erase(matchingNodes.begin() + i, matchingNodes.end());
@@ -1171,6 +1224,35 @@ HostAndPort SetState::getMatchingHost(const ReadPreferenceSetting& criteria) con
     }
 }
 
+void SetState::noteOperationLatency(const HostAndPort& host, int64_t latencyMicros) {
+    if (latencyMicros < 0) {
+        return;
+    }
+
+    if (Node* node = findNode(host)) {
+        node->noteOperationLatency(latencyMicros, Date_t::now());
+    }
+
+    if (recentOperationLatencies.size() < kNumOperationLatencySamples) {
+        recentOperationLatencies.push_back(latencyMicros);
+    } else {
+        recentOperationLatencies[nextOperationLatency] = latencyMicros;
+        nextOperationLatency = (nextOperationLatency + 1) % kNumOperationLatencySamples;
+    }
+}
+
+int64_t SetState::getOperationLatencyPercentile(int percentile) const {
+    invariant(percentile >= 0 && percentile <= 100);
+    if (recentOperationLatencies.size() < kMinOperationLatencySamples) {
+        return -1;
+    }
+
+    std::vector<int64_t> latencies(recentOperationLatencies);
+    const size_t rank = std::min(latencies.size() - 1, latencies.size() * percentile / 100);
+    std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+    return latencies[rank];
+}
+
 Node* SetState::findNode(const HostAndPort& host) {
     const Nodes::iterator it = std::lower_bound(nodes.begin(), nodes.end(), host, compareHosts);
     if (it == nodes.end() || it->host != host)
@@ -119,6 +119,27 @@ public:
      */
     void failedHost(const HostAndPort& host, const Status& status);
 
+    /**
+     * Returns a host other than 'excludedHost' which matches 'readPref', or an empty host if there
+     * is none. Uses only local data and never refreshes the view of the set, so this is suitable
+     * for finding a second host to send a hedged read to.
+     */
+    HostAndPort getAlternateHost(const ReadPreferenceSetting& readPref,
+                                 const HostAndPort& excludedHost);
+
+    /**
+     * Notes how long an operation run on 'host' took to return. A moving average of these is added
+     * to each host's ping time when choosing between hosts, so that a host which is responding
+     * slowly (for example because it is stalled or overloaded) is avoided for a while.
+     */
+    void noteOperationLatency(const HostAndPort& host, Milliseconds latency);
+
+    /**
+     * Returns the given percentile (0-100) of the latencies of the operations recently noted with
+     * noteOperationLatency across the whole set, or a negative duration if too few have been noted.
+     */
+    Milliseconds getOperationLatencyPercentile(int percentile) const;
+
     /**
      * Returns true if this node is the master based ONLY on local data. Be careful, return may
      * be stale.
@@ -122,10 +122,25 @@ public:
          */
         void update(const IsMasterReply& reply);
 
+        /**
+         * Folds the latency of an operation run on this host into operationLatencyMicros.
+         */
+        void noteOperationLatency(int64_t operationLatencyMicrosSample, Date_t now);
+
+        /**
+         * Returns the latency used to choose between nodes: the isMaster round trip time, plus
+         * the moving average of recent operation latencies if that has been updated recently.
+         * Operation latencies which have not been updated for a while are ignored, so that a node
+         * which was avoided for being slow is eventually tried again.
+         */
+        int64_t selectionLatencyMicros(Date_t now) const;
+
         HostAndPort host;
         bool isUp{false};
         bool isMaster{false};
         int64_t latencyMicros{};
+        int64_t operationLatencyMicros{};  // moving average of latencies seen by operations
+        Date_t operationLatencyUpdateTime{};
         BSONObj tags;  // owned
         int minWireVersion{};
         int maxWireVersion{};
@@ -147,11 +162,25 @@ public:
     bool isUsable() const;
 
     /**
-     * Returns a host matching criteria or an empty host if no known host matches.
+     * Returns a host matching criteria or an empty host if no known host matches. Never returns
+     * 'excludedHost'.
      *
      * Note: Uses only local data and does not go over the network.
      */
-    HostAndPort getMatchingHost(const ReadPreferenceSetting& criteria) const;
+    HostAndPort getMatchingHost(const ReadPreferenceSetting& criteria,
+                                const HostAndPort& excludedHost = HostAndPort()) const;
+
+    /**
+     * Records the latency of an operation run on 'host', both for the host's selection latency
+     * and for the set-wide latency percentiles.
+     */
+    void noteOperationLatency(const HostAndPort& host, int64_t latencyMicros);
+
+    /**
+     * Returns the given percentile of the recent operation latencies across the set, or -1 if
+     * too few operations have been noted.
+     */
+    int64_t getOperationLatencyPercentile(int percentile) const;
 
     /**
      * Returns the Node with the given host, or NULL if no Node has that host.
@@ -206,6 +235,11 @@ public:
     mutable PseudoRandom rand;  // only used for host selection to balance load
     mutable int roundRobin;     // used when useDeterministicHostSelection is true
     MongoURI setUri;            // URI that may have constructed this
+
+    // Latencies in micros of the most recent operations passed to noteOperationLatency. Once full,
+    // this is used as a ring buffer with nextOperationLatency as the oldest entry.
+    std::vector<int64_t> recentOperationLatencies;
+    size_t nextOperationLatency{0};
 };
 
 struct ReplicaSetMonitor::ScanState {
@@ -298,6 +298,68 @@ TEST(ReplSetMonitorReadPref, NearestOneLocal) {
     ASSERT(!isPrimarySelected);
 }
 
+TEST(ReplSetMonitorReadPref, NearestAvoidsHostWithSlowOperations) {
+    vector<Node> nodes = getThreeMemberWithTags();
+    TagSet tags(getDefaultTagSet());
+
+    const Date_t now = Date_t::now();
+    for (auto& node : nodes) {
+        node.latencyMicros = 1 * 1000;
+        node.noteOperationLatency(1 * 1000, now);
+    }
+    nodes[0].noteOperationLatency(200 * 1000, now);
+
+    for (int i = 0; i < 10; ++i) {
+        HostAndPort host = selectNode(nodes, mongo::ReadPreference::Nearest, tags, 3, nullptr);
+        ASSERT(!host.empty());
+        ASSERT_NOT_EQUALS("a", host.host());
+    }
+}
+
+TEST(ReplSetMonitorReadPref, NearestIgnoresOldOperationLatencies) {
+    vector<Node> nodes = getThreeMemberWithTags();
+    TagSet tags(getDefaultTagSet());
+
+    nodes[0].latencyMicros = 10 * 1000;
+    nodes[1].latencyMicros = 20 * 1000;
+    nodes[2].latencyMicros = 30 * 1000;
+    nodes[0].noteOperationLatency(200 * 1000, Date_t::now() - Minutes(5));
+
+    HostAndPort host = selectNode(nodes, mongo::ReadPreference::Nearest, tags, 3, nullptr);
+    ASSERT_EQUALS("a", host.host());
+}
+
+TEST(ReplSetMonitorReadPref, SecOnlyExcludedHost) {
+    SetState set("name", {HostAndPort("a")});
+    set.nodes = getThreeMemberWithTags();
+
+    ReadPreferenceSetting criteria(mongo::ReadPreference::SecondaryOnly,
+                                   TagSet(getDefaultTagSet()));
+    ASSERT_EQUALS("c", set.getMatchingHost(criteria, HostAndPort("a")).host());
+    ASSERT_EQUALS("a", set.getMatchingHost(criteria, HostAndPort("c")).host());
+
+    // The primary is never eligible, even when all secondaries are excluded.
+    set.nodes[2].isUp = false;
+    ASSERT(set.getMatchingHost(criteria, HostAndPort("a")).empty());
+}
+
+TEST(ReplSetMonitorReadPref, OperationLatencyPercentile) {
+    SetState set("name", {HostAndPort("a")});
+    set.nodes = getThreeMemberWithTags();
+
+    // Too few latencies are known.
+    set.noteOperationLatency(HostAndPort("a"), 5 * 1000);
+    ASSERT_EQUALS(-1, set.getOperationLatencyPercentile(95));
+
+    // Only the most recent latencies are kept, so the first one noted no longer counts.
+    for (int i = 1; i <= 200; ++i) {
+        set.noteOperationLatency(HostAndPort("c"), i * 1000);
+    }
+    ASSERT_EQUALS(73 * 1000, set.getOperationLatencyPercentile(0));
+    ASSERT_EQUALS(194 * 1000, set.getOperationLatencyPercentile(95));
+    ASSERT_EQUALS(200 * 1000, set.getOperationLatencyPercentile(100));
+}
+
 TEST(ReplSetMonitorReadPref, PriOnlyWithTagsNoMatch) {
     vector<Node> nodes = getThreeMemberWithTags();
     TagSet tags(getP2TagSet());
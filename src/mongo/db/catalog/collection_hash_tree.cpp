@@ -0,0 +1,282 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection_hash_tree.h"
+
+#include "mongo/base/data_view.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/recovery_unit.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/md5.hpp"
+
+namespace mongo {
+namespace {
+
+const auto getRegistry = ServiceContext::declareDecoration<CollectionHashTreeRegistry>();
+
+// The digest of the document an in-progress delete is about to remove. aboutToDelete() is only
+// handed the document and onDelete() only the collection, so the digest is carried between them.
+const auto pendingDeleteDigest =
+    OperationContext::declareDecoration<boost::optional<CollectionHashTree::DocumentDigest>>();
+
+}  // namespace
+
+constexpr int CollectionHashTree::kFanout;
+constexpr int CollectionHashTree::kDepth;
+constexpr size_t CollectionHashTree::kNumLeaves;
+
+CollectionHashTree::DocumentDigest CollectionHashTree::digest(const BSONObj& doc) {
+    DocumentDigest result;
+
+    md5digest docDigest;
+    md5(doc.objdata(), doc.objsize(), docDigest);
+    ConstDataView docView(reinterpret_cast<const char*>(docDigest));
+    result.lanes[0] = docView.read<LittleEndian<uint64_t>>();
+    result.lanes[1] = docView.read<LittleEndian<uint64_t>>(sizeof(uint64_t));
+
+    // Place the document by its _id so that updates never move it between leaves. The type byte is
+    // included so that, for example, the int 1 and the string "\x01\0\0\0" do not collide.
+    BSONElement idElt = doc["_id"];
+    if (idElt.eoo()) {
+        result.leaf = result.lanes[0] % kNumLeaves;
+        return result;
+    }
+
+    md5_state_t st;
+    md5_init(&st);
+    const char type = idElt.type();
+    md5_append(&st, reinterpret_cast<const md5_byte_t*>(&type), 1);
+    md5_append(&st, reinterpret_cast<const md5_byte_t*>(idElt.value()), idElt.valuesize());
+    md5digest idDigest;
+    md5_finish(&st, idDigest);
+    result.leaf =
+        ConstDataView(reinterpret_cast<const char*>(idDigest)).read<LittleEndian<uint32_t>>() %
+        kNumLeaves;
+    return result;
+}
+
+size_t CollectionHashTree::numNodesAtLevel(int level) {
+    invariant(level >= 0 && level <= kDepth);
+    size_t n = 1;
+    for (int i = 0; i < level; ++i) {
+        n *= kFanout;
+    }
+    return n;
+}
+
+void CollectionHashTree::add(const DocumentDigest& digest) {
+    Leaf& leaf = _leaves[digest.leaf];
+    leaf.lanes[0].fetchAndAdd(digest.lanes[0]);
+    leaf.lanes[1].fetchAndAdd(digest.lanes[1]);
+    leaf.count.fetchAndAdd(1);
+}
+
+void CollectionHashTree::remove(const DocumentDigest& digest) {
+    Leaf& leaf = _leaves[digest.leaf];
+    leaf.lanes[0].fetchAndSubtract(digest.lanes[0]);
+    leaf.lanes[1].fetchAndSubtract(digest.lanes[1]);
+    leaf.count.fetchAndSubtract(1);
+}
+
+void CollectionHashTree::_nodeDigest(int level, size_t index, unsigned char* out) const {
+    md5_state_t st;
+    md5_init(&st);
+
+    if (level == kDepth) {
+        const Leaf& leaf = _leaves[index];
+        char buf[3 * sizeof(uint64_t)];
+        DataView view(buf);
+        view.write<LittleEndian<uint64_t>>(leaf.lanes[0].load(), 0);
+        view.write<LittleEndian<uint64_t>>(leaf.lanes[1].load(), sizeof(uint64_t));
+        view.write<LittleEndian<int64_t>>(leaf.count.load(), 2 * sizeof(uint64_t));
+        md5_append(&st, reinterpret_cast<const md5_byte_t*>(buf), sizeof(buf));
+    } else {
+        for (size_t child = index * kFanout; child < (index + 1) * kFanout; ++child) {
+            md5digest childDigest;
+            _nodeDigest(level + 1, child, childDigest);
+            md5_append(&st, childDigest, sizeof(childDigest));
+        }
+    }
+
+    md5_finish(&st, out);
+}
+
+std::string CollectionHashTree::nodeHash(int level, size_t index) const {
+    invariant(index < numNodesAtLevel(level));
+    md5digest d;
+    _nodeDigest(level, index, d);
+    return digestToString(d);
+}
+
+long long CollectionHashTree::nodeCount(int level, size_t index) const {
+    invariant(index < numNodesAtLevel(level));
+    const size_t width = kNumLeaves / numNodesAtLevel(level);
+    long long count = 0;
+    for (size_t leaf = index * width; leaf < (index + 1) * width; ++leaf) {
+        count += _leaves[leaf].count.load();
+    }
+    return count;
+}
+
+CollectionHashTreeRegistry& CollectionHashTreeRegistry::get(ServiceContext* service) {
+    return getRegistry(service);
+}
+
+CollectionHashTreeRegistry& CollectionHashTreeRegistry::get(OperationContext* opCtx) {
+    return getRegistry(opCtx->getServiceContext());
+}
+
+std::shared_ptr<const CollectionHashTree> CollectionHashTreeRegistry::find(
+    const UUID& uuid) const {
+    return _find(uuid);
+}
+
+std::shared_ptr<CollectionHashTree> CollectionHashTreeRegistry::_find(
+    const OptionalCollectionUUID& uuid) const {
+    if (!uuid || _numTrees.load() == 0) {
+        return nullptr;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _trees.find(*uuid);
+    if (it == _trees.end()) {
+        return nullptr;
+    }
+    return it->second.tree;
+}
+
+void CollectionHashTreeRegistry::install(const UUID& uuid,
+                                         const NamespaceString& nss,
+                                         std::shared_ptr<CollectionHashTree> tree) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _trees[uuid] = Entry{nss, std::move(tree)};
+    _numTrees.store(_trees.size());
+}
+
+void CollectionHashTreeRegistry::_apply(OperationContext* opCtx,
+                                        std::shared_ptr<CollectionHashTree> tree,
+                                        const CollectionHashTree::DocumentDigest& digest,
+                                        bool isInsert) {
+    if (isInsert) {
+        tree->add(digest);
+        opCtx->recoveryUnit()->onRollback([tree, digest] { tree->remove(digest); });
+    } else {
+        tree->remove(digest);
+        opCtx->recoveryUnit()->onRollback([tree, digest] { tree->add(digest); });
+    }
+}
+
+void CollectionHashTreeRegistry::onInsert(OperationContext* opCtx,
+                                          const OptionalCollectionUUID& uuid,
+                                          const BSONObj& doc) {
+    auto tree = _find(uuid);
+    if (!tree) {
+        return;
+    }
+    _apply(opCtx, std::move(tree), CollectionHashTree::digest(doc), true);
+}
+
+void CollectionHashTreeRegistry::onUpdate(OperationContext* opCtx,
+                                          const OptionalCollectionUUID& uuid,
+                                          const boost::optional<BSONObj>& preImageDoc,
+                                          const BSONObj& updatedDoc) {
+    auto tree = _find(uuid);
+    if (!tree) {
+        return;
+    }
+
+    // In-place updates with damages do not capture the pre-image, so there is nothing to subtract.
+    if (!preImageDoc) {
+        invalidate(uuid);
+        return;
+    }
+
+    _apply(opCtx, tree, CollectionHashTree::digest(*preImageDoc), false);
+    _apply(opCtx, std::move(tree), CollectionHashTree::digest(updatedDoc), true);
+}
+
+void CollectionHashTreeRegistry::aboutToDelete(OperationContext* opCtx, const BSONObj& doc) {
+    auto& pending = pendingDeleteDigest(opCtx);
+    pending = boost::none;
+    if (_numTrees.load() == 0) {
+        return;
+    }
+    pending = CollectionHashTree::digest(doc);
+}
+
+void CollectionHashTreeRegistry::onDelete(OperationContext* opCtx,
+                                          const OptionalCollectionUUID& uuid) {
+    auto& pending = pendingDeleteDigest(opCtx);
+    auto digest = std::move(pending);
+    pending = boost::none;
+
+    auto tree = _find(uuid);
+    if (!tree) {
+        return;
+    }
+
+    // The tree was installed between aboutToDelete() and onDelete(); we cannot tell what to remove.
+    if (!digest) {
+        invalidate(uuid);
+        return;
+    }
+
+    _apply(opCtx, std::move(tree), *digest, false);
+}
+
+void CollectionHashTreeRegistry::invalidate(const OptionalCollectionUUID& uuid) {
+    if (!uuid || _numTrees.load() == 0) {
+        return;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _trees.erase(*uuid);
+    _numTrees.store(_trees.size());
+}
+
+void CollectionHashTreeRegistry::invalidateDatabase(StringData dbName) {
+    if (_numTrees.load() == 0) {
+        return;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    for (auto it = _trees.begin(); it != _trees.end();) {
+        if (it->second.nss.db() == dbName) {
+            it = _trees.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    _numTrees.store(_trees.size());
+}
+
+}  // namespace mongo
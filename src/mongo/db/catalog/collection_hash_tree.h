@@ -0,0 +1,200 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class BSONObj;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * An incrementally maintained Merkle tree of document hashes for a single collection.
+ *
+ * Every document is assigned to one of kNumLeaves leaves by a hash of its _id, so a document lands
+ * in the same leaf on every member of a replica set regardless of the order in which writes were
+ * applied. A leaf stores the number of documents in it and the sum, modulo 2^64 per 64-bit lane,
+ * of their MD5 digests. Sums are commutative and invertible, which lets concurrent writers update
+ * leaves without coordination and lets an aborted write be undone by subtracting its digest.
+ *
+ * Interior node hashes are the MD5 of their children's hashes and are computed on demand. Two
+ * trees with equal root hashes hold the same documents with overwhelming probability; when the
+ * roots differ, comparing child hashes level by level narrows the difference down to a set of
+ * leaves.
+ *
+ * Level 0 is the root; level kDepth is the leaf level.
+ */
+class CollectionHashTree {
+    MONGO_DISALLOW_COPYING(CollectionHashTree);
+
+public:
+    static constexpr int kFanout = 16;
+    static constexpr int kDepth = 3;
+    static constexpr size_t kNumLeaves = 16 * 16 * 16;
+
+    /**
+     * The contribution of a single document to the tree.
+     */
+    struct DocumentDigest {
+        size_t leaf;
+        std::array<uint64_t, 2> lanes;
+    };
+
+    CollectionHashTree() = default;
+
+    /**
+     * Computes the leaf and digest of 'doc'.
+     */
+    static DocumentDigest digest(const BSONObj& doc);
+
+    /**
+     * Returns the number of nodes on 'level'.
+     */
+    static size_t numNodesAtLevel(int level);
+
+    void add(const DocumentDigest& digest);
+    void remove(const DocumentDigest& digest);
+
+    /**
+     * Returns the hex-encoded hash of the node at position 'index' on 'level'.
+     */
+    std::string nodeHash(int level, size_t index) const;
+
+    /**
+     * Returns the number of documents stored under the node at position 'index' on 'level'.
+     */
+    long long nodeCount(int level, size_t index) const;
+
+    std::string rootHash() const {
+        return nodeHash(0, 0);
+    }
+
+    long long count() const {
+        return nodeCount(0, 0);
+    }
+
+private:
+    struct Leaf {
+        AtomicUInt64 lanes[2];
+        AtomicInt64 count;
+    };
+
+    void _nodeDigest(int level, size_t index, unsigned char* out) const;
+
+    std::array<Leaf, kNumLeaves> _leaves;
+};
+
+/**
+ * Owns the CollectionHashTrees maintained on this node, keyed by collection UUID.
+ *
+ * Trees are created on demand by dbHash and from then on kept up to date by the OpObserver. A tree
+ * is discarded whenever its collection changes in a way the OpObserver cannot describe as a set of
+ * document insertions and deletions (drop, truncation, or an update without a pre-image); the next
+ * request that needs it rebuilds it from a collection scan.
+ *
+ * Callers installing or reading a tree must hold the collection lock in at least MODE_S so that no
+ * writer can be concurrently updating it.
+ */
+class CollectionHashTreeRegistry {
+    MONGO_DISALLOW_COPYING(CollectionHashTreeRegistry);
+
+public:
+    CollectionHashTreeRegistry() = default;
+
+    static CollectionHashTreeRegistry& get(ServiceContext* service);
+    static CollectionHashTreeRegistry& get(OperationContext* opCtx);
+
+    /**
+     * Returns the maintained tree for 'uuid', or nullptr if there is none.
+     */
+    std::shared_ptr<const CollectionHashTree> find(const UUID& uuid) const;
+
+    /**
+     * Starts maintaining 'tree' for the collection 'nss' with the given 'uuid'. The tree must
+     * reflect the current contents of the collection.
+     */
+    void install(const UUID& uuid,
+                 const NamespaceString& nss,
+                 std::shared_ptr<CollectionHashTree> tree);
+
+    /**
+     * OpObserver hooks. Each change is applied immediately and reverted if the enclosing
+     * WriteUnitOfWork rolls back.
+     */
+    void onInsert(OperationContext* opCtx, const OptionalCollectionUUID& uuid, const BSONObj& doc);
+    void onUpdate(OperationContext* opCtx,
+                  const OptionalCollectionUUID& uuid,
+                  const boost::optional<BSONObj>& preImageDoc,
+                  const BSONObj& updatedDoc);
+    void aboutToDelete(OperationContext* opCtx, const BSONObj& doc);
+    void onDelete(OperationContext* opCtx, const OptionalCollectionUUID& uuid);
+
+    /**
+     * Stops maintaining the tree for a collection, or for every collection in 'dbName'.
+     */
+    void invalidate(const OptionalCollectionUUID& uuid);
+    void invalidateDatabase(StringData dbName);
+
+private:
+    struct Entry {
+        NamespaceString nss;
+        std::shared_ptr<CollectionHashTree> tree;
+    };
+
+    std::shared_ptr<CollectionHashTree> _find(const OptionalCollectionUUID& uuid) const;
+
+    void _apply(OperationContext* opCtx,
+                std::shared_ptr<CollectionHashTree> tree,
+                const CollectionHashTree::DocumentDigest& digest,
+                bool isInsert);
+
+    mutable stdx::mutex _mutex;
+    stdx::unordered_map<UUID, Entry, UUID::Hash> _trees;
+
+    // Mirrors _trees.size() so that writers can skip the mutex when nothing is maintained.
+    AtomicWord<long long> _numTrees{0};
+};
+
+}  // namespace mongo
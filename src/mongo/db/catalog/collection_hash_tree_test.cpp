@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection_hash_tree.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(CollectionHashTree, EmptyTreesAreEqual) {
+    CollectionHashTree a;
+    CollectionHashTree b;
+    ASSERT_EQ(a.rootHash(), b.rootHash());
+    ASSERT_EQ(0, a.count());
+}
+
+TEST(CollectionHashTree, RootIsIndependentOfInsertionOrder) {
+    CollectionHashTree a;
+    CollectionHashTree b;
+    for (int i = 0; i < 100; ++i) {
+        a.add(CollectionHashTree::digest(BSON("_id" << i << "x" << i * 2)));
+    }
+    for (int i = 99; i >= 0; --i) {
+        b.add(CollectionHashTree::digest(BSON("_id" << i << "x" << i * 2)));
+    }
+    ASSERT_EQ(a.rootHash(), b.rootHash());
+    ASSERT_EQ(100, a.count());
+}
+
+TEST(CollectionHashTree, RemoveUndoesAdd) {
+    CollectionHashTree tree;
+    tree.add(CollectionHashTree::digest(BSON("_id" << 1)));
+    const auto before = tree.rootHash();
+
+    const auto digest = CollectionHashTree::digest(BSON("_id" << 2 << "a" << "b"));
+    tree.add(digest);
+    ASSERT_NE(before, tree.rootHash());
+
+    tree.remove(digest);
+    ASSERT_EQ(before, tree.rootHash());
+    ASSERT_EQ(1, tree.count());
+}
+
+TEST(CollectionHashTree, UpdateStaysInSameLeaf) {
+    const auto before = CollectionHashTree::digest(BSON("_id" << 7 << "v" << 1));
+    const auto after = CollectionHashTree::digest(BSON("_id" << 7 << "v" << 2));
+    ASSERT_EQ(before.leaf, after.leaf);
+    ASSERT(before.lanes != after.lanes);
+}
+
+TEST(CollectionHashTree, DifferenceIsLocalizedToOneLeafPath) {
+    CollectionHashTree a;
+    CollectionHashTree b;
+    for (int i = 0; i < 1000; ++i) {
+        const auto digest = CollectionHashTree::digest(BSON("_id" << i));
+        a.add(digest);
+        b.add(digest);
+    }
+    const auto extra = CollectionHashTree::digest(BSON("_id"
+                                                       << "extra"));
+    b.add(extra);
+    ASSERT_NE(a.rootHash(), b.rootHash());
+
+    size_t index = extra.leaf;
+    for (int level = CollectionHashTree::kDepth; level > 0; --level) {
+        const size_t numNodes = CollectionHashTree::numNodesAtLevel(level);
+        for (size_t node = 0; node < numNodes; ++node) {
+            if (node == index) {
+                ASSERT_NE(a.nodeHash(level, node), b.nodeHash(level, node));
+            } else {
+                ASSERT_EQ(a.nodeHash(level, node), b.nodeHash(level, node));
+            }
+        }
+        index /= CollectionHashTree::kFanout;
+    }
+    ASSERT_EQ(1, b.nodeCount(CollectionHashTree::kDepth, extra.leaf) -
+                  a.nodeCount(CollectionHashTree::kDepth, extra.leaf));
+}
+
+TEST(CollectionHashTree, NumNodesAtLevel) {
+    ASSERT_EQ(1U, CollectionHashTree::numNodesAtLevel(0));
+    ASSERT_EQ(CollectionHashTree::kNumLeaves,
+              CollectionHashTree::numNodesAtLevel(CollectionHashTree::kDepth));
+}
+
+}  // namespace
+}  // namespace mongo
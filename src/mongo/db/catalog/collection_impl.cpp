@@ -42,6 +42,7 @@
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/background.h"
 #include "mongo/db/catalog/collection_catalog_entry.h"
+#include "mongo/db/catalog/collection_hash_tree.h"
 #include "mongo/db/catalog/database_catalog_entry.h"
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog/index_consistency.h"
@@ -866,6 +867,9 @@ Status CollectionImpl::truncate(OperationContext* opCtx) {
     if (!status.isOK())
         return status;
 
+    // Truncation bypasses the OpObserver, so any maintained hash tree is now stale.
+    CollectionHashTreeRegistry::get(opCtx).invalidate(uuid());
+
     // 4) re-create indexes
     for (size_t i = 0; i < indexSpecs.size(); i++) {
         status = _indexCatalog.createIndexOnEmptyCollection(opCtx, indexSpecs[i]).getStatus();
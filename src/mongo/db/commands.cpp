@@ -32,6 +32,7 @@
 
 #include "mongo/db/commands.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -451,4 +452,25 @@ BSONObj Command::filterCommandReplyForPassthrough(const BSONObj& cmdObj) {
     return bob.obj();
 }
 
+constexpr size_t DuplicateTopLevelFieldChecker::kInlineFields;
+
+void DuplicateTopLevelFieldChecker::check(StringData fieldName) {
+    bool isDuplicate = std::find(_inlineFields.begin(),
+                                 _inlineFields.begin() + _numInlineFields,
+                                 fieldName) != _inlineFields.begin() + _numInlineFields;
+
+    if (!isDuplicate) {
+        if (_numInlineFields < kInlineFields) {
+            _inlineFields[_numInlineFields++] = fieldName;
+        } else {
+            isDuplicate = !_overflowFields.try_emplace(fieldName, true).second;
+        }
+    }
+
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << "Parsed command object contains duplicate top level key: "
+                          << fieldName,
+            !isDuplicate);
+}
+
 }  // namespace mongo
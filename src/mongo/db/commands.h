@@ -28,11 +28,13 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 #include <string>
 #include <vector>
 
 #include "mongo/base/counter.h"
+#include "mongo/base/disallow_copying.h"
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
 #include "mongo/db/auth/privilege.h"
@@ -464,6 +466,7 @@ public:
             arg == "$configServerState" ||               //
             arg == "$db" ||                              //
             arg == "allowImplicitCollectionCreation" ||  //
+            arg == "$oplogDeltaEncoding" ||              //
             arg == "$oplogQueryData" ||                  //
             arg == "$queryOptions" ||                    //
             arg == "$readPreference" ||                  //
@@ -628,4 +631,31 @@ class ErrmsgCommandDeprecated : public BasicCommand {
                            BSONObjBuilder& result) = 0;
 };
 
+/**
+ * Rejects a request body that repeats a top-level field. It is fed each field name from the pass
+ * the command dispatcher already makes over the body, rather than scanning it again. The first
+ * kInlineFields names are remembered in a fixed array and compared linearly, which covers nearly
+ * every request without allocating; only unusually wide bodies spill over into a hash table.
+ */
+class DuplicateTopLevelFieldChecker {
+    MONGO_DISALLOW_COPYING(DuplicateTopLevelFieldChecker);
+
+public:
+    static constexpr size_t kInlineFields = 16;
+
+    DuplicateTopLevelFieldChecker() = default;
+
+    /**
+     * Throws FailedToParse if 'fieldName' has already been passed to this checker. The storage
+     * behind 'fieldName' must outlive the checker.
+     */
+    void check(StringData fieldName);
+
+private:
+    std::array<StringData, kInlineFields> _inlineFields;
+    size_t _numInlineFields = 0;
+
+    StringMap<bool> _overflowFields;
+};
+
 }  // namespace mongo
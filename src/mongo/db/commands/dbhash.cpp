@@ -35,7 +35,9 @@
 #include <map>
 #include <string>
 
+#include "mongo/bson/util/bson_extract.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_hash_tree.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_catalog_entry.h"
 #include "mongo/db/catalog/index_catalog.h"
@@ -54,6 +56,42 @@ namespace mongo {
 
 namespace {
 
+/**
+ * Returns the maintained hash tree of 'collection', building it with a collection scan and
+ * installing it if there is none yet. Returns nullptr for collections whose contents can change
+ * without going through the OpObserver (capped collections) or that have no UUID. The caller must
+ * hold the collection in at least MODE_S.
+ */
+std::shared_ptr<const CollectionHashTree> getOrBuildCollectionHashTree(OperationContext* opCtx,
+                                                                       Collection* collection) {
+    if (collection->isCapped() || !collection->uuid()) {
+        return nullptr;
+    }
+
+    auto& registry = CollectionHashTreeRegistry::get(opCtx);
+    if (auto tree = registry.find(*collection->uuid())) {
+        return tree;
+    }
+
+    auto tree = std::make_shared<CollectionHashTree>();
+    auto exec = InternalPlanner::collectionScan(
+        opCtx, collection->ns().ns(), collection, PlanExecutor::NO_YIELD);
+
+    BSONObj obj;
+    PlanExecutor::ExecState state;
+    while (PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
+        tree->add(CollectionHashTree::digest(obj));
+    }
+    if (PlanExecutor::IS_EOF != state) {
+        uasserted(40652,
+                  "Plan executor error while building collection hash tree: " +
+                      WorkingSetCommon::toStatusString(obj));
+    }
+
+    registry.install(*collection->uuid(), collection->ns(), tree);
+    return tree;
+}
+
 class DBHashCmd : public ErrmsgCommandDeprecated {
 public:
     DBHashCmd() : ErrmsgCommandDeprecated("dbHash", "dbhash") {}
@@ -94,6 +132,18 @@ public:
             }
         }
 
+        // With 'incremental', collections are hashed through their maintained CollectionHashTree,
+        // which is built by a full scan the first time and kept up to date by the OpObserver
+        // afterwards. The resulting hashes are only comparable with other incremental hashes.
+        bool incremental = false;
+        {
+            Status status =
+                bsonExtractBooleanFieldWithDefault(cmdObj, "incremental", false, &incremental);
+            if (!status.isOK()) {
+                return appendCommandStatus(result, status);
+            }
+        }
+
         const std::string ns = parseNs(dbname, cmdObj);
         uassert(ErrorCodes::InvalidNamespace,
                 str::stream() << "Invalid db name: " << ns,
@@ -149,7 +199,8 @@ public:
                 continue;
 
             // Compute the hash for this collection.
-            std::string hash = _hashCollection(opCtx, db, collNss.toString());
+            std::string hash = incremental ? _hashCollectionIncremental(opCtx, db, collNss)
+                                           : _hashCollection(opCtx, db, collNss.toString());
 
             bb.append(collNss.coll(), hash);
             md5_append(&globalState, (const md5_byte_t*)hash.c_str(), hash.size());
@@ -161,12 +212,30 @@ public:
         std::string hash = digestToString(d);
 
         result.append("md5", hash);
+        if (incremental) {
+            result.append("incremental", true);
+        }
         result.appendNumber("timeMillis", timer.millis());
 
         return 1;
     }
 
 private:
+    std::string _hashCollectionIncremental(OperationContext* opCtx,
+                                           Database* db,
+                                           const NamespaceString& nss) {
+        Collection* collection = db->getCollection(opCtx, nss);
+        if (!collection)
+            return "";
+
+        auto tree = getOrBuildCollectionHashTree(opCtx, collection);
+        if (!tree) {
+            // Capped collections and collections without a UUID are not maintained.
+            return _hashCollection(opCtx, db, nss.toString());
+        }
+        return tree->rootHash();
+    }
+
     std::string _hashCollection(OperationContext* opCtx,
                                 Database* db,
                                 const std::string& fullCollectionName) {
@@ -224,5 +293,168 @@ private:
 
 } dbhashCmd;
 
+/**
+ * Exposes the nodes of a collection's hash tree so that replica set members whose incremental
+ * dbHash differs can descend to the differing leaves and then to the documents in them.
+ *
+ * {dbHashTree: <collection>, level: <int>, index: <int>} returns the hash and document count of
+ * one node and of each of its children.
+ *
+ * {dbHashTree: <collection>, leaves: [<int>, ...]} returns the _id and MD5 of every document in
+ * the given leaves. This needs a collection scan, but is only meant for the few leaves found to
+ * differ.
+ */
+class DBHashTreeCmd : public BasicCommand {
+public:
+    DBHashTreeCmd() : BasicCommand("dbHashTree") {}
+
+    virtual bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    virtual bool slaveOk() const {
+        return true;
+    }
+
+    virtual void help(std::stringstream& help) const {
+        help << "returns nodes of a collection's incrementally maintained hash tree\n"
+             << "{dbHashTree: <collection>, level: <int>, index: <int>} or "
+             << "{dbHashTree: <collection>, leaves: [<int>, ...]}";
+    }
+
+    virtual void addRequiredPrivileges(const std::string& dbname,
+                                       const BSONObj& cmdObj,
+                                       std::vector<Privilege>* out) {
+        ActionSet actions;
+        actions.addAction(ActionType::dbHash);
+        out->push_back(Privilege(ResourcePattern::forDatabaseName(dbname), actions));
+    }
+
+    virtual bool run(OperationContext* opCtx,
+                     const std::string& dbname,
+                     const BSONObj& cmdObj,
+                     BSONObjBuilder& result) {
+        const NamespaceString nss(parseNsCollectionRequired(dbname, cmdObj));
+
+        AutoGetCollection autoColl(opCtx, nss, MODE_IS, MODE_S);
+        Collection* collection = autoColl.getCollection();
+        if (!collection) {
+            return appendCommandStatus(
+                result,
+                {ErrorCodes::NamespaceNotFound,
+                 str::stream() << "Collection " << nss.ns() << " does not exist"});
+        }
+
+        auto tree = getOrBuildCollectionHashTree(opCtx, collection);
+        if (!tree) {
+            return appendCommandStatus(
+                result,
+                {ErrorCodes::IllegalOperation,
+                 str::stream() << "Collection " << nss.ns() << " does not maintain a hash tree"});
+        }
+
+        if (cmdObj.hasField("leaves")) {
+            return _runLeaves(opCtx, collection, cmdObj, result);
+        }
+
+        long long level = 0;
+        long long index = 0;
+        Status status = bsonExtractIntegerFieldWithDefault(cmdObj, "level", 0, &level);
+        if (status.isOK()) {
+            status = bsonExtractIntegerFieldWithDefault(cmdObj, "index", 0, &index);
+        }
+        if (!status.isOK()) {
+            return appendCommandStatus(result, status);
+        }
+        if (level < 0 || level > CollectionHashTree::kDepth || index < 0 ||
+            static_cast<size_t>(index) >= CollectionHashTree::numNodesAtLevel(level)) {
+            return appendCommandStatus(result,
+                                       {ErrorCodes::BadValue,
+                                        str::stream() << "No hash tree node at level " << level
+                                                      << ", index "
+                                                      << index});
+        }
+
+        result.append("level", level);
+        result.append("index", index);
+        result.append("hash", tree->nodeHash(level, index));
+        result.appendNumber("count", tree->nodeCount(level, index));
+
+        if (level < CollectionHashTree::kDepth) {
+            BSONArrayBuilder children(result.subarrayStart("children"));
+            for (size_t child = index * CollectionHashTree::kFanout;
+                 child < (index + 1) * CollectionHashTree::kFanout;
+                 ++child) {
+                BSONObjBuilder childBuilder(children.subobjStart());
+                childBuilder.appendNumber("index", static_cast<long long>(child));
+                childBuilder.append("hash", tree->nodeHash(level + 1, child));
+                childBuilder.appendNumber("count", tree->nodeCount(level + 1, child));
+            }
+        }
+
+        return true;
+    }
+
+private:
+    bool _runLeaves(OperationContext* opCtx,
+                    Collection* collection,
+                    const BSONObj& cmdObj,
+                    BSONObjBuilder& result) {
+        if (cmdObj["leaves"].type() != Array) {
+            return appendCommandStatus(result,
+                                       {ErrorCodes::TypeMismatch, "'leaves' must be an array"});
+        }
+
+        std::set<size_t> leaves;
+        for (auto&& elem : cmdObj["leaves"].Obj()) {
+            if (!elem.isNumber() || elem.numberLong() < 0 ||
+                static_cast<size_t>(elem.numberLong()) >= CollectionHashTree::kNumLeaves) {
+                return appendCommandStatus(
+                    result, {ErrorCodes::BadValue, str::stream() << "Invalid leaf: " << elem});
+            }
+            leaves.insert(elem.numberLong());
+        }
+
+        auto exec = InternalPlanner::collectionScan(
+            opCtx, collection->ns().ns(), collection, PlanExecutor::NO_YIELD);
+
+        // Leave room for the rest of the reply.
+        const int maxDocumentsBytes = BSONObjMaxUserSize / 2;
+        bool truncated = false;
+
+        BSONArrayBuilder documents(result.subarrayStart("documents"));
+        BSONObj obj;
+        PlanExecutor::ExecState state;
+        while (PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
+            const auto digest = CollectionHashTree::digest(obj);
+            if (!leaves.count(digest.leaf)) {
+                continue;
+            }
+            if (documents.len() > maxDocumentsBytes) {
+                truncated = true;
+                break;
+            }
+
+            BSONObjBuilder docBuilder(documents.subobjStart());
+            docBuilder.appendNumber("leaf", static_cast<long long>(digest.leaf));
+            if (obj.hasField("_id")) {
+                docBuilder.appendAs(obj["_id"], "_id");
+            }
+            docBuilder.append("md5", md5simpledigest(obj.objdata(), obj.objsize()));
+        }
+        documents.doneFast();
+
+        if (!truncated && PlanExecutor::IS_EOF != state) {
+            uasserted(40653,
+                      "Plan executor error while running dbHashTree command: " +
+                          WorkingSetCommon::toStatusString(obj));
+        }
+
+        result.append("truncated", truncated);
+        return true;
+    }
+
+} dbHashTreeCmd;
+
 }  // namespace
 }  // namespace mongo
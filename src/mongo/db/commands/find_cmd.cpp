@@ -49,6 +49,7 @@
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/repl/oplog_delta_encoding.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/server_parameters.h"
@@ -258,8 +259,13 @@ public:
         }
 
         // Acquire locks. If the query is on a view, we release our locks and convert the query
-        // request into an aggregation command.
-        Lock::DBLock dbSLock(opCtx, dbname, MODE_IS);
+        // request into an aggregation command. Only a query by UUID needs the database lock before
+        // the collection is known; otherwise AutoGetCollectionOrViewForReadCommand takes all the
+        // locks, which lets it serve reads on secondaries without waiting for batch application.
+        boost::optional<Lock::DBLock> dbSLock;
+        if (cmdObj.firstElement().type() == BinData) {
+            dbSLock.emplace(opCtx, dbname, MODE_IS);
+        }
         const NamespaceString nss(parseNsOrUUID(opCtx, dbname, cmdObj));
         qr->refreshNSS(opCtx);
 
@@ -286,11 +292,16 @@ public:
         }
         std::unique_ptr<CanonicalQuery> cq = std::move(statusWithCQ.getValue());
 
-        AutoGetCollectionOrViewForReadCommand ctx(opCtx, nss, std::move(dbSLock));
-        Collection* collection = ctx.getCollection();
-        if (ctx.getView()) {
+        boost::optional<AutoGetCollectionOrViewForReadCommand> ctx;
+        if (dbSLock) {
+            ctx.emplace(opCtx, nss, std::move(*dbSLock));
+        } else {
+            ctx.emplace(opCtx, nss);
+        }
+        Collection* collection = ctx->getCollection();
+        if (ctx->getView()) {
             // Relinquish locks. The aggregation command will re-acquire them.
-            ctx.releaseLocksForView();
+            ctx->releaseLocksForView();
 
             // Convert the find command into an aggregation using $match (and other stages, as
             // necessary), if possible.
@@ -340,6 +351,12 @@ public:
 
         const QueryRequest& originalQR = exec->getCanonicalQuery()->getQueryRequest();
 
+        // Syncing nodes may ask for the oplog entries they fetch to be delta encoded.
+        boost::optional<repl::OplogDeltaEncoder> deltaEncoder;
+        if (nss.isOplog() && repl::OplogDeltaEncoder::isRequested(cmdObj)) {
+            deltaEncoder.emplace();
+        }
+
         // Stream query results, adding them to a BSONArray as we go.
         CursorResponseBuilder firstBatch(/*isInitialResponse*/ true, &result);
         BSONObj obj;
@@ -354,7 +371,7 @@ public:
             }
 
             // Add result to output buffer.
-            firstBatch.append(obj);
+            firstBatch.append(deltaEncoder ? deltaEncoder->encode(obj) : obj);
             numResults++;
         }
 
@@ -51,6 +51,7 @@
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/repl/oplog.h"
+#include "mongo/db/repl/oplog_delta_encoding.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
@@ -133,17 +134,22 @@ public:
         return GetMoreRequest::parseNs(dbname, cmdObj).ns();
     }
 
-    Status checkAuthForCommand(Client* client,
-                               const std::string& dbname,
-                               const BSONObj& cmdObj) override {
+    Status checkAuthForOperation(OperationContext* opCtx,
+                                 const std::string& dbname,
+                                 const BSONObj& cmdObj) override {
         StatusWith<GetMoreRequest> parseStatus = GetMoreRequest::parseFromBSON(dbname, cmdObj);
         if (!parseStatus.isOK()) {
             return parseStatus.getStatus();
         }
         const GetMoreRequest& request = parseStatus.getValue();
 
-        return AuthorizationSession::get(client)->checkAuthForGetMore(
+        auto authzSession = AuthorizationSession::get(opCtx->getClient());
+        auto status = authzSession->checkAuthForGetMore(
             request.nss, request.cursorid, request.term.is_initialized());
+        if (status.isOK()) {
+            AuthorizedGetMoreRequest::get(opCtx).set(cmdObj, std::move(parseStatus.getValue()));
+        }
+        return status;
     }
 
     bool runParsed(OperationContext* opCtx,
@@ -334,7 +340,19 @@ public:
             shouldWaitForInserts(opCtx) = true;
         }
 
-        Status batchStatus = generateBatch(opCtx, cursor, request, &nextBatch, &state, &numResults);
+        // Syncing nodes may ask for the oplog entries they fetch to be delta encoded.
+        boost::optional<repl::OplogDeltaEncoder> deltaEncoder;
+        if (request.nss.isOplog() && repl::OplogDeltaEncoder::isRequested(cmdObj)) {
+            deltaEncoder.emplace();
+        }
+
+        Status batchStatus = generateBatch(opCtx,
+                                           cursor,
+                                           request,
+                                           deltaEncoder.get_ptr(),
+                                           &nextBatch,
+                                           &state,
+                                           &numResults);
         if (!batchStatus.isOK()) {
             return appendCommandStatus(result, batchStatus);
         }
@@ -393,7 +411,8 @@ public:
         // Counted as a getMore, not as a command.
         globalOpCounters.gotGetMore();
 
-        StatusWith<GetMoreRequest> parsedRequest = GetMoreRequest::parseFromBSON(dbname, cmdObj);
+        StatusWith<GetMoreRequest> parsedRequest =
+            AuthorizedGetMoreRequest::get(opCtx).take(dbname, cmdObj);
         if (!parsedRequest.isOK()) {
             return appendCommandStatus(result, parsedRequest.getStatus());
         }
@@ -408,12 +427,15 @@ public:
      * Returns the number of documents in the batch in *numResults, which must be initialized to
      * zero by the caller. Returns the final ExecState returned by the cursor in *state.
      *
+     * If 'deltaEncoder' is not null, the documents are delta encoded with it before being added.
+     *
      * Returns an OK status if the batch was successfully generated, and a non-OK status if the
      * PlanExecutor encounters a failure.
      */
     Status generateBatch(OperationContext* opCtx,
                          ClientCursor* cursor,
                          const GetMoreRequest& request,
+                         repl::OplogDeltaEncoder* deltaEncoder,
                          CursorResponseBuilder* nextBatch,
                          PlanExecutor::ExecState* state,
                          long long* numResults) {
@@ -437,7 +459,7 @@ public:
                 shouldWaitForInserts(opCtx) = false;
                 // Add result to output buffer.
                 nextBatch->setLatestOplogTimestamp(exec->getLatestOplogTimestamp());
-                nextBatch->append(obj);
+                nextBatch->append(deltaEncoder ? deltaEncoder->encode(obj) : obj);
                 (*numResults)++;
             }
         } catch (const CloseChangeStreamException& ex) {
@@ -315,12 +315,14 @@ public:
     }
 
     BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElement) const {
-        BSONObj result;
-        if (getSSLManager()) {
-            result = getSSLManager()->getSSLConfiguration().getServerStatusBSON();
+        if (!getSSLManager()) {
+            return BSONObj();
         }
 
-        return result;
+        BSONObjBuilder result;
+        result.appendElements(getSSLManager()->getSSLConfiguration().getServerStatusBSON());
+        getSSLHandshakeStats().append(&result);
+        return result.obj();
     }
 } security;
 #endif
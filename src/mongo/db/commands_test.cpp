@@ -137,4 +137,35 @@ TEST_F(ParseNsOrUUID, ParseValidUUID) {
     auto parsedNss = Command::parseNsOrUUID(opCtx, "test", cmd);
     ASSERT_EQUALS(nss, parsedNss);
 }
+
+TEST(Commands, DuplicateTopLevelFieldCheckerAcceptsDistinctFields) {
+    DuplicateTopLevelFieldChecker checker;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < 2 * DuplicateTopLevelFieldChecker::kInlineFields; ++i) {
+        names.push_back(str::stream() << "field" << i);
+    }
+    for (auto&& name : names) {
+        checker.check(name);
+    }
+}
+
+TEST(Commands, DuplicateTopLevelFieldCheckerRejectsDuplicates) {
+    DuplicateTopLevelFieldChecker checker;
+    checker.check("find");
+    checker.check("filter");
+    ASSERT_THROWS_CODE(checker.check("find"), AssertionException, ErrorCodes::FailedToParse);
+}
+
+TEST(Commands, DuplicateTopLevelFieldCheckerRejectsDuplicatesPastInlineCapacity) {
+    DuplicateTopLevelFieldChecker checker;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < DuplicateTopLevelFieldChecker::kInlineFields + 2; ++i) {
+        names.push_back(str::stream() << "field" << i);
+        checker.check(names.back());
+    }
+
+    // Both a name held inline and one that spilled into the overflow table are caught.
+    ASSERT_THROWS_CODE(checker.check("field0"), AssertionException, ErrorCodes::FailedToParse);
+    ASSERT_THROWS_CODE(checker.check(names.back()), AssertionException, ErrorCodes::FailedToParse);
+}
 }  // namespace mongo
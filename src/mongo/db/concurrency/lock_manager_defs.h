@@ -186,6 +186,7 @@ public:
     enum SingletonHashIds {
         SINGLETON_INVALID = 0,
         SINGLETON_PARALLEL_BATCH_WRITER_MODE,
+        SINGLETON_LAST_APPLIED_SNAPSHOT,
         SINGLETON_GLOBAL,
         SINGLETON_MMAPV1_FLUSH,
         SINGLETON_IN_FLIGHT_OPLOG,
@@ -264,6 +265,12 @@ extern const ResourceId resourceIdAdminDB;
 // TODO: Merge this with resourceIdGlobal
 extern const ResourceId resourceIdParallelBatchWriterMode;
 
+// Hardcoded resource id held in MODE_IS by reads on secondaries that are served from the snapshot
+// of the last applied batch instead of conflicting with ParallelBatchWriterMode. Batch application
+// locks it in MODE_X to wait for those reads before applying writes that are not timestamped.
+// Like resourceIdParallelBatchWriterMode, it must be locked before resourceIdGlobal.
+extern const ResourceId resourceIdLastAppliedSnapshot;
+
 // Every place that starts oplog inserts takes this lock in MODE_IX and holds it
 // until the end of their WriteUnitOfWork.
 //
@@ -639,10 +639,10 @@ void LockerImpl<IsForMMAPV1>::restoreLockState(const Locker::LockSnapshot& state
     invariant(_modeForTicket == MODE_NONE);
 
     std::vector<OneLock>::const_iterator it = state.locks.begin();
-    // If we locked the PBWM, it must be locked before the resourceIdGlobal resource.
-    if (it != state.locks.end() && it->resourceId == resourceIdParallelBatchWriterMode) {
+    // If we locked the PBWM or the last applied snapshot, they must be locked before the
+    // resourceIdGlobal resource.
+    for (; it != state.locks.end() && it->resourceId < resourceIdGlobal; it++) {
         invariant(LOCK_OK == lock(it->resourceId, it->mode));
-        it++;
     }
 
     invariant(LOCK_OK == lockGlobal(state.globalMode));
@@ -964,6 +964,8 @@ const ResourceId resourceIdOplog = ResourceId(RESOURCE_COLLECTION, StringData("l
 const ResourceId resourceIdAdminDB = ResourceId(RESOURCE_DATABASE, StringData("admin"));
 const ResourceId resourceIdParallelBatchWriterMode =
     ResourceId(RESOURCE_GLOBAL, ResourceId::SINGLETON_PARALLEL_BATCH_WRITER_MODE);
+const ResourceId resourceIdLastAppliedSnapshot =
+    ResourceId(RESOURCE_GLOBAL, ResourceId::SINGLETON_LAST_APPLIED_SNAPSHOT);
 const ResourceId resourceInFlightForOplog =
     ResourceId(RESOURCE_METADATA, ResourceId::SINGLETON_IN_FLIGHT_OPLOG);
 
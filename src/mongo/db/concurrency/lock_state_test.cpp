@@ -216,6 +216,38 @@ TEST(LockerImpl, saveAndRestoreDBAndCollection) {
     ASSERT(locker.unlockGlobal());
 }
 
+/**
+ * Tests that the last applied snapshot lock is released while yielding and is reacquired before the
+ * global lock.
+ */
+TEST(LockerImpl, saveAndRestoreLastAppliedSnapshot) {
+    Locker::LockSnapshot lockInfo;
+
+    DefaultLockerImpl locker;
+
+    const ResourceId resIdDatabase(RESOURCE_DATABASE, "TestDB"_sd);
+
+    ASSERT_EQUALS(LOCK_OK, locker.lock(resourceIdLastAppliedSnapshot, MODE_IS));
+    locker.lockGlobal(MODE_IS);
+    ASSERT_EQUALS(LOCK_OK, locker.lock(resIdDatabase, MODE_IS));
+    ASSERT(locker.saveLockStateAndUnlock(&lockInfo));
+
+    ASSERT_EQUALS(MODE_NONE, locker.getLockMode(resourceIdLastAppliedSnapshot));
+
+    // Batch application can wait for the yielded read.
+    DefaultLockerImpl applier;
+    ASSERT_EQUALS(LOCK_OK, applier.lock(resourceIdLastAppliedSnapshot, MODE_X, Milliseconds(0)));
+    ASSERT(applier.unlock(resourceIdLastAppliedSnapshot));
+
+    locker.restoreLockState(lockInfo);
+
+    ASSERT_EQUALS(MODE_IS, locker.getLockMode(resourceIdLastAppliedSnapshot));
+    ASSERT_EQUALS(MODE_IS, locker.getLockMode(resIdDatabase));
+
+    ASSERT(locker.unlockGlobal());
+    ASSERT(locker.unlock(resourceIdLastAppliedSnapshot));
+}
+
 TEST(LockerImpl, DefaultLocker) {
     const ResourceId resId(RESOURCE_DATABASE, "TestDB"_sd);
 
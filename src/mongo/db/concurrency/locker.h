@@ -334,4 +334,27 @@ private:
     bool _shouldConflictWithSecondaryBatchApplication = true;
 };
 
+/**
+ * RAII-style class to opt out of replication's use of the ParallelBatchWriterMode lock for the
+ * duration of its scope. The previous setting is restored on destruction.
+ */
+class ShouldNotConflictWithSecondaryBatchApplicationBlock {
+    MONGO_DISALLOW_COPYING(ShouldNotConflictWithSecondaryBatchApplicationBlock);
+
+public:
+    explicit ShouldNotConflictWithSecondaryBatchApplicationBlock(Locker* lockState)
+        : _lockState(lockState),
+          _originalShouldConflict(_lockState->shouldConflictWithSecondaryBatchApplication()) {
+        _lockState->setShouldConflictWithSecondaryBatchApplication(false);
+    }
+
+    ~ShouldNotConflictWithSecondaryBatchApplicationBlock() {
+        _lockState->setShouldConflictWithSecondaryBatchApplication(_originalShouldConflict);
+    }
+
+private:
+    Locker* const _lockState;
+    const bool _originalShouldConflict;
+};
+
 }  // namespace mongo
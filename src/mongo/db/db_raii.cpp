@@ -38,6 +38,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/util/fail_point_service.h"
 
@@ -45,6 +46,10 @@ namespace mongo {
 
 namespace {
 MONGO_FP_DECLARE(setAutoGetCollectionWait);
+
+// When set, reads on secondaries are served from the snapshot of the last applied batch of oplog
+// entries rather than waiting for the ParallelBatchWriterMode lock.
+MONGO_EXPORT_SERVER_PARAMETER(allowSecondaryReadsDuringBatchApplication, bool, true);
 }  // namespace
 
 AutoGetDb::AutoGetDb(OperationContext* opCtx, StringData ns, LockMode mode)
@@ -136,7 +141,10 @@ AutoStatsTracker::~AutoStatsTracker() {
 
 AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
                                                    const StringData dbName,
-                                                   const UUID& uuid) {
+                                                   const UUID& uuid)
+    : _opCtx(opCtx) {
+    _prepareToReadAtLastAppliedSnapshot(opCtx, dbName);
+
     // Lock the database since a UUID will always be in the same database even though its
     // collection name may change.
     Lock::DBLock dbSLock(opCtx, dbName, MODE_IS);
@@ -147,6 +155,7 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
     if (!nss.isEmpty()) {
         _autoColl.emplace(
             opCtx, nss, MODE_IS, AutoGetCollection::ViewMode::kViewsForbidden, std::move(dbSLock));
+        _ensureLastAppliedSnapshotIsValid(nss, opCtx);
 
         // Note: this can yield.
         _ensureMajorityCommittedSnapshotIsValid(nss, opCtx);
@@ -155,8 +164,11 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
 
 AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
                                                    const NamespaceString& nss,
-                                                   AutoGetCollection::ViewMode viewMode) {
+                                                   AutoGetCollection::ViewMode viewMode)
+    : _opCtx(opCtx) {
+    _prepareToReadAtLastAppliedSnapshot(opCtx, nss.db());
     _autoColl.emplace(opCtx, nss, MODE_IS, MODE_IS, viewMode);
+    _ensureLastAppliedSnapshotIsValid(nss, opCtx);
 
     // Note: this can yield.
     _ensureMajorityCommittedSnapshotIsValid(nss, opCtx);
@@ -165,12 +177,96 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
 AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
                                                    const NamespaceString& nss,
                                                    AutoGetCollection::ViewMode viewMode,
-                                                   Lock::DBLock lock) {
+                                                   Lock::DBLock lock)
+    : _opCtx(opCtx) {
+    // The caller already holds the global lock, so it is too late to opt out of conflicting with
+    // secondary batch application.
     _autoColl.emplace(opCtx, nss, MODE_IS, viewMode, std::move(lock));
 
     // Note: this can yield.
     _ensureMajorityCommittedSnapshotIsValid(nss, opCtx);
 }
+
+AutoGetCollectionForRead::~AutoGetCollectionForRead() {
+    if (_shouldNotConflictWithSecondaryBatchApplicationBlock) {
+        // Releasing the outermost lock abandons the snapshot, after which later reads by this
+        // operation may go back to reading the latest data.
+        _autoColl = boost::none;
+        _opCtx->recoveryUnit()->clearReadFromLastAppliedSnapshot();
+    }
+}
+
+void AutoGetCollectionForRead::_prepareToReadAtLastAppliedSnapshot(OperationContext* opCtx,
+                                                                   StringData dbName) {
+    if (!allowSecondaryReadsDuringBatchApplication.load()) {
+        return;
+    }
+
+    // Operations that already hold locks may have a snapshot open, and operations that already
+    // opted out of conflicting with batch application are fine with an inconsistent view.
+    if (opCtx->lockState()->isLocked() ||
+        !opCtx->lockState()->shouldConflictWithSecondaryBatchApplication()) {
+        return;
+    }
+
+    // The local database is not written through batch application.
+    if (dbName == NamespaceString::kLocalDb) {
+        return;
+    }
+
+    if (opCtx->recoveryUnit()->isReadingFromMajorityCommittedSnapshot()) {
+        return;
+    }
+
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet ||
+        !replCoord->getMemberState().secondary()) {
+        return;
+    }
+
+    // Fails if no batch has been applied since the node last changed state.
+    if (!opCtx->recoveryUnit()->setReadFromLastAppliedSnapshot().isOK()) {
+        return;
+    }
+
+    _shouldNotConflictWithSecondaryBatchApplicationBlock.emplace(opCtx->lockState());
+    _lastAppliedSnapshotLock.emplace(opCtx->lockState(), resourceIdLastAppliedSnapshot, MODE_IS);
+}
+
+void AutoGetCollectionForRead::_ensureLastAppliedSnapshotIsValid(const NamespaceString& nss,
+                                                                 OperationContext* opCtx) {
+    if (!_shouldNotConflictWithSecondaryBatchApplicationBlock) {
+        return;
+    }
+
+    // A batch with untimestamped writes may have withdrawn the snapshot this read was prepared
+    // with, or applied and replaced it, before '_lastAppliedSnapshotLock' was granted. While it is
+    // held, the newest snapshot cannot be withdrawn.
+    opCtx->recoveryUnit()->abandonSnapshot();
+    if (opCtx->recoveryUnit()->setReadFromLastAppliedSnapshot().isOK()) {
+        auto coll = _autoColl->getCollection();
+        if (!coll) {
+            return;
+        }
+
+        // Catalog changes on secondaries reserve the last applied optime, so a collection created
+        // or modified by the batch being applied right now has a minimum visible snapshot equal to
+        // ours.
+        auto minSnapshot = coll->getMinimumVisibleSnapshot();
+        auto mySnapshot = opCtx->recoveryUnit()->getLastAppliedSnapshot();
+        if (!minSnapshot || *minSnapshot < *mySnapshot) {
+            return;
+        }
+    }
+
+    _autoColl = boost::none;
+    opCtx->recoveryUnit()->clearReadFromLastAppliedSnapshot();
+    _lastAppliedSnapshotLock = boost::none;
+    _shouldNotConflictWithSecondaryBatchApplicationBlock = boost::none;
+
+    _autoColl.emplace(opCtx, nss, MODE_IS);
+}
+
 void AutoGetCollectionForRead::_ensureMajorityCommittedSnapshotIsValid(const NamespaceString& nss,
                                                                        OperationContext* opCtx) {
     while (true) {
@@ -213,6 +309,19 @@ AutoGetCollectionForReadCommand::AutoGetCollectionForReadCommand(
     AutoGetCollection::ViewMode viewMode,
     Lock::DBLock lock) {
     _autoCollForRead.emplace(opCtx, nss, viewMode, std::move(lock));
+    _trackStatsAndCheckShardVersion(opCtx, nss);
+}
+
+AutoGetCollectionForReadCommand::AutoGetCollectionForReadCommand(
+    OperationContext* opCtx, const NamespaceString& nss, AutoGetCollection::ViewMode viewMode) {
+    // Let AutoGetCollectionForRead take the database lock itself, so that it can decide whether to
+    // conflict with secondary batch application.
+    _autoCollForRead.emplace(opCtx, nss, viewMode);
+    _trackStatsAndCheckShardVersion(opCtx, nss);
+}
+
+void AutoGetCollectionForReadCommand::_trackStatsAndCheckShardVersion(
+    OperationContext* opCtx, const NamespaceString& nss) {
     const int doNotChangeProfilingLevel = 0;
     _statsTracker.emplace(opCtx,
                           nss,
@@ -226,11 +335,6 @@ AutoGetCollectionForReadCommand::AutoGetCollectionForReadCommand(
     css->checkShardVersionOrThrow(opCtx);
 }
 
-AutoGetCollectionForReadCommand::AutoGetCollectionForReadCommand(
-    OperationContext* opCtx, const NamespaceString& nss, AutoGetCollection::ViewMode viewMode)
-    : AutoGetCollectionForReadCommand(
-          opCtx, nss, viewMode, Lock::DBLock(opCtx, nss.db(), MODE_IS)) {}
-
 AutoGetCollectionOrViewForReadCommand::AutoGetCollectionOrViewForReadCommand(
     OperationContext* opCtx, const NamespaceString& nss)
     : AutoGetCollectionForReadCommand(opCtx, nss, AutoGetCollection::ViewMode::kViewsPermitted),
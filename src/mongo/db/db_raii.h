@@ -254,6 +254,10 @@ private:
  * utility will ensure that the read will be performed against an appropriately committed snapshot
  * if the operation is using a readConcern of 'majority'.
  *
+ * On secondaries, reads that would otherwise wait for the current batch of oplog entries to finish
+ * applying instead skip the ParallelBatchWriterMode lock and read from the snapshot of the last
+ * applied batch, unless the collection's catalog entry changed in the batch being applied.
+ *
  * Use this when you want to read the contents of a collection, but you are not at the top-level of
  * some command. This will ensure your reads obey any requested readConcern, but will not update the
  * status of CurrentOp, or add a Top entry.
@@ -288,6 +292,9 @@ public:
                              const NamespaceString& nss,
                              AutoGetCollection::ViewMode viewMode,
                              Lock::DBLock lock);
+
+    ~AutoGetCollectionForRead();
+
     Database* getDb() const {
         if (!_autoColl) {
             return nullptr;
@@ -306,6 +313,31 @@ private:
     void _ensureMajorityCommittedSnapshotIsValid(const NamespaceString& nss,
                                                  OperationContext* opCtx);
 
+    /**
+     * Called before any locks are taken. Opts out of conflicting with secondary batch application
+     * if this read can be served from the last applied snapshot instead.
+     */
+    void _prepareToReadAtLastAppliedSnapshot(OperationContext* opCtx, StringData dbName);
+
+    /**
+     * Called with the collection locked. Moves the read to the newest last applied snapshot. If
+     * there is none, because a batch with untimestamped writes is being applied, or if the
+     * collection changed in a way that the snapshot does not reflect yet, drops the locks and
+     * reacquires them conflicting with secondary batch application, reading the latest data.
+     */
+    void _ensureLastAppliedSnapshotIsValid(const NamespaceString& nss, OperationContext* opCtx);
+
+    OperationContext* const _opCtx;
+
+    // Must outlive '_autoColl', since whether the global lock holds the ParallelBatchWriterMode
+    // lock is decided when it is acquired.
+    boost::optional<ShouldNotConflictWithSecondaryBatchApplicationBlock>
+        _shouldNotConflictWithSecondaryBatchApplicationBlock;
+
+    // Held in MODE_IS while reading from the last applied snapshot, so that batches with
+    // untimestamped writes wait for this read before withdrawing the snapshot.
+    boost::optional<Lock::ResourceLock> _lastAppliedSnapshotLock;
+
     boost::optional<AutoGetCollection> _autoColl;
 };
 
@@ -359,6 +391,8 @@ protected:
                                     AutoGetCollection::ViewMode viewMode,
                                     Lock::DBLock lock);
 
+    void _trackStatsAndCheckShardVersion(OperationContext* opCtx, const NamespaceString& nss);
+
     // '_autoCollForRead' may need to be reset by AutoGetCollectionOrViewForReadCommand, so needs to
     // be a boost::optional.
     boost::optional<AutoGetCollectionForRead> _autoCollForRead;
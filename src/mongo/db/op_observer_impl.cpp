@@ -33,6 +33,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/auth/authorization_manager.h"
 #include "mongo/db/catalog/collection_catalog_entry.h"
+#include "mongo/db/catalog/collection_hash_tree.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
@@ -282,11 +283,13 @@ void OpObserverImpl::onInserts(OperationContext* opCtx,
     const auto opTimeList = repl::logInsertOps(opCtx, nss, uuid, session, begin, end, fromMigrate);
 
     auto css = CollectionShardingState::get(opCtx, nss.ns());
+    auto& hashTrees = CollectionHashTreeRegistry::get(opCtx);
 
     size_t index = 0;
     for (auto it = begin; it != end; it++, index++) {
         AuthorizationManager::get(opCtx->getServiceContext())
             ->logOp(opCtx, "i", nss, it->doc, nullptr);
+        hashTrees.onInsert(opCtx, uuid, it->doc);
         if (!fromMigrate) {
             auto opTime = opTimeList.empty() ? repl::OpTime() : opTimeList[index];
             css->onInsertOp(opCtx, it->doc, opTime);
@@ -328,6 +331,9 @@ void OpObserverImpl::onUpdate(OperationContext* opCtx, const OplogUpdateEntryArg
     AuthorizationManager::get(opCtx->getServiceContext())
         ->logOp(opCtx, "u", args.nss, args.update, &args.criteria);
 
+    CollectionHashTreeRegistry::get(opCtx).onUpdate(
+        opCtx, args.uuid, args.preImageDoc, args.updatedDoc);
+
     auto css = CollectionShardingState::get(opCtx, args.nss);
     if (!args.fromMigrate) {
         css->onUpdateOp(opCtx,
@@ -356,6 +362,8 @@ void OpObserverImpl::onUpdate(OperationContext* opCtx, const OplogUpdateEntryArg
 auto OpObserverImpl::aboutToDelete(OperationContext* opCtx,
                                    NamespaceString const& nss,
                                    BSONObj const& doc) -> CollectionShardingState::DeleteState {
+    CollectionHashTreeRegistry::get(opCtx).aboutToDelete(opCtx, doc);
+
     auto* css = CollectionShardingState::get(opCtx, nss.ns());
     return css->makeDeleteState(doc);
 }
@@ -367,6 +375,8 @@ void OpObserverImpl::onDelete(OperationContext* opCtx,
                               CollectionShardingState::DeleteState deleteState,
                               bool fromMigrate,
                               const boost::optional<BSONObj>& deletedDoc) {
+    CollectionHashTreeRegistry::get(opCtx).onDelete(opCtx, uuid);
+
     if (deleteState.documentKey.isEmpty()) {
         return;
     }
@@ -514,6 +524,7 @@ void OpObserverImpl::onDropDatabase(OperationContext* opCtx, const std::string&
     }
 
     NamespaceUUIDCache::get(opCtx).evictNamespacesInDatabase(dbName);
+    CollectionHashTreeRegistry::get(opCtx).invalidateDatabase(dbName);
 
     AuthorizationManager::get(opCtx->getServiceContext())
         ->logOp(opCtx, "c", cmdNss, cmdObj, nullptr);
@@ -549,6 +560,8 @@ repl::OpTime OpObserverImpl::onDropCollection(OperationContext* opCtx,
     // Evict namespace entry from the namespace/uuid cache if it exists.
     NamespaceUUIDCache::get(opCtx).evictNamespace(collectionName);
 
+    CollectionHashTreeRegistry::get(opCtx).invalidate(uuid);
+
     // Remove collection from the uuid catalog.
     if (uuid) {
         UUIDCatalog& catalog = UUIDCatalog::get(opCtx);
@@ -649,6 +662,8 @@ void OpObserverImpl::onEmptyCapped(OperationContext* opCtx,
 
     AuthorizationManager::get(opCtx->getServiceContext())
         ->logOp(opCtx, "c", cmdNss, cmdObj, nullptr);
+
+    CollectionHashTreeRegistry::get(opCtx).invalidate(uuid);
 }
 
 }  // namespace mongo
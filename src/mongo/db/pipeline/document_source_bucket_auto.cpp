@@ -30,7 +30,10 @@
 
 #include "mongo/db/pipeline/document_source_bucket_auto.h"
 
+#include <algorithm>
+
 #include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 
 namespace mongo {
@@ -44,6 +47,8 @@ REGISTER_DOCUMENT_SOURCE(bucketAuto,
                          LiteParsedDocumentSourceDefault::parse,
                          DocumentSourceBucketAuto::createFromBson);
 
+constexpr StringData DocumentSourceBucketAuto::kPartialCountField;
+
 const char* DocumentSourceBucketAuto::getSourceName() const {
     return "$bucketAuto";
 }
@@ -81,6 +86,10 @@ DocumentSource::GetDepsReturn DocumentSourceBucketAuto::getDependencies(DepsTrac
         accumulatedField.expression->addDependencies(deps);
     }
 
+    if (_doingMerge) {
+        deps->fields.insert(kPartialCountField.toString());
+    }
+
     // We know exactly which fields will be present in the output document. Future stages cannot
     // depend on any further fields. The grouping process will remove any metadata from the
     // documents, so there can be no further dependencies on metadata.
@@ -107,8 +116,8 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
     auto next = pSource->getNext();
     for (; next.isAdvanced(); next = pSource->getNext()) {
         auto nextDoc = next.releaseDocument();
+        _nDocuments += countDocuments(nextDoc);
         _sorter->add(extractKey(nextDoc), nextDoc);
-        _nDocuments++;
     }
     return next;
 }
@@ -144,15 +153,22 @@ Value DocumentSourceBucketAuto::extractKey(const Document& doc) {
     return key.missing() ? Value(BSONNULL) : std::move(key);
 }
 
-void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>& entry,
-                                                   Bucket& bucket) {
+long long DocumentSourceBucketAuto::countDocuments(const Document& doc) const {
+    return _doingMerge ? doc[kPartialCountField].coerceToLong() : 1;
+}
+
+long long DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>& entry,
+                                                        Bucket& bucket) {
     invariant(pExpCtx->getValueComparator().evaluate(entry.first >= bucket._max));
     bucket._max = entry.first;
 
     const size_t numAccumulators = _accumulatedFields.size();
     for (size_t k = 0; k < numAccumulators; k++) {
-        bucket._accums[k]->process(_accumulatedFields[k].expression->evaluate(entry.second), false);
+        bucket._accums[k]->process(_accumulatedFields[k].expression->evaluate(entry.second),
+                                   _doingMerge);
     }
+
+    return countDocuments(entry.second);
 }
 
 void DocumentSourceBucketAuto::populateBuckets() {
@@ -197,7 +213,7 @@ void DocumentSourceBucketAuto::populateBuckets() {
         Bucket currentBucket(pExpCtx, currentValue.first, currentValue.first, _accumulatedFields);
 
         // Add the first value into the current bucket.
-        addDocumentToBucket(currentValue, currentBucket);
+        long long currentBucketSize = addDocumentToBucket(currentValue, currentBucket);
 
         if (isLastBucket) {
             // If this is the last bucket allowed, we need to put any remaining documents in
@@ -206,15 +222,11 @@ void DocumentSourceBucketAuto::populateBuckets() {
                 addDocumentToBucket(_sortedInput->next(), currentBucket);
             }
         } else {
-            // We go to approxBucketSize - 1 because we already added the first value in order
-            // to keep track of the minimum value.
-            for (long long j = 0; j < approxBucketSize - 1; j++) {
-                if (_sortedInput->more()) {
-                    addDocumentToBucket(_sortedInput->next(), currentBucket);
-                } else {
-                    // No more values to process.
-                    break;
-                }
+            // Fill the bucket up to approxBucketSize documents. An entry holding a group computed
+            // by a shard goes into the bucket whole, just as the documents making up the group
+            // would all be absorbed below for having the same value.
+            while (currentBucketSize < approxBucketSize && _sortedInput->more()) {
+                currentBucketSize += addDocumentToBucket(_sortedInput->next(), currentBucket);
             }
 
             boost::optional<pair<Value, Document>> nextValue = _sortedInput->more()
@@ -326,6 +338,55 @@ Document DocumentSourceBucketAuto::makeDocument(const Bucket& bucket) {
     return out.freeze();
 }
 
+bool DocumentSourceBucketAuto::canPushDownGrouping() const {
+    return std::none_of(_accumulatedFields.begin(),
+                        _accumulatedFields.end(),
+                        [](const AccumulationStatement& accumulatedField) {
+                            return accumulatedField.fieldName == kPartialCountField;
+                        });
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::getShardSource() {
+    if (!canPushDownGrouping()) {
+        return nullptr;
+    }
+
+    // $group treats a missing 'groupBy' value as null, just as extractKey() does.
+    auto accumulationStatements = _accumulatedFields;
+    accumulationStatements.emplace_back(kPartialCountField.toString(),
+                                        ExpressionConstant::create(pExpCtx, Value(1)),
+                                        AccumulationStatement::getFactory("$sum"));
+    return DocumentSourceGroup::create(
+        pExpCtx, _groupByExpression, std::move(accumulationStatements), _maxMemoryUsageBytes);
+}
+
+std::list<intrusive_ptr<DocumentSource>> DocumentSourceBucketAuto::getMergeSources() {
+    if (!canPushDownGrouping()) {
+        return {this};
+    }
+
+    // The merger buckets the groups by their _id and merges the partial value of each
+    // accumulator, which the shards output under the accumulator's own field name.
+    VariablesParseState vps = pExpCtx->variablesParseState;
+    vector<AccumulationStatement> mergeStatements;
+    for (auto&& accumulatedField : _accumulatedFields) {
+        auto copiedAccumulatedField = accumulatedField;
+        copiedAccumulatedField.expression =
+            ExpressionFieldPath::parse(pExpCtx, "$$ROOT." + accumulatedField.fieldName, vps);
+        mergeStatements.push_back(std::move(copiedAccumulatedField));
+    }
+
+    intrusive_ptr<DocumentSourceBucketAuto> merger(
+        new DocumentSourceBucketAuto(pExpCtx,
+                                     ExpressionFieldPath::parse(pExpCtx, "$$ROOT._id", vps),
+                                     _nBuckets,
+                                     std::move(mergeStatements),
+                                     _granularityRounder,
+                                     _maxMemoryUsageBytes));
+    merger->_doingMerge = true;
+    return {merger};
+}
+
 void DocumentSourceBucketAuto::doDispose() {
     _sortedInput.reset();
     _bucketsIterator = _buckets.end();
@@ -351,6 +412,10 @@ Value DocumentSourceBucketAuto::serialize(
     }
     insides["output"] = outputSpec.freezeToValue();
 
+    if (_doingMerge) {
+        insides["$doingMerge"] = Value(true);
+    }
+
     return Value{Document{{getSourceName(), insides.freezeToValue()}}};
 }
 
@@ -432,6 +497,7 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
     boost::intrusive_ptr<Expression> groupByExpression;
     boost::optional<int> numBuckets;
     boost::intrusive_ptr<GranularityRounder> granularityRounder;
+    bool doingMerge = false;
 
     for (auto&& argument : elem.Obj()) {
         const auto argName = argument.fieldNameStringData();
@@ -472,6 +538,11 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
                         << typeName(argument.type()),
                     argument.type() == BSONType::String);
             granularityRounder = GranularityRounder::getGranularityRounder(pExpCtx, argument.str());
+        } else if ("$doingMerge" == argName) {
+            uassert(40656,
+                    "The $bucketAuto '$doingMerge' field must be true if present",
+                    argument.trueValue());
+            doingMerge = true;
         } else {
             uasserted(40245, str::stream() << "Unrecognized option to $bucketAuto: " << argName);
         }
@@ -481,8 +552,10 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
             "$bucketAuto requires 'groupBy' and 'buckets' to be specified",
             groupByExpression && numBuckets);
 
-    return DocumentSourceBucketAuto::create(
+    auto bucketAuto = DocumentSourceBucketAuto::create(
         pExpCtx, groupByExpression, numBuckets.get(), accumulationStatements, granularityRounder);
+    bucketAuto->_doingMerge = doingMerge;
+    return bucketAuto;
 }
 }  // namespace mongo
 
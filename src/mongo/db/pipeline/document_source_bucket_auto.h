@@ -57,17 +57,19 @@ public:
     }
 
     /**
-     * The $bucketAuto stage must be run on the merging shard.
+     * The shards group their documents by the 'groupBy' value and compute partial accumulator
+     * values and a document count for each group. Bucket boundaries depend only on how many
+     * documents have each value, so the merger computes the same buckets from these groups as it
+     * would from the documents themselves.
      */
-    boost::intrusive_ptr<DocumentSource> getShardSource() final {
-        return nullptr;
-    }
-    std::list<boost::intrusive_ptr<DocumentSource>> getMergeSources() final {
-        return {this};
-    }
+    boost::intrusive_ptr<DocumentSource> getShardSource() final;
+    std::list<boost::intrusive_ptr<DocumentSource>> getMergeSources() final;
 
     static const uint64_t kDefaultMaxMemoryUsageBytes = 100 * 1024 * 1024;
 
+    // The field in which the shards report the number of documents in each group.
+    static constexpr StringData kPartialCountField = "bucketAutoPartialCount"_sd;
+
     /**
      * Convenience method to create a $bucketAuto stage.
      *
@@ -129,9 +131,22 @@ private:
     void populateBuckets();
 
     /**
-     * Adds the document in 'entry' to 'bucket' by updating the accumulators in 'bucket'.
+     * Returns the number of input documents that 'doc' accounts for.
+     */
+    long long countDocuments(const Document& doc) const;
+
+    /**
+     * Adds the document in 'entry' to 'bucket' by updating the accumulators in 'bucket'. Returns
+     * the number of input documents that 'entry' accounts for, which is more than one when merging
+     * the groups computed by the shards.
      */
-    void addDocumentToBucket(const std::pair<Value, Document>& entry, Bucket& bucket);
+    long long addDocumentToBucket(const std::pair<Value, Document>& entry, Bucket& bucket);
+
+    /**
+     * Returns true if the shards can group their documents ahead of the merger, which is the case
+     * unless an output field would collide with 'kPartialCountField'.
+     */
+    bool canPushDownGrouping() const;
 
     /**
      * Adds 'newBucket' to _buckets and updates any boundaries if necessary.
@@ -157,6 +172,10 @@ private:
     boost::intrusive_ptr<Expression> _groupByExpression;
     boost::intrusive_ptr<GranularityRounder> _granularityRounder;
     long long _nDocuments = 0;
+
+    // Set on the merger when the input consists of the groups computed by the shards rather than
+    // of documents.
+    bool _doingMerge = false;
 };
 
 }  // namespace mongo
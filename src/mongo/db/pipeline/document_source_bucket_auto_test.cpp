@@ -41,6 +41,7 @@
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_source_bucket_auto.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
@@ -802,5 +803,105 @@ TEST_F(BucketAutoTests, ShouldFailOnNegativeNumbersWhenGranularitySpecified) {
         AssertionException,
         40260);
 }
+
+/**
+ * Runs 'stage' over 'inputs' and returns everything it outputs.
+ */
+vector<Document> runStage(const intrusive_ptr<DocumentSource>& stage, deque<Document> inputs) {
+    deque<DocumentSource::GetNextResult> mockInputs;
+    for (auto&& input : inputs) {
+        mockInputs.emplace_back(std::move(input));
+    }
+    auto source = DocumentSourceMock::create(std::move(mockInputs));
+    stage->setSource(source.get());
+
+    vector<Document> results;
+    for (auto next = stage->getNext(); next.isAdvanced(); next = stage->getNext()) {
+        results.push_back(next.releaseDocument());
+    }
+    return results;
+}
+
+TEST_F(BucketAutoTests, MergingGroupsFromShardsProducesSameBucketsAsUnsplitStage) {
+    auto spec = fromjson(
+        "{$bucketAuto : {groupBy : '$x', buckets : 3, output : {count : {$sum : 1}, total : {$sum "
+        ": '$y'}, avg : {$avg : '$y'}, ys : {$addToSet : '$y'}}}}");
+    deque<Document> shard0Docs = {Document{{"x", 1}, {"y", 1}},
+                                  Document{{"x", 5}, {"y", 2}},
+                                  Document{{"x", 1}, {"y", 3}},
+                                  Document{{"x", 2}, {"y", 4}}};
+    deque<Document> shard1Docs = {Document{{"x", 3}, {"y", 5}},
+                                  Document{{"x", 1}, {"y", 6}},
+                                  Document{{"x", 6}, {"y", 7}},
+                                  Document{{"x", 3}, {"y", 8}},
+                                  Document{{"x", 4}, {"y", 9}}};
+
+    deque<Document> allDocs(shard0Docs.begin(), shard0Docs.end());
+    allDocs.insert(allDocs.end(), shard1Docs.begin(), shard1Docs.end());
+    auto expected = getResults(spec, allDocs);
+    ASSERT_EQUALS(expected.size(), 3UL);
+
+    // Each shard groups its own documents, outputting partial results for the merger.
+    getExpCtx()->needsMerge = true;
+    deque<Document> partialGroups;
+    for (auto&& shardDocs : {shard0Docs, shard1Docs}) {
+        auto bucketAuto = createBucketAuto(spec);
+        auto shardSource =
+            dynamic_cast<SplittableDocumentSource*>(bucketAuto.get())->getShardSource();
+        ASSERT(dynamic_cast<DocumentSourceGroup*>(shardSource.get()));
+        for (auto&& group : runStage(shardSource, shardDocs)) {
+            partialGroups.push_back(group);
+        }
+    }
+    ASSERT_EQUALS(partialGroups.size(), 7UL);
+
+    auto bucketAuto = createBucketAuto(spec);
+    auto mergeSources =
+        dynamic_cast<SplittableDocumentSource*>(bucketAuto.get())->getMergeSources();
+    ASSERT_EQUALS(mergeSources.size(), 1UL);
+    auto results = runStage(mergeSources.front(), partialGroups);
+
+    ASSERT_EQUALS(results.size(), expected.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_VALUE_EQ(results[i]["_id"], expected[i]["_id"]);
+        ASSERT_VALUE_EQ(results[i]["count"], expected[i]["count"]);
+        ASSERT_VALUE_EQ(results[i]["total"], expected[i]["total"]);
+        ASSERT_VALUE_EQ(results[i]["avg"], expected[i]["avg"]);
+        ASSERT_EQUALS(results[i]["ys"].getArrayLength(), expected[i]["ys"].getArrayLength());
+    }
+}
+
+TEST_F(BucketAutoTests, MergerSerializesDoingMergeAndCanBeReParsed) {
+    auto bucketAuto = createBucketAuto(
+        fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2, output : {avg : {$avg : '$y'}}}}"));
+    auto mergeSources =
+        dynamic_cast<SplittableDocumentSource*>(bucketAuto.get())->getMergeSources();
+    ASSERT_EQUALS(mergeSources.size(), 1UL);
+
+    vector<Value> serialization;
+    mergeSources.front()->serializeToArray(serialization);
+    ASSERT_EQUALS(serialization.size(), 1UL);
+    ASSERT_VALUE_EQ(serialization[0]["$bucketAuto"]["$doingMerge"], Value(true));
+    ASSERT_VALUE_EQ(serialization[0]["$bucketAuto"]["groupBy"], Value("$_id"_sd));
+
+    auto roundTripped = createBucketAuto(serialization[0].getDocument().toBson());
+    vector<Value> newSerialization;
+    roundTripped->serializeToArray(newSerialization);
+    ASSERT_EQUALS(newSerialization.size(), 1UL);
+    ASSERT_VALUE_EQ(newSerialization[0], serialization[0]);
+}
+
+TEST_F(BucketAutoTests, RunsEntirelyOnMergerIfOutputFieldCollidesWithPartialCount) {
+    auto bucketAuto = createBucketAuto(fromjson(
+        "{$bucketAuto : {groupBy : '$x', buckets : 2, output : {bucketAutoPartialCount : {$sum : "
+        "1}}}}"));
+    auto splittable = dynamic_cast<SplittableDocumentSource*>(bucketAuto.get());
+    ASSERT_FALSE(splittable->getShardSource());
+
+    auto mergeSources = splittable->getMergeSources();
+    ASSERT_EQUALS(mergeSources.size(), 1UL);
+    ASSERT_EQUALS(mergeSources.front(), bucketAuto);
+}
+
 }  // namespace
 }  // namespace mongo
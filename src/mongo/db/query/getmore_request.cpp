@@ -36,6 +36,7 @@
 
 #include "mongo/db/commands.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
 #include "mongo/db/repl/bson_extract_optime.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/stringutils.h"
@@ -50,6 +51,9 @@ const char kAwaitDataTimeoutField[] = "maxTimeMS";
 const char kTermField[] = "term";
 const char kLastKnownCommittedOpTimeField[] = "lastKnownCommittedOpTime";
 
+const auto getAuthorizedGetMoreRequest =
+    OperationContext::declareDecoration<AuthorizedGetMoreRequest>();
+
 }  // namespace
 
 const char GetMoreRequest::kGetMoreCommandName[] = "getMore";
@@ -212,4 +216,31 @@ BSONObj GetMoreRequest::toBSON() const {
     return builder.obj();
 }
 
+AuthorizedGetMoreRequest& AuthorizedGetMoreRequest::get(OperationContext* opCtx) {
+    return getAuthorizedGetMoreRequest(opCtx);
+}
+
+void AuthorizedGetMoreRequest::set(const BSONObj& cmdObj, GetMoreRequest request) {
+    _request = boost::none;
+    if (!cmdObj.isOwned()) {
+        _cmdObj = BSONObj();
+        return;
+    }
+    _cmdObj = cmdObj;
+    _request.emplace(std::move(request));
+}
+
+StatusWith<GetMoreRequest> AuthorizedGetMoreRequest::take(const std::string& dbname,
+                                                          const BSONObj& cmdObj) {
+    auto request = std::move(_request);
+    const bool parsedFromCmdObj = request && _cmdObj.binaryEqual(cmdObj);
+    _cmdObj = BSONObj();
+    _request = boost::none;
+
+    if (!parsedFromCmdObj) {
+        return GetMoreRequest::parseFromBSON(dbname, cmdObj);
+    }
+    return {std::move(*request)};
+}
+
 }  // namespace mongo
@@ -31,14 +31,18 @@
 #include <boost/optional.hpp>
 #include <string>
 
+#include "mongo/base/disallow_copying.h"
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class OperationContext;
+
 struct GetMoreRequest {
     static const char kGetMoreCommandName[];
 
@@ -95,4 +99,35 @@ private:
     Status isValid() const;
 };
 
+/**
+ * The GetMoreRequest that a getMore command parsed in checkAuthForOperation, kept on the operation
+ * so that run() does not parse the same command object again.
+ */
+class AuthorizedGetMoreRequest {
+    MONGO_DISALLOW_COPYING(AuthorizedGetMoreRequest);
+
+public:
+    AuthorizedGetMoreRequest() = default;
+
+    static AuthorizedGetMoreRequest& get(OperationContext* opCtx);
+
+    /**
+     * Remembers 'request' as the result of parsing 'cmdObj'. Nothing is remembered if 'cmdObj' is
+     * not owned, because its buffer could then be reused by the time take() compares against it.
+     */
+    void set(const BSONObj& cmdObj, GetMoreRequest request);
+
+    /**
+     * Returns the remembered request if it was parsed from a command object with the same bytes
+     * as 'cmdObj', and parses 'cmdObj' otherwise, as when authorization is disabled. Comparing the
+     * bytes means that a request left behind by a command that failed before run() can never be
+     * mistaken for a later one. Nothing is remembered afterwards.
+     */
+    StatusWith<GetMoreRequest> take(const std::string& dbname, const BSONObj& cmdObj);
+
+private:
+    BSONObj _cmdObj;
+    boost::optional<GetMoreRequest> _request;
+};
+
 }  // namespace mongo
@@ -280,4 +280,74 @@ TEST(GetMoreRequestTest, toBSONHasMaxTimeMS) {
     ASSERT_BSONOBJ_EQ(requestObj, expectedRequest);
 }
 
+GetMoreRequest makeRequest(CursorId id) {
+    return GetMoreRequest(
+        NamespaceString("db.coll"), id, boost::none, boost::none, boost::none, boost::none);
+}
+
+TEST(AuthorizedGetMoreRequestTest, TakeParsesWhenNothingWasSet) {
+    AuthorizedGetMoreRequest authorized;
+    auto cmdObj = BSON("getMore" << CursorId(123) << "collection"
+                                 << "coll");
+    auto result = authorized.take("db", cmdObj);
+    ASSERT_OK(result.getStatus());
+    ASSERT_EQUALS(CursorId(123), result.getValue().cursorid);
+
+    ASSERT_NOT_OK(authorized.take("db", BSON("getMore" << CursorId(123))).getStatus());
+}
+
+TEST(AuthorizedGetMoreRequestTest, TakeReturnsRequestSetForSameCommandOnce) {
+    AuthorizedGetMoreRequest authorized;
+    auto cmdObj = BSON("getMore" << CursorId(123) << "collection"
+                                 << "coll");
+
+    // The remembered request is distinguishable from what parsing 'cmdObj' would produce.
+    authorized.set(cmdObj, makeRequest(456));
+    auto first = authorized.take("db", cmdObj);
+    ASSERT_OK(first.getStatus());
+    ASSERT_EQUALS(CursorId(456), first.getValue().cursorid);
+
+    auto second = authorized.take("db", cmdObj);
+    ASSERT_OK(second.getStatus());
+    ASSERT_EQUALS(CursorId(123), second.getValue().cursorid);
+}
+
+TEST(AuthorizedGetMoreRequestTest, TakeMatchesCommandsWithTheSameBytes) {
+    AuthorizedGetMoreRequest authorized;
+    auto cmdObj = BSON("getMore" << CursorId(123) << "collection"
+                                 << "coll");
+    authorized.set(cmdObj, makeRequest(456));
+
+    auto copy = cmdObj.copy();
+    ASSERT_NOT_EQUALS(cmdObj.objdata(), copy.objdata());
+    ASSERT_EQUALS(CursorId(456), authorized.take("db", copy).getValue().cursorid);
+}
+
+TEST(AuthorizedGetMoreRequestTest, StaleRequestIsNotUsedForADifferentCommand) {
+    AuthorizedGetMoreRequest authorized;
+    auto staleCmdObj = BSON("getMore" << CursorId(123) << "collection"
+                                      << "coll");
+    authorized.set(staleCmdObj, makeRequest(123));
+
+    // The command that set the request failed before run(), and its buffer was released.
+    staleCmdObj = BSONObj();
+
+    auto cmdObj = BSON("getMore" << CursorId(789) << "collection"
+                                 << "coll");
+    auto result = authorized.take("db", cmdObj);
+    ASSERT_OK(result.getStatus());
+    ASSERT_EQUALS(CursorId(789), result.getValue().cursorid);
+}
+
+TEST(AuthorizedGetMoreRequestTest, UnownedCommandIsNotRemembered) {
+    AuthorizedGetMoreRequest authorized;
+    auto owned = BSON("getMore" << CursorId(123) << "collection"
+                                << "coll");
+    BSONObj unowned(owned.objdata());
+    ASSERT_FALSE(unowned.isOwned());
+
+    authorized.set(unowned, makeRequest(456));
+    ASSERT_EQUALS(CursorId(123), authorized.take("db", owned).getValue().cursorid);
+}
+
 }  // namespace
@@ -105,6 +105,14 @@ const char kOptionsField[] = "options";
 // Field names for sorting options.
 const char kNaturalSortField[] = "$natural";
 
+/**
+ * Returns the object held by 'el', a field of 'cmdObj'. If 'cmdObj' is owned the result shares its
+ * buffer, otherwise it is a copy.
+ */
+BSONObj ownedSubobject(const BSONElement& el, const BSONObj& cmdObj) {
+    return cmdObj.isOwned() ? el.Obj().shareOwnershipWith(cmdObj) : el.Obj().getOwned();
+}
+
 }  // namespace
 
 const char QueryRequest::kFindCommandName[] = "find";
@@ -154,25 +162,25 @@ StatusWith<unique_ptr<QueryRequest>> QueryRequest::parseFromFindCommand(unique_p
                 return status;
             }
 
-            qr->_filter = el.Obj().getOwned();
+            qr->_filter = ownedSubobject(el, cmdObj);
         } else if (fieldName == kProjectionField) {
             Status status = checkFieldType(el, Object);
             if (!status.isOK()) {
                 return status;
             }
 
-            qr->_proj = el.Obj().getOwned();
+            qr->_proj = ownedSubobject(el, cmdObj);
         } else if (fieldName == kSortField) {
             Status status = checkFieldType(el, Object);
             if (!status.isOK()) {
                 return status;
             }
 
-            qr->_sort = el.Obj().getOwned();
+            qr->_sort = ownedSubobject(el, cmdObj);
         } else if (fieldName == kHintField) {
             BSONObj hintObj;
             if (Object == el.type()) {
-                hintObj = cmdObj["hint"].Obj().getOwned();
+                hintObj = ownedSubobject(el, cmdObj);
             } else if (String == el.type()) {
                 hintObj = el.wrap("$hint");
             } else {
@@ -188,7 +196,7 @@ StatusWith<unique_ptr<QueryRequest>> QueryRequest::parseFromFindCommand(unique_p
                 return status;
             }
 
-            qr->_readConcern = el.Obj().getOwned();
+            qr->_readConcern = ownedSubobject(el, cmdObj);
         } else if (fieldName == QueryRequest::kUnwrappedReadPrefField) {
             // Read preference parsing is handled elsewhere, but we store a copy here.
             Status status = checkFieldType(el, Object);
@@ -196,7 +204,7 @@ StatusWith<unique_ptr<QueryRequest>> QueryRequest::parseFromFindCommand(unique_p
                 return status;
             }
 
-            qr->setUnwrappedReadPref(el.Obj());
+            qr->setUnwrappedReadPref(ownedSubobject(el, cmdObj));
         } else if (fieldName == kCollationField) {
             // Collation parsing is handled elsewhere, but we store a copy here.
             Status status = checkFieldType(el, Object);
@@ -204,7 +212,7 @@ StatusWith<unique_ptr<QueryRequest>> QueryRequest::parseFromFindCommand(unique_p
                 return status;
             }
 
-            qr->_collation = el.Obj().getOwned();
+            qr->_collation = ownedSubobject(el, cmdObj);
         } else if (fieldName == kSkipField) {
             if (!el.isNumber()) {
                 str::stream ss;
@@ -287,14 +295,14 @@ StatusWith<unique_ptr<QueryRequest>> QueryRequest::parseFromFindCommand(unique_p
                 return status;
             }
 
-            qr->_min = el.Obj().getOwned();
+            qr->_min = ownedSubobject(el, cmdObj);
         } else if (fieldName == kMaxField) {
             Status status = checkFieldType(el, Object);
             if (!status.isOK()) {
                 return status;
             }
 
-            qr->_max = el.Obj().getOwned();
+            qr->_max = ownedSubobject(el, cmdObj);
         } else if (fieldName == kReturnKeyField) {
             Status status = checkFieldType(el, Bool);
             if (!status.isOK()) {
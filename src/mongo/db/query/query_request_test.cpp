@@ -451,6 +451,36 @@ TEST(QueryRequestTest, ParseFromCommandAllFlagsTrue) {
     ASSERT(qr->isAllowPartialResults());
 }
 
+TEST(QueryRequestTest, ParseFromCommandSharesOwnedCommandBuffer) {
+    BSONObj cmdObj = fromjson(
+        "{find: 'testns',"
+        "filter: {a: 1},"
+        "projection: {b: 1},"
+        "sort: {c: 1},"
+        "hint: {c: 1}}");
+    ASSERT(cmdObj.isOwned());
+    const NamespaceString nss("test.testns");
+    unique_ptr<QueryRequest> qr(assertGet(QueryRequest::makeFromFindCommand(nss, cmdObj, false)));
+
+    ASSERT(qr->getFilter().isOwned());
+    ASSERT_EQ(cmdObj["filter"].Obj().objdata(), qr->getFilter().objdata());
+    ASSERT_EQ(cmdObj["projection"].Obj().objdata(), qr->getProj().objdata());
+    ASSERT_EQ(cmdObj["sort"].Obj().objdata(), qr->getSort().objdata());
+    ASSERT_EQ(cmdObj["hint"].Obj().objdata(), qr->getHint().objdata());
+}
+
+TEST(QueryRequestTest, ParseFromCommandCopiesUnownedCommandBuffer) {
+    BSONObj ownedCmdObj = fromjson("{find: 'testns', filter: {a: 1}}");
+    BSONObj cmdObj(ownedCmdObj.objdata());
+    ASSERT_FALSE(cmdObj.isOwned());
+    const NamespaceString nss("test.testns");
+    unique_ptr<QueryRequest> qr(assertGet(QueryRequest::makeFromFindCommand(nss, cmdObj, false)));
+
+    ASSERT(qr->getFilter().isOwned());
+    ASSERT_NOT_EQUALS(cmdObj["filter"].Obj().objdata(), qr->getFilter().objdata());
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 1}"), qr->getFilter());
+}
+
 TEST(QueryRequestTest, ParseFromCommandCommentWithValidMinMax) {
     BSONObj cmdObj = fromjson(
         "{find: 'testns',"
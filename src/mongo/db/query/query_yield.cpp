@@ -30,6 +30,10 @@
 #include "mongo/db/query/query_yield.h"
 
 #include "mongo/bson/bsonobj.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/record_fetcher.h"
@@ -41,6 +45,26 @@ namespace mongo {
 namespace {
 MONGO_FP_DECLARE(setYieldAllLocksHang);
 MONGO_FP_DECLARE(setYieldAllLocksWait);
+
+/**
+ * Moves a read served from the snapshot of the last applied batch to the newest such snapshot.
+ * Returns false if there is none, because a batch with untimestamped writes is being applied, or
+ * if the collection changed in a way that the snapshot does not reflect yet.
+ */
+bool canResumeAtLastAppliedSnapshot(OperationContext* opCtx, const NamespaceString& nss) {
+    if (!opCtx->recoveryUnit()->setReadFromLastAppliedSnapshot().isOK()) {
+        return false;
+    }
+
+    Database* db = nss.isValid() ? dbHolder().get(opCtx, nss.db()) : nullptr;
+    Collection* coll = db ? db->getCollection(opCtx, nss) : nullptr;
+    if (!coll) {
+        return true;
+    }
+
+    auto minSnapshot = coll->getMinimumVisibleSnapshot();
+    return !minSnapshot || *minSnapshot < *opCtx->recoveryUnit()->getLastAppliedSnapshot();
+}
 }  // namespace
 
 // static
@@ -84,6 +108,22 @@ void QueryYield::yieldAllLocks(OperationContext* opCtx,
     }
 
     locker->restoreLockState(snapshot);
+
+    // The batch applied while yielding may have withdrawn the last applied snapshot or changed the
+    // collection. Wait for it to complete; after that, with the locks held again, nothing can
+    // invalidate the newest snapshot.
+    if (opCtx->recoveryUnit()->getLastAppliedSnapshot() &&
+        !canResumeAtLastAppliedSnapshot(opCtx, planExecNS)) {
+        invariant(locker->saveLockStateAndUnlock(&snapshot));
+        opCtx->recoveryUnit()->abandonSnapshot();
+
+        Lock::ResourceLock pbwm(locker, resourceIdParallelBatchWriterMode, MODE_IS);
+        if (!opCtx->recoveryUnit()->setReadFromLastAppliedSnapshot().isOK()) {
+            // This node is no longer applying batches, so read the latest data.
+            opCtx->recoveryUnit()->clearReadFromLastAppliedSnapshot();
+        }
+        locker->restoreLockState(snapshot);
+    }
 }
 
 }  // namespace mongo
@@ -36,6 +36,7 @@
 #include "mongo/bson/util/bson_extract.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_delta_encoding.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
@@ -51,6 +52,11 @@ Counter64 readersCreatedStats;
 ServerStatusMetricField<Counter64> displayReadersCreated("repl.network.readersCreated",
                                                          &readersCreatedStats);
 
+// The number of bytes saved by delta encoding of the oplog entries received.
+Counter64 deltaEncodingBytesSavedStats;
+ServerStatusMetricField<Counter64> displayDeltaEncodingBytesSaved(
+    "repl.network.deltaEncoding.bytesSaved", &deltaEncodingBytesSavedStats);
+
 // Number of seconds for the `maxTimeMS` on the initial `find` command.
 MONGO_EXPORT_SERVER_PARAMETER(oplogInitialFindMaxSeconds, int, 60);
 
@@ -250,8 +256,16 @@ void AbstractOplogFetcher::_callback(const Fetcher::QueryResponseStatus& result,
         return;
     }
 
+    // Restore any delta encoded entries before anything looks at the batch.
+    auto queryResponse = result.getValue();
+    auto bytesSaved = decodeOplogDeltaBatch(&queryResponse.documents);
+    if (!bytesSaved.isOK()) {
+        _finishCallback(bytesSaved.getStatus());
+        return;
+    }
+    deltaEncodingBytesSavedStats.increment(bytesSaved.getValue());
+
     // At this point we have a successful batch and can call the subclass's _onSuccessfulBatch.
-    const auto& queryResponse = result.getValue();
     auto batchResult = _onSuccessfulBatch(queryResponse);
     if (!batchResult.isOK()) {
         // The stopReplProducer fail point expects this to return successfully. If another fail
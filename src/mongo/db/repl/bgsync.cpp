@@ -55,6 +55,8 @@
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/s/shard_identity_rollback_notifier.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/db/storage/snapshot_manager.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/rpc/metadata/repl_set_metadata.h"
 #include "mongo/stdx/memory.h"
@@ -644,6 +646,13 @@ void BackgroundSync::_runRollback(OperationContext* opCtx,
         }
     }
 
+    // Rollback rewrites data without timestamps, so reads must stop being served from the snapshot
+    // of the last applied batch until batch application resumes.
+    if (auto snapshotManager =
+            opCtx->getServiceContext()->getGlobalStorageEngine()->getSnapshotManager()) {
+        snapshotManager->clearLocalSnapshot();
+    }
+
     if (MONGO_FAIL_POINT(rollbackHangBeforeStart)) {
         // This log output is used in js tests so please leave it.
         log() << "rollback - rollbackHangBeforeStart fail point "
@@ -0,0 +1,176 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_delta_encoding.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const char kOpsFieldName[] = "$d";
+
+// Back-references are stored in a single byte, and zero is reserved for verbatim fields.
+const size_t kMaxReferencedFields = 255;
+
+}  // namespace
+
+const char kOplogDeltaEncodingFieldName[] = "$oplogDeltaEncoding";
+
+bool OplogDeltaEncoder::isRequested(const BSONObj& cmdObj) {
+    BSONElement elem = cmdObj[kOplogDeltaEncodingFieldName];
+    return !elem.eoo() && elem.trueValue();
+}
+
+BSONObj OplogDeltaEncoder::encode(const BSONObj& entry) {
+    std::vector<BSONElement> previousFields;
+    if (!_previous.isEmpty()) {
+        for (auto&& elem : _previous) {
+            if (previousFields.size() == kMaxReferencedFields) {
+                break;
+            }
+            previousFields.push_back(elem);
+        }
+    }
+
+    _ops.clear();
+    BSONObjBuilder verbatim;
+    bool sharesFields = false;
+    size_t position = 0;
+    for (auto&& elem : entry) {
+        char op = 0;
+
+        // Fields usually appear at the same position in consecutive entries, so look there first.
+        if (position < previousFields.size() && elem.binaryEqual(previousFields[position])) {
+            op = static_cast<char>(position + 1);
+        } else {
+            for (size_t i = 0; i < previousFields.size(); ++i) {
+                if (elem.binaryEqual(previousFields[i])) {
+                    op = static_cast<char>(i + 1);
+                    break;
+                }
+            }
+        }
+
+        if (op) {
+            sharesFields = true;
+        } else {
+            verbatim.append(elem);
+        }
+        _ops.push_back(op);
+        ++position;
+    }
+
+    _previous = entry;
+    if (!sharesFields) {
+        return entry;
+    }
+
+    BSONObjBuilder encoded;
+    encoded.appendBinData(kOpsFieldName, _ops.size(), BinDataGeneral, _ops.data());
+    encoded.appendElements(verbatim.done());
+    return encoded.obj();
+}
+
+StatusWith<BSONObj> OplogDeltaDecoder::decode(const BSONObj& encoded) {
+    BSONObjIterator it(encoded);
+    BSONElement opsElem = it.more() ? it.next() : BSONElement();
+    if (opsElem.eoo() || opsElem.fieldNameStringData() != kOpsFieldName) {
+        _previous = encoded.getOwned();
+        return _previous;
+    }
+
+    if (opsElem.type() != BinData || opsElem.binDataType() != BinDataGeneral) {
+        return {ErrorCodes::FailedToParse,
+                str::stream() << "delta encoded oplog entry has an invalid '" << kOpsFieldName
+                              << "' field: "
+                              << encoded};
+    }
+
+    std::vector<BSONElement> previousFields;
+    for (auto&& elem : _previous) {
+        if (previousFields.size() == kMaxReferencedFields) {
+            break;
+        }
+        previousFields.push_back(elem);
+    }
+
+    int len;
+    const char* ops = opsElem.binData(len);
+    BSONObjBuilder decoded;
+    for (int i = 0; i < len; ++i) {
+        const size_t op = static_cast<unsigned char>(ops[i]);
+        if (op == 0) {
+            if (!it.more()) {
+                return {ErrorCodes::FailedToParse,
+                        str::stream() << "delta encoded oplog entry is missing verbatim fields: "
+                                      << encoded};
+            }
+            decoded.append(it.next());
+        } else if (op <= previousFields.size()) {
+            decoded.append(previousFields[op - 1]);
+        } else {
+            return {ErrorCodes::FailedToParse,
+                    str::stream() << "delta encoded oplog entry refers to field " << op - 1
+                                  << " of a previous entry with "
+                                  << previousFields.size()
+                                  << " fields: "
+                                  << encoded};
+        }
+    }
+
+    if (it.more()) {
+        return {ErrorCodes::FailedToParse,
+                str::stream() << "delta encoded oplog entry has unreferenced fields: " << encoded};
+    }
+
+    _previous = decoded.obj();
+    return _previous;
+}
+
+StatusWith<long long> decodeOplogDeltaBatch(std::vector<BSONObj>* batch) {
+    OplogDeltaDecoder decoder;
+    long long bytesSaved = 0;
+    for (auto&& entry : *batch) {
+        const int encodedSize = entry.objsize();
+        auto decoded = decoder.decode(entry);
+        if (!decoded.isOK()) {
+            return decoded.getStatus();
+        }
+        entry = std::move(decoded.getValue());
+        bytesSaved += entry.objsize() - encodedSize;
+    }
+    return bytesSaved;
+}
+
+}  // namespace repl
+}  // namespace mongo
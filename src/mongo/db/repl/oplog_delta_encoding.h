@@ -0,0 +1,108 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status_with.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Delta encoding for batches of oplog entries sent to syncing nodes.
+ *
+ * Consecutive oplog entries usually share most of their top-level fields: the term, the version,
+ * the operation type, the namespace and the collection UUID are typically identical from one entry
+ * to the next. A syncing node that sends the kOplogDeltaEncodingFieldName metadata field with its
+ * 'find' and 'getMore' commands on the oplog receives each entry after the first in a batch with
+ * the fields it shares with the previous entry replaced by back-references.
+ *
+ * An encoded entry is a document whose first field is named "$d" and holds BinData with one byte
+ * for each field of the decoded entry, in order. A zero byte means the field is the next field of
+ * the encoded document after "$d". A byte k > 0 means the field is the (k - 1)th field of the
+ * previous decoded entry, copied verbatim including its name. Documents that do not start with a
+ * "$d" field are not encoded, so decoding a batch from a node that ignores the request is a no-op.
+ * The first entry of every batch is sent unencoded.
+ */
+extern const char kOplogDeltaEncodingFieldName[];
+
+/**
+ * Encodes the entries of one batch, in order.
+ */
+class OplogDeltaEncoder {
+    MONGO_DISALLOW_COPYING(OplogDeltaEncoder);
+
+public:
+    OplogDeltaEncoder() = default;
+
+    /**
+     * Returns true if 'cmdObj' asks for the oplog entries in its response to be delta encoded.
+     */
+    static bool isRequested(const BSONObj& cmdObj);
+
+    /**
+     * Returns 'entry' encoded relative to the entry passed to the previous call, or 'entry' itself
+     * if nothing can be shared with it.
+     */
+    BSONObj encode(const BSONObj& entry);
+
+private:
+    BSONObj _previous;
+    std::vector<char> _ops;
+};
+
+/**
+ * Decodes the entries of one batch, in order.
+ */
+class OplogDeltaDecoder {
+    MONGO_DISALLOW_COPYING(OplogDeltaDecoder);
+
+public:
+    OplogDeltaDecoder() = default;
+
+    /**
+     * Returns the oplog entry that 'encoded' represents given the entry returned by the previous
+     * call. Unencoded entries are returned unchanged.
+     */
+    StatusWith<BSONObj> decode(const BSONObj& encoded);
+
+private:
+    BSONObj _previous;
+};
+
+/**
+ * Decodes every entry of 'batch' in place. Returns the number of bytes the encoding saved.
+ */
+StatusWith<long long> decodeOplogDeltaBatch(std::vector<BSONObj>* batch);
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,137 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_delta_encoding.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+BSONObj makeInsert(int i) {
+    return BSON("ts" << Timestamp(1, i) << "t" << 1LL << "h" << static_cast<long long>(i) << "v"
+                     << 2
+                     << "op"
+                     << "i"
+                     << "ns"
+                     << "test.coll"
+                     << "o"
+                     << BSON("_id" << i << "x" << 1));
+}
+
+TEST(OplogDeltaEncoding, FirstEntryIsSentVerbatim) {
+    OplogDeltaEncoder encoder;
+    auto entry = makeInsert(0);
+    ASSERT_BSONOBJ_EQ(entry, encoder.encode(entry));
+}
+
+TEST(OplogDeltaEncoding, SharedFieldsAreReplacedByReferences) {
+    OplogDeltaEncoder encoder;
+    encoder.encode(makeInsert(0));
+    auto encoded = encoder.encode(makeInsert(1));
+
+    ASSERT_EQ("$d", encoded.firstElement().fieldNameStringData());
+    ASSERT_FALSE(encoded.hasField("ns"));
+    ASSERT_FALSE(encoded.hasField("op"));
+    ASSERT_TRUE(encoded.hasField("ts"));
+    ASSERT_TRUE(encoded.hasField("o"));
+    ASSERT_LT(encoded.objsize(), makeInsert(1).objsize());
+}
+
+TEST(OplogDeltaEncoding, BatchRoundTrips) {
+    OplogDeltaEncoder encoder;
+    std::vector<BSONObj> original;
+    std::vector<BSONObj> batch;
+    for (int i = 0; i < 10; ++i) {
+        original.push_back(makeInsert(i));
+        batch.push_back(encoder.encode(original.back()));
+    }
+    // Entries with different shapes are interleaved with the inserts.
+    original.push_back(BSON("ts" << Timestamp(2, 0) << "op"
+                                 << "n"
+                                 << "o"
+                                 << BSON("msg"
+                                         << "noop")));
+    batch.push_back(encoder.encode(original.back()));
+    original.push_back(makeInsert(11));
+    batch.push_back(encoder.encode(original.back()));
+
+    auto bytesSaved = decodeOplogDeltaBatch(&batch);
+    ASSERT_OK(bytesSaved.getStatus());
+    ASSERT_GT(bytesSaved.getValue(), 0);
+    ASSERT_EQ(original.size(), batch.size());
+    for (size_t i = 0; i < original.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(original[i], batch[i]);
+        ASSERT(original[i].binaryEqual(batch[i]));
+    }
+}
+
+TEST(OplogDeltaEncoding, UnencodedBatchIsUnchanged) {
+    std::vector<BSONObj> batch{makeInsert(0), makeInsert(1)};
+    auto bytesSaved = decodeOplogDeltaBatch(&batch);
+    ASSERT_OK(bytesSaved.getStatus());
+    ASSERT_EQ(0, bytesSaved.getValue());
+    ASSERT_BSONOBJ_EQ(makeInsert(1), batch[1]);
+}
+
+TEST(OplogDeltaEncoding, InvalidReferenceFailsToDecode) {
+    OplogDeltaDecoder decoder;
+    ASSERT_OK(decoder.decode(BSON("a" << 1)).getStatus());
+
+    const char ops[] = {2};
+    BSONObjBuilder bob;
+    bob.appendBinData("$d", sizeof(ops), BinDataGeneral, ops);
+    ASSERT_EQ(ErrorCodes::FailedToParse, decoder.decode(bob.obj()).getStatus());
+}
+
+TEST(OplogDeltaEncoding, MissingVerbatimFieldFailsToDecode) {
+    OplogDeltaDecoder decoder;
+    ASSERT_OK(decoder.decode(BSON("a" << 1)).getStatus());
+
+    const char ops[] = {1, 0};
+    BSONObjBuilder bob;
+    bob.appendBinData("$d", sizeof(ops), BinDataGeneral, ops);
+    ASSERT_EQ(ErrorCodes::FailedToParse, decoder.decode(bob.obj()).getStatus());
+}
+
+TEST(OplogDeltaEncoding, IsRequested) {
+    ASSERT_TRUE(OplogDeltaEncoder::isRequested(BSON("find"
+                                                    << "oplog.rs"
+                                                    << "$oplogDeltaEncoding"
+                                                    << 1)));
+    ASSERT_FALSE(OplogDeltaEncoder::isRequested(BSON("find"
+                                                     << "oplog.rs")));
+}
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -35,7 +35,9 @@
 #include "mongo/base/counter.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_delta_encoding.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
 #include "mongo/util/assert_util.h"
@@ -52,6 +54,11 @@ MONGO_FP_DECLARE(stopReplProducer);
 
 namespace {
 
+// Whether to ask the sync source to delta encode the oplog entries it sends. Sync sources that
+// predate delta encoding reject the request, so this must only be enabled once every member of the
+// replica set supports it.
+MONGO_EXPORT_SERVER_PARAMETER(oplogFetcherUseDeltaEncoding, bool, false);
+
 // The number and time spent reading batches off the network
 TimerStats getmoreReplStats;
 ServerStatusMetricField<TimerStats> displayBatchesRecieved("repl.network.getmores",
@@ -106,6 +113,9 @@ BSONObj makeMetadataObject(bool isV1ElectionProtocol) {
     BSONObjBuilder metaBuilder;
     metaBuilder << rpc::kReplSetMetadataFieldName << 1;
     metaBuilder << rpc::kOplogQueryMetadataFieldName << 1;
+    if (oplogFetcherUseDeltaEncoding.load()) {
+        metaBuilder << kOplogDeltaEncodingFieldName << 1;
+    }
     metaBuilder.appendElements(ReadPreferenceSetting::secondaryPreferredMetadata());
     return metaBuilder.obj();
 }
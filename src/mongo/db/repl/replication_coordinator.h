@@ -347,6 +347,15 @@ public:
      */
     virtual void setMyLastDurableOpTimeForward(const OpTime& opTime) = 0;
 
+    /**
+     * Same as setMyLastAppliedOpTimeForward, but does not report the new optime upstream.
+     *
+     * This is used by secondaries that are about to journal a batch of applied operations, so that
+     * the sync source learns about the applied and the durable optime in a single
+     * replSetUpdatePosition once the batch is journaled.
+     */
+    virtual void setMyLastAppliedOpTimeForwardWithoutReportingUpstream(const OpTime& opTime) = 0;
+
     /**
      * Same as above, but used during places we need to zero our last optime.
      */
@@ -76,6 +76,7 @@
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/session_catalog.h"
+#include "mongo/db/storage/snapshot_manager.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/executor/network_connection_hook.h"
 #include "mongo/executor/network_interface.h"
@@ -452,6 +453,12 @@ OpTime ReplicationCoordinatorExternalStateImpl::onTransitionToPrimary(OperationC
     }
     const auto opTimeToReturn = fassertStatusOK(28665, loadLastOpTime(opCtx));
 
+    // Reads on a primary see the latest data, so the snapshot of the last applied batch must not
+    // be used by operations that started while this node was a secondary.
+    if (auto manager = _service->getGlobalStorageEngine()->getSnapshotManager()) {
+        manager->clearLocalSnapshot();
+    }
+
     _shardingOnTransitionToPrimaryHook(opCtx);
     _dropAllTempCollections(opCtx);
 
@@ -252,52 +252,75 @@ private:
     Waiter* _waiter;
 };
 
+std::string ReplicationCoordinatorImpl::WaiterList::_queueKey(WaiterType waiter) {
+    // Whether a waiter is done depends on its opTime and on the parts of its write concern that
+    // say which nodes must have reached that opTime, but not on its timeout.
+    if (!waiter->writeConcern) {
+        return std::string();
+    }
+    const auto& wc = *waiter->writeConcern;
+    return str::stream() << wc.wMode << '|' << wc.wNumNodes << '|'
+                         << static_cast<int>(wc.syncMode);
+}
+
 void ReplicationCoordinatorImpl::WaiterList::add_inlock(WaiterType waiter) {
-    _list.push_back(waiter);
+    _queues[_queueKey(waiter)].emplace(waiter->opTime, waiter);
 }
 
 void ReplicationCoordinatorImpl::WaiterList::signalAndRemoveIf_inlock(
     stdx::function<bool(WaiterType)> func) {
-    // Only advance iterator when the element doesn't match.
-    for (auto it = _list.begin(); it != _list.end();) {
-        if (!func(*it)) {
-            ++it;
-            continue;
+    std::vector<WaiterType> ready;
+    for (auto queueIt = _queues.begin(); queueIt != _queues.end();) {
+        auto& queue = queueIt->second;
+        auto it = queue.begin();
+        while (it != queue.end() && func(it->second)) {
+            ready.push_back(it->second);
+            it = queue.erase(it);
         }
 
-        WaiterType waiter = std::move(*it);
-        if (it == std::prev(_list.end())) {
-            // Iterator will be invalid after erasing the last element, so set it to the
-            // next one (i.e. end()).
-            it = _list.erase(it);
+        if (queue.empty()) {
+            queueIt = _queues.erase(queueIt);
         } else {
-            // Iterator is still valid after pop_back().
-            std::swap(*it, _list.back());
-            _list.pop_back();
+            ++queueIt;
         }
+    }
 
-        // It's important to call notify() after the waiter has been removed from the list
-        // since notify() might remove the waiter itself.
+    // It's important to call notify() after the waiters have been removed from the list since
+    // notify() might remove the waiter itself.
+    for (auto& waiter : ready) {
         waiter->notify_inlock();
     }
 }
 
 void ReplicationCoordinatorImpl::WaiterList::signalAndRemoveAll_inlock() {
-    std::vector<WaiterType> list = std::move(_list);
+    auto queues = std::move(_queues);
+    _queues.clear();
     // Call notify() after removing the waiters from the list.
-    for (auto& waiter : list) {
-        waiter->notify_inlock();
+    for (auto& queue : queues) {
+        for (auto& entry : queue.second) {
+            entry.second->notify_inlock();
+        }
     }
 }
 
 bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(WaiterType waiter) {
-    auto it = std::find(_list.begin(), _list.end(), waiter);
-    if (it == _list.end()) {
+    auto queueIt = _queues.find(_queueKey(waiter));
+    if (queueIt == _queues.end()) {
         return false;
     }
-    std::swap(*it, _list.back());
-    _list.pop_back();
-    return true;
+
+    auto& queue = queueIt->second;
+    auto range = queue.equal_range(waiter->opTime);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == waiter) {
+            queue.erase(it);
+            if (queue.empty()) {
+                _queues.erase(queueIt);
+            }
+            return true;
+        }
+    }
+    return false;
 }
 
 namespace {
@@ -1042,6 +1065,15 @@ void ReplicationCoordinatorImpl::setMyLastDurableOpTimeForward(const OpTime& opT
     }
 }
 
+void ReplicationCoordinatorImpl::setMyLastAppliedOpTimeForwardWithoutReportingUpstream(
+    const OpTime& opTime) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    if (opTime > _getMyLastAppliedOpTime_inlock()) {
+        const bool allowRollback = false;
+        _setMyLastAppliedOpTime_inlock(opTime, allowRollback);
+    }
+}
+
 void ReplicationCoordinatorImpl::setMyLastAppliedOpTime(const OpTime& opTime) {
     stdx::unique_lock<stdx::mutex> lock(_mutex);
     _setMyLastAppliedOpTime_inlock(opTime, false);
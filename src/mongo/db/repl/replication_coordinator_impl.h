@@ -28,7 +28,9 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -160,6 +162,8 @@ public:
     virtual void setMyLastAppliedOpTimeForward(const OpTime& opTime);
     virtual void setMyLastDurableOpTimeForward(const OpTime& opTime);
 
+    virtual void setMyLastAppliedOpTimeForwardWithoutReportingUpstream(const OpTime& opTime);
+
     virtual void resetMyLastOpTimes();
 
     virtual void setMyHeartbeatMessage(const std::string& msg);
@@ -521,13 +525,22 @@ private:
         void add_inlock(WaiterType waiter);
         // Returns whether waiter is found and removed.
         bool remove_inlock(WaiterType waiter);
-        // Signals and removes all waiters that satisfy the condition.
+        // Signals and removes all waiters that satisfy the condition. Waiters with the same write
+        // concern are visited in increasing opTime order, stopping at the first one that does not
+        // satisfy the condition, so the condition must hold for every earlier opTime whenever it
+        // holds for a later one.
         void signalAndRemoveIf_inlock(stdx::function<bool(WaiterType)> fun);
         // Signals and removes all waiters from the list.
         void signalAndRemoveAll_inlock();
 
     private:
-        std::vector<WaiterType> _list;
+        // Waiters with the same write concern, ordered by opTime.
+        using WaiterQueue = std::multimap<OpTime, WaiterType>;
+
+        static std::string _queueKey(WaiterType waiter);
+
+        // Keyed by _queueKey(). Empty queues are removed.
+        std::map<std::string, WaiterQueue> _queues;
     };
 
     typedef std::vector<executor::TaskExecutor::CallbackHandle> HeartbeatHandles;
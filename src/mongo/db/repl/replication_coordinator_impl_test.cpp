@@ -1138,6 +1138,67 @@ TEST_F(ReplCoordTest, NodeReturnsOkWhenAWriteConcernWithNoTimeoutHasBeenSatisfie
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, NodeWakesWaitersInOpTimeOrderForEachWriteConcern) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version"
+                            << 2
+                            << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id"
+                                               << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id"
+                                                  << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id"
+                                                  << 2))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    getReplCoord()->setMyLastAppliedOpTime(OpTimeWithTermOne(100, 0));
+    getReplCoord()->setMyLastDurableOpTime(OpTimeWithTermOne(100, 0));
+    simulateSuccessfulV1Election();
+
+    OpTimeWithTermOne time1(100, 1);
+    OpTimeWithTermOne time2(100, 2);
+    getReplCoord()->setMyLastAppliedOpTime(time2);
+    getReplCoord()->setMyLastDurableOpTime(time2);
+
+    WriteConcernOptions twoNodes;
+    twoNodes.wTimeout = WriteConcernOptions::kNoTimeout;
+    twoNodes.wNumNodes = 2;
+    WriteConcernOptions threeNodes = twoNodes;
+    threeNodes.wNumNodes = 3;
+
+    ReplicationAwaiter twoNodesAtTime1(getReplCoord(), getServiceContext());
+    twoNodesAtTime1.setOpTime(time1);
+    twoNodesAtTime1.setWriteConcern(twoNodes);
+    ReplicationAwaiter twoNodesAtTime2(getReplCoord(), getServiceContext());
+    twoNodesAtTime2.setOpTime(time2);
+    twoNodesAtTime2.setWriteConcern(twoNodes);
+    ReplicationAwaiter threeNodesAtTime1(getReplCoord(), getServiceContext());
+    threeNodesAtTime1.setOpTime(time1);
+    threeNodesAtTime1.setWriteConcern(threeNodes);
+
+    twoNodesAtTime2.start();
+    twoNodesAtTime1.start();
+    threeNodesAtTime1.start();
+
+    // Only the earlier of the two waiters for two nodes is satisfied.
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time1));
+    ASSERT_OK(twoNodesAtTime1.getResult().status);
+
+    // A waiter for a different write concern is not held back by a later unsatisfied waiter.
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 2, time1));
+    ASSERT_OK(threeNodesAtTime1.getResult().status);
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time2));
+    ASSERT_OK(twoNodesAtTime2.getResult().status);
+}
+
 TEST_F(ReplCoordTest, NodeReturnsWriteConcernFailedWhenAWriteConcernTimesOutBeforeBeingSatisified) {
     assertStartSuccess(BSON("_id"
                             << "mySet"
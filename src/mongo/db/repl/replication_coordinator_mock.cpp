@@ -212,6 +212,11 @@ void ReplicationCoordinatorMock::setMyLastDurableOpTimeForward(const OpTime& opT
     }
 }
 
+void ReplicationCoordinatorMock::setMyLastAppliedOpTimeForwardWithoutReportingUpstream(
+    const OpTime& opTime) {
+    setMyLastAppliedOpTimeForward(opTime);
+}
+
 void ReplicationCoordinatorMock::resetMyLastOpTimes() {
     _myLastDurableOpTime = OpTime();
 }
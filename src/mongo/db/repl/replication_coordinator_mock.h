@@ -122,6 +122,8 @@ public:
     virtual void setMyLastAppliedOpTimeForward(const OpTime& opTime);
     virtual void setMyLastDurableOpTimeForward(const OpTime& opTime);
 
+    virtual void setMyLastAppliedOpTimeForwardWithoutReportingUpstream(const OpTime& opTime);
+
     virtual void resetMyLastOpTimes();
 
     virtual void setMyHeartbeatMessage(const std::string& msg);
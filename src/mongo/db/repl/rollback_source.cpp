@@ -0,0 +1,51 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/rollback_source.h"
+
+namespace mongo {
+namespace repl {
+
+std::pair<std::vector<BSONObj>, NamespaceString> RollbackSource::findManyByUUID(
+    const std::string& db, UUID uuid, const std::vector<BSONElement>& ids) const {
+    std::vector<BSONObj> docs;
+    NamespaceString nss;
+    for (auto&& id : ids) {
+        BSONObj doc;
+        std::tie(doc, nss) = findOneByUUID(db, uuid, id.wrap());
+        if (!doc.isEmpty()) {
+            docs.push_back(std::move(doc));
+        }
+    }
+    return {std::move(docs), std::move(nss)};
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -28,15 +28,17 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/status_with.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/util/net/hostandport.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
 
-class NamespaceString;
 class OperationContext;
 
 namespace repl {
@@ -88,6 +90,16 @@ public:
                                                               UUID uuid,
                                                               const BSONObj& filter) const = 0;
 
+    /**
+     * Fetches the documents with the given _ids from the sync source using the UUID. Returns the
+     * documents that were found, in no particular order, and the namespace matching the UUID on
+     * the sync source. Documents that do not exist on the sync source are omitted.
+     *
+     * The default implementation calls findOneByUUID() once per _id.
+     */
+    virtual std::pair<std::vector<BSONObj>, NamespaceString> findManyByUUID(
+        const std::string& db, UUID uuid, const std::vector<BSONElement>& ids) const;
+
     /**
      * Clones a single collection from the sync source.
      */
@@ -79,6 +79,56 @@ std::pair<BSONObj, NamespaceString> RollbackSourceImpl::findOneByUUID(const std:
     return _getConnection()->findOneByUUID(db, uuid, filter);
 }
 
+std::pair<std::vector<BSONObj>, NamespaceString> RollbackSourceImpl::findManyByUUID(
+    const std::string& db, UUID uuid, const std::vector<BSONElement>& ids) const {
+    BSONObjBuilder filterBuilder;
+    {
+        BSONObjBuilder idBuilder(filterBuilder.subobjStart("_id"));
+        BSONArrayBuilder inBuilder(idBuilder.subarrayStart("$in"));
+        for (auto&& id : ids) {
+            inBuilder.append(id);
+        }
+    }
+
+    BSONObjBuilder cmdBuilder;
+    uuid.appendToBuilder(&cmdBuilder, "find");
+    cmdBuilder.append("filter", filterBuilder.obj());
+    cmdBuilder.append("batchSize", static_cast<long long>(ids.size()));
+    const BSONObj cmd = cmdBuilder.obj();
+
+    auto conn = _getConnection();
+    BSONObj res;
+    uassert(40654,
+            str::stream() << "find command using UUID failed. Command: " << cmd << " Result: "
+                          << res,
+            conn->runCommand(db, cmd, res, QueryOption_SlaveOk));
+
+    std::vector<BSONObj> docs;
+    BSONObj cursorObj = res.getObjectField("cursor");
+    const NamespaceString resNss(cursorObj["ns"].valueStringData());
+    for (auto&& elem : cursorObj.getObjectField("firstBatch")) {
+        docs.push_back(elem.Obj().getOwned());
+    }
+
+    // The documents may not fit in a single batch; drain the cursor.
+    long long cursorId = cursorObj["id"].numberLong();
+    while (cursorId != 0) {
+        const BSONObj getMoreCmd = BSON("getMore" << cursorId << "collection" << resNss.coll());
+        uassert(40655,
+                str::stream() << "getMore command failed. Command: " << getMoreCmd << " Result: "
+                              << res,
+                conn->runCommand(db, getMoreCmd, res, QueryOption_SlaveOk));
+
+        cursorObj = res.getObjectField("cursor");
+        for (auto&& elem : cursorObj.getObjectField("nextBatch")) {
+            docs.push_back(elem.Obj().getOwned());
+        }
+        cursorId = cursorObj["id"].numberLong();
+    }
+
+    return {std::move(docs), resNss};
+}
+
 void RollbackSourceImpl::copyCollectionFromRemote(OperationContext* opCtx,
                                                   const NamespaceString& nss) const {
     std::string errmsg;
@@ -67,6 +67,7 @@
 #include "mongo/db/repl/roll_back_local_operations.h"
 #include "mongo/db/repl/rollback_source.h"
 #include "mongo/db/repl/rslog.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/s/shard_identity_rollback_notifier.h"
 #include "mongo/db/session_catalog.h"
 #include "mongo/util/exit.h"
@@ -88,6 +89,9 @@ namespace repl {
 
 using namespace rollback_internal;
 
+// The maximum number of documents refetched from the sync source with a single query.
+MONGO_EXPORT_SERVER_PARAMETER(rollbackRefetchBatchSize, int, 1000);
+
 bool DocID::operator<(const DocID& other) const {
     int comp = uuid.toString().compare(other.uuid.toString());
     if (comp < 0)
@@ -919,22 +923,38 @@ void rollback_internal::syncFixUp(OperationContext* opCtx,
 
     log() << "Starting refetching documents";
 
-    for (auto&& doc : fixUpInfo.docsToRefetch) {
-        invariant(!doc._id.eoo());  // This is checked when we insert to the set.
-
-        UUID uuid = doc.uuid;
-        NamespaceString nss = catalog.lookupNSSByUUID(uuid);
+    const StringData::ComparatorInterface* stringComparator = nullptr;
+    const BSONElementComparator eltCmp(BSONElementComparator::FieldNamesMode::kIgnore,
+                                       stringComparator);
+
+    // Documents to refetch are ordered by collection UUID, so each batch is a run of documents
+    // from a single collection, fetched with one query instead of one round trip per document.
+    auto it = fixUpInfo.docsToRefetch.begin();
+    while (it != fixUpInfo.docsToRefetch.end()) {
+        const UUID uuid = it->uuid;
+        const NamespaceString nss = catalog.lookupNSSByUUID(uuid);
+
+        std::vector<const DocID*> batch;
+        std::vector<BSONElement> ids;
+        int idBytes = 0;
+        const size_t maxBatchSize = std::max(1, rollbackRefetchBatchSize.load());
+        while (it != fixUpInfo.docsToRefetch.end() && it->uuid == uuid &&
+               batch.size() < maxBatchSize && idBytes < BSONObjMaxUserSize / 2) {
+            invariant(!it->_id.eoo());  // This is checked when we insert to the set.
+            batch.push_back(&*it);
+            ids.push_back(it->_id);
+            idBytes += it->_id.size();
+            ++it;
+        }
 
         try {
-            LOG(2) << "Refetching document, namespace: " << nss.toString()
-                   << ", _id: " << redact(doc._id);
-            // TODO : Slow. Lots of round trips.
-            numFetched++;
+            LOG(2) << "Refetching " << batch.size() << " documents, namespace: " << nss.toString();
+            numFetched += batch.size();
 
-            BSONObj good;
+            std::vector<BSONObj> found;
             NamespaceString resNss;
-            std::tie(good, resNss) =
-                rollbackSource.findOneByUUID(nss.db().toString(), uuid, doc._id.wrap());
+            std::tie(found, resNss) =
+                rollbackSource.findManyByUUID(nss.db().toString(), uuid, ids);
 
             // To prevent inconsistencies in the transactions collection, rollback fails if the UUID
             // of the collection is different on the sync source than on the node rolling back,
@@ -951,7 +971,11 @@ void rollback_internal::syncFixUp(OperationContext* opCtx,
                        "resync is required.");
             }
 
-            totalSize += good.objsize();
+            auto foundById = eltCmp.makeBSONEltIndexedMap<BSONObj>();
+            for (auto&& good : found) {
+                totalSize += good.objsize();
+                foundById.emplace(good["_id"], good);
+            }
 
             // Checks that the total amount of data that needs to be refetched is at most
             // 300 MB. We do not roll back more than 300 MB of documents in order to
@@ -960,8 +984,29 @@ void rollback_internal::syncFixUp(OperationContext* opCtx,
                 throw RSFatalException("replSet too much data to roll back.");
             }
 
-            // Note good might be empty, indicating we should delete it.
-            goodVersions[uuid].insert(std::pair<DocID, BSONObj>(doc, good));
+            // A collation on the remote collection can make the query return a document whose _id
+            // differs bytewise from the one we asked for. Such _ids are fetched individually.
+            const auto requested = eltCmp.makeBSONEltFlatSet(ids);
+            const bool allMatched = foundById.size() == found.size() &&
+                std::all_of(found.begin(), found.end(), [&](const BSONObj& good) {
+                    return requested.count(good["_id"]) > 0;
+                });
+
+            for (auto doc : batch) {
+                BSONObj good;
+                auto foundIt = foundById.find(doc->_id);
+                if (foundIt != foundById.end()) {
+                    good = foundIt->second;
+                } else if (!allMatched) {
+                    LOG(2) << "Refetching document individually, namespace: " << nss.toString()
+                           << ", _id: " << redact(doc->_id);
+                    std::tie(good, std::ignore) =
+                        rollbackSource.findOneByUUID(nss.db().toString(), uuid, doc->_id.wrap());
+                }
+
+                // Note good might be empty, indicating we should delete it.
+                goodVersions[uuid].insert(std::pair<DocID, BSONObj>(*doc, good));
+            }
 
         } catch (const DBException& ex) {
             // If the collection turned into a view, we might get an error trying to
@@ -970,8 +1015,8 @@ void rollback_internal::syncFixUp(OperationContext* opCtx,
             if (ex.code() == ErrorCodes::CommandNotSupportedOnView)
                 continue;
 
-            log() << "Rollback couldn't re-fetch from uuid: " << uuid << " _id: " << redact(doc._id)
-                  << ' ' << numFetched << '/' << fixUpInfo.docsToRefetch.size() << ": "
+            log() << "Rollback couldn't re-fetch " << batch.size() << " documents from uuid: "
+                  << uuid << ' ' << numFetched << '/' << fixUpInfo.docsToRefetch.size() << ": "
                   << redact(ex);
             throw;
         }
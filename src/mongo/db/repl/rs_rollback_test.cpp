@@ -475,6 +475,74 @@ TEST_F(RSRollbackTest, RollbackDeleteRestoreDocument) {
             _opCtx.get(), _coordinator, _replicationProcess.get(), coll->uuid().get(), doc));
 }
 
+TEST_F(RSRollbackTest, RollbackRefetchesDocumentsOfACollectionInOneBatch) {
+    createOplog(_opCtx.get());
+    CollectionOptions options;
+    options.uuid = UUID::gen();
+    auto coll = _createCollection(_opCtx.get(), "test.t", options);
+    auto uuid = coll->uuid().get();
+
+    auto commonOperation =
+        std::make_pair(BSON("ts" << Timestamp(Seconds(1), 0) << "h" << 1LL), RecordId(1));
+    auto makeDeleteOperation = [&](int id, int time) {
+        return std::make_pair(BSON("ts" << Timestamp(Seconds(time), 0) << "h" << 1LL << "op"
+                                        << "d"
+                                        << "ui"
+                                        << uuid
+                                        << "ns"
+                                        << "test.t"
+                                        << "o"
+                                        << BSON("_id" << id)),
+                              RecordId(time));
+    };
+
+    class RollbackSourceLocal : public RollbackSourceMock {
+    public:
+        using RollbackSourceMock::RollbackSourceMock;
+        std::pair<BSONObj, NamespaceString> findOneByUUID(const std::string& db,
+                                                          UUID uuid,
+                                                          const BSONObj& filter) const override {
+            ++findOneCalls;
+            return {BSONObj(), NamespaceString()};
+        }
+        std::pair<std::vector<BSONObj>, NamespaceString> findManyByUUID(
+            const std::string& db,
+            UUID uuid,
+            const std::vector<BSONElement>& ids) const override {
+            ++findManyCalls;
+            idsRequested += ids.size();
+            std::vector<BSONObj> docs;
+            for (auto&& id : ids) {
+                docs.push_back(BSON("_id" << id.numberInt() << "a" << 1));
+            }
+            return {docs, NamespaceString("test.t")};
+        }
+        mutable int findOneCalls = 0;
+        mutable int findManyCalls = 0;
+        mutable size_t idsRequested = 0;
+    };
+
+    RollbackSourceLocal rollbackSource(std::unique_ptr<OplogInterface>(new OplogInterfaceMock({
+        commonOperation,
+    })));
+    ASSERT_OK(syncRollback(_opCtx.get(),
+                           OplogInterfaceMock({makeDeleteOperation(2, 4),
+                                               makeDeleteOperation(1, 3),
+                                               makeDeleteOperation(0, 2),
+                                               commonOperation}),
+                           rollbackSource,
+                           {},
+                           _coordinator,
+                           _replicationProcess.get()));
+    ASSERT_EQUALS(1, rollbackSource.findManyCalls);
+    ASSERT_EQUALS(3U, rollbackSource.idsRequested);
+    ASSERT_EQUALS(0, rollbackSource.findOneCalls);
+
+    AutoGetCollectionForReadCommand autoColl(_opCtx.get(), NamespaceString("test.t"));
+    ASSERT_TRUE(autoColl.getCollection());
+    ASSERT_EQUALS(3, autoColl.getCollection()->numRecords(_opCtx.get()));
+}
+
 TEST_F(RSRollbackTest, RollbackInsertDocumentWithNoId) {
     createOplog(_opCtx.get());
     auto commonOperation =
@@ -34,6 +34,7 @@
 #include "mongo/db/repl/sync_tail.h"
 
 #include "third_party/murmurhash3/MurmurHash3.h"
+#include <algorithm>
 #include <boost/functional/hash.hpp>
 #include <memory>
 
@@ -71,6 +72,7 @@
 #include "mongo/db/session.h"
 #include "mongo/db/session_txn_record.h"
 #include "mongo/db/stats/timer_stats.h"
+#include "mongo/db/storage/snapshot_manager.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
@@ -149,6 +151,11 @@ ServerStatusMetricField<Counter64> displayAttemptsToBecomeSecondary(
 // Number and time of each ApplyOps worker pool round
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
+
+// When journaling, whether to report the applied optime of a batch upstream only together with its
+// durable optime, once the batch has been journaled.
+MONGO_EXPORT_SERVER_PARAMETER(reportAppliedOpTimeWithDurableOpTime, bool, true);
+
 void initializePrefetchThread() {
     if (!Client::getCurrent()) {
         Client::initThreadIfNotAlready();
@@ -182,6 +189,10 @@ protected:
         _replCoord->setMyLastAppliedOpTimeForward(newOpTime);
     }
 
+    void _recordAppliedWithoutReportingUpstream(const OpTime& newOpTime) {
+        _replCoord->setMyLastAppliedOpTimeForwardWithoutReportingUpstream(newOpTime);
+    }
+
     void _recordDurable(const OpTime& newOpTime) {
         // We have to use setMyLastDurableOpTimeForward since this thread races with
         // ReplicationExternalStateImpl::onTransitionToPrimary.
@@ -232,7 +243,14 @@ ApplyBatchFinalizerForJournal::~ApplyBatchFinalizerForJournal() {
 }
 
 void ApplyBatchFinalizerForJournal::record(const OpTime& newOpTime) {
-    _recordApplied(newOpTime);
+    // Reporting the applied optime now would usually put a replSetUpdatePosition in flight that
+    // the report of the durable optime, a journal flush later, has to wait behind. Waiters for
+    // majority write concern need the durable optime, so report both together after the flush.
+    if (reportAppliedOpTimeWithDurableOpTime.load()) {
+        _recordAppliedWithoutReportingUpstream(newOpTime);
+    } else {
+        _recordApplied(newOpTime);
+    }
 
     stdx::unique_lock<stdx::mutex> lock(_mutex);
     _latestOpTime = newOpTime;
@@ -406,6 +424,24 @@ Status SyncTail::syncApply(OperationContext* opCtx,
 
 namespace {
 
+// Pauses batch application after all operations in the batch have been applied, while the
+// ParallelBatchWriterMode lock is still held.
+MONGO_FP_DECLARE(pauseBatchApplicationBeforeCompletion);
+
+/**
+ * Returns true if applying 'ops' writes without timestamps. Atomic applyOps and index builds do, so
+ * their writes are visible at every snapshot as soon as they are applied.
+ */
+bool hasUntimestampedWrites(const MultiApplier::Operations& ops) {
+    return std::any_of(ops.cbegin(), ops.cend(), [](const OplogEntry& op) {
+        if (!op.isCommand()) {
+            return op.getOpType() == OpTypeEnum::kInsert && op.getNamespace().isSystemDotIndexes();
+        }
+        return op.getCommandType() == OplogEntry::CommandType::kApplyOps ||
+            op.getCommandType() == OplogEntry::CommandType::kCreateIndexes;
+    });
+}
+
 // The pool threads call this to prefetch each op
 void prefetchOp(const BSONObj& op) {
     initializePrefetchThread();
@@ -1410,6 +1446,17 @@ StatusWith<OpTime> multiApply(OperationContext* opCtx,
                 "attempting to replicate ops while primary"};
     }
 
+    // Reads served from the snapshot of the last applied batch would observe untimestamped writes
+    // before the rest of the batch. Wait for the reads holding that snapshot to release their
+    // locks, then withdraw it so that reads conflict with this batch until it is complete.
+    auto snapshotManager =
+        getGlobalServiceContext()->getGlobalStorageEngine()->getSnapshotManager();
+    if (snapshotManager && hasUntimestampedWrites(ops)) {
+        Lock::ResourceLock lastAppliedSnapshotLock(
+            opCtx->lockState(), resourceIdLastAppliedSnapshot, MODE_X);
+        snapshotManager->clearLocalSnapshot();
+    }
+
     auto latestTxnRecords = computeLatestTransactionTableRecords(ops);
     std::vector<Status> statusVector(workerPool->getNumThreads(), Status::OK());
     {
@@ -1436,6 +1483,15 @@ StatusWith<OpTime> multiApply(OperationContext* opCtx,
         // Update the transaction table to point to the latest oplog entries for each session id.
         scheduleTxnTableUpdates(opCtx, workerPool, latestTxnRecords);
 
+        if (MONGO_FAIL_POINT(pauseBatchApplicationBeforeCompletion)) {
+            log() << "pauseBatchApplicationBeforeCompletion fail point enabled. Blocking until "
+                     "fail point is disabled.";
+            while (MONGO_FAIL_POINT(pauseBatchApplicationBeforeCompletion) &&
+                   !globalInShutdownDeprecated()) {
+                mongo::sleepsecs(1);
+            }
+        }
+
         // Notify the storage engine that a replication batch has completed.
         // This means that all the writes associated with the oplog entries in the batch are
         // finished and no new writes with timestamps associated with those oplog entries will show
@@ -1450,6 +1506,11 @@ StatusWith<OpTime> multiApply(OperationContext* opCtx,
         }
     }
 
+    // Readers that do not conflict with batch application may now observe this batch.
+    if (snapshotManager) {
+        snapshotManager->setLocalSnapshot(ops.back().getTimestamp());
+    }
+
     // We have now written all database writes and updated the oplog to match.
     return ops.back().getOpTime();
 }
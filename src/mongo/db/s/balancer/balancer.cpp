@@ -299,6 +299,19 @@ void Balancer::report(OperationContext* opCtx, BSONObjBuilder* builder) {
     builder->append("numBalancerRounds", _numBalancerRounds);
 }
 
+void Balancer::reportDryRun(OperationContext* opCtx, BSONObjBuilder* builder) {
+    uassertStatusOK(Grid::get(opCtx)->getBalancerConfiguration()->refreshAndCheck(opCtx));
+
+    const auto candidateChunks =
+        uassertStatusOK(_chunkSelectionPolicy->selectChunksToMove(opCtx, false, true));
+
+    BSONArrayBuilder migrationsArr(builder->subarrayStart("migrations"));
+    for (const auto& migrateInfo : candidateChunks) {
+        migrationsArr.append(migrateInfo.toBSON());
+    }
+    migrationsArr.doneFast();
+}
+
 void Balancer::_mainThread() {
     Client::initThread("Balancer");
     auto opCtx = cc().makeOperationContext();
@@ -376,8 +389,9 @@ void Balancer::_mainThread() {
                     LOG(1) << "Done enforcing tag range boundaries.";
                 }
 
-                const auto candidateChunks = uassertStatusOK(
-                    _chunkSelectionPolicy->selectChunksToMove(opCtx.get(), _balancedLastTime));
+                const auto candidateChunks =
+                    uassertStatusOK(_chunkSelectionPolicy->selectChunksToMove(
+                        opCtx.get(), _balancedLastTime, false));
 
                 if (candidateChunks.empty()) {
                     LOG(1) << "no need to move any chunk";
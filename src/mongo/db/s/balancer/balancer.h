@@ -140,6 +140,13 @@ public:
      */
     void report(OperationContext* opCtx, BSONObjBuilder* builder);
 
+    /**
+     * Blocking call, which asks the active balancer policy which chunks it would move if a
+     * balancing round were to start now and appends them to the specified builder. Nothing is
+     * moved and the result does not depend on whether the balancer is enabled.
+     */
+    void reportDryRun(OperationContext* opCtx, BSONObjBuilder* builder);
+
 private:
     /**
      * Possible runtime states of the balancer. The comments indicate the allowed next state.
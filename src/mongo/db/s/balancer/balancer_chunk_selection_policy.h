@@ -93,9 +93,12 @@ public:
      * Potentially blocking method, which gives out a set of chunks to be moved. The
      * aggressiveBalanceHint indicates to the balancing logic that it should lower the threshold for
      * difference in number of chunks across shards and thus potentially cause more chunks to move.
+     * The dryRun flag indicates that the chunks will not actually be moved, so the selection must
+     * not affect the state used by subsequent balancing rounds.
      */
     virtual StatusWith<MigrateInfoVector> selectChunksToMove(OperationContext* opCtx,
-                                                             bool aggressiveBalanceHint) = 0;
+                                                             bool aggressiveBalanceHint,
+                                                             bool dryRun) = 0;
 
     /**
      * Requests a single chunk to be relocated to a different shard, if possible. If some error
@@ -37,6 +37,7 @@
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj_comparator_interface.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/catalog/sharding_catalog_client.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/catalog/type_collection.h"
@@ -57,6 +58,16 @@ using std::vector;
 
 namespace {
 
+// Whether to balance collections by the cost model of BalancerPolicy::balanceByCost, which takes
+// into account the data size and operation load of each shard, instead of by chunk counts
+MONGO_EXPORT_SERVER_PARAMETER(balancerUseCostBasedPolicy, bool, false);
+
+// The weights of the terms of the cost model, see BalancerCostWeights
+MONGO_EXPORT_SERVER_PARAMETER(balancerCostDataSizeWeight, double, 1.0);
+MONGO_EXPORT_SERVER_PARAMETER(balancerCostLoadWeight, double, 1.0);
+MONGO_EXPORT_SERVER_PARAMETER(balancerCostChunkCountWeight, double, 0.1);
+MONGO_EXPORT_SERVER_PARAMETER(balancerCostMigrationWeight, double, 0.1);
+
 /**
  * Does a linear pass over the information cached in the specified chunk manager and extracts chunk
  * distrubution and chunk placement information which is needed by the balancer policy.
@@ -231,7 +242,7 @@ StatusWith<SplitInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToSpli
 }
 
 StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMove(
-    OperationContext* opCtx, bool aggressiveBalanceHint) {
+    OperationContext* opCtx, bool aggressiveBalanceHint, bool dryRun) {
     auto shardStatsStatus = _clusterStats->getStats(opCtx);
     if (!shardStatsStatus.isOK()) {
         return shardStatsStatus.getStatus();
@@ -269,8 +280,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
-        auto candidatesStatus =
-            _getMigrateCandidatesForCollection(opCtx, nss, shardStats, aggressiveBalanceHint);
+        auto candidatesStatus = _getMigrateCandidatesForCollection(
+            opCtx, nss, shardStats, aggressiveBalanceHint, dryRun);
         if (candidatesStatus == ErrorCodes::NamespaceNotFound) {
             // Namespace got dropped before we managed to get to it, so just skip it
             continue;
@@ -414,7 +425,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
     OperationContext* opCtx,
     const NamespaceString& nss,
     const ShardStatisticsVector& shardStats,
-    bool aggressiveBalanceHint) {
+    bool aggressiveBalanceHint,
+    bool dryRun) {
     auto routingInfoStatus =
         Grid::get(opCtx)->catalogCache()->getShardedCollectionRoutingInfoWithRefresh(opCtx, nss);
     if (!routingInfoStatus.isOK()) {
@@ -473,7 +485,35 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
         }
     }
 
-    return BalancerPolicy::balance(shardStats, distribution, aggressiveBalanceHint);
+    if (!balancerUseCostBasedPolicy.load()) {
+        return BalancerPolicy::balance(shardStats, distribution, aggressiveBalanceHint);
+    }
+
+    vector<ShardId> shardsWithChunks;
+    for (const auto& stat : shardStats) {
+        if (distribution.numberOfChunksInShard(stat.shardId)) {
+            shardsWithChunks.push_back(stat.shardId);
+        }
+    }
+
+    // A dry run must not record operation counts, otherwise the next balancer round would measure
+    // the operation rates over the interval since the dry run instead of since the previous round
+    auto collStatsStatus =
+        _clusterStats->getCollectionStats(opCtx, nss, shardsWithChunks, !dryRun);
+    if (!collStatsStatus.isOK()) {
+        warning() << "Balancing collection " << nss.ns() << " by chunk counts instead of by cost"
+                  << causedBy(collStatsStatus.getStatus());
+        return BalancerPolicy::balance(shardStats, distribution, aggressiveBalanceHint);
+    }
+
+    BalancerCostWeights weights;
+    weights.dataSize = balancerCostDataSizeWeight.load();
+    weights.load = balancerCostLoadWeight.load();
+    weights.chunkCount = balancerCostChunkCountWeight.load();
+    weights.migration = balancerCostMigrationWeight.load();
+
+    return BalancerPolicy::balanceByCost(
+        shardStats, distribution, collStatsStatus.getValue(), weights);
 }
 
 }  // namespace mongo
@@ -42,7 +42,8 @@ public:
     StatusWith<SplitInfoVector> selectChunksToSplit(OperationContext* opCtx) override;
 
     StatusWith<MigrateInfoVector> selectChunksToMove(OperationContext* opCtx,
-                                                     bool aggressiveBalanceHint) override;
+                                                     bool aggressiveBalanceHint,
+                                                     bool dryRun) override;
 
     StatusWith<boost::optional<MigrateInfo>> selectSpecificChunkToMove(
         OperationContext* opCtx, const ChunkType& chunk) override;
@@ -69,7 +70,8 @@ private:
         OperationContext* opCtx,
         const NamespaceString& nss,
         const ShardStatisticsVector& shardStats,
-        bool aggressiveBalanceHint);
+        bool aggressiveBalanceHint,
+        bool dryRun);
 
     // Source for obtaining cluster statistics. Not owned and must not be destroyed before the
     // policy object is destroyed.
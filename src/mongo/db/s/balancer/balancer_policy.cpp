@@ -32,6 +32,8 @@
 
 #include "mongo/db/s/balancer/balancer_policy.h"
 
+#include <algorithm>
+
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/catalog/type_tags.h"
@@ -53,6 +55,21 @@ namespace {
 const size_t kDefaultImbalanceThreshold = 2;
 const size_t kAggressiveImbalanceThreshold = 1;
 
+// Cost reductions smaller than this are treated as rounding noise rather than as an improvement.
+const double kMinCostReduction = 1e-9;
+
+/**
+ * Returns by how much moving 'value' from a shard at 'donorValue' to a shard at 'receiverValue'
+ * changes the sum over all shards of (shard's value / 'mean' - 1)^2.
+ */
+double costDelta(double donorValue, double receiverValue, double value, double mean) {
+    if (mean <= 0) {
+        return 0;
+    }
+
+    return 2 * value * (receiverValue - donorValue + value) / (mean * mean);
+}
+
 }  // namespace
 
 DistributionStatus::DistributionStatus(NamespaceString nss, ShardToChunksMap shardToChunksMap)
@@ -298,13 +315,70 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
     // migrations for the same shard.
     set<ShardId> usedShards;
 
+    // 1) and 2) Move chunks off of draining shards and out of shards not in their zone
+    _selectRequiredMigrations(shardStats, distribution, &migrations, &usedShards);
+
+    // 3) for each tag balance
+    const size_t imbalanceThreshold = (shouldAggressivelyBalance || distribution.totalChunks() < 20)
+        ? kAggressiveImbalanceThreshold
+        : kDefaultImbalanceThreshold;
+
+    vector<string> tagsPlusEmpty(distribution.tags().begin(), distribution.tags().end());
+    tagsPlusEmpty.push_back("");
+
+    for (const auto& tag : tagsPlusEmpty) {
+        const size_t totalNumberOfChunksWithTag =
+            (tag.empty() ? distribution.totalChunks() : distribution.totalChunksWithTag(tag));
+
+        size_t totalNumberOfShardsWithTag = 0;
+
+        for (const auto& stat : shardStats) {
+            if (tag.empty() || stat.shardTags.count(tag)) {
+                totalNumberOfShardsWithTag++;
+            }
+        }
+
+        // Skip zones which have no shards assigned to them. This situation is not harmful, but
+        // should not be possible so warn the operator to correct it.
+        if (totalNumberOfShardsWithTag == 0) {
+            if (!tag.empty()) {
+                warning() << "Zone " << redact(tag) << " in collection " << distribution.nss()
+                          << " has no assigned shards and chunks which fall into it cannot be "
+                             "balanced. This should be corrected by either assigning shards to the "
+                             "zone or by deleting it.";
+            }
+            continue;
+        }
+
+        // Calculate the ceiling of the optimal number of chunks per shard
+        const size_t idealNumberOfChunksPerShardForTag =
+            (totalNumberOfChunksWithTag / totalNumberOfShardsWithTag) +
+            (totalNumberOfChunksWithTag % totalNumberOfShardsWithTag ? 1 : 0);
+
+        while (_singleZoneBalance(shardStats,
+                                  distribution,
+                                  tag,
+                                  idealNumberOfChunksPerShardForTag,
+                                  imbalanceThreshold,
+                                  &migrations,
+                                  &usedShards))
+            ;
+    }
+
+    return migrations;
+}
+
+void BalancerPolicy::_selectRequiredMigrations(const ShardStatisticsVector& shardStats,
+                                               const DistributionStatus& distribution,
+                                               vector<MigrateInfo>* migrations,
+                                               set<ShardId>* usedShards) {
     // 1) Check for shards, which are in draining mode
     {
         for (const auto& stat : shardStats) {
             if (!stat.isDraining)
                 continue;
 
-            if (usedShards.count(stat.shardId))
+            if (usedShards->count(stat.shardId))
                 continue;
 
             const vector<ChunkType>& chunks = distribution.getChunks(stat.shardId);
@@ -326,9 +400,9 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
                 const string tag = distribution.getTagForChunk(chunk);
 
                 const ShardId to =
-                    _getLeastLoadedReceiverShard(shardStats, distribution, tag, usedShards);
+                    _getLeastLoadedReceiverShard(shardStats, distribution, tag, *usedShards);
                 if (!to.isValid()) {
-                    if (migrations.empty()) {
+                    if (migrations->empty()) {
                         warning() << "Chunk " << redact(chunk.toString())
                                   << " is on a draining shard, but no appropriate recipient found";
                     }
@@ -336,13 +410,13 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
                 }
 
                 invariant(to != stat.shardId);
-                migrations.emplace_back(to, chunk);
-                invariant(usedShards.insert(stat.shardId).second);
-                invariant(usedShards.insert(to).second);
+                migrations->emplace_back(to, chunk);
+                invariant(usedShards->insert(stat.shardId).second);
+                invariant(usedShards->insert(to).second);
                 break;
             }
 
-            if (migrations.empty()) {
+            if (migrations->empty()) {
                 warning() << "Unable to find any chunk to move from draining shard " << stat.shardId
                           << ". numJumboChunks: " << numJumboChunks;
             }
@@ -352,7 +426,7 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
     // 2) Check for chunks, which are on the wrong shard and must be moved off of it
     if (!distribution.tags().empty()) {
         for (const auto& stat : shardStats) {
-            if (usedShards.count(stat.shardId))
+            if (usedShards->count(stat.shardId))
                 continue;
 
             const vector<ChunkType>& chunks = distribution.getChunks(stat.shardId);
@@ -373,9 +447,9 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
                 }
 
                 const ShardId to =
-                    _getLeastLoadedReceiverShard(shardStats, distribution, tag, usedShards);
+                    _getLeastLoadedReceiverShard(shardStats, distribution, tag, *usedShards);
                 if (!to.isValid()) {
-                    if (migrations.empty()) {
+                    if (migrations->empty()) {
                         warning() << "Chunk " << redact(chunk.toString()) << " violates zone "
                                   << redact(tag) << ", but no appropriate recipient found";
                     }
@@ -383,59 +457,31 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
                 }
 
                 invariant(to != stat.shardId);
-                migrations.emplace_back(to, chunk);
-                invariant(usedShards.insert(stat.shardId).second);
-                invariant(usedShards.insert(to).second);
+                migrations->emplace_back(to, chunk);
+                invariant(usedShards->insert(stat.shardId).second);
+                invariant(usedShards->insert(to).second);
                 break;
             }
         }
     }
+}
 
-    // 3) for each tag balance
-    const size_t imbalanceThreshold = (shouldAggressivelyBalance || distribution.totalChunks() < 20)
-        ? kAggressiveImbalanceThreshold
-        : kDefaultImbalanceThreshold;
+vector<MigrateInfo> BalancerPolicy::balanceByCost(
+    const ShardStatisticsVector& shardStats,
+    const DistributionStatus& distribution,
+    const ClusterStatistics::CollectionStatisticsMap& collStats,
+    const BalancerCostWeights& weights) {
+    vector<MigrateInfo> migrations;
+    set<ShardId> usedShards;
+
+    _selectRequiredMigrations(shardStats, distribution, &migrations, &usedShards);
 
     vector<string> tagsPlusEmpty(distribution.tags().begin(), distribution.tags().end());
     tagsPlusEmpty.push_back("");
 
     for (const auto& tag : tagsPlusEmpty) {
-        const size_t totalNumberOfChunksWithTag =
-            (tag.empty() ? distribution.totalChunks() : distribution.totalChunksWithTag(tag));
-
-        size_t totalNumberOfShardsWithTag = 0;
-
-        for (const auto& stat : shardStats) {
-            if (tag.empty() || stat.shardTags.count(tag)) {
-                totalNumberOfShardsWithTag++;
-            }
-        }
-
-        // Skip zones which have no shards assigned to them. This situation is not harmful, but
-        // should not be possible so warn the operator to correct it.
-        if (totalNumberOfShardsWithTag == 0) {
-            if (!tag.empty()) {
-                warning() << "Zone " << redact(tag) << " in collection " << distribution.nss()
-                          << " has no assigned shards and chunks which fall into it cannot be "
-                             "balanced. This should be corrected by either assigning shards to the "
-                             "zone or by deleting it.";
-            }
-            continue;
-        }
-
-        // Calculate the ceiling of the optimal number of chunks per shard
-        const size_t idealNumberOfChunksPerShardForTag =
-            (totalNumberOfChunksWithTag / totalNumberOfShardsWithTag) +
-            (totalNumberOfChunksWithTag % totalNumberOfShardsWithTag ? 1 : 0);
-
-        while (_singleZoneBalance(shardStats,
-                                  distribution,
-                                  tag,
-                                  idealNumberOfChunksPerShardForTag,
-                                  imbalanceThreshold,
-                                  &migrations,
-                                  &usedShards))
-            ;
+        _singleZoneBalanceByCost(
+            shardStats, distribution, collStats, weights, tag, &migrations, &usedShards);
     }
 
     return migrations;
@@ -528,6 +574,132 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
     return false;
 }
 
+void BalancerPolicy::_singleZoneBalanceByCost(
+    const ShardStatisticsVector& shardStats,
+    const DistributionStatus& distribution,
+    const ClusterStatistics::CollectionStatisticsMap& collStats,
+    const BalancerCostWeights& weights,
+    const string& tag,
+    vector<MigrateInfo>* migrations,
+    set<ShardId>* usedShards) {
+    // The estimated utilization of the zone on a shard and of each of the shard's chunks
+    struct ShardUtilization {
+        const ClusterStatistics::ShardStatistics* stat{nullptr};
+        ShardId shardId;
+        double numChunks{0};
+        double dataSize{0};
+        double load{0};
+        double chunkDataSize{0};
+        double chunkLoad{0};
+    };
+
+    vector<ShardUtilization> shards;
+    ShardUtilization total;
+
+    for (const auto& stat : shardStats) {
+        if (stat.isDraining || (!tag.empty() && !stat.shardTags.count(tag)))
+            continue;
+
+        ShardUtilization shard;
+        shard.stat = &stat;
+        shard.shardId = stat.shardId;
+        shard.numChunks = distribution.numberOfChunksInShardWithTag(stat.shardId, tag);
+
+        const auto it = collStats.find(stat.shardId);
+        const size_t numCollectionChunks = distribution.numberOfChunksInShard(stat.shardId);
+        if (it != collStats.end() && numCollectionChunks) {
+            shard.chunkDataSize =
+                static_cast<double>(it->second.dataSizeBytes) / numCollectionChunks;
+            shard.chunkLoad = it->second.opsPerSec / numCollectionChunks;
+        }
+
+        shard.dataSize = shard.numChunks * shard.chunkDataSize;
+        shard.load = shard.numChunks * shard.chunkLoad;
+
+        total.numChunks += shard.numChunks;
+        total.dataSize += shard.dataSize;
+        total.load += shard.load;
+
+        shards.push_back(std::move(shard));
+    }
+
+    if (shards.size() < 2)
+        return;
+
+    const double meanNumChunks = total.numChunks / shards.size();
+    const double meanDataSize = total.dataSize / shards.size();
+    const double meanLoad = total.load / shards.size();
+
+    // Shards, which have only jumbo chunks left in the zone
+    set<ShardId> exhaustedDonors;
+
+    while (true) {
+        const ShardUtilization* bestFrom = nullptr;
+        const ShardUtilization* bestTo = nullptr;
+        double bestCostReduction = kMinCostReduction;
+
+        for (const auto& from : shards) {
+            if (!from.numChunks || usedShards->count(from.shardId) ||
+                exhaustedDonors.count(from.shardId))
+                continue;
+
+            for (const auto& to : shards) {
+                if (&to == &from || usedShards->count(to.shardId))
+                    continue;
+
+                if (!isShardSuitableReceiver(*to.stat, tag).isOK())
+                    continue;
+
+                double costReduction =
+                    -weights.chunkCount * costDelta(from.numChunks, to.numChunks, 1, meanNumChunks);
+                costReduction -=
+                    weights.dataSize *
+                    costDelta(from.dataSize, to.dataSize, from.chunkDataSize, meanDataSize);
+                costReduction -=
+                    weights.load * costDelta(from.load, to.load, from.chunkLoad, meanLoad);
+                if (meanDataSize > 0) {
+                    costReduction -= weights.migration * from.chunkDataSize / meanDataSize;
+                }
+
+                if (costReduction > bestCostReduction) {
+                    bestFrom = &from;
+                    bestTo = &to;
+                    bestCostReduction = costReduction;
+                }
+            }
+        }
+
+        if (!bestFrom)
+            return;
+
+        const auto& chunks = distribution.getChunks(bestFrom->shardId);
+        const auto chunkIt =
+            std::find_if(chunks.begin(), chunks.end(), [&](const ChunkType& chunk) {
+                return !chunk.getJumbo() && distribution.getTagForChunk(chunk) == tag;
+            });
+        if (chunkIt == chunks.end()) {
+            warning() << "Shard: " << bestFrom->shardId
+                      << ", collection: " << distribution.nss().ns()
+                      << " has only jumbo chunks for zone \'" << tag
+                      << "\' and cannot be balanced";
+            exhaustedDonors.insert(bestFrom->shardId);
+            continue;
+        }
+
+        LOG(1) << "collection : " << distribution.nss().ns();
+        LOG(1) << "zone       : " << tag;
+        LOG(1) << "donor      : " << bestFrom->shardId << " chunks on " << bestFrom->numChunks
+               << " data size " << bestFrom->dataSize << " ops/sec " << bestFrom->load;
+        LOG(1) << "receiver   : " << bestTo->shardId << " chunks on " << bestTo->numChunks
+               << " data size " << bestTo->dataSize << " ops/sec " << bestTo->load;
+        LOG(1) << "cost saved : " << bestCostReduction;
+
+        migrations->emplace_back(bestTo->shardId, *chunkIt);
+        invariant(usedShards->insert(bestFrom->shardId).second);
+        invariant(usedShards->insert(bestTo->shardId).second);
+    }
+}
+
 ZoneRange::ZoneRange(const BSONObj& a_min, const BSONObj& a_max, const std::string& _zone)
     : min(a_min.getOwned()), max(a_max.getOwned()), zone(_zone) {}
 
@@ -552,6 +724,16 @@ std::string MigrateInfo::getName() const {
     return ChunkType::genID(ns, minKey);
 }
 
+BSONObj MigrateInfo::toBSON() const {
+    BSONObjBuilder builder;
+    builder.append("ns", ns);
+    builder.append("min", minKey);
+    builder.append("max", maxKey);
+    builder.append("from", from.toString());
+    builder.append("to", to.toString());
+    return builder.obj();
+}
+
 string MigrateInfo::toString() const {
     return str::stream() << ns << ": [" << minKey << ", " << maxKey << "), from " << from << ", to "
                          << to;
@@ -52,6 +52,8 @@ struct MigrateInfo {
 
     std::string getName() const;
 
+    BSONObj toBSON() const;
+
     std::string toString() const;
 
     std::string ns;
@@ -65,6 +67,23 @@ struct MigrateInfo {
 typedef std::vector<ClusterStatistics::ShardStatistics> ShardStatisticsVector;
 typedef std::map<ShardId, std::vector<ChunkType>> ShardToChunksMap;
 
+/**
+ * Relative weights of the terms of the cost model used by BalancerPolicy::balanceByCost.
+ */
+struct BalancerCostWeights {
+    // Weight of the imbalance in the amount of data stored on each shard
+    double dataSize{1.0};
+
+    // Weight of the imbalance in the rate of operations served by each shard
+    double load{1.0};
+
+    // Weight of the imbalance in the number of chunks owned by each shard
+    double chunkCount{0.1};
+
+    // Weight of the amount of data a migration has to copy
+    double migration{0.1};
+};
+
 /**
  * This class constitutes a cache of the chunk distribution across the entire cluster along with the
  * zone boundaries imposed on it. This information is stored in format, which makes it efficient to
@@ -184,6 +203,27 @@ public:
                                             const DistributionStatus& distribution,
                                             bool shouldAggressivelyBalance);
 
+    /**
+     * Same as balance() as far as draining shards and chunks in the wrong zone are concerned, but
+     * instead of evening out the number of chunks per shard, suggests the migrations which reduce
+     * the following cost the most:
+     *
+     *   sum over each zone and each of dataSize, load and chunkCount of
+     *       weight * sum over the zone's shards of (shard's value / mean value - 1)^2
+     *
+     * with each migration charged weights.migration * (chunk's data size / mean data size). A
+     * migration is only suggested if it lowers the cost by more than it is charged, so a shard
+     * needs to be out of balance by more than a chunk's worth before anything moves.
+     *
+     * The data size and operation rate of each chunk are estimated by dividing the values in
+     * 'collStats' evenly among the collection's chunks on that shard.
+     */
+    static std::vector<MigrateInfo> balanceByCost(
+        const ShardStatisticsVector& shardStats,
+        const DistributionStatus& distribution,
+        const ClusterStatistics::CollectionStatisticsMap& collStats,
+        const BalancerCostWeights& weights);
+
     /**
      * Using the specified distribution information, returns a suggested better location for the
      * specified chunk if one is available.
@@ -193,6 +233,15 @@ public:
                                                            const DistributionStatus& distribution);
 
 private:
+    /**
+     * Suggests the migrations, which are necessary regardless of how balanced the shards are,
+     * namely moving chunks off of draining shards and out of shards not in the chunk's zone.
+     */
+    static void _selectRequiredMigrations(const ShardStatisticsVector& shardStats,
+                                          const DistributionStatus& distribution,
+                                          std::vector<MigrateInfo>* migrations,
+                                          std::set<ShardId>* usedShards);
+
     /**
      * Return the shard with the specified tag, which has the least number of chunks. If the tag is
      * empty, considers all shards.
@@ -230,6 +279,19 @@ private:
                                    size_t imbalanceThreshold,
                                    std::vector<MigrateInfo>* migrations,
                                    std::set<ShardId>* usedShards);
+
+    /**
+     * Suggests the migrations within the specified zone, which lower the cost described in
+     * balanceByCost the most, using each shard at most once.
+     */
+    static void _singleZoneBalanceByCost(
+        const ShardStatisticsVector& shardStats,
+        const DistributionStatus& distribution,
+        const ClusterStatistics::CollectionStatisticsMap& collStats,
+        const BalancerCostWeights& weights,
+        const std::string& tag,
+        std::vector<MigrateInfo>* migrations,
+        std::set<ShardId>* usedShards);
 };
 
 }  // namespace mongo
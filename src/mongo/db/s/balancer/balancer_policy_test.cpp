@@ -553,6 +553,131 @@ TEST(BalancerPolicy, BalancerHandlesNoShardsWithTag) {
     ASSERT(BalancerPolicy::balance(cluster.first, distribution, false).empty());
 }
 
+ClusterStatistics::CollectionStatistics makeCollStats(uint64_t dataSizeBytes, double opsPerSec) {
+    ClusterStatistics::CollectionStatistics stats;
+    stats.dataSizeBytes = dataSizeBytes;
+    stats.opsPerSec = opsPerSec;
+    return stats;
+}
+
+TEST(BalancerPolicy, BalanceByCostMovesDataOffLargerShard) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId1, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 4}});
+
+    const auto migrations(BalancerPolicy::balanceByCost(
+        cluster.first,
+        DistributionStatus(kNamespace, cluster.second),
+        {{kShardId0, makeCollStats(400 << 20, 0)}, {kShardId1, makeCollStats(40 << 20, 0)}},
+        BalancerCostWeights()));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMax(), migrations[0].maxKey);
+}
+
+TEST(BalancerPolicy, BalanceByCostMovesLoadOffBusierShard) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId1, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 4}});
+
+    const auto migrations(BalancerPolicy::balanceByCost(
+        cluster.first,
+        DistributionStatus(kNamespace, cluster.second),
+        {{kShardId0, makeCollStats(100 << 20, 0)}, {kShardId1, makeCollStats(100 << 20, 1000)}},
+        BalancerCostWeights()));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId1, migrations[0].from);
+    ASSERT_EQ(kShardId0, migrations[0].to);
+}
+
+TEST(BalancerPolicy, BalanceByCostDoesNotMoveChunksOfEvenlySpreadData) {
+    // shard0 has four times as many chunks, but they are four times smaller
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 8},
+         {ShardStatistics(kShardId1, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 2}});
+
+    const ClusterStatistics::CollectionStatisticsMap collStats{
+        {kShardId0, makeCollStats(100 << 20, 10)}, {kShardId1, makeCollStats(100 << 20, 10)}};
+
+    ASSERT(BalancerPolicy::balanceByCost(cluster.first,
+                                         DistributionStatus(kNamespace, cluster.second),
+                                         collStats,
+                                         BalancerCostWeights())
+               .empty());
+}
+
+TEST(BalancerPolicy, BalanceByCostDoesNotMoveChunksOfBalancedCollection) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId1, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 4}});
+
+    const ClusterStatistics::CollectionStatisticsMap collStats{
+        {kShardId0, makeCollStats(100 << 20, 10)}, {kShardId1, makeCollStats(100 << 20, 10)}};
+
+    ASSERT(BalancerPolicy::balanceByCost(cluster.first,
+                                         DistributionStatus(kNamespace, cluster.second),
+                                         collStats,
+                                         BalancerCostWeights())
+               .empty());
+}
+
+TEST(BalancerPolicy, BalanceByCostSpreadsChunksOfEmptyCollection) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 8},
+         {ShardStatistics(kShardId1, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 0}});
+
+    const auto migrations(
+        BalancerPolicy::balanceByCost(cluster.first,
+                                      DistributionStatus(kNamespace, cluster.second),
+                                      ClusterStatistics::CollectionStatisticsMap(),
+                                      BalancerCostWeights()));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+}
+
+TEST(BalancerPolicy, BalanceByCostUsesEachShardOnce) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId1, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId2, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId3, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 4}});
+
+    const ClusterStatistics::CollectionStatisticsMap collStats{
+        {kShardId0, makeCollStats(400 << 20, 0)},
+        {kShardId1, makeCollStats(400 << 20, 0)},
+        {kShardId2, makeCollStats(40 << 20, 0)},
+        {kShardId3, makeCollStats(40 << 20, 0)}};
+
+    const auto migrations(BalancerPolicy::balanceByCost(cluster.first,
+                                                        DistributionStatus(kNamespace, cluster.second),
+                                                        collStats,
+                                                        BalancerCostWeights()));
+    ASSERT_EQ(2U, migrations.size());
+
+    std::set<ShardId> donors{migrations[0].from, migrations[1].from};
+    std::set<ShardId> receivers{migrations[0].to, migrations[1].to};
+    ASSERT(donors == (std::set<ShardId>{kShardId0, kShardId1}));
+    ASSERT(receivers == (std::set<ShardId>{kShardId2, kShardId3}));
+}
+
+TEST(BalancerPolicy, BalanceByCostDrainsShardRegardlessOfCost) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, true, emptyTagSet, emptyShardVersion), 1},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 5}});
+
+    const auto migrations(BalancerPolicy::balanceByCost(
+        cluster.first,
+        DistributionStatus(kNamespace, cluster.second),
+        {{kShardId0, makeCollStats(1 << 20, 0)}, {kShardId1, makeCollStats(500 << 20, 100)}},
+        BalancerCostWeights()));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+}
+
 TEST(DistributionStatus, AddTagRangeOverlap) {
     DistributionStatus d(kNamespace, ShardToChunksMap{});
 
@@ -75,4 +75,11 @@ BSONObj ClusterStatistics::ShardStatistics::toBSON() const {
     return builder.obj();
 }
 
+BSONObj ClusterStatistics::CollectionStatistics::toBSON() const {
+    BSONObjBuilder builder;
+    builder.append("dataSizeBytes", static_cast<long long>(dataSizeBytes));
+    builder.append("opsPerSec", opsPerSec);
+    return builder.obj();
+}
+
 }  // namespace mongo
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -39,6 +40,7 @@
 namespace mongo {
 
 class BSONObj;
+class NamespaceString;
 class OperationContext;
 template <typename T>
 class StatusWith;
@@ -94,6 +96,25 @@ public:
         std::string mongoVersion;
     };
 
+    /**
+     * Structure, which describes the utilization of a single collection on a single shard.
+     */
+    struct CollectionStatistics {
+        /**
+         * Returns BSON representation of this collection's statistics, for reporting purposes.
+         */
+        BSONObj toBSON() const;
+
+        // The size of the collection's data stored on the shard
+        uint64_t dataSizeBytes{0};
+
+        // The rate of operations against the collection on the shard, measured between the two
+        // most recent times its statistics were retrieved. Zero if it has not been measured yet.
+        double opsPerSec{0};
+    };
+
+    typedef std::map<ShardId, CollectionStatistics> CollectionStatisticsMap;
+
     virtual ~ClusterStatistics();
 
     /**
@@ -102,6 +123,18 @@ public:
      */
     virtual StatusWith<std::vector<ShardStatistics>> getStats(OperationContext* opCtx) = 0;
 
+    /**
+     * Retrieves the utilization of the specified collection on each of the specified shards.
+     * Shards, which do not have the collection, are reported with zero utilization. Unless
+     * recordOpCounts is set, the operation counts retrieved are not remembered as the base for the
+     * operation rates reported by subsequent calls.
+     */
+    virtual StatusWith<CollectionStatisticsMap> getCollectionStats(
+        OperationContext* opCtx,
+        const NamespaceString& nss,
+        const std::vector<ShardId>& shardIds,
+        bool recordOpCounts) = 0;
+
 protected:
     ClusterStatistics();
 };
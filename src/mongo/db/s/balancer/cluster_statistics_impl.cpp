@@ -35,6 +35,7 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/util/bson_extract.h"
 #include "mongo/client/read_preference.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/s/catalog/sharding_catalog_client.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/client/shard_registry.h"
@@ -92,6 +93,58 @@ StatusWith<string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId s
     return version;
 }
 
+/**
+ * Runs a $collStats aggregation for the specified collection against the specified shard and
+ * obtains the size of the collection's data and the number of operations run against it since the
+ * shard started.
+ */
+StatusWith<std::pair<long long, long long>> retrieveCollectionDataSizeAndOpCount(
+    OperationContext* opCtx, const ShardId& shardId, const NamespaceString& nss) {
+    auto shardStatus = Grid::get(opCtx)->shardRegistry()->getShard(opCtx, shardId);
+    if (!shardStatus.isOK()) {
+        return shardStatus.getStatus();
+    }
+
+    auto commandResponse = shardStatus.getValue()->runCommandWithFixedRetryAttempts(
+        opCtx,
+        ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+        nss.db().toString(),
+        BSON("aggregate" << nss.coll() << "pipeline"
+                         << BSON_ARRAY(BSON("$collStats" << BSON("latencyStats" << BSONObj()
+                                                                                << "storageStats"
+                                                                                << BSONObj())))
+                         << "cursor"
+                         << BSONObj()),
+        Shard::RetryPolicy::kIdempotent);
+    if (!commandResponse.isOK()) {
+        return commandResponse.getStatus();
+    }
+
+    // The collection does not exist on the shard
+    if (commandResponse.getValue().commandStatus == ErrorCodes::NamespaceNotFound) {
+        return std::make_pair(0LL, 0LL);
+    }
+    if (!commandResponse.getValue().commandStatus.isOK()) {
+        return commandResponse.getValue().commandStatus;
+    }
+
+    const BSONObj& response = commandResponse.getValue().response;
+    const auto firstBatch = response["cursor"]["firstBatch"].Obj();
+    if (firstBatch.isEmpty()) {
+        return std::make_pair(0LL, 0LL);
+    }
+
+    const BSONObj collStats = firstBatch.firstElement().Obj();
+    const BSONObj latencyStats = collStats["latencyStats"].Obj();
+
+    long long opCount = 0;
+    for (const auto opType : {"reads", "writes", "commands"}) {
+        opCount += latencyStats[opType]["ops"].safeNumberLong();
+    }
+
+    return std::make_pair(collStats["storageStats"]["size"].safeNumberLong(), opCount);
+}
+
 }  // namespace
 
 using ShardStatistics = ClusterStatistics::ShardStatistics;
@@ -164,4 +217,50 @@ StatusWith<vector<ShardStatistics>> ClusterStatisticsImpl::getStats(OperationCon
     return stats;
 }
 
+StatusWith<ClusterStatistics::CollectionStatisticsMap> ClusterStatisticsImpl::getCollectionStats(
+    OperationContext* opCtx,
+    const NamespaceString& nss,
+    const vector<ShardId>& shardIds,
+    bool recordOpCounts) {
+    CollectionStatisticsMap stats;
+
+    for (const auto& shardId : shardIds) {
+        auto dataSizeAndOpCountStatus = retrieveCollectionDataSizeAndOpCount(opCtx, shardId, nss);
+        if (!dataSizeAndOpCountStatus.isOK()) {
+            const auto& status = dataSizeAndOpCountStatus.getStatus();
+
+            return {status.code(),
+                    str::stream() << "Unable to obtain utilization information for collection "
+                                  << nss.ns()
+                                  << " on shard "
+                                  << shardId
+                                  << " due to "
+                                  << status.reason()};
+        }
+
+        const long long opCount = dataSizeAndOpCountStatus.getValue().second;
+        const Date_t now = Date_t::now();
+
+        auto& collStats = stats[shardId];
+        collStats.dataSizeBytes = dataSizeAndOpCountStatus.getValue().first;
+
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        auto& lastSample = _opCountSamples[std::make_pair(shardId, nss.ns())];
+
+        // The operation counts restart from zero if the shard restarts
+        if (lastSample.time != Date_t() && now > lastSample.time &&
+            opCount >= lastSample.opCount) {
+            collStats.opsPerSec = static_cast<double>(opCount - lastSample.opCount) * 1000 /
+                durationCount<Milliseconds>(now - lastSample.time);
+        }
+
+        if (recordOpCounts) {
+            lastSample.opCount = opCount;
+            lastSample.time = now;
+        }
+    }
+
+    return stats;
+}
+
 }  // namespace mongo
@@ -28,7 +28,12 @@
 
 #pragma once
 
+#include <string>
+#include <utility>
+
 #include "mongo/db/s/balancer/cluster_statistics.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -36,6 +41,9 @@ namespace mongo {
  * Default implementation for the cluster statistics gathering utility. Uses a blocking method to
  * fetch the statistics and does not perform any caching. If any of the shards fails to report
  * statistics fails the entire refresh.
+ *
+ * Shards only report cumulative operation counts, so the last count seen for each collection on
+ * each shard is remembered in order to turn the next one into a rate.
  */
 class ClusterStatisticsImpl final : public ClusterStatistics {
 public:
@@ -43,6 +51,24 @@ public:
     ~ClusterStatisticsImpl();
 
     StatusWith<std::vector<ShardStatistics>> getStats(OperationContext* opCtx) override;
+
+    StatusWith<CollectionStatisticsMap> getCollectionStats(
+        OperationContext* opCtx,
+        const NamespaceString& nss,
+        const std::vector<ShardId>& shardIds,
+        bool recordOpCounts) override;
+
+private:
+    struct OpCountSample {
+        long long opCount{0};
+        Date_t time;
+    };
+
+    // Protects the state below
+    stdx::mutex _mutex;
+
+    // The most recent operation count reported for each shard and collection namespace
+    std::map<std::pair<ShardId, std::string>, OpCountSample> _opCountSamples;
 };
 
 }  // namespace mongo
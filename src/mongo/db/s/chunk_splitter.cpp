@@ -41,6 +41,7 @@
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/split_chunk.h"
 #include "mongo/db/s/split_vector.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog/sharding_catalog_client.h"
 #include "mongo/s/catalog/type_chunk.h"
@@ -55,6 +56,12 @@
 namespace mongo {
 namespace {
 
+// Whether the auto-splitter may estimate split points from a random sample of the collection
+// instead of scanning the chunk. The sample is drawn from the whole collection, so for a chunk
+// holding a small fraction of it most of the sampled documents are wasted and the estimate usually
+// falls back to the scan anyways.
+MONGO_EXPORT_SERVER_PARAMETER(autoSplitEstimateFromSample, bool, false);
+
 /**
  * Constructs the default options for the thread pool used to schedule splits.
  */
@@ -322,7 +329,8 @@ void ChunkSplitter::_runAutosplit(const NamespaceString& nss,
                                                        boost::none,
                                                        boost::none,
                                                        boost::none,
-                                                       maxChunkSizeBytes));
+                                                       maxChunkSizeBytes,
+                                                       autoSplitEstimateFromSample.load()));
 
         if (splitPoints.size() <= 1) {
             // No split points means there isn't enough data to split on; 1 split point means we
@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
@@ -53,6 +54,7 @@
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/metadata_manager.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/executor/task_executor.h"
@@ -72,6 +74,36 @@ namespace {
 const WriteConcernOptions kMajorityWriteConcern(WriteConcernOptions::kMajority,
                                                 WriteConcernOptions::SyncMode::UNSET,
                                                 Seconds(60));
+
+// How many orphaned documents are removed in a single WriteUnitOfWork.
+const int kMaxDeletesPerWriteUnitOfWork = 64;
+
+// Range deletion proceeds from one batch straight to the next for as long as the majority commit
+// point is no more than this many seconds behind the last write on this node. Otherwise it waits
+// for each batch to be majority committed before starting the next one. A negative value makes
+// every batch wait.
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterMaxReplicationLagSecs, int, 1);
+
+/**
+ * Returns whether replication of the deletions done so far is lagging enough that range deletion
+ * should wait for them to be majority committed before continuing.
+ */
+bool shouldWaitForReplication(OperationContext* opCtx) {
+    const int maxLagSecs = rangeDeleterMaxReplicationLagSecs.load();
+    if (maxLagSecs < 0) {
+        return true;
+    }
+
+    auto const replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet) {
+        return false;
+    }
+
+    const auto lastAppliedSecs = replCoord->getMyLastAppliedOpTime().getTimestamp().getSecs();
+    const auto lastCommittedSecs = replCoord->getLastCommittedOpTime().getTimestamp().getSecs();
+    return lastAppliedSecs > lastCommittedSecs + static_cast<unsigned>(maxLagSecs);
+}
+
 }  // unnamed namespace
 
 CollectionRangeDeleter::~CollectionRangeDeleter() {
@@ -177,11 +209,7 @@ auto CollectionRangeDeleter::cleanUpNextRange(OperationContext* opCtx,
                 wrote = e.toStatus();
                 warning() << e.what();
             }
-            if (!wrote.isOK() || wrote.getValue() == 0) {
-                if (wrote.isOK()) {
-                    log() << "No documents remain to delete in " << nss << " range "
-                          << redact(range->toString());
-                }
+            if (!wrote.isOK()) {
                 stdx::lock_guard<stdx::mutex> scopedLock(css->_metadataManager->_managerLock);
                 self->_pop(wrote.getStatus());
                 if (!self->_orphans.empty()) {
@@ -195,7 +223,13 @@ auto CollectionRangeDeleter::cleanUpNextRange(OperationContext* opCtx,
 
     invariant(range);
     invariantOK(wrote.getStatus());
-    invariant(wrote.getValue() > 0);
+
+    // Batches are not individually waited for unless replication falls behind, but the range is
+    // only reported as clean once all of its deletions are majority committed.
+    if (wrote.getValue() > 0 && !shouldWaitForReplication(opCtx)) {
+        notification.abandon();
+        return Date_t{};
+    }
 
     repl::ReplClientInfo::forClient(opCtx->getClient()).setLastOpToSystemLastOpTime(opCtx);
     const auto clientOpTime = repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
@@ -215,7 +249,7 @@ auto CollectionRangeDeleter::cleanUpNextRange(OperationContext* opCtx,
         AutoGetCollection autoColl(opCtx, nss, MODE_IX);
         auto* css = CollectionShardingState::get(opCtx, nss);
         stdx::lock_guard<stdx::mutex> scopedLock(css->_metadataManager->_managerLock);
-        auto* self = &css->_metadataManager->_rangesToClean;
+        auto* self = forTestOnly ? forTestOnly : &css->_metadataManager->_rangesToClean;
         // if range were already popped (e.g. by dropping nss during the waitForWriteConcern above)
         // its notification would have been triggered, so this check suffices to ensure that it is
         // safe to pop the range here.
@@ -225,6 +259,23 @@ auto CollectionRangeDeleter::cleanUpNextRange(OperationContext* opCtx,
                   << wrote.getValue() << " local deletions because of replication failure";
             self->_pop(status);
         }
+    } else if (wrote.getValue() == 0) {
+        log() << "No documents remain to delete in " << nss << " range "
+              << redact(range->toString());
+
+        AutoGetCollection autoColl(opCtx, nss, MODE_IX);
+        auto* css = CollectionShardingState::get(opCtx, nss);
+        stdx::lock_guard<stdx::mutex> scopedLock(css->_metadataManager->_managerLock);
+        auto* self = forTestOnly ? forTestOnly : &css->_metadataManager->_rangesToClean;
+        // As above, the range may have been popped while waiting for replication
+        if (!notification.ready()) {
+            invariant(!self->isEmpty() && self->_orphans.front().notification == notification);
+            self->_pop(Status::OK());
+            if (!self->_orphans.empty()) {
+                LOG(1) << "Deleting " << nss.ns() << " range "
+                       << redact(self->_orphans.front().range.toString()) << " next.";
+            }
+        }
     } else {
         log() << "Deleted " << wrote.getValue() << " documents in " << nss.ns() << " range "
               << redact(range->toString());
@@ -279,40 +330,74 @@ StatusWith<int> CollectionRangeDeleter::_doDeletion(OperationContext* opCtx,
         saver.emplace("moveChunk", nss.ns(), "cleaning");
     }
 
+    auto halfOpen = BoundInclusion::kIncludeStartKeyOnly;
+    auto manual = PlanExecutor::YIELD_MANUAL;
+    auto forward = InternalPlanner::FORWARD;
+    auto fetch = InternalPlanner::IXSCAN_FETCH;
+
+    // A single scan serves the whole batch. The documents it returns are deleted in groups, each
+    // in its own WriteUnitOfWork, with the scan saved across the deletes.
+    auto exec = InternalPlanner::indexScan(
+        opCtx, collection, descriptor, min, max, halfOpen, manual, forward, fetch);
+
     int numDeleted = 0;
-    do {
-        auto halfOpen = BoundInclusion::kIncludeStartKeyOnly;
-        auto manual = PlanExecutor::YIELD_MANUAL;
-        auto forward = InternalPlanner::FORWARD;
-        auto fetch = InternalPlanner::IXSCAN_FETCH;
-
-        auto exec = InternalPlanner::indexScan(
-            opCtx, collection, descriptor, min, max, halfOpen, manual, forward, fetch);
-
-        RecordId rloc;
-        BSONObj obj;
-        PlanExecutor::ExecState state = exec->getNext(&obj, &rloc);
-        if (state == PlanExecutor::IS_EOF) {
-            break;
+    bool exhausted = false;
+    while (!exhausted && numDeleted < maxToDelete) {
+        std::vector<RecordId> group;
+        const int groupLimit = std::min(kMaxDeletesPerWriteUnitOfWork, maxToDelete - numDeleted);
+        while (int(group.size()) < groupLimit) {
+            RecordId rloc;
+            BSONObj obj;
+            PlanExecutor::ExecState state = exec->getNext(&obj, &rloc);
+            if (state == PlanExecutor::IS_EOF) {
+                exhausted = true;
+                break;
+            }
+            if (state == PlanExecutor::FAILURE || state == PlanExecutor::DEAD) {
+                warning(LogComponent::kSharding)
+                    << PlanExecutor::statestr(state) << " - cursor error while trying to delete "
+                    << min << " to " << max << " in " << nss << ": "
+                    << WorkingSetCommon::toStatusString(obj)
+                    << ", stats: " << Explain::getWinningPlanStats(exec.get());
+                exhausted = true;
+                break;
+            }
+            invariant(PlanExecutor::ADVANCED == state);
+
+            if (saver) {
+                saver->goingToDelete(obj).transitional_ignore();
+            }
+            group.push_back(std::move(rloc));
         }
-        if (state == PlanExecutor::FAILURE || state == PlanExecutor::DEAD) {
-            warning(LogComponent::kSharding)
-                << PlanExecutor::statestr(state) << " - cursor error while trying to delete " << min
-                << " to " << max << " in " << nss << ": " << WorkingSetCommon::toStatusString(obj)
-                << ", stats: " << Explain::getWinningPlanStats(exec.get());
+
+        if (group.empty()) {
             break;
         }
-        invariant(PlanExecutor::ADVANCED == state);
 
+        exec->saveState();
+
+        bool isRetry = false;
         writeConflictRetry(opCtx, "delete range", nss.ns(), [&] {
+            // Whatever caused the write conflict may have deleted some of the documents already.
+            const bool checkExists = std::exchange(isRetry, true);
+
             WriteUnitOfWork wuow(opCtx);
-            if (saver) {
-                saver->goingToDelete(obj).transitional_ignore();
+            for (const auto& rloc : group) {
+                Snapshotted<BSONObj> unused;
+                if (checkExists && !collection->findDoc(opCtx, rloc, &unused)) {
+                    continue;
+                }
+                collection->deleteDocument(opCtx, kUninitializedStmtId, rloc, nullptr, true);
             }
-            collection->deleteDocument(opCtx, kUninitializedStmtId, rloc, nullptr, true);
             wuow.commit();
         });
-    } while (++numDeleted < maxToDelete);
+
+        numDeleted += group.size();
+
+        if (!exhausted) {
+            uassertStatusOK(exec->restoreState());
+        }
+    }
 
     return numDeleted;
 }
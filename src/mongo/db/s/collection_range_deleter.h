@@ -153,6 +153,10 @@ public:
      * watchers of ranges as they are done being deleted. It performs its own collection locking, so
      * it must be called without locks.
      *
+     * A batch of deletions is only waited for to become majority committed if replication lags by
+     * more than rangeDeleterMaxReplicationLagSecs. Watchers of a range are always notified only
+     * after all of its deletions are majority committed.
+     *
      * If it should be scheduled to run again because there might be more documents to delete,
      * returns the time to begin, or boost::none otherwise.
      *
@@ -216,6 +216,30 @@ TEST_F(CollectionRangeDeleterTest, MultipleDocumentsInOneRangeToClean) {
     ASSERT_EQUALS(0ULL, dbclient.count(kAdminSysVer.ns(), BSON(kPattern << "startRangeDeletion")));
 }
 
+// Tests that a batch spanning several write units of work deletes exactly the documents in range.
+TEST_F(CollectionRangeDeleterTest, BatchLargerThanWriteUnitOfWork) {
+    CollectionRangeDeleter rangeDeleter;
+    DBDirectClient dbclient(operationContext());
+    for (int i = 0; i < 300; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kPattern << i));
+    }
+
+    std::list<Deletion> ranges;
+    auto deletion = Deletion{ChunkRange(BSON(kPattern << 0), BSON(kPattern << 250)), Date_t{}};
+    ranges.emplace_back(std::move(deletion));
+    auto when = rangeDeleter.add(std::move(ranges));
+    ASSERT(when && *when == Date_t{});
+
+    ASSERT_TRUE(next(rangeDeleter, 200));
+    ASSERT_EQUALS(100ULL, dbclient.count(kNss.toString(), BSONObj()));
+    ASSERT_TRUE(next(rangeDeleter, 200));
+    ASSERT_EQUALS(50ULL, dbclient.count(kNss.toString(), BSONObj()));
+    ASSERT_TRUE(next(rangeDeleter, 200));
+    ASSERT_TRUE(rangeDeleter.isEmpty());
+    ASSERT_FALSE(next(rangeDeleter, 200));
+    ASSERT_EQUALS(50ULL, dbclient.count(kNss.toString(), BSON(kPattern << GTE << 250)));
+}
+
 // Tests the case that there are multiple documents within a range to clean, and the range deleter
 // has a max deletion rate of one document per run.
 TEST_F(CollectionRangeDeleterTest, MultipleCleanupNextRangeCalls) {
@@ -128,10 +128,22 @@ private:
     }
 };
 
+class ConfigSvrBalancerDryRunCommand : public ConfigSvrBalancerControlCommand {
+public:
+    ConfigSvrBalancerDryRunCommand()
+        : ConfigSvrBalancerControlCommand("_configsvrBalancerDryRun") {}
+
+private:
+    void _run(OperationContext* opCtx, BSONObjBuilder* result) override {
+        Balancer::get(opCtx)->reportDryRun(opCtx, result);
+    }
+};
+
 MONGO_INITIALIZER(ClusterBalancerControlCommands)(InitializerContext* context) {
     new ConfigSvrBalancerStartCommand();
     new ConfigSvrBalancerStopCommand();
     new ConfigSvrBalancerStatusCommand();
+    new ConfigSvrBalancerDryRunCommand();
 
     return Status::OK();
 }
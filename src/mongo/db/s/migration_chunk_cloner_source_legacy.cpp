@@ -44,6 +44,7 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/s/start_chunk_clone_request.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
@@ -67,6 +68,17 @@ const char kRecvChunkAbort[] = "_recvChunkAbort";
 
 const int kMaxObjectPerChunk{250000};
 
+// Chunks are only split into multiple clone streams if each stream would carry at least this many
+// documents, so that small migrations do not pay for the extra scans and connections
+const long long kMinDocumentsPerCloneStream{1000};
+
+// Upper bound on the number of shard key index entries retained while counting the chunk, from
+// which the boundaries of the clone streams are picked
+const size_t kMaxCloneStreamBoundarySamples{64};
+
+// Maximum number of concurrent streams through which the documents of a chunk are cloned
+MONGO_EXPORT_SERVER_PARAMETER(migrationCloneStreams, int, 4);
+
 bool isInRange(const BSONObj& obj,
                const BSONObj& min,
                const BSONObj& max,
@@ -86,45 +98,6 @@ BSONObj createRequestWithSessionId(StringData commandName,
 
 }  // namespace
 
-/**
- * Used to receive invalidation notifications from operations, which delete documents.
- */
-class DeleteNotificationStage final : public PlanStage {
-public:
-    DeleteNotificationStage(MigrationChunkClonerSourceLegacy* cloner, OperationContext* opCtx)
-        : PlanStage("SHARDING_NOTIFY_DELETE", opCtx), _cloner(cloner) {}
-
-    void doInvalidate(OperationContext* opCtx, const RecordId& dl, InvalidationType type) override {
-        if (type == INVALIDATION_DELETION) {
-            stdx::lock_guard<stdx::mutex> sl(_cloner->_mutex);
-            _cloner->_cloneLocs.erase(dl);
-        }
-    }
-
-    StageState doWork(WorkingSetID* out) override {
-        MONGO_UNREACHABLE;
-    }
-
-    bool isEOF() override {
-        MONGO_UNREACHABLE;
-    }
-
-    std::unique_ptr<PlanStageStats> getStats() override {
-        MONGO_UNREACHABLE;
-    }
-
-    SpecificStats* getSpecificStats() const override {
-        MONGO_UNREACHABLE;
-    }
-
-    StageType stageType() const override {
-        return STAGE_NOTIFY_DELETE;
-    }
-
-private:
-    MigrationChunkClonerSourceLegacy* const _cloner;
-};
-
 /**
  * Used to commit work for LogOpForSharding. Used to keep track of changes in documents that are
  * part of a chunk being migrated.
@@ -197,7 +170,9 @@ MigrationChunkClonerSourceLegacy::MigrationChunkClonerSourceLegacy(MoveChunkRequ
 
 MigrationChunkClonerSourceLegacy::~MigrationChunkClonerSourceLegacy() {
     invariant(_state == kDone);
-    invariant(!_deleteNotifyExec);
+    for (const auto& stream : _cloneStreams) {
+        invariant(!stream.exec);
+    }
 }
 
 Status MigrationChunkClonerSourceLegacy::startClone(OperationContext* opCtx) {
@@ -206,10 +181,10 @@ Status MigrationChunkClonerSourceLegacy::startClone(OperationContext* opCtx) {
 
     _sessionCatalogSource.init(opCtx);
 
-    // Load the ids of the currently available documents
-    auto storeCurrentLocsStatus = _storeCurrentLocs(opCtx);
-    if (!storeCurrentLocsStatus.isOK()) {
-        return storeCurrentLocsStatus;
+    // Count the currently available documents and partition them into clone streams
+    auto initCloneStreamsStatus = _initCloneStreams(opCtx);
+    if (!initCloneStreamsStatus.isOK()) {
+        return initCloneStreamsStatus;
     }
 
     // Prime up the session migration source if there are oplog entries to migrate.
@@ -226,7 +201,8 @@ Status MigrationChunkClonerSourceLegacy::startClone(OperationContext* opCtx) {
                                             _args.getMinKey(),
                                             _args.getMaxKey(),
                                             _shardKeyPattern.toBSON(),
-                                            _args.getSecondaryThrottle());
+                                            _args.getSecondaryThrottle(),
+                                            getNumCloneStreams());
 
     auto startChunkCloneResponseStatus = _callRecipient(cmdBuilder.obj());
     if (!startChunkCloneResponseStatus.isOK()) {
@@ -272,18 +248,20 @@ Status MigrationChunkClonerSourceLegacy::awaitUntilCriticalSectionIsAppropriate(
 
         stdx::lock_guard<stdx::mutex> sl(_mutex);
 
-        const std::size_t cloneLocsRemaining = _cloneLocs.size();
+        const std::size_t cloneStreamsRemaining = _cloneStreams.size() - _numCloneStreamsExhausted;
 
         log() << "moveChunk data transfer progress: " << redact(res) << " mem used: " << _memoryUsed
-              << " documents remaining to clone: " << cloneLocsRemaining;
+              << " documents remaining to clone: "
+              << std::max(0LL, _numRecordsToClone - _numRecordsCloned)
+              << " clone streams remaining: " << cloneStreamsRemaining;
 
         if (res["state"].String() == "steady") {
-            if (cloneLocsRemaining != 0) {
+            if (cloneStreamsRemaining != 0) {
                 return {ErrorCodes::OperationIncomplete,
                         str::stream() << "Unable to enter critical section because the recipient "
                                          "shard thinks all data is cloned while there are still "
-                                      << cloneLocsRemaining
-                                      << " documents remaining"};
+                                      << cloneStreamsRemaining
+                                      << " clone streams remaining"};
             }
 
             return Status::OK();
@@ -448,55 +426,146 @@ void MigrationChunkClonerSourceLegacy::onDeleteOp(OperationContext* opCtx,
 uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
     stdx::lock_guard<stdx::mutex> sl(_mutex);
 
+    const long long recordsRemaining = std::max(0LL, _numRecordsToClone - _numRecordsCloned);
     return std::min(static_cast<uint64_t>(BSONObjMaxUserSize),
-                    _averageObjectSizeForCloneLocs * _cloneLocs.size());
+                    _averageObjectSizeForCloneLocs * static_cast<uint64_t>(recordsRemaining));
+}
+
+int MigrationChunkClonerSourceLegacy::getNumCloneStreams() {
+    stdx::lock_guard<stdx::mutex> sl(_mutex);
+    return static_cast<int>(_cloneStreams.size());
 }
 
 Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
                                                         Collection* collection,
                                                         BSONArrayBuilder* arrBuilder) {
+    // Recipients which do not know about clone streams drain them one after the other. A stream
+    // which is not exhausted always contributes at least one document to an empty batch, so an
+    // empty result still means that there is no more initial clone data.
+    for (int stream = 0; stream < getNumCloneStreams(); ++stream) {
+        const int arrSizeBefore = arrBuilder->arrSize();
+
+        Status status = nextCloneBatch(opCtx, collection, stream, arrBuilder);
+        if (!status.isOK()) {
+            return status;
+        }
+
+        if (arrBuilder->arrSize() > arrSizeBefore) {
+            break;
+        }
+    }
+
+    return Status::OK();
+}
+
+Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
+                                                        Collection* collection,
+                                                        int streamIndex,
+                                                        BSONArrayBuilder* arrBuilder) {
     dassert(opCtx->lockState()->isCollectionLockedForMode(_args.getNss().ns(), MODE_IS));
 
+    CloneStream* stream;
+
+    {
+        stdx::lock_guard<stdx::mutex> sl(_mutex);
+
+        if (_state == kDone) {
+            return {ErrorCodes::IllegalOperation, "The migration was cancelled"};
+        }
+
+        if (streamIndex < 0 || static_cast<size_t>(streamIndex) >= _cloneStreams.size()) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "Clone stream " << streamIndex << " does not exist, there are "
+                                  << _cloneStreams.size()
+                                  << " clone streams"};
+        }
+
+        stream = &_cloneStreams[streamIndex];
+        if (stream->exhausted) {
+            return Status::OK();
+        }
+
+        if (!stream->exec) {
+            return {ErrorCodes::OperationFailed,
+                    str::stream() << "Clone stream " << streamIndex
+                                  << " failed during a previous batch"};
+        }
+
+        if (stream->inUse) {
+            return {ErrorCodes::ConflictingOperationInProgress,
+                    str::stream() << "Clone stream " << streamIndex
+                                  << " is already being read by another operation"};
+        }
+
+        stream->inUse = true;
+    }
+
+    // The scan is used outside of the mutex so that onInsertOp/onUpdateOp/onDeleteOp and the
+    // other clone streams are not blocked while documents are being fetched
+    PlanExecutor* const exec = stream->exec.get();
+
     ElapsedTracker tracker(opCtx->getServiceContext()->getFastClockSource(),
                            internalQueryExecYieldIterations.load(),
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
-    stdx::lock_guard<stdx::mutex> sl(_mutex);
-
-    std::set<RecordId>::iterator it;
+    const int arrSizeBefore = arrBuilder->arrSize();
+    bool reachedEOF = false;
 
-    for (it = _cloneLocs.begin(); it != _cloneLocs.end(); ++it) {
-        // We must always make progress in this method by at least one document because empty return
-        // indicates there is no more initial clone data.
-        if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
-            break;
-        }
+    exec->reattachToOperationContext(opCtx);
+    Status status = exec->restoreState();
 
-        Snapshotted<BSONObj> doc;
-        if (collection->findDoc(opCtx, *it, &doc)) {
+    if (status.isOK()) {
+        BSONObj obj;
+        PlanExecutor::ExecState state;
+        while (PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
             // Use the builder size instead of accumulating the document sizes directly so that we
             // take into consideration the overhead of BSONArray indices.
             if (arrBuilder->arrSize() &&
-                (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
+                (arrBuilder->len() + obj.objsize() + 1024) > BSONObjMaxUserSize) {
+                exec->enqueue(obj);
                 break;
             }
 
-            arrBuilder->append(doc.value());
+            arrBuilder->append(obj);
+
+            // We must always make progress in this method by at least one document because empty
+            // return indicates there is no more initial clone data.
+            if (tracker.intervalHasElapsed()) {
+                break;
+            }
+        }
+
+        if (PlanExecutor::DEAD == state || PlanExecutor::FAILURE == state) {
+            status = {ErrorCodes::OperationFailed,
+                      str::stream() << "Executor error while cloning documents of chunk: "
+                                    << WorkingSetCommon::toStatusString(obj)};
         }
+
+        reachedEOF = (PlanExecutor::IS_EOF == state);
     }
 
-    _cloneLocs.erase(_cloneLocs.begin(), it);
+    stdx::lock_guard<stdx::mutex> sl(_mutex);
+
+    stream->inUse = false;
+    _numRecordsCloned += arrBuilder->arrSize() - arrSizeBefore;
 
-    // If we have drained all the cloned data, there is no need to keep the delete notify executor
-    // around
-    if (_cloneLocs.empty() && _deleteNotifyExec) {
-        // We have a different OperationContext than when we created the PlanExecutor, so need to
-        // manually destroy it ourselves.
-        _deleteNotifyExec->dispose(opCtx, collection->getCursorManager());
-        _deleteNotifyExec.reset();
+    if (reachedEOF) {
+        stream->exhausted = true;
+        _numCloneStreamsExhausted++;
     }
 
-    return Status::OK();
+    // If the stream has been drained, cannot be resumed or the migration was cancelled while this
+    // batch was being produced, there is no need to keep the executor around. We have a different
+    // OperationContext than when we created the PlanExecutor, so need to manually destroy it
+    // ourselves.
+    if (reachedEOF || !status.isOK() || _state == kDone) {
+        _disposeCloneStream(sl, opCtx, collection->getCursorManager(), stream);
+    } else {
+        exec->saveState();
+        exec->detachFromOperationContext();
+    }
+
+    return status;
 }
 
 Status MigrationChunkClonerSourceLegacy::nextModsBatch(OperationContext* opCtx,
@@ -507,7 +576,7 @@ Status MigrationChunkClonerSourceLegacy::nextModsBatch(OperationContext* opCtx,
     stdx::lock_guard<stdx::mutex> sl(_mutex);
 
     // All clone data must have been drained before starting to fetch the incremental changes
-    invariant(_cloneLocs.empty());
+    invariant(_numCloneStreamsExhausted == _cloneStreams.size());
 
     long long docSizeAccumulator = 0;
 
@@ -525,17 +594,36 @@ void MigrationChunkClonerSourceLegacy::_cleanup(OperationContext* opCtx) {
         _state = kDone;
         _reload.clear();
         _deleted.clear();
+
+        if (std::none_of(_cloneStreams.begin(),
+                         _cloneStreams.end(),
+                         [](const CloneStream& stream) { return bool(stream.exec); })) {
+            return;
+        }
     }
 
-    if (_deleteNotifyExec) {
-        AutoGetCollection autoColl(opCtx, _args.getNss(), MODE_IS);
-        const auto cursorManager =
-            autoColl.getCollection() ? autoColl.getCollection()->getCursorManager() : nullptr;
-        _deleteNotifyExec->dispose(opCtx, cursorManager);
-        _deleteNotifyExec.reset();
+    AutoGetCollection autoColl(opCtx, _args.getNss(), MODE_IS);
+    const auto cursorManager =
+        autoColl.getCollection() ? autoColl.getCollection()->getCursorManager() : nullptr;
+
+    // Streams which are in use are disposed of by the batch, which is reading them, as soon as it
+    // completes
+    stdx::lock_guard<stdx::mutex> sl(_mutex);
+    for (auto& stream : _cloneStreams) {
+        if (stream.exec && !stream.inUse) {
+            _disposeCloneStream(sl, opCtx, cursorManager, &stream);
+        }
     }
 }
 
+void MigrationChunkClonerSourceLegacy::_disposeCloneStream(WithLock,
+                                                           OperationContext* opCtx,
+                                                           CursorManager* cursorManager,
+                                                           CloneStream* stream) {
+    stream->exec->dispose(opCtx, cursorManager);
+    stream->exec.reset();
+}
+
 StatusWith<BSONObj> MigrationChunkClonerSourceLegacy::_callRecipient(const BSONObj& cmdObj) {
     executor::RemoteCommandResponse responseStatus(
         Status{ErrorCodes::InternalError, "Uninitialized value"});
@@ -566,7 +654,7 @@ StatusWith<BSONObj> MigrationChunkClonerSourceLegacy::_callRecipient(const BSONO
     return responseStatus.data.getOwned();
 }
 
-Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opCtx) {
+Status MigrationChunkClonerSourceLegacy::_initCloneStreams(OperationContext* opCtx) {
     AutoGetCollection autoColl(opCtx, _args.getNss(), MODE_IS);
 
     Collection* const collection = autoColl.getCollection();
@@ -584,23 +672,10 @@ Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opC
     if (!idx) {
         return {ErrorCodes::IndexNotFound,
                 str::stream() << "can't find index with prefix " << _shardKeyPattern.toBSON()
-                              << " in storeCurrentLocs for "
+                              << " in initCloneStreams for "
                               << _args.getNss().ns()};
     }
 
-    // Install the stage, which will listen for notifications on the collection
-    auto statusWithDeleteNotificationPlanExecutor =
-        PlanExecutor::make(opCtx,
-                           stdx::make_unique<WorkingSet>(),
-                           stdx::make_unique<DeleteNotificationStage>(this, opCtx),
-                           collection,
-                           PlanExecutor::YIELD_MANUAL);
-    if (!statusWithDeleteNotificationPlanExecutor.isOK()) {
-        return statusWithDeleteNotificationPlanExecutor.getStatus();
-    }
-
-    _deleteNotifyExec = std::move(statusWithDeleteNotificationPlanExecutor.getValue());
-
     // Assume both min and max non-empty, append MinKey's to make them fit chosen index
     const KeyPattern kp(idx->keyPattern());
 
@@ -639,18 +714,30 @@ Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opC
     bool isLargeChunk = false;
     unsigned long long recCount = 0;
 
+    // Every 'sampleInterval'th index key is retained as a candidate clone stream boundary. Whenever
+    // the sample grows too large, every other key is dropped and the interval doubles, so the
+    // retained keys stay evenly spread over the chunk regardless of its size.
+    std::vector<BSONObj> boundarySamples;
+    unsigned long long sampleInterval = 1;
+
     BSONObj obj;
-    RecordId recordId;
     PlanExecutor::ExecState state;
-    while (PlanExecutor::ADVANCED == (state = exec->getNext(&obj, &recordId))) {
+    while (PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
         Status interruptStatus = opCtx->checkForInterruptNoAssert();
         if (!interruptStatus.isOK()) {
             return interruptStatus;
         }
 
-        if (!isLargeChunk) {
-            stdx::lock_guard<stdx::mutex> lk(_mutex);
-            _cloneLocs.insert(recordId);
+        if (recCount % sampleInterval == 0) {
+            boundarySamples.push_back(obj.getOwned());
+
+            if (boundarySamples.size() > 2 * kMaxCloneStreamBoundarySamples) {
+                for (size_t i = 0; 2 * i < boundarySamples.size(); ++i) {
+                    boundarySamples[i] = std::move(boundarySamples[2 * i]);
+                }
+                boundarySamples.resize((boundarySamples.size() + 1) / 2);
+                sampleInterval *= 2;
+            }
         }
 
         if (++recCount > maxRecsWhenFull) {
@@ -688,7 +775,48 @@ Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opC
                           << _args.getMaxKey()};
     }
 
+    // Pick the stream boundaries evenly from the sampled keys. Keys equal to the previous boundary
+    // are skipped, because the streams must cover disjoint, non-empty ranges of the index.
+    const long long maxStreams = std::max(
+        1LL,
+        std::min(static_cast<long long>(migrationCloneStreams.load()),
+                 static_cast<long long>(recCount) / kMinDocumentsPerCloneStream));
+
+    std::vector<BSONObj> boundaries{min};
+    for (long long i = 1; i < maxStreams; ++i) {
+        const BSONObj& candidate = boundarySamples[i * boundarySamples.size() / maxStreams];
+        if (candidate.woCompare(boundaries.back()) > 0 && candidate.woCompare(max) < 0) {
+            boundaries.push_back(candidate);
+        }
+    }
+    boundaries.push_back(max);
+
+    std::vector<CloneStream> cloneStreams(boundaries.size() - 1);
+    for (size_t i = 0; i < cloneStreams.size(); ++i) {
+        // The documents are fetched by the recipient-driven _migrateClone commands, each of which
+        // runs on its own OperationContext, so the scans are detached between batches. Changes to
+        // the base data made between batches are already being queued and will migrate in the
+        // 'transferMods' stage.
+        cloneStreams[i].exec = InternalPlanner::indexScan(opCtx,
+                                                          collection,
+                                                          idx,
+                                                          boundaries[i],
+                                                          boundaries[i + 1],
+                                                          BoundInclusion::kIncludeStartKeyOnly,
+                                                          PlanExecutor::YIELD_MANUAL,
+                                                          InternalPlanner::FORWARD,
+                                                          InternalPlanner::IXSCAN_FETCH);
+        cloneStreams[i].exec->saveState();
+        cloneStreams[i].exec->detachFromOperationContext();
+    }
+
+    log() << "Cloning " << recCount << " documents of chunk " << redact(_args.getMinKey())
+          << " -> " << redact(_args.getMaxKey()) << " for " << _args.getNss().ns() << " through "
+          << cloneStreams.size() << " streams";
+
     stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _cloneStreams = std::move(cloneStreams);
+    _numRecordsToClone = recCount;
     _averageObjectSizeForCloneLocs = collectionAverageObjectSize + 12;
 
     return Status::OK();
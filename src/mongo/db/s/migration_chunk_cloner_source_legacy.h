@@ -29,7 +29,7 @@
 #pragma once
 
 #include <list>
-#include <set>
+#include <vector>
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/client/connection_string.h"
@@ -43,6 +43,7 @@
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/net/hostandport.h"
 
 namespace mongo {
@@ -50,8 +51,8 @@ namespace mongo {
 class BSONArrayBuilder;
 class BSONObjBuilder;
 class Collection;
+class CursorManager;
 class Database;
-class RecordId;
 
 class MigrationChunkClonerSourceLegacy final : public MigrationChunkClonerSource {
     MONGO_DISALLOW_COPYING(MigrationChunkClonerSourceLegacy);
@@ -104,6 +105,13 @@ public:
      */
     uint64_t getCloneBatchBufferAllocationSize();
 
+    /**
+     * Returns the number of independent streams into which the initial clone was partitioned. Each
+     * stream covers a disjoint range of the shard key index and can be drained concurrently with
+     * the others through the stream-specific nextCloneBatch overload.
+     */
+    int getNumCloneStreams();
+
     /**
      * Called by the recipient shard. Populates the passed BSONArrayBuilder with a set of documents,
      * which are part of the initial clone sequence.
@@ -122,6 +130,16 @@ public:
                           Collection* collection,
                           BSONArrayBuilder* arrBuilder);
 
+    /**
+     * Same as above, but only returns documents from the clone stream with index 'stream', which
+     * must be less than getNumCloneStreams(). Different streams may be drained concurrently, but
+     * each individual stream may only be served to one caller at a time.
+     */
+    Status nextCloneBatch(OperationContext* opCtx,
+                          Collection* collection,
+                          int stream,
+                          BSONArrayBuilder* arrBuilder);
+
     /**
      * Called by the recipient shard. Transfers the accummulated local mods from source to
      * destination. Must not be called before all cloned objects have been fetched through calls to
@@ -140,12 +158,26 @@ public:
     repl::OpTime nextSessionMigrationBatch(OperationContext* opCtx, BSONArrayBuilder* arrBuilder);
 
 private:
-    friend class DeleteNotificationStage;
     friend class LogOpForShardingHandler;
 
     // Represents the states in which the cloner can be
     enum State { kNew, kCloning, kDone };
 
+    /**
+     * A detached index scan over one sub-range of the migrating chunk. The scan is re-attached to
+     * the calling operation for the duration of each batch, so documents are read in index order
+     * without ever materializing the set of record ids belonging to the chunk.
+     */
+    struct CloneStream {
+        std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
+
+        // Set while a batch is being produced from this stream, outside of the mutex
+        bool inUse{false};
+
+        // Set once the scan has returned all of its documents
+        bool exhausted{false};
+    };
+
     /**
      * Idempotent method, which cleans up any previously initialized state. It is safe to be called
      * at any time, but no methods should be called after it.
@@ -159,12 +191,21 @@ private:
     StatusWith<BSONObj> _callRecipient(const BSONObj& cmdObj);
 
     /**
-     * Get the disklocs that belong to the chunk migrated and sort them in _cloneLocs (to avoid
-     * seeking disk later).
+     * Counts the documents that belong to the migrated chunk, rejecting chunks that are too large,
+     * and partitions the chunk's range of the shard key index into _cloneStreams.
      *
      * Returns OK or any error status otherwise.
      */
-    Status _storeCurrentLocs(OperationContext* opCtx);
+    Status _initCloneStreams(OperationContext* opCtx);
+
+    /**
+     * Disposes of the scan of 'stream'. Must be called with _mutex held and the collection lock
+     * held in at least IS mode.
+     */
+    void _disposeCloneStream(WithLock,
+                             OperationContext* opCtx,
+                             CursorManager* cursorManager,
+                             CloneStream* stream);
 
     /**
      * Insert items from docIdList to a new array with the given fieldName in the given builder. If
@@ -197,10 +238,6 @@ private:
     // The resolved primary of the recipient shard
     const HostAndPort _recipientHost;
 
-    // Registered deletion notifications plan executor, which will listen for document deletions
-    // during the cloning stage
-    std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> _deleteNotifyExec;
-
     SessionCatalogMigrationSource _sessionCatalogSource;
 
     // Protects the entries below
@@ -209,8 +246,16 @@ private:
     // The current state of the cloner
     State _state{kNew};
 
-    // List of record ids that needs to be transferred (initial clone)
-    std::set<RecordId> _cloneLocs;
+    // Scans over disjoint sub-ranges of the chunk, which produce the initial clone
+    std::vector<CloneStream> _cloneStreams;
+
+    // Number of entries in _cloneStreams, which have been fully drained
+    size_t _numCloneStreamsExhausted{0};
+
+    // Number of documents found in the chunk when the clone started and number of documents which
+    // have been handed to the recipient since. Used to estimate the remaining clone work.
+    long long _numRecordsToClone{0};
+    long long _numRecordsCloned{0};
 
     // The estimated average object size during the clone phase. Used for buffer size
     // pre-allocation (initial clone).
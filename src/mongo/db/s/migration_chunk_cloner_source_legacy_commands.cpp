@@ -30,6 +30,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/bson/util/bson_extract.h"
 #include "mongo/db/auth/action_set.h"
 #include "mongo/db/auth/action_type.h"
 #include "mongo/db/auth/authorization_manager.h"
@@ -112,6 +113,8 @@ private:
     MigrationChunkClonerSourceLegacy* _chunkCloner;
 };
 
+const char kStream[] = "stream";
+
 class InitialCloneCommand : public BasicCommand {
 public:
     InitialCloneCommand() : BasicCommand("_migrateClone") {}
@@ -147,6 +150,14 @@ public:
         const MigrationSessionId migrationSessionId(
             uassertStatusOK(MigrationSessionId::extractFromBSON(cmdObj)));
 
+        // Recipients which support clone streams name the stream they are draining
+        boost::optional<int> stream;
+        if (cmdObj.hasField(kStream)) {
+            long long streamValue;
+            uassertStatusOK(bsonExtractIntegerField(cmdObj, kStream, &streamValue));
+            stream = static_cast<int>(streamValue);
+        }
+
         boost::optional<BSONArrayBuilder> arrBuilder;
 
         // Try to maximize on the size of the buffer, which we are returning in order to have less
@@ -162,8 +173,13 @@ public:
 
             arrSizeAtPrevIteration = arrBuilder->arrSize();
 
-            uassertStatusOK(autoCloner.getCloner()->nextCloneBatch(
-                opCtx, autoCloner.getColl(), arrBuilder.get_ptr()));
+            if (stream) {
+                uassertStatusOK(autoCloner.getCloner()->nextCloneBatch(
+                    opCtx, autoCloner.getColl(), *stream, arrBuilder.get_ptr()));
+            } else {
+                uassertStatusOK(autoCloner.getCloner()->nextCloneBatch(
+                    opCtx, autoCloner.getColl(), arrBuilder.get_ptr()));
+            }
         }
 
         invariant(arrBuilder);
@@ -294,6 +294,83 @@ TEST_F(MigrationChunkClonerSourceLegacyTest, CorrectDocumentsFetched) {
     futureCommit.timed_get(kFutureTimeout);
 }
 
+TEST_F(MigrationChunkClonerSourceLegacyTest, LargeChunkIsClonedThroughDisjointStreams) {
+    const int kNumDocs = 5000;
+
+    std::vector<BSONObj> contents;
+    for (int i = 0; i < kNumDocs; ++i) {
+        contents.push_back(createCollectionDocument(i));
+    }
+    contents.push_back(createCollectionDocument(kNumDocs));
+
+    createShardedCollection(contents);
+
+    MigrationChunkClonerSourceLegacy cloner(
+        createMoveChunkRequest(ChunkRange(BSON("X" << 0), BSON("X" << kNumDocs))),
+        kShardKeyPattern,
+        kDonorConnStr,
+        kRecipientConnStr.getServers()[0]);
+
+    {
+        auto futureStartClone = launchAsync([&]() {
+            onCommand([&](const RemoteCommandRequest& request) {
+                ASSERT_EQ(4, request.cmdObj["cloneStreams"].numberInt());
+                return BSON("ok" << true);
+            });
+        });
+
+        ASSERT_OK(cloner.startClone(operationContext()));
+        futureStartClone.timed_get(kFutureTimeout);
+    }
+
+    ASSERT_EQ(4, cloner.getNumCloneStreams());
+
+    {
+        AutoGetCollection autoColl(operationContext(), kNss, MODE_IS);
+
+        std::set<int> clonedIds;
+        for (int stream = 0; stream < cloner.getNumCloneStreams(); ++stream) {
+            int numInStream = 0;
+            int lastId = -1;
+
+            while (true) {
+                BSONArrayBuilder arrBuilder;
+                ASSERT_OK(cloner.nextCloneBatch(
+                    operationContext(), autoColl.getCollection(), stream, &arrBuilder));
+                if (arrBuilder.arrSize() == 0) {
+                    break;
+                }
+
+                for (const auto& elem : arrBuilder.arr()) {
+                    const int id = elem.Obj()["_id"].numberInt();
+                    ASSERT_GT(id, lastId);
+                    ASSERT(clonedIds.insert(id).second);
+                    lastId = id;
+                    numInStream++;
+                }
+            }
+
+            ASSERT_GT(numInStream, 0);
+        }
+
+        ASSERT_EQ(static_cast<size_t>(kNumDocs), clonedIds.size());
+        ASSERT_EQ(0, *clonedIds.begin());
+        ASSERT_EQ(kNumDocs - 1, *clonedIds.rbegin());
+
+        // Recipients which do not know about streams see the clone as complete
+        BSONArrayBuilder arrBuilder;
+        ASSERT_OK(cloner.nextCloneBatch(operationContext(), autoColl.getCollection(), &arrBuilder));
+        ASSERT_EQ(0, arrBuilder.arrSize());
+    }
+
+    auto futureCommit = launchAsync([&]() {
+        onCommand([&](const RemoteCommandRequest& request) { return BSON("ok" << true); });
+    });
+
+    ASSERT_OK(cloner.commitClone(operationContext()));
+    futureCommit.timed_get(kFutureTimeout);
+}
+
 TEST_F(MigrationChunkClonerSourceLegacyTest, CollectionNotFound) {
     MigrationChunkClonerSourceLegacy cloner(
         createMoveChunkRequest(ChunkRange(BSON("X" << 100), BSON("X" << 200))),
@@ -179,11 +179,17 @@ bool opReplicatedEnough(OperationContext* opCtx,
  * Create the migration clone request BSON object to send to the source shard.
  *
  * 'sessionId' unique identifier for this migration.
+ * 'stream' clone stream to read from, if the donor offers more than one.
  */
-BSONObj createMigrateCloneRequest(const NamespaceString& nss, const MigrationSessionId& sessionId) {
+BSONObj createMigrateCloneRequest(const NamespaceString& nss,
+                                  const MigrationSessionId& sessionId,
+                                  boost::optional<int> stream) {
     BSONObjBuilder builder;
     builder.append("_migrateClone", nss.ns());
     sessionId.append(&builder);
+    if (stream) {
+        builder.append("stream", *stream);
+    }
     return builder.obj();
 }
 
@@ -307,7 +313,8 @@ Status MigrationDestinationManager::start(const NamespaceString& nss,
                                           const BSONObj& max,
                                           const BSONObj& shardKeyPattern,
                                           const OID& epoch,
-                                          const WriteConcernOptions& writeConcern) {
+                                          const WriteConcernOptions& writeConcern,
+                                          int numCloneStreams) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     invariant(!_sessionId);
     invariant(!_scopedRegisterReceiveChunk);
@@ -322,6 +329,7 @@ Status MigrationDestinationManager::start(const NamespaceString& nss,
     _min = min;
     _max = max;
     _shardKeyPattern = shardKeyPattern;
+    _numCloneStreams = numCloneStreams;
 
     _chunkMarkedPending = false;
 
@@ -682,83 +690,61 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* opCtx,
 
         _sessionMigration->start(opCtx->getServiceContext());
 
-        const BSONObj migrateCloneRequest = createMigrateCloneRequest(_nss, *_sessionId);
-
         _chunkMarkedPending = true;  // no lock needed, only the migrate thread looks.
 
-        while (true) {
-            BSONObj res;
-            if (!conn->runCommand("admin",
-                                  migrateCloneRequest,
-                                  res)) {  // gets array of objects to copy, in disk order
-                setStateFail(str::stream() << "_migrateClone failed: " << redact(res.toString()));
+        if (_numCloneStreams == 1) {
+            if (!_cloneDocuments(
+                    opCtx, conn.get(), boost::none, min, max, shardKeyPattern, writeConcern)) {
                 conn.done();
                 return;
             }
-
-            BSONObj arr = res["objects"].Obj();
-            int thisTime = 0;
-
-            BSONObjIterator i(arr);
-            while (i.more()) {
-                opCtx->checkForInterrupt();
-
-                if (getState() == ABORT) {
-                    log() << "Migration aborted while copying documents";
-                    return;
-                }
-
-                BSONObj docToClone = i.next().Obj();
-                {
-                    OldClientWriteContext cx(opCtx, _nss.ns());
-
-                    BSONObj localDoc;
-                    if (willOverrideLocalId(opCtx,
-                                            _nss,
-                                            min,
-                                            max,
-                                            shardKeyPattern,
-                                            cx.db(),
-                                            docToClone,
-                                            &localDoc)) {
-                        string errMsg = str::stream() << "cannot migrate chunk, local document "
-                                                      << redact(localDoc)
-                                                      << " has same _id as cloned "
-                                                      << "remote document " << redact(docToClone);
-
-                        warning() << errMsg;
-
-                        // Exception will abort migration cleanly
-                        uasserted(16976, errMsg);
+        } else {
+            // Each stream is drained by its own thread, client and connection, so that fetching
+            // from the donor and inserting locally overlap across streams
+            std::vector<stdx::thread> cloneThreads;
+            for (int stream = 0; stream < _numCloneStreams; ++stream) {
+                cloneThreads.emplace_back([&, stream] {
+                    Client::initThread(
+                        std::string(str::stream() << "migrateCloneThread-" << stream));
+                    auto cloneOpCtx = getGlobalServiceContext()->makeOperationContext(&cc());
+
+                    if (getGlobalAuthorizationManager()->isAuthEnabled()) {
+                        AuthorizationSession::get(cloneOpCtx->getClient())
+                            ->grantInternalAuthorization();
                     }
 
-                    Helpers::upsert(opCtx, _nss.ns(), docToClone, true);
-                }
-                thisTime++;
+                    try {
+                        DisableDocumentValidation cloneValidationDisabler(cloneOpCtx.get());
+                        ScopedDbConnection cloneConn(fromShardConnString);
+                        // A failed stream has still read every reply in full, so its connection
+                        // can go back to the pool either way.
+                        _cloneDocuments(cloneOpCtx.get(),
+                                        cloneConn.get(),
+                                        stream,
+                                        min,
+                                        max,
+                                        shardKeyPattern,
+                                        writeConcern);
+                        cloneConn.done();
+                    } catch (const std::exception& e) {
+                        setStateFail(str::stream() << "migrate failed while cloning stream "
+                                                   << stream << ": " << redact(e.what()));
+                    }
+                });
+            }
 
-                {
-                    stdx::lock_guard<stdx::mutex> statsLock(_mutex);
-                    _numCloned++;
-                    _clonedBytes += docToClone.objsize();
-                }
+            for (auto& cloneThread : cloneThreads) {
+                cloneThread.join();
+            }
 
-                if (writeConcern.shouldWaitForOtherNodes()) {
-                    repl::ReplicationCoordinator::StatusAndDuration replStatus =
-                        repl::getGlobalReplicationCoordinator()->awaitReplication(
-                            opCtx,
-                            repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp(),
-                            writeConcern);
-                    if (replStatus.status.code() == ErrorCodes::WriteConcernFailed) {
-                        warning() << "secondaryThrottle on, but doc insert timed out; "
-                                     "continuing";
-                    } else {
-                        massertStatusOK(replStatus.status);
-                    }
-                }
+            const auto stateAfterClone = getState();
+            if (stateAfterClone == ABORT || stateAfterClone == FAIL) {
+                return;
             }
 
-            if (thisTime == 0)
-                break;
+            // The documents were written by other clients, so make sure the writes are covered by
+            // the optime, which is waited on below before entering the steady state
+            repl::ReplClientInfo::forClient(opCtx->getClient()).setLastOpToSystemLastOpTime(opCtx);
         }
 
         timing.done(3);
@@ -921,6 +907,92 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* opCtx,
     conn.done();
 }
 
+bool MigrationDestinationManager::_cloneDocuments(OperationContext* opCtx,
+                                                  DBClientBase* conn,
+                                                  boost::optional<int> stream,
+                                                  const BSONObj& min,
+                                                  const BSONObj& max,
+                                                  const BSONObj& shardKeyPattern,
+                                                  const WriteConcernOptions& writeConcern) {
+    const BSONObj migrateCloneRequest = createMigrateCloneRequest(_nss, *_sessionId, stream);
+
+    while (true) {
+        BSONObj res;
+        if (!conn->runCommand("admin",
+                              migrateCloneRequest,
+                              res)) {  // gets array of objects to copy, in index order
+            setStateFail(str::stream() << "_migrateClone failed: " << redact(res.toString()));
+            return false;
+        }
+
+        BSONObj arr = res["objects"].Obj();
+        int thisTime = 0;
+
+        BSONObjIterator i(arr);
+        while (i.more()) {
+            opCtx->checkForInterrupt();
+
+            // Another clone stream may have failed, in which case there is no point in continuing
+            const auto state = getState();
+            if (state == ABORT || state == FAIL) {
+                log() << "Migration aborted while copying documents";
+                return false;
+            }
+
+            BSONObj docToClone = i.next().Obj();
+            {
+                OldClientWriteContext cx(opCtx, _nss.ns());
+
+                BSONObj localDoc;
+                if (willOverrideLocalId(opCtx,
+                                        _nss,
+                                        min,
+                                        max,
+                                        shardKeyPattern,
+                                        cx.db(),
+                                        docToClone,
+                                        &localDoc)) {
+                    string errMsg = str::stream() << "cannot migrate chunk, local document "
+                                                  << redact(localDoc)
+                                                  << " has same _id as cloned "
+                                                  << "remote document " << redact(docToClone);
+
+                    warning() << errMsg;
+
+                    // Exception will abort migration cleanly
+                    uasserted(16976, errMsg);
+                }
+
+                Helpers::upsert(opCtx, _nss.ns(), docToClone, true);
+            }
+            thisTime++;
+
+            {
+                stdx::lock_guard<stdx::mutex> statsLock(_mutex);
+                _numCloned++;
+                _clonedBytes += docToClone.objsize();
+            }
+
+            if (writeConcern.shouldWaitForOtherNodes()) {
+                repl::ReplicationCoordinator::StatusAndDuration replStatus =
+                    repl::getGlobalReplicationCoordinator()->awaitReplication(
+                        opCtx,
+                        repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp(),
+                        writeConcern);
+                if (replStatus.status.code() == ErrorCodes::WriteConcernFailed) {
+                    warning() << "secondaryThrottle on, but doc insert timed out; "
+                                 "continuing";
+                } else {
+                    massertStatusOK(replStatus.status);
+                }
+            }
+        }
+
+        if (thisTime == 0)
+            return true;
+    }
+}
+
 bool MigrationDestinationManager::_applyMigrateOp(OperationContext* opCtx,
                                                   const NamespaceString& nss,
                                                   const BSONObj& min,
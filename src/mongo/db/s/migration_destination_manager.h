@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <string>
 
 #include "mongo/base/disallow_copying.h"
@@ -49,6 +50,7 @@
 
 namespace mongo {
 
+class DBClientBase;
 class OperationContext;
 class Status;
 struct WriteConcernOptions;
@@ -96,7 +98,8 @@ public:
     BSONObj getMigrationStatusReport();
 
     /**
-     * Returns OK if migration started successfully.
+     * Returns OK if migration started successfully. The initial clone is pulled from the donor
+     * through 'numCloneStreams' concurrent streams.
      */
     Status start(const NamespaceString& nss,
                  ScopedRegisterReceiveChunk scopedRegisterReceiveChunk,
@@ -108,7 +111,8 @@ public:
                  const BSONObj& max,
                  const BSONObj& shardKeyPattern,
                  const OID& epoch,
-                 const WriteConcernOptions& writeConcern);
+                 const WriteConcernOptions& writeConcern,
+                 int numCloneStreams);
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
@@ -143,6 +147,20 @@ private:
                         const OID& epoch,
                         const WriteConcernOptions& writeConcern);
 
+    /**
+     * Pulls documents from the donor through repeated _migrateClone calls on 'conn' and upserts
+     * them, until the donor reports that there are no more. If 'stream' is set, only that clone
+     * stream is drained. Returns false if the migration failed or was aborted, in which case the
+     * state has already been set accordingly.
+     */
+    bool _cloneDocuments(OperationContext* opCtx,
+                         DBClientBase* conn,
+                         boost::optional<int> stream,
+                         const BSONObj& min,
+                         const BSONObj& max,
+                         const BSONObj& shardKeyPattern,
+                         const WriteConcernOptions& writeConcern);
+
     bool _applyMigrateOp(OperationContext* opCtx,
                          const NamespaceString& ns,
                          const BSONObj& min,
@@ -201,6 +219,9 @@ private:
     BSONObj _max;
     BSONObj _shardKeyPattern;
 
+    // Number of clone streams offered by the donor
+    int _numCloneStreams{1};
+
     // Set to true once we have accepted the chunk as pending into our metadata. Used so that on
     // failure we can perform the appropriate cleanup.
     bool _chunkMarkedPending{false};
@@ -35,6 +35,7 @@
 #include <string>
 #include <vector>
 
+#include "mongo/bson/util/bson_extract.h"
 #include "mongo/db/auth/action_set.h"
 #include "mongo/db/auth/action_type.h"
 #include "mongo/db/auth/authorization_manager.h"
@@ -133,6 +134,14 @@ public:
         const MigrationSessionId migrationSessionId(
             uassertStatusOK(MigrationSessionId::extractFromBSON(cmdObj)));
 
+        // Donors which predate clone streams do not send the field and serve a single stream
+        long long numCloneStreams;
+        uassertStatusOK(
+            bsonExtractIntegerFieldWithDefault(cmdObj, "cloneStreams", 1, &numCloneStreams));
+        uassert(ErrorCodes::BadValue,
+                "The number of clone streams must be positive",
+                numCloneStreams >= 1);
+
         // Ensure this shard is not currently receiving or donating any chunks.
         auto scopedRegisterReceiveChunk(
             uassertStatusOK(shardingState->registerReceiveChunk(nss, chunkRange, fromShard)));
@@ -148,7 +157,8 @@ public:
             chunkRange.getMax(),
             shardKeyPattern,
             currentVersion.epoch(),
-            writeConcern));
+            writeConcern,
+            static_cast<int>(numCloneStreams)));
 
         result.appendBool("started", true);
         return true;
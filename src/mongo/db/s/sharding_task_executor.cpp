@@ -109,10 +109,27 @@ StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleWorkAt(
 
 StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleRemoteCommand(
     const RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb) {
+    return _scheduleRemoteCommand(request, cb, false);
+}
+
+StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleRemoteCommandInline(
+    const RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb) {
+    return _scheduleRemoteCommand(request, cb, true);
+}
+
+StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::_scheduleRemoteCommand(
+    const RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb, bool runInline) {
+    // The metadata bookkeeping done by the callback wrapper below only updates in-memory state
+    // under short-lived locks, so it is as safe to run inline as the caller's callback.
+    const auto schedule = [&](const RemoteCommandRequest& request,
+                              const RemoteCommandCallbackFn& cb) {
+        return runInline ? _executor->scheduleRemoteCommandInline(request, cb)
+                         : _executor->scheduleRemoteCommand(request, cb);
+    };
 
     // schedule the user's callback if there is not opCtx
     if (!request.opCtx) {
-        return _executor->scheduleRemoteCommand(request, cb);
+        return schedule(request, cb);
     }
 
     boost::optional<RemoteCommandRequest> newRequest;
@@ -186,7 +203,7 @@ StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleRemoteCom
         }
     };
 
-    return _executor->scheduleRemoteCommand(newRequest ? *newRequest : request, shardingCb);
+    return schedule(newRequest ? *newRequest : request, shardingCb);
 }
 
 void ShardingTaskExecutor::cancel(const CallbackHandle& cbHandle) {
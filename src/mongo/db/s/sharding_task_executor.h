@@ -67,12 +67,18 @@ public:
     StatusWith<CallbackHandle> scheduleWorkAt(Date_t when, const CallbackFn& work) override;
     StatusWith<CallbackHandle> scheduleRemoteCommand(const RemoteCommandRequest& request,
                                                      const RemoteCommandCallbackFn& cb) override;
+    StatusWith<CallbackHandle> scheduleRemoteCommandInline(
+        const RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb) override;
     void cancel(const CallbackHandle& cbHandle) override;
     void wait(const CallbackHandle& cbHandle) override;
 
     void appendConnectionStats(ConnectionPoolStats* stats) const override;
 
 private:
+    StatusWith<CallbackHandle> _scheduleRemoteCommand(const RemoteCommandRequest& request,
+                                                      const RemoteCommandCallbackFn& cb,
+                                                      bool runInline);
+
     std::unique_ptr<ThreadPoolTaskExecutor> _executor;
 };
 
@@ -43,6 +43,8 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -50,10 +52,103 @@ namespace {
 
 const int kMaxObjectPerChunk{250000};
 
+// Number of documents to sample when estimating split points. Sampling is only attempted on
+// collections with more than twice this many documents. Setting it to 0 disables sampling.
+MONGO_EXPORT_SERVER_PARAMETER(splitVectorSampleSize, int, 2000);
+
+// Minimum number of sampled documents that must fall into each resulting chunk for the estimated
+// split points to be used instead of those from a scan of the index.
+MONGO_EXPORT_SERVER_PARAMETER(splitVectorMinSamplesPerChunk, int, 10);
+
 BSONObj prettyKey(const BSONObj& keyPattern, const BSONObj& key) {
     return key.replaceFieldNames(keyPattern).clientReadable();
 }
 
+/**
+ * Estimates the points at which a scan of the shard key index over [min, max) would split the
+ * range into chunks of 'keyCount' + 1 keys, using the shard keys of a random sample of the
+ * collection's documents. Returns boost::none if the record store cannot produce random cursors or
+ * if too few of the sampled documents fall into the range for the estimate to be trusted.
+ */
+boost::optional<std::vector<BSONObj>> sampleSplitKeys(OperationContext* opCtx,
+                                                      Collection* collection,
+                                                      const BSONObj& keyPattern,
+                                                      const BSONObj& min,
+                                                      const BSONObj& max,
+                                                      long long recCount,
+                                                      long long keyCount,
+                                                      boost::optional<long long> maxSplitPoints,
+                                                      SplitVectorStats* stats) {
+    const long long sampleSize = splitVectorSampleSize.load();
+    if (sampleSize <= 0 || recCount <= 2 * sampleSize) {
+        return boost::none;
+    }
+
+    auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return boost::none;
+    }
+
+    std::vector<BSONObj> samples;
+    long long numSampled = 0;
+    while (numSampled < sampleSize) {
+        if (numSampled % 128 == 0) {
+            opCtx->checkForInterrupt();
+        }
+
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        numSampled++;
+
+        BSONObj key = dotted_path_support::extractElementsBasedOnTemplate(
+            record->data.toBson(), keyPattern, true);
+        if ((min.isEmpty() || key.woCompare(min) >= 0) &&
+            (max.isEmpty() || key.woCompare(max) < 0)) {
+            samples.push_back(key.getOwned());
+        }
+    }
+    stats->docsSampled += numSampled;
+
+    if (samples.empty()) {
+        return boost::none;
+    }
+
+    // Scale the sample up to the estimated number of keys in the range and split it the way a full
+    // scan would, i.e. at every (keyCount + 1)-th key.
+    const long long numInRange = samples.size();
+    const double keysPerSample = static_cast<double>(recCount) / numSampled;
+    const long long estimatedKeys = static_cast<long long>(numInRange * keysPerSample);
+    long long numSplitPoints = std::max(0LL, (estimatedKeys - 1) / (keyCount + 1));
+    if (maxSplitPoints && maxSplitPoints.get()) {
+        numSplitPoints = std::min(numSplitPoints, maxSplitPoints.get());
+    }
+
+    if (numInRange < splitVectorMinSamplesPerChunk.load() * (numSplitPoints + 1)) {
+        return boost::none;
+    }
+
+    std::sort(samples.begin(), samples.end(), SimpleBSONObjComparator::kInstance.makeLessThan());
+
+    // As with the index scan, never split at the lowest key of the range or twice at the same key.
+    std::vector<BSONObj> splitKeys;
+    for (long long i = 1; i <= numSplitPoints; i++) {
+        const auto pos = std::min(numInRange - 1,
+                                  static_cast<long long>(i * (keyCount + 1) / keysPerSample));
+        const BSONObj& key = samples[pos];
+        if (key.woCompare(samples.front()) == 0 ||
+            (!splitKeys.empty() && key.woCompare(splitKeys.back()) == 0)) {
+            continue;
+        }
+        splitKeys.push_back(key);
+        LOG(4) << "picked a split key from the sample: " << redact(key);
+    }
+
+    stats->usedSampling = true;
+    return splitKeys;
+}
+
 }  // namespace
 
 StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
@@ -65,9 +160,16 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
                                              boost::optional<long long> maxSplitPoints,
                                              boost::optional<long long> maxChunkObjects,
                                              boost::optional<long long> maxChunkSize,
-                                             boost::optional<long long> maxChunkSizeBytes) {
+                                             boost::optional<long long> maxChunkSizeBytes,
+                                             bool allowSampling,
+                                             SplitVectorStats* stats) {
     std::vector<BSONObj> splitKeys;
 
+    SplitVectorStats unusedStats;
+    if (!stats) {
+        stats = &unusedStats;
+    }
+
     // Always have a default value for maxChunkObjects
     if (!maxChunkObjects) {
         maxChunkObjects = kMaxObjectPerChunk;
@@ -151,6 +253,21 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
             keyCount = maxChunkObjects.get();
         }
 
+        // Chunks of hashed shard keys are bounded by the hashes stored in the index rather than by
+        // values found in the documents, so they can only be split from a scan of the index.
+        if (allowSampling && !force && !KeyPattern::isHashedKeyPattern(keyPattern)) {
+            Timer sampleTimer;
+            auto sampledKeys = sampleSplitKeys(
+                opCtx, collection, keyPattern, min, max, recCount, keyCount, maxSplitPoints, stats);
+            if (sampledKeys) {
+                LOG(1) << "estimated " << sampledKeys->size() << " split points for chunk "
+                       << nss.toString() << " " << redact(minKey) << " -->> " << redact(maxKey)
+                       << " from " << stats->docsSampled << " sampled documents in "
+                       << sampleTimer.millis() << "ms";
+                return std::move(*sampledKeys);
+            }
+        }
+
         //
         // Traverse the index and add the keyCount-th key to the result vector. If that key
         // appeared in the vector before, we omit it. The invariant here is that all the
@@ -187,6 +304,7 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
         while (1) {
             while (PlanExecutor::ADVANCED == state) {
                 currCount++;
+                stats->keysExamined++;
 
                 if (currCount > keyCount && !force) {
                     currKey = dotted_path_support::extractElementsBasedOnTemplate(
@@ -39,6 +39,20 @@ class OperationContext;
 template <typename T>
 class StatusWith;
 
+/**
+ * Describes the work splitVector did to find the split points of a chunk.
+ */
+struct SplitVectorStats {
+    // Number of index keys read by scans of the chunk's range
+    long long keysExamined{0};
+
+    // Number of documents read through a random cursor while sampling the collection
+    long long docsSampled{0};
+
+    // Whether the returned split points were estimated from a sample instead of an index scan
+    bool usedSampling{false};
+};
+
 /**
  * Given a chunk, determines whether it can be split and returns the split points if so. This
  * function is functionally equivalent to the splitVector command.
@@ -54,6 +68,11 @@ class StatusWith;
  * be specified.
  * If force is set, split at the halfway point of the chunk. This also effectively
  * makes maxChunkSize equal the size of the chunk.
+ * If allowSampling is set and force is not, the split points may be estimated from a random sample
+ * of the collection's documents instead of a scan of the chunk's index range. The estimate is only
+ * used if the sample contains at least splitVectorMinSamplesPerChunk documents for every chunk that
+ * would result from the split, otherwise the index is scanned as usual.
+ * If stats is not null, it is filled in with a description of the work done.
  */
 StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
                                              const NamespaceString& nss,
@@ -64,6 +83,8 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
                                              boost::optional<long long> maxSplitPoints,
                                              boost::optional<long long> maxChunkObjects,
                                              boost::optional<long long> maxChunkSize,
-                                             boost::optional<long long> maxChunkSizeBytes);
+                                             boost::optional<long long> maxChunkSizeBytes,
+                                             bool allowSampling = false,
+                                             SplitVectorStats* stats = nullptr);
 
 }  // namespace mongo
@@ -65,6 +65,8 @@ public:
                 "  { splitVector : \"blog.post\" , keyPattern:{x:1} , min:{x:10} , max:{x:20}, "
                 "force: true }\n"
                 "  'force' will produce one split point even if data is small; defaults to false\n"
+                "  'sample: true' allows the split points to be estimated from a random sample of "
+                "the collection instead of a scan of the whole chunk\n"
                 "NOTE: This command may take a while to run";
     }
 
@@ -110,6 +112,8 @@ public:
             force = true;
         }
 
+        const bool allowSampling = jsobj["sample"].trueValue();
+
         boost::optional<long long> maxSplitPoints;
         BSONElement maxSplitPointsElem = jsobj["maxSplitPoints"];
         if (maxSplitPointsElem.isNumber()) {
@@ -134,6 +138,7 @@ public:
             maxChunkSizeBytes = maxSizeElem.numberLong();
         }
 
+        SplitVectorStats stats;
         auto statusWithSplitKeys = splitVector(opCtx,
                                                nss,
                                                keyPattern,
@@ -143,12 +148,17 @@ public:
                                                maxSplitPoints,
                                                maxChunkObjects,
                                                maxChunkSize,
-                                               maxChunkSizeBytes);
+                                               maxChunkSizeBytes,
+                                               allowSampling,
+                                               &stats);
         if (!statusWithSplitKeys.isOK()) {
             return appendCommandStatus(result, statusWithSplitKeys.getStatus());
         }
 
         result.append("splitKeys", statusWithSplitKeys.getValue());
+        result.append("keysExamined", stats.keysExamined);
+        result.append("docsSampled", stats.docsSampled);
+        result.append("sampled", stats.usedSampling);
         return true;
     }
 
@@ -33,8 +33,10 @@
 #include "mongo/db/s/split_vector.h"
 
 #include "mongo/db/dbdirectclient.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/shard_server_test_fixture.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -70,6 +72,13 @@ private:
 
 namespace {
 
+void setServerParameter(const std::string& name, const std::string& value) {
+    const auto& params = ServerParameterSet::getGlobal()->getMap();
+    const auto it = params.find(name);
+    invariant(it != params.end());
+    invariant(it->second->setFromString(value).isOK());
+}
+
 TEST_F(SplitVectorTest, SplitVectorInHalf) {
     std::vector<BSONObj> splitKeys = unittest::assertGet(splitVector(operationContext(),
                                                                      kNss,
@@ -112,6 +121,76 @@ TEST_F(SplitVectorTest, ForceSplit) {
     }
 }
 
+TEST_F(SplitVectorTest, ForceSplitReportsKeysExaminedByBothPasses) {
+    SplitVectorStats stats;
+    std::vector<BSONObj> splitKeys = unittest::assertGet(splitVector(operationContext(),
+                                                                     kNss,
+                                                                     BSON(kPattern << 1),
+                                                                     BSON(kPattern << 0),
+                                                                     BSON(kPattern << 100),
+                                                                     true,
+                                                                     boost::none,
+                                                                     boost::none,
+                                                                     getDocSizeBytes() * 6LL,
+                                                                     getDocSizeBytes() * 6LL,
+                                                                     true,
+                                                                     &stats));
+    ASSERT_EQ(1U, splitKeys.size());
+    ASSERT_BSONOBJ_EQ(BSON(kPattern << 50), splitKeys.front());
+    ASSERT_EQ(200, stats.keysExamined);
+    ASSERT_EQ(0, stats.docsSampled);
+    ASSERT_FALSE(stats.usedSampling);
+}
+
+TEST_F(SplitVectorTest, SmallCollectionIsScannedEvenIfSamplingIsAllowed) {
+    SplitVectorStats stats;
+    std::vector<BSONObj> splitKeys = unittest::assertGet(splitVector(operationContext(),
+                                                                     kNss,
+                                                                     BSON(kPattern << 1),
+                                                                     BSON(kPattern << 0),
+                                                                     BSON(kPattern << 100),
+                                                                     false,
+                                                                     boost::none,
+                                                                     boost::none,
+                                                                     boost::none,
+                                                                     getDocSizeBytes() * 100LL,
+                                                                     true,
+                                                                     &stats));
+    ASSERT_EQ(1U, splitKeys.size());
+    ASSERT_BSONOBJ_EQ(BSON(kPattern << 50), splitKeys.front());
+    ASSERT_EQ(100, stats.keysExamined);
+    ASSERT_EQ(0, stats.docsSampled);
+    ASSERT_FALSE(stats.usedSampling);
+}
+
+TEST_F(SplitVectorTest, SplitPointEstimatedFromSample) {
+    // A sample of 40 documents is enough to trust an estimate which splits the chunk in two
+    setServerParameter("splitVectorSampleSize", "40");
+    ON_BLOCK_EXIT([] { setServerParameter("splitVectorSampleSize", "2000"); });
+
+    SplitVectorStats stats;
+    std::vector<BSONObj> splitKeys = unittest::assertGet(splitVector(operationContext(),
+                                                                     kNss,
+                                                                     BSON(kPattern << 1),
+                                                                     BSON(kPattern << 0),
+                                                                     BSON(kPattern << 100),
+                                                                     false,
+                                                                     boost::none,
+                                                                     boost::none,
+                                                                     boost::none,
+                                                                     getDocSizeBytes() * 100LL,
+                                                                     true,
+                                                                     &stats));
+    ASSERT_TRUE(stats.usedSampling);
+    ASSERT_EQ(40, stats.docsSampled);
+    ASSERT_EQ(0, stats.keysExamined);
+
+    // The sample is random, so the split point is only known to fall strictly inside the chunk
+    ASSERT_EQ(1U, splitKeys.size());
+    ASSERT_GT(splitKeys.front()[kPattern].numberInt(), 0);
+    ASSERT_LT(splitKeys.front()[kPattern].numberInt(), 100);
+}
+
 TEST_F(SplitVectorTest, MaxChunkObjectsSet) {
     std::vector<BSONObj> splitKeys = unittest::assertGet(splitVector(operationContext(),
                                                                      kNss,
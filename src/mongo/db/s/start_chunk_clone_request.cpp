@@ -44,6 +44,7 @@ const char kToShardId[] = "toShardName";
 const char kChunkMinKey[] = "min";
 const char kChunkMaxKey[] = "max";
 const char kShardKeyPattern[] = "shardKeyPattern";
+const char kCloneStreams[] = "cloneStreams";
 
 }  // namespace
 
@@ -146,6 +147,21 @@ StatusWith<StartChunkCloneRequest> StartChunkCloneRequest::createFromCommand(Nam
         }
     }
 
+    {
+        long long numCloneStreams;
+        Status status =
+            bsonExtractIntegerFieldWithDefault(obj, kCloneStreams, 1, &numCloneStreams);
+        if (!status.isOK()) {
+            return status;
+        }
+
+        if (numCloneStreams < 1) {
+            return Status(ErrorCodes::BadValue, "The number of clone streams must be positive");
+        }
+
+        request._numCloneStreams = static_cast<int>(numCloneStreams);
+    }
+
     return request;
 }
 
@@ -159,10 +175,12 @@ void StartChunkCloneRequest::appendAsCommand(
     const BSONObj& chunkMinKey,
     const BSONObj& chunkMaxKey,
     const BSONObj& shardKeyPattern,
-    const MigrationSecondaryThrottleOptions& secondaryThrottle) {
+    const MigrationSecondaryThrottleOptions& secondaryThrottle,
+    int numCloneStreams) {
     invariant(builder->asTempObj().isEmpty());
     invariant(nss.isValid());
     invariant(fromShardConnectionString.isValid());
+    invariant(numCloneStreams >= 1);
 
     builder->append(kRecvChunkStart, nss.ns());
     sessionId.append(builder);
@@ -173,6 +191,10 @@ void StartChunkCloneRequest::appendAsCommand(
     builder->append(kChunkMaxKey, chunkMaxKey);
     builder->append(kShardKeyPattern, shardKeyPattern);
     secondaryThrottle.append(builder);
+
+    if (numCloneStreams > 1) {
+        builder->append(kCloneStreams, numCloneStreams);
+    }
 }
 
 }  // namespace mongo
@@ -57,6 +57,10 @@ public:
      * Constructs a start chunk clone command with the specified parameters and writes it to the
      * builder, without closing the builder. The builder must be empty, but callers are free to
      * append more fields once the command has been constructed.
+     *
+     * 'numCloneStreams' is the number of streams, which the recipient may drain concurrently
+     * through _migrateClone. The field is omitted when there is a single stream so that the command
+     * remains understood by recipients, which predate clone streams.
      */
     static void appendAsCommand(BSONObjBuilder* builder,
                                 const NamespaceString& nss,
@@ -67,7 +71,8 @@ public:
                                 const BSONObj& chunkMinKey,
                                 const BSONObj& chunkMaxKey,
                                 const BSONObj& shardKeyPattern,
-                                const MigrationSecondaryThrottleOptions& secondaryThrottle);
+                                const MigrationSecondaryThrottleOptions& secondaryThrottle,
+                                int numCloneStreams = 1);
 
     const NamespaceString& getNss() const {
         return _nss;
@@ -105,6 +110,10 @@ public:
         return _secondaryThrottle;
     }
 
+    int getNumCloneStreams() const {
+        return _numCloneStreams;
+    }
+
 private:
     StartChunkCloneRequest(NamespaceString nss,
                            MigrationSessionId sessionId,
@@ -132,6 +141,9 @@ private:
 
     // The parsed secondary throttle options
     MigrationSecondaryThrottleOptions _secondaryThrottle;
+
+    // Number of clone streams offered by the donor
+    int _numCloneStreams{1};
 };
 
 }  // namespace mongo
@@ -77,6 +77,33 @@ TEST(StartChunkCloneRequest, CreateAsCommandComplete) {
     ASSERT_BSONOBJ_EQ(BSON("Key" << 1), request.getShardKeyPattern());
     ASSERT_EQ(MigrationSecondaryThrottleOptions::kOff,
               request.getSecondaryThrottle().getSecondaryThrottle());
+    ASSERT_EQ(1, request.getNumCloneStreams());
+    ASSERT(cmdObj["cloneStreams"].eoo());
+}
+
+TEST(StartChunkCloneRequest, CreateAsCommandWithCloneStreams) {
+    MigrationSessionId sessionId = MigrationSessionId::generate("shard0001", "shard0002");
+
+    BSONObjBuilder builder;
+    StartChunkCloneRequest::appendAsCommand(
+        &builder,
+        NamespaceString("TestDB.TestColl"),
+        sessionId,
+        assertGet(ConnectionString::parse("TestDonorRS/Donor1:12345,Donor2:12345,Donor3:12345")),
+        ShardId("shard0001"),
+        ShardId("shard0002"),
+        BSON("Key" << -100),
+        BSON("Key" << 100),
+        BSON("Key" << 1),
+        MigrationSecondaryThrottleOptions::create(MigrationSecondaryThrottleOptions::kOff),
+        4);
+
+    BSONObj cmdObj = builder.obj();
+
+    auto request = assertGet(StartChunkCloneRequest::createFromCommand(
+        NamespaceString(cmdObj["_recvChunkStart"].String()), cmdObj));
+
+    ASSERT_EQ(4, request.getNumCloneStreams());
 }
 
 }  // namespace
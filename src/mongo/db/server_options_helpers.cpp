@@ -819,9 +819,11 @@ Status storeServerOptions(const moe::Environment& params) {
     if (params.count("net.transportLayer")) {
         serverGlobalParams.transportLayer = params["net.transportLayer"].as<std::string>();
         if (serverGlobalParams.transportLayer != "asio" &&
+            serverGlobalParams.transportLayer != "ioUring" &&
             serverGlobalParams.transportLayer != "legacy") {
             return {ErrorCodes::BadValue,
-                    "Unsupported value for transportLayer. Must be \"asio\" or \"legacy\""};
+                    "Unsupported value for transportLayer. Must be \"asio\", \"ioUring\" or "
+                    "\"legacy\""};
         }
     }
 
@@ -834,7 +836,7 @@ Status storeServerOptions(const moe::Environment& params) {
                         "must be \"synchronous\""};
             }
         } else {
-            const auto valid = {"synchronous"_sd, "adaptive"_sd};
+            const auto valid = {"synchronous"_sd, "adaptive"_sd, "workStealing"_sd};
             if (std::find(valid.begin(), valid.end(), value) == valid.end()) {
                 return {ErrorCodes::BadValue, "Unsupported value for serviceExecutor"};
             }
@@ -55,6 +55,9 @@
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/ops/write_ops_exec.h"
 #include "mongo/db/query/find.h"
+#include "mongo/db/query/getmore_request.h"
+#include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_request.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/repl/read_concern_args.h"
@@ -68,6 +71,7 @@
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/rpc/factory.h"
+#include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/rpc/metadata.h"
 #include "mongo/rpc/metadata/config_server_metadata.h"
 #include "mongo/rpc/metadata/logical_time_metadata.h"
@@ -296,14 +300,15 @@ void appendReplyMetadata(OperationContext* opCtx,
 }
 
 /**
- * Given the specified command and whether it supports read concern, returns an effective read
- * concern which should be used.
+ * Given the command's readConcern field and whether it supports read concern, returns an effective
+ * read concern which should be used.
  */
-StatusWith<repl::ReadConcernArgs> _extractReadConcern(const BSONObj& cmdObj,
+StatusWith<repl::ReadConcernArgs> _extractReadConcern(const BSONElement& readConcernElem,
                                                       bool supportsNonLocalReadConcern) {
     repl::ReadConcernArgs readConcernArgs;
 
-    auto readConcernParseStatus = readConcernArgs.initialize(cmdObj, Command::testCommandsEnabled);
+    auto readConcernParseStatus =
+        readConcernArgs.initialize(readConcernElem, Command::testCommandsEnabled);
     if (!readConcernParseStatus.isOK()) {
         return readConcernParseStatus;
     }
@@ -560,8 +565,10 @@ void execCommandDatabase(OperationContext* opCtx,
         BSONElement helpField;
         BSONElement shardVersionFieldIdx;
         BSONElement queryOptionMaxTimeMSField;
+        BSONElement readConcernField;
 
-        StringMap<int> topLevelFields;
+        // Pick out every generic argument the dispatcher needs in a single pass over the body.
+        DuplicateTopLevelFieldChecker topLevelFields;
         for (auto&& element : request.body) {
             StringData fieldName = element.fieldNameStringData();
             if (fieldName == QueryRequest::cmdOptionMaxTimeMS) {
@@ -574,12 +581,11 @@ void execCommandDatabase(OperationContext* opCtx,
                 shardVersionFieldIdx = element;
             } else if (fieldName == QueryRequest::queryOptionMaxTimeMS) {
                 queryOptionMaxTimeMSField = element;
+            } else if (fieldName == repl::ReadConcernArgs::kReadConcernFieldName) {
+                readConcernField = element;
             }
 
-            uassert(ErrorCodes::FailedToParse,
-                    str::stream() << "Parsed command object contains duplicate top level key: "
-                                  << fieldName,
-                    topLevelFields[fieldName]++ == 0);
+            topLevelFields.check(fieldName);
         }
 
         if (Command::isHelpRequest(helpField)) {
@@ -670,7 +676,7 @@ void execCommandDatabase(OperationContext* opCtx,
 
         auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
         readConcernArgs = uassertStatusOK(_extractReadConcern(
-            request.body, command->supportsNonLocalReadConcern(dbname, request.body)));
+            readConcernField, command->supportsNonLocalReadConcern(dbname, request.body)));
 
         auto& oss = OperationShardingState::get(opCtx);
 
@@ -735,8 +741,9 @@ void execCommandDatabase(OperationContext* opCtx,
         // Note: the read concern may not have been successfully or yet placed on the opCtx, so
         // parsing it separately here.
         const std::string db = request.getDatabase().toString();
-        auto readConcernArgsStatus = _extractReadConcern(
-            request.body, command->supportsNonLocalReadConcern(db, request.body));
+        auto readConcernArgsStatus =
+            _extractReadConcern(request.body[repl::ReadConcernArgs::kReadConcernFieldName],
+                                command->supportsNonLocalReadConcern(db, request.body));
         auto operationTime = readConcernArgsStatus.isOK()
             ? computeOperationTime(
                   opCtx, startOperationTime, readConcernArgsStatus.getValue().getLevel())
@@ -780,10 +787,79 @@ void curOpCommandSetup(OperationContext* opCtx, const OpMsgRequest& request) {
     curop->setNS_inlock(nss.ns());
 }
 
+/**
+ * Returns the command that produces the next batch of an OP_MSG exhaust cursor, or boost::none if
+ * 'request' cannot be continued from its reply 'response'. Only find and getMore are streamed, and
+ * only while they succeed and leave the cursor open; the stream ends with the reply that exhausts
+ * or closes the cursor, or with the first error. An empty batch from a tailable cursor also ends it
+ * unless the cursor waits for data, so that the server does not spin on a cursor with nothing to
+ * return. Any other empty batch, such as the first batch of a find with batchSize 0, is streamed.
+ */
+boost::optional<BSONObj> makeExhaustInvocation(OperationContext* opCtx,
+                                               const OpMsgRequest& request,
+                                               const Message& response) {
+    const auto commandName = request.getCommandName();
+    if (commandName != QueryRequest::kFindCommandName &&
+        commandName != GetMoreRequest::kGetMoreCommandName) {
+        return boost::none;
+    }
+
+    // Only the cursor id and namespace are needed, so avoid CursorResponse, which would walk the
+    // whole batch.
+    const auto reply = OpMsg::parse(response).body;
+    const auto cursorElem = reply["cursor"];
+    if (!getStatusFromCommandResult(reply).isOK() || cursorElem.type() != Object) {
+        return boost::none;
+    }
+    const auto cursorObj = cursorElem.Obj();
+    const CursorId cursorId = cursorObj["id"].safeNumberLong();
+    if (cursorId == 0) {
+        return boost::none;
+    }
+
+    // A getMore only returns an empty batch with the cursor still open if the cursor is tailable,
+    // and the getMore command flags the operation when its cursor waits for data.
+    const bool isFind = commandName == QueryRequest::kFindCommandName;
+    const bool isTailable = !isFind || request.body["tailable"].trueValue();
+    const bool awaitsData =
+        isFind ? request.body["awaitData"].trueValue() : shouldWaitForInserts(opCtx);
+    const auto batch = cursorObj[isFind ? "firstBatch" : "nextBatch"];
+    if (isTailable && !awaitsData && batch.type() == Array && batch.Obj().isEmpty()) {
+        return boost::none;
+    }
+
+    if (commandName == GetMoreRequest::kGetMoreCommandName) {
+        return request.body.getOwned();
+    }
+
+    // Turn the find into the getMore a client would have sent next. The batch size the client
+    // asked for on the find carries over to every batch of the stream, except that a getMore
+    // can't ask for an empty batch, so batchSize 0 only applies to the first one.
+    boost::optional<long long> batchSize;
+    if (auto batchSizeElem = request.body["batchSize"]) {
+        if (batchSizeElem.numberLong() > 0) {
+            batchSize = batchSizeElem.numberLong();
+        }
+    }
+
+    BSONObjBuilder bob(GetMoreRequest(NamespaceString(cursorObj["ns"].str()),
+                                      cursorId,
+                                      batchSize,
+                                      boost::none,
+                                      boost::none,
+                                      boost::none)
+                           .toBSON());
+    bob.append("$db", request.getDatabase());
+    if (auto lsid = request.body[OperationSessionInfo::kSessionIdFieldName]) {
+        bob.append(lsid);
+    }
+    return bob.obj();
+}
+
 DbResponse runCommands(OperationContext* opCtx, const Message& message) {
     auto replyBuilder = rpc::makeReplyBuilder(rpc::protocolForMessage(message));
+    OpMsgRequest request;
     [&] {
-        OpMsgRequest request;
         try {  // Parse.
             request = rpc::opMsgRequestFromAnyProtocol(message);
         } catch (const DBException& ex) {
@@ -844,11 +920,17 @@ DbResponse runCommands(OperationContext* opCtx, const Message& message) {
         return {};  // Don't reply.
     }
 
-    auto response = replyBuilder->done();
-    CurOp::get(opCtx)->debug().responseLength = response.header().dataLen();
+    DbResponse dbResponse{replyBuilder->done()};
+    CurOp::get(opCtx)->debug().responseLength = dbResponse.response.header().dataLen();
 
-    // TODO exhaust
-    return DbResponse{std::move(response)};
+    if (OpMsg::isFlagSet(message, OpMsg::kExhaustSupported) && !request.body.isEmpty()) {
+        dbResponse.nextInvocation = makeExhaustInvocation(opCtx, request, dbResponse.response);
+        if (dbResponse.nextInvocation) {
+            CurOp::get(opCtx)->debug().exhaust = true;
+        }
+    }
+
+    return dbResponse;
 }
 
 DbResponse receivedQuery(OperationContext* opCtx,
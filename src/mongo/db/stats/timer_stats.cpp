@@ -29,6 +29,10 @@
 
 #include "mongo/db/stats/timer_stats.h"
 
+#include <algorithm>
+
+#include "mongo/platform/bits.h"
+
 namespace mongo {
 
 TimerHolder::TimerHolder(TimerStats* stats) : _stats(stats), _recorded(false) {}
@@ -69,4 +73,39 @@ BSONObj TimerStats::getReport() const {
     b.appendNumber("totalMillis", t);
     return b.obj();
 }
+
+const int TimerHistogramStats::kNumBuckets;
+
+int TimerHistogramStats::_getBucket(int millis) {
+    if (millis <= 0) {
+        return 0;
+    }
+    // Bucket i > 0 holds times in [2^(i-1), 2^i), and the last bucket everything above it.
+    const int bucket = 64 - countLeadingZeros64(static_cast<unsigned long long>(millis));
+    return std::min(bucket, kNumBuckets - 1);
+}
+
+long long TimerHistogramStats::bucketLowerBound(int bucket) {
+    return bucket == 0 ? 0 : 1LL << (bucket - 1);
+}
+
+void TimerHistogramStats::recordMillis(int millis) {
+    _totals.recordMillis(millis);
+    _buckets[_getBucket(millis)].fetchAndAdd(1);
+}
+
+BSONObj TimerHistogramStats::getReport() const {
+    BSONObjBuilder b;
+    b.appendElements(_totals.getReport());
+    BSONArrayBuilder histogram(b.subarrayStart("histogram"));
+    for (int i = 0; i < kNumBuckets; ++i) {
+        const long long count = _buckets[i].loadRelaxed();
+        if (count == 0) {
+            continue;
+        }
+        histogram.append(BSON("millis" << bucketLowerBound(i) << "count" << count));
+    }
+    histogram.doneFast();
+    return b.obj();
+}
 }
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/util/timer.h"
 
@@ -59,6 +61,33 @@ private:
     AtomicInt64 _totalMillis;
 };
 
+/**
+ * Holds the same information as TimerStats, and additionally counts the recorded times in
+ * power-of-two millisecond buckets so that latency percentiles can be estimated.
+ */
+class TimerHistogramStats {
+public:
+    static const int kNumBuckets = 20;
+
+    void recordMillis(int millis);
+
+    /**
+     * Returns the inclusive lower bound, in milliseconds, of the given bucket.
+     */
+    static long long bucketLowerBound(int bucket);
+
+    BSONObj getReport() const;
+    operator BSONObj() const {
+        return getReport();
+    }
+
+private:
+    static int _getBucket(int millis);
+
+    TimerStats _totals;
+    std::array<AtomicInt64, kNumBuckets> _buckets;
+};
+
 /**
  * Holds an instance of a Timer such that we the time is recorded
  * when the TimerHolder goes out of scope
@@ -48,4 +48,29 @@ TEST(TimerStatsTest, GetReportOneRecording) {
     ASSERT_BSONOBJ_EQ(BSON("num" << 1 << "totalMillis" << millis), timerStats.getReport());
 }
 
+TEST(TimerHistogramStatsTest, GetReportNoRecording) {
+    ASSERT_BSONOBJ_EQ(BSON("num" << 0 << "totalMillis" << 0 << "histogram" << BSONArray()),
+                      TimerHistogramStats().getReport());
+}
+
+TEST(TimerHistogramStatsTest, GetReportCountsPowerOfTwoBuckets) {
+    TimerHistogramStats stats;
+    stats.recordMillis(0);
+    stats.recordMillis(1);
+    stats.recordMillis(5);
+    stats.recordMillis(6);
+    stats.recordMillis(7);
+    stats.recordMillis(1 << 30);
+    ASSERT_BSONOBJ_EQ(BSON("num" << 6 << "totalMillis" << (19 + (1 << 30)) << "histogram"
+                                 << BSON_ARRAY(BSON("millis" << 0 << "count" << 1)
+                                               << BSON("millis" << 1 << "count" << 1)
+                                               << BSON("millis" << 4 << "count" << 3)
+                                               << BSON("millis"
+                                                       << TimerHistogramStats::bucketLowerBound(
+                                                              TimerHistogramStats::kNumBuckets - 1)
+                                                       << "count"
+                                                       << 1))),
+                      stats.getReport());
+}
+
 }  // namespace
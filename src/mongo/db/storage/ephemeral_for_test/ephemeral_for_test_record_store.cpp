@@ -38,6 +38,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/db/storage/recovery_unit.h"
+#include "mongo/platform/random.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -186,6 +187,36 @@ private:
     const bool _isCapped;
 };
 
+class EphemeralForTestRecordStore::RandomCursor final : public RecordCursor {
+public:
+    RandomCursor(OperationContext* opCtx, const EphemeralForTestRecordStore& rs)
+        : _records(rs._data->records), _random(SecureRandom::create()->nextInt64()) {}
+
+    boost::optional<Record> next() final {
+        if (_records.empty())
+            return {};
+
+        // RecordIds are mostly allocated sequentially, so the record at or after a random id
+        // between the first and the last one is close enough to a uniform pick for testing.
+        const int64_t first = _records.begin()->first.repr();
+        const int64_t last = _records.rbegin()->first.repr();
+        auto it = _records.lower_bound(RecordId(first + _random.nextInt64(last - first + 1)));
+        return {{it->first, it->second.toRecordData()}};
+    }
+
+    void save() final {}
+    bool restore() final {
+        return true;
+    }
+
+    void detachFromOperationContext() final {}
+    void reattachToOperationContext(OperationContext* opCtx) final {}
+
+private:
+    const EphemeralForTestRecordStore::Records& _records;
+    PseudoRandom _random;
+};
+
 class EphemeralForTestRecordStore::ReverseCursor final : public SeekableRecordCursor {
 public:
     ReverseCursor(OperationContext* opCtx, const EphemeralForTestRecordStore& rs)
@@ -549,6 +580,11 @@ std::unique_ptr<SeekableRecordCursor> EphemeralForTestRecordStore::getCursor(
     return stdx::make_unique<ReverseCursor>(opCtx, *this);
 }
 
+std::unique_ptr<RecordCursor> EphemeralForTestRecordStore::getRandomCursor(
+    OperationContext* opCtx) const {
+    return stdx::make_unique<RandomCursor>(opCtx, *this);
+}
+
 Status EphemeralForTestRecordStore::truncate(OperationContext* opCtx) {
     // Unlike other changes, TruncateChange mutates _data on construction to perform the
     // truncate
@@ -88,6 +88,7 @@ public:
 
     std::unique_ptr<SeekableRecordCursor> getCursor(OperationContext* opCtx,
                                                     bool forward) const final;
+    std::unique_ptr<RecordCursor> getRandomCursor(OperationContext* opCtx) const final;
 
     virtual Status truncate(OperationContext* opCtx);
 
@@ -168,6 +169,7 @@ private:
 
     class Cursor;
     class ReverseCursor;
+    class RandomCursor;
 
     StatusWith<RecordId> extractAndCheckLocForOplog(const char* data, int len) const;
 
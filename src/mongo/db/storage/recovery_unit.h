@@ -123,6 +123,40 @@ public:
         return {};
     }
 
+    /**
+     * Informs this RecoveryUnit that all future reads through it should be from the snapshot of the
+     * last complete batch of oplog entries applied on this secondary (see
+     * SnapshotManager::setLocalSnapshot()). Newer local snapshots are used whenever
+     * implementations would normally change snapshots.
+     *
+     * If there is no local snapshot, returns a status with error code
+     * InterruptedDueToReplStateChange and the caller must conflict with batch application instead.
+     * After this returns successfully, at any point where implementations attempt to acquire the
+     * local snapshot, if there is none available due to a call to
+     * SnapshotManager::clearLocalSnapshot(), a AssertionException with the same code should be
+     * thrown.
+     */
+    virtual Status setReadFromLastAppliedSnapshot() {
+        return {ErrorCodes::CommandNotSupported,
+                "Current storage engine does not support reading from the last applied snapshot"};
+    }
+
+    /**
+     * Undoes setReadFromLastAppliedSnapshot(). Must not be called while a snapshot is open.
+     */
+    virtual void clearReadFromLastAppliedSnapshot() {}
+
+    /**
+     * Returns the SnapshotName of the local snapshot this recovery unit reads from, or boost::none
+     * if setReadFromLastAppliedSnapshot() has not been called.
+     *
+     * It is possible for reads to occur from later snapshots, but they may not occur from earlier
+     * snapshots.
+     */
+    virtual boost::optional<SnapshotName> getLastAppliedSnapshot() const {
+        return {};
+    }
+
     /**
      * Gets the local SnapshotId.
      *
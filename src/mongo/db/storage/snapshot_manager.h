@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <limits>
 #include <string>
 
@@ -86,6 +87,29 @@ public:
      */
     virtual void dropAllSnapshots() = 0;
 
+    /**
+     * Sets the timestamp of the last complete batch of oplog entries applied on a secondary. Reads
+     * at this timestamp observe a state that is consistent with the primary's, so they do not need
+     * to conflict with batch application.
+     *
+     * Storage engines that do not support point-in-time reads should use the default
+     * implementation, which never makes a local snapshot available.
+     */
+    virtual void setLocalSnapshot(const Timestamp& timestamp) {}
+
+    /**
+     * Returns the timestamp set by setLocalSnapshot(), or boost::none if there is none.
+     */
+    virtual boost::optional<Timestamp> getLocalSnapshot() const {
+        return boost::none;
+    }
+
+    /**
+     * Forgets the local snapshot. Called when the node stops applying oplog entries in batches, for
+     * example on transition to primary or to rollback.
+     */
+    virtual void clearLocalSnapshot() {}
+
 protected:
     /**
      * SnapshotManagers are not intended to be deleted through pointers to base type.
@@ -224,6 +224,31 @@ boost::optional<SnapshotName> WiredTigerRecoveryUnit::getMajorityCommittedSnapsh
     return _majorityCommittedSnapshot;
 }
 
+Status WiredTigerRecoveryUnit::setReadFromLastAppliedSnapshot() {
+    auto localSnapshot = _sessionCache->snapshotManager().getLocalSnapshot();
+    if (!localSnapshot) {
+        return {ErrorCodes::InterruptedDueToReplStateChange,
+                "No batch of oplog entries has been applied since the last replication state "
+                "change"};
+    }
+
+    _lastAppliedSnapshot = SnapshotName(*localSnapshot);
+    _readFromLastAppliedSnapshot = true;
+    return Status::OK();
+}
+
+void WiredTigerRecoveryUnit::clearReadFromLastAppliedSnapshot() {
+    invariant(!_active);
+    _readFromLastAppliedSnapshot = false;
+    _lastAppliedSnapshot = SnapshotName::min();
+}
+
+boost::optional<SnapshotName> WiredTigerRecoveryUnit::getLastAppliedSnapshot() const {
+    if (!_readFromLastAppliedSnapshot)
+        return {};
+    return _lastAppliedSnapshot;
+}
+
 void WiredTigerRecoveryUnit::_txnOpen() {
     invariant(!_active);
     _ensureSession();
@@ -240,6 +265,9 @@ void WiredTigerRecoveryUnit::_txnOpen() {
     } else if (_readFromMajorityCommittedSnapshot) {
         _majorityCommittedSnapshot =
             _sessionCache->snapshotManager().beginTransactionOnCommittedSnapshot(session);
+    } else if (_readFromLastAppliedSnapshot) {
+        _lastAppliedSnapshot =
+            _sessionCache->snapshotManager().beginTransactionOnLocalSnapshot(session);
     } else if (_isOplogReader) {
         _sessionCache->snapshotManager().beginTransactionOnOplog(
             _sessionCache->getKVEngine()->getOplogManager(), session);
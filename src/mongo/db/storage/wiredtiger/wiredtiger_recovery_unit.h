@@ -69,6 +69,10 @@ public:
 
     boost::optional<SnapshotName> getMajorityCommittedSnapshot() const override;
 
+    Status setReadFromLastAppliedSnapshot() override;
+    void clearReadFromLastAppliedSnapshot() override;
+    boost::optional<SnapshotName> getLastAppliedSnapshot() const override;
+
     SnapshotId getSnapshotId() const override;
 
     Status setTimestamp(SnapshotName timestamp) override;
@@ -131,6 +135,8 @@ private:
     uint64_t _mySnapshotId;
     bool _readFromMajorityCommittedSnapshot = false;
     SnapshotName _majorityCommittedSnapshot = SnapshotName::min();
+    bool _readFromLastAppliedSnapshot = false;
+    SnapshotName _lastAppliedSnapshot = SnapshotName::min();
     SnapshotName _readAtTimestamp = SnapshotName::min();
     std::unique_ptr<Timer> _timer;
     bool _isOplogReader = false;
@@ -64,6 +64,21 @@ void WiredTigerSnapshotManager::dropAllSnapshots() {
     _committedSnapshot = boost::none;
 }
 
+void WiredTigerSnapshotManager::setLocalSnapshot(const Timestamp& timestamp) {
+    stdx::lock_guard<stdx::mutex> lock(_localSnapshotMutex);
+    _localSnapshot = timestamp;
+}
+
+boost::optional<Timestamp> WiredTigerSnapshotManager::getLocalSnapshot() const {
+    stdx::lock_guard<stdx::mutex> lock(_localSnapshotMutex);
+    return _localSnapshot;
+}
+
+void WiredTigerSnapshotManager::clearLocalSnapshot() {
+    stdx::lock_guard<stdx::mutex> lock(_localSnapshotMutex);
+    _localSnapshot = boost::none;
+}
+
 void WiredTigerSnapshotManager::shutdown() {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     if (!_session)
@@ -103,6 +118,34 @@ SnapshotName WiredTigerSnapshotManager::beginTransactionOnCommittedSnapshot(
     return *_committedSnapshot;
 }
 
+SnapshotName WiredTigerSnapshotManager::beginTransactionOnLocalSnapshot(
+    WT_SESSION* session) const {
+    stdx::lock_guard<stdx::mutex> lock(_localSnapshotMutex);
+
+    uassert(ErrorCodes::InterruptedDueToReplStateChange,
+            "Local snapshot disappeared while running operation",
+            _localSnapshot);
+    SnapshotName name(*_localSnapshot);
+    char readTSConfigString[15 /* read_timestamp= */ + (8 * 2) /* 16 hexadecimal digits */ +
+                            1 /* trailing null */];
+    auto size = std::snprintf(readTSConfigString,
+                              sizeof(readTSConfigString),
+                              "read_timestamp=%llx",
+                              static_cast<unsigned long long>(name.asU64()));
+    invariant(static_cast<std::size_t>(size) < sizeof(readTSConfigString));
+
+    int status = session->begin_transaction(session, readTSConfigString);
+
+    // As with oplog reads, a local snapshot that has fallen behind the oldest_timestamp can only
+    // be the result of a race with a newer batch; retrying will pick up the newer snapshot.
+    if (status == EINVAL) {
+        throw WriteConflictException();
+    }
+
+    invariantWTOK(status);
+    return name;
+}
+
 void WiredTigerSnapshotManager::beginTransactionOnOplog(WiredTigerOplogManager* oplogManager,
                                                         WT_SESSION* session) const {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
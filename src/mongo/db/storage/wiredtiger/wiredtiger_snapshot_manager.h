@@ -58,6 +58,9 @@ public:
     void setCommittedSnapshot(const SnapshotName& name, Timestamp ts) final;
     void cleanupUnneededSnapshots() final;
     void dropAllSnapshots() final;
+    void setLocalSnapshot(const Timestamp& timestamp) final;
+    boost::optional<Timestamp> getLocalSnapshot() const final;
+    void clearLocalSnapshot() final;
 
     //
     // WT-specific methods
@@ -77,6 +80,13 @@ public:
      */
     SnapshotName beginTransactionOnCommittedSnapshot(WT_SESSION* session) const;
 
+    /**
+     * Starts a transaction on the local snapshot and returns the SnapshotName used.
+     *
+     * Throws if there is currently no local snapshot.
+     */
+    SnapshotName beginTransactionOnLocalSnapshot(WT_SESSION* session) const;
+
     /**
      * Starts a transaction on the oplog using an appropriate timestamp for oplog visiblity.
      */
@@ -95,6 +105,12 @@ public:
 private:
     mutable stdx::mutex _mutex;  // Guards all members.
     boost::optional<SnapshotName> _committedSnapshot;
+
+    // The local snapshot is updated after every batch applied on a secondary, so it is kept under
+    // its own mutex to avoid contending with committed snapshot readers.
+    mutable stdx::mutex _localSnapshotMutex;
+    boost::optional<Timestamp> _localSnapshot;
+
     WT_SESSION* _session;
     WT_CONNECTION* _conn;
 };
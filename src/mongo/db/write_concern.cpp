@@ -56,6 +56,11 @@ using repl::OpTime;
 static TimerStats gleWtimeStats;
 static ServerStatusMetricField<TimerStats> displayGleLatency("getLastError.wtime", &gleWtimeStats);
 
+// Time spent waiting for w:majority write concerns, which bounds the latency of majority writes.
+static TimerHistogramStats gleWtimeMajorityStats;
+static ServerStatusMetricField<TimerHistogramStats> displayGleMajorityLatency(
+    "getLastError.wtimeMajority", &gleWtimeMajorityStats);
+
 static Counter64 gleWtimeouts;
 static ServerStatusMetricField<Counter64> gleWtimeoutsDisplay("getLastError.wtimeouts",
                                                               &gleWtimeouts);
@@ -237,6 +242,9 @@ Status waitForWriteConcern(OperationContext* opCtx,
         replOpTime,
         writeConcernWithPopulatedSyncMode.syncMode == WriteConcernOptions::SyncMode::JOURNAL);
     gleWtimeStats.recordMillis(durationCount<Milliseconds>(replStatus.duration));
+    if (writeConcernWithPopulatedSyncMode.wMode == WriteConcernOptions::kMajority) {
+        gleWtimeMajorityStats.recordMillis(durationCount<Milliseconds>(replStatus.duration));
+    }
     result->wTime = durationCount<Milliseconds>(replStatus.duration);
 
     return replStatus.status;
@@ -43,9 +43,39 @@
 namespace mongo {
 namespace executor {
 
+void SSLSessionCache::resume(const HostAndPort& host, SSL* ssl) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _sessions.find(host);
+    if (it != _sessions.end()) {
+        // SSL_set_session takes its own reference, so the session may be replaced or dropped from
+        // the cache while the handshake is in progress.
+        ::SSL_set_session(ssl, it->second.get());
+    }
+}
+
+void SSLSessionCache::remember(const HostAndPort& host, SSL* ssl) {
+    std::unique_ptr<SSL_SESSION, SessionDeleter> session(::SSL_get1_session(ssl));
+    if (!session) {
+        return;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _sessions[host] = std::move(session);
+}
+
+void SSLSessionCache::forget(const HostAndPort& host) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _sessions.erase(host);
+}
+
 AsyncSecureStream::AsyncSecureStream(asio::io_service::strand* strand,
-                                     asio::ssl::context* sslContext)
-    : _strand(strand), _stream(_strand->get_io_service(), *sslContext) {}
+                                     asio::ssl::context* sslContext,
+                                     const HostAndPort& host,
+                                     SSLSessionCache* sessionCache)
+    : _strand(strand),
+      _stream(_strand->get_io_service(), *sslContext),
+      _host(host),
+      _sessionCache(sessionCache) {}
 
 AsyncSecureStream::~AsyncSecureStream() {
     destroyStream(&_stream.lowest_layer(), _connected);
@@ -88,13 +118,25 @@ void AsyncSecureStream::read(asio::mutable_buffer buffer, StreamHandler&& stream
 }
 
 void AsyncSecureStream::_handleConnect(asio::ip::tcp::resolver::iterator iter) {
-    _stream.async_handshake(decltype(_stream)::client,
-                            _strand->wrap([this, iter](std::error_code ec) {
-                                if (ec) {
-                                    return _userHandler(ec);
-                                }
-                                return _handleHandshake(ec, iter->host_name());
-                            }));
+    if (_sessionCache) {
+        _sessionCache->resume(_host, _stream.native_handle());
+    }
+
+    _handshakeTimer.reset();
+    _stream.async_handshake(
+        decltype(_stream)::client, _strand->wrap([this, iter](std::error_code ec) {
+            getSSLHandshakeStats().record(_stream.native_handle(),
+                                          SSLManagerInterface::ConnectionDirection::kOutgoing,
+                                          _handshakeTimer.elapsed(),
+                                          !ec);
+            if (ec) {
+                if (_sessionCache) {
+                    _sessionCache->forget(_host);
+                }
+                return _userHandler(ec);
+            }
+            return _handleHandshake(ec, iter->host_name());
+        }));
 }
 
 void AsyncSecureStream::_handleHandshake(std::error_code ec, const std::string& hostName) {
@@ -103,6 +145,11 @@ void AsyncSecureStream::_handleHandshake(std::error_code ec, const std::string&
     if (!certStatus.isOK()) {
         warning() << "Failed to validate peer certificate during SSL handshake: "
                   << certStatus.getStatus();
+        if (_sessionCache) {
+            _sessionCache->forget(_host);
+        }
+    } else if (_sessionCache) {
+        _sessionCache->remember(_host, _stream.native_handle());
     }
     _userHandler(make_error_code(certStatus.getStatus().code()));
 }
@@ -34,15 +34,66 @@
 
 #include <asio.hpp>
 #include <asio/ssl.hpp>
+#include <memory>
 
+#include "mongo/base/disallow_copying.h"
 #include "mongo/executor/async_stream_interface.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/net/hostandport.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace executor {
 
+/**
+ * Remembers the most recent TLS session negotiated with each remote host, so that the next
+ * connection to that host can resume it with an abbreviated handshake instead of repeating the
+ * certificate exchange and key agreement. Works with both session ids and session tickets.
+ */
+class SSLSessionCache {
+    MONGO_DISALLOW_COPYING(SSLSessionCache);
+
+public:
+    SSLSessionCache() = default;
+
+    /**
+     * Offers the session remembered for 'host', if any, for resumption by 'ssl'. Must be called
+     * before the handshake starts.
+     */
+    void resume(const HostAndPort& host, SSL* ssl);
+
+    /**
+     * Remembers the session negotiated by 'ssl' with 'host' after a successful handshake.
+     */
+    void remember(const HostAndPort& host, SSL* ssl);
+
+    /**
+     * Drops the session remembered for 'host', after a handshake with it failed.
+     */
+    void forget(const HostAndPort& host);
+
+private:
+    struct SessionDeleter {
+        void operator()(SSL_SESSION* session) const {
+            ::SSL_SESSION_free(session);
+        }
+    };
+
+    stdx::mutex _mutex;
+    stdx::unordered_map<HostAndPort, std::unique_ptr<SSL_SESSION, SessionDeleter>> _sessions;
+};
+
 class AsyncSecureStream final : public AsyncStreamInterface {
 public:
-    AsyncSecureStream(asio::io_service::strand* strand, asio::ssl::context* sslContext);
+    /**
+     * If 'sessionCache' is not null, the handshake tries to resume the last session negotiated
+     * with 'host' and the session it ends up with is remembered for next time.
+     */
+    AsyncSecureStream(asio::io_service::strand* strand,
+                      asio::ssl::context* sslContext,
+                      const HostAndPort& host,
+                      SSLSessionCache* sessionCache);
 
     ~AsyncSecureStream();
 
@@ -64,7 +115,10 @@ private:
 
     asio::io_service::strand* const _strand;
     asio::ssl::stream<asio::ip::tcp::socket> _stream;
+    const HostAndPort _host;
+    SSLSessionCache* const _sessionCache;
     ConnectHandler _userHandler;
+    Timer _handshakeTimer;
     bool _connected = false;
 };
 
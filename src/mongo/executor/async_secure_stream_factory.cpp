@@ -31,6 +31,7 @@
 #include "mongo/executor/async_secure_stream_factory.h"
 
 #include "mongo/config.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/executor/async_secure_stream.h"
 #include "mongo/executor/async_stream.h"
 #include "mongo/stdx/memory.h"
@@ -42,6 +43,10 @@
 namespace mongo {
 namespace executor {
 
+// Whether outgoing TLS connections from the executor try to resume the last session negotiated
+// with the same host.
+MONGO_EXPORT_SERVER_PARAMETER(sslOutgoingSessionResumption, bool, true);
+
 AsyncSecureStreamFactory::AsyncSecureStreamFactory(SSLManagerInterface* sslManager)
     : _sslContext(asio::ssl::context::sslv23) {
     // We use sslv23, which corresponds to OpenSSLs SSLv23_method, for compatibility with older
@@ -55,10 +60,14 @@ AsyncSecureStreamFactory::AsyncSecureStreamFactory(SSLManagerInterface* sslManag
 }
 
 std::unique_ptr<AsyncStreamInterface> AsyncSecureStreamFactory::makeStream(
-    asio::io_service::strand* strand, const HostAndPort&) {
+    asio::io_service::strand* strand, const HostAndPort& host) {
     int sslModeVal = getSSLGlobalParams().sslMode.load();
     if (sslModeVal == SSLParams::SSLMode_preferSSL || sslModeVal == SSLParams::SSLMode_requireSSL) {
-        return stdx::make_unique<AsyncSecureStream>(strand, &_sslContext);
+        return stdx::make_unique<AsyncSecureStream>(
+            strand,
+            &_sslContext,
+            host,
+            sslOutgoingSessionResumption.load() ? &_sessionCache : nullptr);
     }
     return stdx::make_unique<AsyncStream>(strand);
 }
@@ -35,6 +35,7 @@
 #include <asio.hpp>
 #include <asio/ssl.hpp>
 
+#include "mongo/executor/async_secure_stream.h"
 #include "mongo/executor/async_stream_factory_interface.h"
 
 namespace mongo {
@@ -52,6 +53,10 @@ public:
 
 private:
     asio::ssl::context _sslContext;
+
+    // Shared by every stream this factory makes, so that reconnecting to a host resumes the
+    // session of an earlier connection to it.
+    SSLSessionCache _sessionCache;
 };
 
 }  // namespace executor
@@ -42,8 +42,12 @@
 #include "mongo/util/lru_cache.h"
 #include "mongo/util/scopeguard.h"
 
+// Each SpecificPool has its own mutex, which guards all of its state. The parent's mutex only
+// guards the map from HostAndPort to SpecificPool and is never held while taking a pool's mutex,
+// so requests to different hosts never contend with each other.
+//
 // One interesting implementation note herein concerns how setup() and
-// refresh() are invoked outside of the global lock, but setTimeout is not.
+// refresh() are invoked outside of the pool's lock, but setTimeout is not.
 // This implementation detail simplifies mocks, allowing them to return
 // synchronously sometimes, whereas having timeouts fire instantly adds little
 // value. In practice, dumping the locks is always safe (because we restrict
@@ -65,8 +69,27 @@ public:
     ~SpecificPool();
 
     /**
-     * Gets a connection from the specific pool. Sinks a unique_lock from the
-     * parent to preserve the lock on _mutex
+     * Locks this pool's mutex, which must be held for all of the methods below that take a lock.
+     */
+    stdx::unique_lock<stdx::mutex> lock() {
+        return stdx::unique_lock<stdx::mutex>(_mutex);
+    }
+
+    /**
+     * Returns true if this pool has been removed from its parent after hostTimeout. A caller that
+     * found the pool in the parent's map before that happened must look it up again.
+     */
+    bool isShutdown(const stdx::unique_lock<stdx::mutex>& lk) const {
+        return _state == State::kShutdown;
+    }
+
+    const HostAndPort& getHostAndPort() const {
+        return _hostAndPort;
+    }
+
+    /**
+     * Gets a connection from the specific pool. Sinks a unique_lock on _mutex
+     * to preserve the lock across the call.
      */
     void getConnection(const HostAndPort& hostAndPort,
                        Milliseconds timeout,
@@ -81,11 +104,18 @@ public:
     void processFailure(const Status& status, stdx::unique_lock<stdx::mutex> lk);
 
     /**
-     * Returns a connection to a specific pool. Sinks a unique_lock from the
-     * parent to preserve the lock on _mutex
+     * Returns a connection to a specific pool. Sinks a unique_lock on _mutex
+     * to preserve the lock across the call.
      */
     void returnConnection(ConnectionInterface* connection, stdx::unique_lock<stdx::mutex> lk);
 
+    /**
+     * Returns a checked out connection to this pool, taking the lock.
+     */
+    void returnConnection(ConnectionInterface* connection) {
+        returnConnection(connection, lock());
+    }
+
     /**
      * Returns the number of connections currently checked out of the pool.
      */
@@ -113,14 +143,23 @@ public:
      */
     size_t openConnections(const stdx::unique_lock<stdx::mutex>& lk);
 
+    /**
+     * Returns the connection counts and cumulative checkout and refresh metrics of this pool.
+     */
+    ConnectionStatsPer getStats(const stdx::unique_lock<stdx::mutex>& lk);
+
 private:
     using OwnedConnection = std::unique_ptr<ConnectionInterface>;
     using OwnershipPool = stdx::unordered_map<ConnectionInterface*, OwnedConnection>;
     using LRUOwnershipPool = LRUCache<OwnershipPool::key_type, OwnershipPool::mapped_type>;
-    using Request = std::pair<Date_t, GetConnectionCallback>;
+    struct Request {
+        Date_t expiration;
+        Date_t requested;
+        GetConnectionCallback cb;
+    };
     struct RequestComparator {
         bool operator()(const Request& a, const Request& b) {
-            return a.first > b.first;
+            return a.expiration > b.expiration;
         }
     };
 
@@ -145,6 +184,9 @@ private:
 
     const HostAndPort _hostAndPort;
 
+    // Guards all of the state below.
+    stdx::mutex _mutex;
+
     LRUOwnershipPool _readyPool;
     OwnershipPool _processingPool;
     OwnershipPool _droppedProcessingPool;
@@ -160,6 +202,12 @@ private:
 
     size_t _created;
 
+    // Cumulative metrics reported in connPoolStats.
+    size_t _checkouts;
+    Milliseconds _totalWaitTime;
+    size_t _refreshes;
+    Milliseconds _totalRefreshTime;
+
     /**
      * The current state of the pool
      *
@@ -181,6 +229,9 @@ private:
         // hostTimeout is passed, we're waiting for any processing
         // connections to finish before shutting down
         kInShutdown,
+
+        // The pool has been removed from its parent and must not be used
+        kShutdown,
     };
 
     State _state;
@@ -203,73 +254,89 @@ ConnectionPool::ConnectionPool(std::unique_ptr<DependentTypeFactoryInterface> im
 
 ConnectionPool::~ConnectionPool() = default;
 
-void ConnectionPool::dropConnections(const HostAndPort& hostAndPort) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+void ConnectionPool::ConnectionHandleDeleter::operator()(ConnectionInterface* connection) {
+    // A pool is only removed from its parent once all of its connections have been returned, so
+    // it is still alive here.
+    if (_pool && connection)
+        _pool->returnConnection(connection);
+}
 
-    auto iter = _pools.find(hostAndPort);
+std::shared_ptr<ConnectionPool::SpecificPool> ConnectionPool::_findPool(
+    const HostAndPort& hostAndPort) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
 
+    auto iter = _pools.find(hostAndPort);
     if (iter == _pools.end())
+        return nullptr;
+
+    return iter->second;
+}
+
+void ConnectionPool::dropConnections(const HostAndPort& hostAndPort) {
+    auto pool = _findPool(hostAndPort);
+    if (!pool)
+        return;
+
+    auto lk = pool->lock();
+    if (pool->isShutdown(lk))
         return;
 
-    iter->second.get()->processFailure(
-        Status(ErrorCodes::PooledConnectionsDropped, "Pooled connections dropped"), std::move(lk));
+    pool->processFailure(Status(ErrorCodes::PooledConnectionsDropped, "Pooled connections dropped"),
+                         std::move(lk));
 }
 
 void ConnectionPool::get(const HostAndPort& hostAndPort,
                          Milliseconds timeout,
                          GetConnectionCallback cb) {
-    SpecificPool* pool;
+    while (true) {
+        std::shared_ptr<SpecificPool> pool;
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+            auto& slot = _pools[hostAndPort];
+            if (!slot)
+                slot = std::make_shared<SpecificPool>(this, hostAndPort);
+            pool = slot;
+        }
 
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+        auto lk = pool->lock();
 
-    auto iter = _pools.find(hostAndPort);
+        // The pool timed out and removed itself between the lookup and taking its lock, so the
+        // next lookup will create a fresh one.
+        if (pool->isShutdown(lk))
+            continue;
 
-    if (iter == _pools.end()) {
-        auto handle = stdx::make_unique<SpecificPool>(this, hostAndPort);
-        pool = handle.get();
-        _pools[hostAndPort] = std::move(handle);
-    } else {
-        pool = iter->second.get();
+        pool->getConnection(hostAndPort, timeout, std::move(lk), std::move(cb));
+        return;
     }
-
-    invariant(pool);
-
-    pool->getConnection(hostAndPort, timeout, std::move(lk), std::move(cb));
 }
 
 void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    std::vector<std::shared_ptr<SpecificPool>> pools;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        pools.reserve(_pools.size());
+        for (const auto& kv : _pools) {
+            pools.push_back(kv.second);
+        }
+    }
 
-    for (const auto& kv : _pools) {
-        HostAndPort host = kv.first;
+    for (const auto& pool : pools) {
+        auto lk = pool->lock();
+        if (pool->isShutdown(lk))
+            continue;
 
-        auto& pool = kv.second;
-        ConnectionStatsPer hostStats{pool->inUseConnections(lk),
-                                     pool->availableConnections(lk),
-                                     pool->createdConnections(lk),
-                                     pool->refreshingConnections(lk)};
-        stats->updateStatsForHost(_name, host, hostStats);
+        stats->updateStatsForHost(_name, pool->getHostAndPort(), pool->getStats(lk));
     }
 }
 
 size_t ConnectionPool::getNumConnectionsPerHost(const HostAndPort& hostAndPort) const {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
-    auto iter = _pools.find(hostAndPort);
-    if (iter != _pools.end()) {
-        return iter->second->openConnections(lk);
-    }
-
-    return 0;
-}
-
-void ConnectionPool::returnConnection(ConnectionInterface* conn) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
-
-    auto iter = _pools.find(conn->getHostAndPort());
+    auto pool = _findPool(hostAndPort);
+    if (!pool)
+        return 0;
 
-    invariant(iter != _pools.end());
-
-    iter->second.get()->returnConnection(conn, std::move(lk));
+    auto lk = pool->lock();
+    return pool->openConnections(lk);
 }
 
 ConnectionPool::SpecificPool::SpecificPool(ConnectionPool* parent, const HostAndPort& hostAndPort)
@@ -281,6 +348,10 @@ ConnectionPool::SpecificPool::SpecificPool(ConnectionPool* parent, const HostAnd
       _inFulfillRequests(false),
       _inSpawnConnections(false),
       _created(0),
+      _checkouts(0),
+      _totalWaitTime(0),
+      _refreshes(0),
+      _totalRefreshTime(0),
       _state(State::kRunning) {}
 
 ConnectionPool::SpecificPool::~SpecificPool() {
@@ -309,6 +380,19 @@ size_t ConnectionPool::SpecificPool::openConnections(const stdx::unique_lock<std
     return _checkedOutPool.size() + _readyPool.size() + _processingPool.size();
 }
 
+ConnectionStatsPer ConnectionPool::SpecificPool::getStats(
+    const stdx::unique_lock<stdx::mutex>& lk) {
+    ConnectionStatsPer stats{inUseConnections(lk),
+                             availableConnections(lk),
+                             createdConnections(lk),
+                             refreshingConnections(lk)};
+    stats.checkouts = _checkouts;
+    stats.totalWaitTime = _totalWaitTime;
+    stats.refreshes = _refreshes;
+    stats.totalRefreshTime = _totalRefreshTime;
+    return stats;
+}
+
 void ConnectionPool::SpecificPool::getConnection(const HostAndPort& hostAndPort,
                                                  Milliseconds timeout,
                                                  stdx::unique_lock<stdx::mutex> lk,
@@ -317,9 +401,9 @@ void ConnectionPool::SpecificPool::getConnection(const HostAndPort& hostAndPort,
         timeout = _parent->_options.refreshTimeout;
     }
 
-    const auto expiration = _parent->_factory->now() + timeout;
+    const auto now = _parent->_factory->now();
 
-    _requests.push(make_pair(expiration, std::move(cb)));
+    _requests.push(Request{now + timeout, now, std::move(cb)});
 
     updateStateInLock();
 
@@ -369,10 +453,13 @@ void ConnectionPool::SpecificPool::returnConnection(ConnectionInterface* connPtr
         // Unlock in case refresh can occur immediately
         lk.unlock();
         connPtr->refresh(_parent->_options.refreshTimeout,
-                         [this](ConnectionInterface* connPtr, Status status) {
+                         [this, now](ConnectionInterface* connPtr, Status status) {
                              connPtr->indicateUsed();
 
-                             stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+                             stdx::unique_lock<stdx::mutex> lk(_mutex);
+
+                             ++_refreshes;
+                             _totalRefreshTime += _parent->_factory->now() - now;
 
                              auto conn = takeFromProcessingPool(connPtr);
 
@@ -432,7 +519,7 @@ void ConnectionPool::SpecificPool::addToReady(stdx::unique_lock<stdx::mutex>& lk
     connPtr->setTimeout(_parent->_options.refreshRequirement, [this, connPtr]() {
         OwnedConnection conn;
 
-        stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
 
         if (!_readyPool.count(connPtr)) {
             // We've already been checked out. We don't need to refresh
@@ -492,7 +579,7 @@ void ConnectionPool::SpecificPool::processFailure(const Status& status,
     lk.unlock();
 
     while (requestsToFail.size()) {
-        requestsToFail.top().second(status);
+        requestsToFail.top().cb(status);
         requestsToFail.pop();
     }
 }
@@ -535,7 +622,8 @@ void ConnectionPool::SpecificPool::fulfillRequests(stdx::unique_lock<stdx::mutex
         }
 
         // Grab the request and callback
-        auto cb = std::move(_requests.top().second);
+        auto cb = std::move(_requests.top().cb);
+        const auto requested = _requests.top().requested;
         _requests.pop();
 
         auto connPtr = conn.get();
@@ -543,12 +631,15 @@ void ConnectionPool::SpecificPool::fulfillRequests(stdx::unique_lock<stdx::mutex
         // check out the connection
         _checkedOutPool[connPtr] = std::move(conn);
 
+        ++_checkouts;
+        _totalWaitTime += _parent->_factory->now() - requested;
+
         updateStateInLock();
 
         // pass it to the user
         connPtr->resetToUnknown();
         lk.unlock();
-        cb(ConnectionHandle(connPtr, ConnectionHandleDeleter(_parent)));
+        cb(ConnectionHandle(connPtr, ConnectionHandleDeleter(this)));
         lk.lock();
     }
 }
@@ -594,7 +685,7 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
             _parent->_options.refreshTimeout, [this](ConnectionInterface* connPtr, Status status) {
                 connPtr->indicateUsed();
 
-                stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+                stdx::unique_lock<stdx::mutex> lk(_mutex);
 
                 auto conn = takeFromProcessingPool(connPtr);
 
@@ -624,7 +715,7 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
 
 // Called every second after hostTimeout until all processing connections reap
 void ConnectionPool::SpecificPool::shutdown() {
-    stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
 
     // We're racing:
     //
@@ -658,7 +749,20 @@ void ConnectionPool::SpecificPool::shutdown() {
     invariant(_requests.empty());
     invariant(_checkedOutPool.empty());
 
-    _parent->_pools.erase(_hostAndPort);
+    _state = State::kShutdown;
+
+    // The parent's map usually holds the last reference to this pool, so keep it alive until our
+    // own lock has been released.
+    std::shared_ptr<SpecificPool> self;
+    {
+        stdx::lock_guard<stdx::mutex> parentLk(_parent->_mutex);
+        auto iter = _parent->_pools.find(_hostAndPort);
+        invariant(iter != _parent->_pools.end() && iter->second.get() == this);
+        self = std::move(iter->second);
+        _parent->_pools.erase(iter);
+    }
+
+    lk.unlock();
 }
 
 template <typename OwnershipPoolType>
@@ -688,29 +792,29 @@ void ConnectionPool::SpecificPool::updateStateInLock() {
 
         // If we were already running and the timer is the same as it was
         // before, nothing to do
-        if (_state == State::kRunning && _requestTimerExpiration == _requests.top().first)
+        if (_state == State::kRunning && _requestTimerExpiration == _requests.top().expiration)
             return;
 
         _state = State::kRunning;
 
         _requestTimer->cancelTimeout();
 
-        _requestTimerExpiration = _requests.top().first;
+        _requestTimerExpiration = _requests.top().expiration;
 
-        auto timeout = _requests.top().first - _parent->_factory->now();
+        auto timeout = _requests.top().expiration - _parent->_factory->now();
 
         // We set a timer for the most recent request, then invoke each timed
         // out request we couldn't service
         _requestTimer->setTimeout(timeout, [this]() {
-            stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+            stdx::unique_lock<stdx::mutex> lk(_mutex);
 
             auto now = _parent->_factory->now();
 
             while (_requests.size()) {
                 auto& x = _requests.top();
 
-                if (x.first <= now) {
-                    auto cb = std::move(x.second);
+                if (x.expiration <= now) {
+                    auto cb = std::move(x.cb);
                     _requests.pop();
 
                     lk.unlock();
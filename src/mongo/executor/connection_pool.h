@@ -134,7 +134,7 @@ public:
     size_t getNumConnectionsPerHost(const HostAndPort& hostAndPort) const;
 
 private:
-    void returnConnection(ConnectionInterface* connection);
+    std::shared_ptr<SpecificPool> _findPool(const HostAndPort& hostAndPort) const;
 
     std::string _name;
 
@@ -144,23 +144,21 @@ private:
 
     const std::unique_ptr<DependentTypeFactoryInterface> _factory;
 
-    // The global mutex for specific pool access and the generation counter
+    // Guards only the map below. Each SpecificPool has its own mutex for its state, and this one is
+    // never held while taking a pool's mutex.
     mutable stdx::mutex _mutex;
-    stdx::unordered_map<HostAndPort, std::unique_ptr<SpecificPool>> _pools;
+    stdx::unordered_map<HostAndPort, std::shared_ptr<SpecificPool>> _pools;
 };
 
 class ConnectionPool::ConnectionHandleDeleter {
 public:
     ConnectionHandleDeleter() = default;
-    ConnectionHandleDeleter(ConnectionPool* pool) : _pool(pool) {}
+    ConnectionHandleDeleter(SpecificPool* pool) : _pool(pool) {}
 
-    void operator()(ConnectionInterface* connection) {
-        if (_pool && connection)
-            _pool->returnConnection(connection);
-    }
+    void operator()(ConnectionInterface* connection);
 
 private:
-    ConnectionPool* _pool = nullptr;
+    SpecificPool* _pool = nullptr;
 };
 
 /**
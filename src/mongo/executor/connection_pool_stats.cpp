@@ -35,6 +35,17 @@
 
 namespace mongo {
 namespace executor {
+namespace {
+
+void appendCumulativeStats(BSONObjBuilder& builder, const ConnectionStatsPer& stats) {
+    builder.appendNumber("checkouts", stats.checkouts);
+    builder.appendNumber("totalWaitTimeMillis", durationCount<Milliseconds>(stats.totalWaitTime));
+    builder.appendNumber("refreshes", stats.refreshes);
+    builder.appendNumber("totalRefreshTimeMillis",
+                         durationCount<Milliseconds>(stats.totalRefreshTime));
+}
+
+}  // namespace
 
 ConnectionStatsPer::ConnectionStatsPer(size_t nInUse,
                                        size_t nAvailable,
@@ -49,6 +60,10 @@ ConnectionStatsPer& ConnectionStatsPer::operator+=(const ConnectionStatsPer& oth
     available += other.available;
     created += other.created;
     refreshing += other.refreshing;
+    checkouts += other.checkouts;
+    totalWaitTime += other.totalWaitTime;
+    refreshes += other.refreshes;
+    totalRefreshTime += other.totalRefreshTime;
 
     return *this;
 }
@@ -83,6 +98,7 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result) {
             poolInfo.appendNumber("poolAvailable", poolStats.available);
             poolInfo.appendNumber("poolCreated", poolStats.created);
             poolInfo.appendNumber("poolRefreshing", poolStats.refreshing);
+            appendCumulativeStats(poolInfo, poolStats);
             for (auto&& host : statsByPoolHost[pool.first]) {
                 BSONObjBuilder hostInfo(poolInfo.subobjStart(host.first.toString()));
                 auto hostStats = host.second;
@@ -90,6 +106,7 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result) {
                 hostInfo.appendNumber("available", hostStats.available);
                 hostInfo.appendNumber("created", hostStats.created);
                 hostInfo.appendNumber("refreshing", hostStats.refreshing);
+                appendCumulativeStats(hostInfo, hostStats);
             }
         }
     }
@@ -102,6 +119,7 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result) {
             hostInfo.appendNumber("available", hostStats.available);
             hostInfo.appendNumber("created", hostStats.created);
             hostInfo.appendNumber("refreshing", hostStats.refreshing);
+            appendCumulativeStats(hostInfo, hostStats);
         }
     }
 }
@@ -30,6 +30,7 @@
 
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/net/hostandport.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace executor {
@@ -49,6 +50,13 @@ struct ConnectionStatsPer {
     size_t available = 0u;
     size_t created = 0u;
     size_t refreshing = 0u;
+
+    // Cumulative counters, only maintained by the executor connection pools. The time a request
+    // waited before it was handed a connection, and the time spent refreshing idle connections.
+    size_t checkouts = 0u;
+    Milliseconds totalWaitTime{0};
+    size_t refreshes = 0u;
+    Milliseconds totalRefreshTime{0};
 };
 
 /**
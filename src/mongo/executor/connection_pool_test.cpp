@@ -34,6 +34,7 @@
 #include "mongo/executor/connection_pool_test_fixture.h"
 
 #include "mongo/executor/connection_pool.h"
+#include "mongo/executor/connection_pool_stats.h"
 #include "mongo/stdx/future.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/unittest.h"
@@ -1308,6 +1309,78 @@ TEST_F(ConnectionPoolTest, RefreshTimeoutsDontTimeoutRequests) {
     ASSERT(!conn2);
 }
 
+/**
+ * Verify that each host's pool reports how long requests waited for a connection and how long
+ * refreshes took.
+ */
+TEST_F(ConnectionPoolTest, PerHostCheckoutAndRefreshStats) {
+    ConnectionPool::Options options;
+
+    options.refreshRequirement = Seconds(3);
+    ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool", options);
+
+    auto now = Date_t::now();
+    PoolImpl::setNow(now);
+
+    const HostAndPort host1("host1", 27017);
+    const HostAndPort host2("host2", 27017);
+
+    // The first request to host1 waits a second for its connection to be set up
+    bool reachedA = false;
+    pool.get(host1, Seconds(10), [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+        ASSERT(swConn.isOK());
+        doneWith(swConn.getValue());
+        reachedA = true;
+    });
+    ASSERT(!reachedA);
+
+    PoolImpl::setNow(now + Seconds(1));
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT(reachedA);
+
+    // The second one is served from the pool without waiting
+    bool reachedB = false;
+    pool.get(host1, Seconds(10), [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+        ASSERT(swConn.isOK());
+        doneWith(swConn.getValue());
+        reachedB = true;
+    });
+    ASSERT(reachedB);
+
+    // A request to host2 is accounted separately
+    bool reachedC = false;
+    ConnectionImpl::pushSetup(Status::OK());
+    pool.get(host2, Seconds(10), [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+        ASSERT(swConn.isOK());
+        doneWith(swConn.getValue());
+        reachedC = true;
+    });
+    ASSERT(reachedC);
+
+    // Let host1's idle connection need a refresh, and make the refresh take two seconds
+    PoolImpl::setNow(now + Seconds(4));
+    ASSERT_EQ(ConnectionImpl::refreshQueueDepth(), 2u);
+    PoolImpl::setNow(now + Seconds(6));
+    ConnectionImpl::pushRefresh(Status::OK());
+    ConnectionImpl::pushRefresh(Status::OK());
+
+    ConnectionPoolStats stats;
+    pool.appendConnectionStats(&stats);
+
+    const auto& host1Stats = stats.statsByHost[host1];
+    ASSERT_EQ(host1Stats.checkouts, 2u);
+    ASSERT_EQ(host1Stats.totalWaitTime, Seconds(1));
+    ASSERT_EQ(host1Stats.refreshes, 1u);
+    ASSERT_EQ(host1Stats.totalRefreshTime, Seconds(2));
+
+    const auto& host2Stats = stats.statsByHost[host2];
+    ASSERT_EQ(host2Stats.checkouts, 1u);
+    ASSERT_EQ(host2Stats.totalWaitTime, Milliseconds(0));
+    ASSERT_EQ(host2Stats.refreshes, 1u);
+
+    ASSERT_EQ(stats.statsByPool["test pool"].checkouts, 3u);
+}
+
 }  // namespace connection_pool_test_details
 }  // namespace executor
 }  // namespace mongo
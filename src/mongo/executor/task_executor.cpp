@@ -67,6 +67,11 @@ TaskExecutor::RemoteCommandCallbackArgs::RemoteCommandCallbackArgs(
     const ResponseStatus& theResponse)
     : executor(theExecutor), myHandle(theHandle), request(theRequest), response(theResponse) {}
 
+StatusWith<TaskExecutor::CallbackHandle> TaskExecutor::scheduleRemoteCommandInline(
+    const RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb) {
+    return scheduleRemoteCommand(request, cb);
+}
+
 TaskExecutor::CallbackState* TaskExecutor::getCallbackFromHandle(const CallbackHandle& cbHandle) {
     return cbHandle.getCallback();
 }
@@ -234,6 +234,19 @@ public:
     virtual StatusWith<CallbackHandle> scheduleRemoteCommand(const RemoteCommandRequest& request,
                                                              const RemoteCommandCallbackFn& cb) = 0;
 
+    /**
+     * Like scheduleRemoteCommand(), except that "cb" may run directly on the thread that completes
+     * the network operation instead of being handed off to the executor's threads. This saves a
+     * thread handoff per remote command for callbacks that only record the response and wake up
+     * a waiter.
+     *
+     * Because it holds up the network thread, "cb" must be short and must never block, and in
+     * particular must not wait on this executor. Executors that cannot run callbacks inline
+     * schedule them as scheduleRemoteCommand() does, which is the default.
+     */
+    virtual StatusWith<CallbackHandle> scheduleRemoteCommandInline(
+        const RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb);
+
     /**
      * If the callback referenced by "cbHandle" hasn't already executed, marks it as
      * canceled and runnable.
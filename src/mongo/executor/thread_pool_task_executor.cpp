@@ -386,6 +386,16 @@ void remoteCommandFailedEarly(const TaskExecutor::CallbackArgs& cbData,
 
 StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteCommand(
     const RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb) {
+    return _scheduleRemoteCommand(request, cb, false);
+}
+
+StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteCommandInline(
+    const RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb) {
+    return _scheduleRemoteCommand(request, cb, true);
+}
+
+StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::_scheduleRemoteCommand(
+    const RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb, bool runInline) {
     RemoteCommandRequest scheduledRequest = request;
     if (request.timeout == RemoteCommandRequest::kNoTimeout) {
         scheduledRequest.expirationDate = RemoteCommandRequest::kNoExpirationDate;
@@ -409,7 +419,7 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteC
     _net->startCommand(
             cbHandle.getValue(),
             scheduledRequest,
-            [this, scheduledRequest, cbState, cb](const ResponseStatus& response) {
+            [this, scheduledRequest, cbState, cb, runInline](const ResponseStatus& response) {
                 using std::swap;
                 CallbackFn newCb = [cb, scheduledRequest, response](const CallbackArgs& cbData) {
                     remoteCommandFinished(cbData, cb, scheduledRequest, response);
@@ -422,6 +432,15 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteC
                        << redact(response.isOK() ? response.toString()
                                                  : response.status.toString());
                 swap(cbState->callback, newCb);
+                if (runInline) {
+                    // Track the callback as in progress in the pool so that shutdown and wait()
+                    // treat it exactly like one that was handed off, then run it right here.
+                    _poolInProgressQueue.splice(
+                        _poolInProgressQueue.end(), _networkInProgressQueue, cbState->iter);
+                    lk.unlock();
+                    runCallback(cbState);
+                    return;
+                }
                 scheduleIntoPool_inlock(&_networkInProgressQueue, cbState->iter, std::move(lk));
             })
         .transitional_ignore();
@@ -79,6 +79,8 @@ public:
     StatusWith<CallbackHandle> scheduleWorkAt(Date_t when, const CallbackFn& work) override;
     StatusWith<CallbackHandle> scheduleRemoteCommand(const RemoteCommandRequest& request,
                                                      const RemoteCommandCallbackFn& cb) override;
+    StatusWith<CallbackHandle> scheduleRemoteCommandInline(
+        const RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb) override;
     void cancel(const CallbackHandle& cbHandle) override;
     void wait(const CallbackHandle& cbHandle) override;
 
@@ -167,6 +169,14 @@ private:
      */
     void runCallback(std::shared_ptr<CallbackState> cbState);
 
+    /**
+     * Implements scheduleRemoteCommand() and scheduleRemoteCommandInline(). If "runInline" is
+     * true, the completion callback runs on the network thread rather than in the pool.
+     */
+    StatusWith<CallbackHandle> _scheduleRemoteCommand(const RemoteCommandRequest& request,
+                                                      const RemoteCommandCallbackFn& cb,
+                                                      bool runInline);
+
     bool _inShutdown_inlock() const;
     void _setState_inlock(State newState);
     stdx::unique_lock<stdx::mutex> _join(stdx::unique_lock<stdx::mutex> lk);
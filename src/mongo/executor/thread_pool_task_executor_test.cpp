@@ -120,6 +120,59 @@ TEST_F(ThreadPoolExecutorTest,
     ASSERT_TRUE(sharedCallbackStateDestroyed);
 }
 
+TEST_F(ThreadPoolExecutorTest, InlineRemoteCommandCallbackRunsOnNetworkThread) {
+    auto net = getNet();
+    auto& executor = getExecutor();
+    launchExecutorThread();
+
+    const RemoteCommandRequest request(HostAndPort("localhost", 27017),
+                                       "mydb",
+                                       BSON("whatsUp"
+                                            << "doc"),
+                                       nullptr);
+    auto status = getDetectableErrorStatus();
+    stdx::thread::id callbackThread;
+    const auto cbHandle = unittest::assertGet(executor.scheduleRemoteCommandInline(
+        request, [&](const TaskExecutor::RemoteCommandCallbackArgs& cbData) {
+            callbackThread = stdx::this_thread::get_id();
+            status = cbData.response.status;
+        }));
+
+    // The callback has run by the time the network operation completes, and it ran on the thread
+    // that completed it rather than on one of the executor's threads.
+    net->enterNetwork();
+    net->scheduleResponse(net->getNextReadyRequest(), net->now(), {ErrorCodes::NoSuchKey, "no"});
+    net->runReadyNetworkOperations();
+    net->exitNetwork();
+    ASSERT_EQUALS(ErrorCodes::NoSuchKey, status);
+    ASSERT(callbackThread == stdx::this_thread::get_id());
+
+    executor.wait(cbHandle);
+    executor.shutdown();
+    joinExecutorThread();
+}
+
+TEST_F(ThreadPoolExecutorTest, InlineRemoteCommandIsCanceledAtShutdown) {
+    auto& executor = getExecutor();
+    launchExecutorThread();
+
+    const RemoteCommandRequest request(HostAndPort("localhost", 27017),
+                                       "mydb",
+                                       BSON("whatsUp"
+                                            << "doc"),
+                                       nullptr);
+    auto status = getDetectableErrorStatus();
+    const auto cbHandle = unittest::assertGet(executor.scheduleRemoteCommandInline(
+        request, [&](const TaskExecutor::RemoteCommandCallbackArgs& cbData) {
+            status = cbData.response.status;
+        }));
+
+    executor.shutdown();
+    executor.wait(cbHandle);
+    joinExecutorThread();
+    ASSERT_EQUALS(ErrorCodes::CallbackCanceled, status);
+}
+
 TEST_F(ThreadPoolExecutorTest, ShutdownAndScheduleRaceDoesNotCrash) {
     // This is a regression test for SERVER-23686. It works by scheduling a work item in the
     // ThreadPoolTaskExecutor that blocks waiting to be signaled by this thread. Once that work item
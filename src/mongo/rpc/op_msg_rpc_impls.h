@@ -30,6 +30,7 @@
 
 #include "mongo/rpc/reply_builder_interface.h"
 #include "mongo/rpc/reply_interface.h"
+#include "mongo/util/net/message_buffer_pool.h"
 #include "mongo/util/net/op_msg.h"
 
 namespace mongo {
@@ -55,6 +56,11 @@ private:
 
 class OpMsgReplyBuilder final : public rpc::ReplyBuilderInterface {
 public:
+    // Replies are built in pooled buffers, and the networking layer returns them to the pool once
+    // they have been sent.
+    OpMsgReplyBuilder()
+        : _builder(MessageBufferPool::allocate(MessageBufferPool::kMinBufferSize)) {}
+
     ReplyBuilderInterface& setRawCommandReply(const BSONObj& reply) override {
         _builder.beginBody().appendElements(reply);
         return *this;
@@ -32,7 +32,12 @@
 
 #include "mongo/s/async_requests_sender.h"
 
+#include <algorithm>
+
 #include "mongo/client/remote_command_targeter.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/query/killcursors_request.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/client/shard_registry.h"
@@ -48,6 +53,38 @@ namespace {
 // Maximum number of retries for network and replication notMaster errors (per host).
 const int kMaxNumFailedHostRetryAttempts = 3;
 
+// Whether reads which may run on secondaries also send the request to a second eligible host when
+// the first host has not responded within the hedging delay.
+MONGO_EXPORT_SERVER_PARAMETER(enableHedgedReads, bool, false);
+
+// The hedging delay is this percentile of the operation latencies recently observed on the shard's
+// replica set. No hedged requests are sent to a shard until enough latencies are known.
+MONGO_EXPORT_SERVER_PARAMETER(hedgedReadsDelayPercentile, int, 95);
+
+/**
+ * Kills the cursor, if any, opened by a command whose response is being discarded.
+ */
+void killDiscardedCursor(executor::TaskExecutor* executor,
+                         const HostAndPort& host,
+                         const executor::RemoteCommandResponse& response) {
+    auto swCursorResponse = CursorResponse::parseFromBSON(response.data);
+    if (!swCursorResponse.isOK() || swCursorResponse.getValue().getCursorId() == 0) {
+        return;
+    }
+
+    const auto& cursorResponse = swCursorResponse.getValue();
+    const auto& nss = cursorResponse.getNSS();
+    executor::RemoteCommandRequest request(
+        host,
+        nss.db().toString(),
+        KillCursorsRequest(nss, {cursorResponse.getCursorId()}).toBSON(),
+        nullptr);
+
+    // Send kill request; discard callback handle, if any, or failure report, if not.
+    Status s = executor->scheduleRemoteCommand(request, [](auto const&) {}).getStatus();
+    std::move(s).ignore();
+}
+
 }  // namespace
 
 AsyncRequestsSender::AsyncRequestsSender(OperationContext* opCtx,
@@ -58,6 +95,7 @@ AsyncRequestsSender::AsyncRequestsSender(OperationContext* opCtx,
                                          Shard::RetryPolicy retryPolicy)
     : _opCtx(opCtx),
       _executor(executor),
+      _callbackState(std::make_shared<CallbackState>(this, executor)),
       _db(std::move(db)),
       _readPreference(readPreference),
       _retryPolicy(retryPolicy) {
@@ -86,6 +124,27 @@ AsyncRequestsSender::~AsyncRequestsSender() {
     while (!done()) {
         next();
     }
+
+    // Every remote has returned its response, but hedging timers may still have callbacks pending,
+    // which must run before this object goes away.
+    std::vector<executor::TaskExecutor::CallbackHandle> pendingCbHandles;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        for (const auto& remote : _remotes) {
+            if (remote.hedgeTimerCbHandle.isValid()) {
+                pendingCbHandles.push_back(remote.hedgeTimerCbHandle);
+            }
+        }
+    }
+
+    for (const auto& cbHandle : pendingCbHandles) {
+        _executor->wait(cbHandle);
+    }
+
+    // Any request still outstanding is the losing half of a hedged pair. Rather than waiting for a
+    // host which was slow enough to be hedged, detach its callback from this object.
+    stdx::lock_guard<stdx::mutex> lk(_callbackState->mutex);
+    _callbackState->ars = nullptr;
 }
 
 AsyncRequestsSender::Response AsyncRequestsSender::next() {
@@ -118,6 +177,31 @@ void AsyncRequestsSender::stopRetrying() {
     _stopRetrying = true;
 }
 
+void AsyncRequestsSender::addRequests(const std::vector<Request>& requests) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    const size_t firstNewRemote = _remotes.size();
+    for (const auto& request : requests) {
+        _remotes.emplace_back(request.shardId, request.cmdObj);
+    }
+
+    if (!_stopRetrying) {
+        _scheduleRequests(lk);
+        return;
+    }
+
+    // Fail the new requests rather than sending them. _ready() promotes the CallbackCanceled
+    // errors to the interruption status, if there was one.
+    for (size_t i = firstNewRemote; i < _remotes.size(); ++i) {
+        _remotes[i].swResponse = Status(ErrorCodes::CallbackCanceled,
+                                        "request was not sent because the ARS is stopping");
+    }
+
+    if (firstNewRemote < _remotes.size() && !*_notification) {
+        _notification->set();
+    }
+}
+
 bool AsyncRequestsSender::done() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     return std::all_of(
@@ -130,8 +214,21 @@ void AsyncRequestsSender::_cancelPendingRequests() {
 
     // Cancel all outstanding requests so they return immediately.
     for (auto& remote : _remotes) {
-        if (remote.cbHandle.isValid()) {
-            _executor->cancel(remote.cbHandle);
+        if (remote.hedgeTimerCbHandle.isValid()) {
+            _executor->cancel(remote.hedgeTimerCbHandle);
+        }
+
+        // A request outstanding for a remote which already has its response is the losing half of
+        // a hedged pair. Canceling it would not stop it on the remote host, but would lose the id
+        // of any cursor it opens there.
+        if (remote.swResponse) {
+            continue;
+        }
+
+        for (const auto& cbHandle : {remote.cbHandle, remote.hedgeCbHandle}) {
+            if (cbHandle.isValid()) {
+                _executor->cancel(cbHandle);
+            }
         }
     }
 }
@@ -211,7 +308,7 @@ void AsyncRequestsSender::_scheduleRequests(WithLock lk) {
         }
 
         // If the remote does not have a response or pending request, schedule remote work for it.
-        if (!remote.swResponse && !remote.cbHandle.isValid()) {
+        if (!remote.swResponse && !remote.cbHandle.isValid() && !remote.hedgeCbHandle.isValid()) {
             auto scheduleStatus = _scheduleRequest(lk, i);
             if (!scheduleStatus.isOK()) {
                 remote.swResponse = std::move(scheduleStatus);
@@ -226,7 +323,7 @@ void AsyncRequestsSender::_scheduleRequests(WithLock lk) {
     }
 }
 
-Status AsyncRequestsSender::_scheduleRequest(WithLock, size_t remoteIndex) {
+Status AsyncRequestsSender::_scheduleRequest(WithLock lk, size_t remoteIndex) {
     auto& remote = _remotes[remoteIndex];
 
     invariant(!remote.cbHandle.isValid());
@@ -240,30 +337,172 @@ Status AsyncRequestsSender::_scheduleRequest(WithLock, size_t remoteIndex) {
     executor::RemoteCommandRequest request(
         *remote.shardHostAndPort, _db, remote.cmdObj, _metadataObj, _opCtx);
 
-    auto callbackStatus = _executor->scheduleRemoteCommand(
-        request,
-        stdx::bind(
-            &AsyncRequestsSender::_handleResponse, this, stdx::placeholders::_1, remoteIndex));
+    // The response handler only records the response and signals the notification, so let it run
+    // on the network thread rather than bouncing through the executor's thread pool.
+    auto callbackStatus =
+        _executor->scheduleRemoteCommandInline(request, _makeResponseCallback(remoteIndex, false));
     if (!callbackStatus.isOK()) {
         return callbackStatus.getStatus();
     }
 
     remote.cbHandle = callbackStatus.getValue();
+    remote.requestTimeout = request.timeout;
+
+    _scheduleHedgeTimer(lk, remoteIndex);
     return Status::OK();
 }
 
+void AsyncRequestsSender::_scheduleHedgeTimer(WithLock, size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+
+    // Only reads which may run on a secondary are hedged, since they are the only requests for
+    // which any other host is eligible. Each remote is hedged at most once.
+    if (!enableHedgedReads.load() || _readPreference.pref == ReadPreference::PrimaryOnly ||
+        remote.hedgeTimerCbHandle.isValid() || remote.hedgeCbHandle.isValid()) {
+        return;
+    }
+
+    auto shard = remote.getShard();
+    if (!shard) {
+        return;
+    }
+
+    const int percentile = std::max(0, std::min(100, hedgedReadsDelayPercentile.load()));
+    const auto hedgeDelay = shard->getTargeter()->getOperationLatencyPercentile(percentile);
+    if (hedgeDelay < Milliseconds(0)) {
+        return;
+    }
+
+    auto timerStatus = _executor->scheduleWorkAt(
+        _executor->now() + hedgeDelay,
+        stdx::bind(
+            &AsyncRequestsSender::_sendHedgedRequest, this, stdx::placeholders::_1, remoteIndex));
+    if (timerStatus.isOK()) {
+        remote.hedgeTimerCbHandle = timerStatus.getValue();
+    }
+}
+
+void AsyncRequestsSender::_sendHedgedRequest(const executor::TaskExecutor::CallbackArgs& cbData,
+                                             size_t remoteIndex) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto& remote = _remotes[remoteIndex];
+    remote.hedgeTimerCbHandle = executor::TaskExecutor::CallbackHandle();
+
+    // Nothing to do if the timer was canceled or the request has completed in the meantime.
+    if (!cbData.status.isOK() || _stopRetrying || remote.swResponse ||
+        !remote.cbHandle.isValid()) {
+        return;
+    }
+
+    auto shard = remote.getShard();
+    if (!shard) {
+        return;
+    }
+
+    auto swHedgeHost =
+        shard->getTargeter()->findAlternateHost(_readPreference, *remote.shardHostAndPort);
+    if (!swHedgeHost.isOK()) {
+        LOG(2) << "Not hedging request to remote " << remote.shardId
+               << causedBy(swHedgeHost.getStatus());
+        return;
+    }
+
+    // The OperationContext may only be used on its own thread, so it is not attached to the hedged
+    // request. The timeout it implied is carried over from the original request instead.
+    executor::RemoteCommandRequest request(swHedgeHost.getValue(),
+                                           _db,
+                                           remote.cmdObj,
+                                           _metadataObj,
+                                           nullptr,
+                                           remote.requestTimeout);
+
+    auto callbackStatus =
+        _executor->scheduleRemoteCommandInline(request, _makeResponseCallback(remoteIndex, true));
+    if (!callbackStatus.isOK()) {
+        return;
+    }
+
+    LOG(1) << "Hedging request to remote " << remote.shardId << " at host "
+           << *remote.shardHostAndPort << " by also sending it to " << swHedgeHost.getValue();
+    remote.hedgeCbHandle = callbackStatus.getValue();
+}
+
+executor::TaskExecutor::RemoteCommandCallbackFn AsyncRequestsSender::_makeResponseCallback(
+    size_t remoteIndex, bool isHedge) {
+    return [ callbackState = _callbackState, remoteIndex, isHedge ](
+        const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData) {
+        stdx::lock_guard<stdx::mutex> lk(callbackState->mutex);
+        if (callbackState->ars) {
+            callbackState->ars->_handleResponse(cbData, remoteIndex, isHedge);
+        } else if (cbData.response.isOK()) {
+            // Only the losing request of a hedged pair can outlive the ARS
+            killDiscardedCursor(callbackState->executor, cbData.request.target, cbData.response);
+        }
+    };
+}
+
 void AsyncRequestsSender::_handleResponse(
-    const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData, size_t remoteIndex) {
+    const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData,
+    size_t remoteIndex,
+    bool isHedge) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
 
     auto& remote = _remotes[remoteIndex];
-    invariant(!remote.swResponse);
 
     // Clear the callback handle. This indicates that we are no longer waiting on a response from
-    // 'remote'.
-    remote.cbHandle = executor::TaskExecutor::CallbackHandle();
+    // 'remote' to this request.
+    auto& cbHandle = isHedge ? remote.hedgeCbHandle : remote.cbHandle;
+    auto& otherCbHandle = isHedge ? remote.cbHandle : remote.hedgeCbHandle;
+    cbHandle = executor::TaskExecutor::CallbackHandle();
+
+    // The other request of a hedged pair has already succeeded.
+    if (remote.swResponse) {
+        if (cbData.response.isOK()) {
+            killDiscardedCursor(_executor, cbData.request.target, cbData.response);
+        }
+        return;
+    }
+
+    Status status = cbData.response.status;
+    if (status.isOK()) {
+        status = getStatusFromCommandResult(cbData.response.data);
+    }
+
+    if (otherCbHandle.isValid()) {
+        if (!status.isOK()) {
+            // Let the other request of the hedged pair decide the outcome, but still tell the
+            // replica set monitor about the failure.
+            LOG(1) << "Hedged command to remote " << remote.shardId << " at host "
+                   << cbData.request.target << " failed, waiting for the other host"
+                   << causedBy(redact(status));
+            if (auto shard = remote.getShard()) {
+                shard->updateReplSetMonitor(cbData.request.target, status);
+            }
+            return;
+        }
+
+        // The other request is left to complete, so that any cursor it opens can be killed
+        LOG(1) << "Hedged command to remote " << remote.shardId << " was answered first by host "
+               << cbData.request.target;
+    }
+
+    if (remote.hedgeTimerCbHandle.isValid()) {
+        _executor->cancel(remote.hedgeTimerCbHandle);
+    }
+
+    // The latencies steer host selection away from slow hosts and determine the hedging delay,
+    // which is why they are only collected while hedging is enabled.
+    if (status.isOK() && cbData.response.elapsedMillis && enableHedgedReads.load() &&
+        _readPreference.pref != ReadPreference::PrimaryOnly) {
+        if (auto shard = remote.getShard()) {
+            shard->getTargeter()->noteOperationLatency(cbData.request.target,
+                                                       *cbData.response.elapsedMillis);
+        }
+    }
 
-    // Store the response or error.
+    // Store the response or error, and the host it came from.
+    remote.shardHostAndPort = cbData.request.target;
     if (cbData.response.status.isOK()) {
         remote.swResponse = std::move(cbData.response);
     } else {
@@ -35,6 +35,7 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/client/read_preference.h"
+#include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/client/shard.h"
@@ -78,6 +79,12 @@ namespace mongo {
  *     }
  * }
  *
+ * If the enableHedgedReads server parameter is set and the read preference allows reading from
+ * secondaries, a request which has not been answered within the hedging delay (a percentile of
+ * the latencies recently observed on the shard's replica set) is also sent to a second eligible
+ * host. The first successful response is returned. The other request is left to complete, even
+ * after the ARS is destroyed, so that any cursor it opens can be killed.
+ *
  * Does not throw exceptions.
  */
 class AsyncRequestsSender {
@@ -160,6 +167,18 @@ public:
      */
     void stopRetrying();
 
+    /**
+     * Schedules more requests on this ARS. Their responses are returned by next() along with the
+     * responses to the requests passed to the constructor, so a caller can send follow-up work to
+     * a remote as soon as it has responded, without waiting for the other remotes.
+     *
+     * If stopRetrying() has been called or the operation was interrupted, the new requests are not
+     * sent and next() returns a CallbackCanceled error (or the interruption error) for each.
+     *
+     * Note: Must only be called from the thread calling next().
+     */
+    void addRequests(const std::vector<Request>& requests);
+
 private:
     /**
      * We instantiate one of these per remote host.
@@ -200,12 +219,40 @@ private:
         // The callback handle to an outstanding request for this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
+        // The timeout of the request, which is reused for the hedged request.
+        Milliseconds requestTimeout{executor::RemoteCommandRequest::kNoTimeout};
+
+        // The callback handle to the timer which sends the hedged request for this remote.
+        executor::TaskExecutor::CallbackHandle hedgeTimerCbHandle;
+
+        // The callback handle to an outstanding hedged request for this remote.
+        executor::TaskExecutor::CallbackHandle hedgeCbHandle;
+
         // Whether this remote's result has been returned.
         bool done = false;
     };
 
     /**
-     * Cancels all outstanding requests on the TaskExecutor and sets the _stopRetrying flag.
+     * State shared with the callbacks of the remote commands sent by the ARS. The losing request of
+     * a hedged pair is neither canceled nor waited for, so its callback may run after the ARS has
+     * been destroyed, in which case it only kills any cursor the request opened.
+     */
+    struct CallbackState {
+        CallbackState(AsyncRequestsSender* ars, executor::TaskExecutor* executor)
+            : ars(ars), executor(executor) {}
+
+        // Serializes the callbacks with the destruction of the ARS
+        stdx::mutex mutex;
+
+        // The ARS to which the responses are delivered, or null once it has been destroyed
+        AsyncRequestsSender* ars;
+
+        executor::TaskExecutor* const executor;
+    };
+
+    /**
+     * Cancels all outstanding requests on the TaskExecutor and sets the _stopRetrying flag. The
+     * losing request of a hedged pair is not canceled.
      */
     void _cancelPendingRequests();
 
@@ -240,21 +287,48 @@ private:
      */
     Status _scheduleRequest(WithLock, size_t remoteIndex);
 
+    /**
+     * If hedged reads are enabled and allowed by the read preference, schedules a timer to send
+     * the hedged request for the remote at 'remoteIndex' once the hedging delay has elapsed.
+     */
+    void _scheduleHedgeTimer(WithLock, size_t remoteIndex);
+
+    /**
+     * The callback for the hedging timer. Sends the command of the remote at 'remoteIndex' to a
+     * second host, unless the first request has completed in the meantime.
+     */
+    void _sendHedgedRequest(const executor::TaskExecutor::CallbackArgs& cbData,
+                            size_t remoteIndex);
+
+    /**
+     * Returns the callback for a remote command, which calls _handleResponse for as long as the ARS
+     * exists.
+     */
+    executor::TaskExecutor::RemoteCommandCallbackFn _makeResponseCallback(size_t remoteIndex,
+                                                                          bool isHedge);
+
     /**
      * The callback for a remote command.
      *
      * 'remoteIndex' is the position of the relevant remote node in '_remotes', and therefore
      * indicates which node the response came from and where the response should be buffered.
+     * 'isHedge' tells whether this is the response to the hedged request.
      *
-     * Stores the response or error in the remote and signals the notification.
+     * Stores the response or error in the remote and signals the notification. While the other
+     * request of a hedged pair is outstanding, errors are not stored and the first success wins. A
+     * success which arrives second is discarded, killing any cursor it opened.
      */
     void _handleResponse(const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData,
-                         size_t remoteIndex);
+                         size_t remoteIndex,
+                         bool isHedge);
 
     OperationContext* _opCtx;
 
     executor::TaskExecutor* _executor;
 
+    // Shared with the callbacks of the remote commands
+    const std::shared_ptr<CallbackState> _callbackState;
+
     // The metadata obj to pass along with the command remote. Used to indicate that the command is
     // ok to run on secondaries.
     BSONObj _metadataObj;
@@ -0,0 +1,292 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/async_requests_sender.h"
+
+#include "mongo/client/remote_command_targeter_factory_mock.h"
+#include "mongo/client/remote_command_targeter_mock.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/executor/network_interface_mock.h"
+#include "mongo/s/catalog/type_shard.h"
+#include "mongo/s/sharding_test_fixture.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using executor::NetworkInterfaceMock;
+using executor::RemoteCommandRequest;
+using executor::RemoteCommandResponse;
+
+const NamespaceString kNss("testdb.testcoll");
+
+const HostAndPort kTestConfigShardHost("FakeConfigHost", 12345);
+const ShardId kTestShardId("FakeShard1");
+const HostAndPort kTestShardHost("FakeShard1Host", 12345);
+const HostAndPort kTestHedgeHost("FakeShard1Secondary", 12345);
+
+const Milliseconds kHedgeDelay(10);
+
+void setServerParameter(const std::string& name, const std::string& value) {
+    const auto& params = ServerParameterSet::getGlobal()->getMap();
+    const auto it = params.find(name);
+    invariant(it != params.end());
+    invariant(it->second->setFromString(value).isOK());
+}
+
+BSONObj makeCursorResponse(CursorId cursorId) {
+    return CursorResponse(kNss, cursorId, {BSON("_id" << 1)})
+        .toBSON(CursorResponse::ResponseType::InitialResponse);
+}
+
+class AsyncRequestsSenderTest : public ShardingTestFixture {
+public:
+    void setUp() override {
+        ShardingTestFixture::setUp();
+        setRemote(HostAndPort("ClientHost", 12345));
+
+        configTargeter()->setFindHostReturnValue(kTestConfigShardHost);
+
+        ShardType shardType;
+        shardType.setName(kTestShardId.toString());
+        shardType.setHost(kTestShardHost.toString());
+
+        auto targeter = stdx::make_unique<RemoteCommandTargeterMock>();
+        targeter->setConnectionStringReturnValue(ConnectionString(kTestShardHost));
+        targeter->setFindHostReturnValue(kTestShardHost);
+        targeter->setFindAlternateHostReturnValue(kTestHedgeHost);
+        targeter->setOperationLatencyPercentileReturnValue(kHedgeDelay);
+        targeterFactory()->addTargeterToReturn(ConnectionString(kTestShardHost),
+                                               std::move(targeter));
+
+        setupShards({shardType});
+
+        setServerParameter("enableHedgedReads", "true");
+    }
+
+    void tearDown() override {
+        setServerParameter("enableHedgedReads", "false");
+        ShardingTestFixture::tearDown();
+    }
+
+protected:
+    /**
+     * Sends a find to the test shard with a read preference which allows it to be hedged. The ARS
+     * is created on the test thread, so the hedging timer is known to be set when this returns.
+     */
+    std::unique_ptr<AsyncRequestsSender> makeARS() {
+        return stdx::make_unique<AsyncRequestsSender>(
+            operationContext(),
+            executor(),
+            kNss.db().toString(),
+            std::vector<AsyncRequestsSender::Request>{
+                AsyncRequestsSender::Request(kTestShardId, BSON("find" << kNss.coll()))},
+            ReadPreferenceSetting(ReadPreference::SecondaryPreferred),
+            Shard::RetryPolicy::kIdempotent);
+    }
+
+    /**
+     * Waits for the next request, which must be sent to 'expectedHost', without responding to it.
+     */
+    NetworkInterfaceMock::NetworkOperationIterator expectRequest(const HostAndPort& expectedHost) {
+        auto net = network();
+        net->enterNetwork();
+        auto noi = net->getNextReadyRequest();
+        net->exitNetwork();
+
+        ASSERT_EQ(expectedHost, noi->getRequest().target);
+        return noi;
+    }
+
+    /**
+     * Advances the clock past the hedging delay and waits for the hedged request.
+     */
+    NetworkInterfaceMock::NetworkOperationIterator expectHedgedRequest() {
+        auto net = network();
+        net->enterNetwork();
+        net->runUntil(net->now() + kHedgeDelay);
+        net->exitNetwork();
+
+        return expectRequest(kTestHedgeHost);
+    }
+
+    void respond(NetworkInterfaceMock::NetworkOperationIterator noi, const BSONObj& obj) {
+        auto net = network();
+        net->enterNetwork();
+        net->scheduleSuccessfulResponse(noi,
+                                        RemoteCommandResponse(obj, BSONObj(), Milliseconds(1)));
+        net->runReadyNetworkOperations();
+        net->exitNetwork();
+    }
+
+    /**
+     * Checks that the next request kills the cursor 'cursorId' on 'host'.
+     */
+    void expectKillCursors(const HostAndPort& host, CursorId cursorId) {
+        auto noi = expectRequest(host);
+        ASSERT_BSONOBJ_EQ(BSON("killCursors" << kNss.coll() << "cursors" << BSON_ARRAY(cursorId)),
+                          noi->getRequest().cmdObj);
+        respond(noi, BSON("ok" << 1));
+    }
+
+    void expectNoRequests() {
+        auto net = network();
+        net->enterNetwork();
+        ASSERT_FALSE(net->hasReadyRequests());
+        net->exitNetwork();
+    }
+};
+
+TEST_F(AsyncRequestsSenderTest, HedgedRequestWins) {
+    auto ars = makeARS();
+
+    auto originalNoi = expectRequest(kTestShardHost);
+    auto hedgeNoi = expectHedgedRequest();
+
+    auto future = launchAsync([&] { return ars->next(); });
+    respond(hedgeNoi, makeCursorResponse(0));
+
+    auto response = future.timed_get(kFutureTimeout);
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestHedgeHost, *response.shardHostAndPort);
+    ASSERT(ars->done());
+    ars.reset();
+
+    // The original request was left to complete, but opened no cursor which needs to be killed
+    respond(originalNoi, makeCursorResponse(0));
+    expectNoRequests();
+}
+
+TEST_F(AsyncRequestsSenderTest, OriginalRequestWins) {
+    auto ars = makeARS();
+
+    auto originalNoi = expectRequest(kTestShardHost);
+    auto hedgeNoi = expectHedgedRequest();
+
+    auto future = launchAsync([&] { return ars->next(); });
+    respond(originalNoi, makeCursorResponse(0));
+
+    auto response = future.timed_get(kFutureTimeout);
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestShardHost, *response.shardHostAndPort);
+    ASSERT(ars->done());
+
+    // The losing response is discarded while the ARS is still around
+    respond(hedgeNoi, makeCursorResponse(0));
+    expectNoRequests();
+}
+
+TEST_F(AsyncRequestsSenderTest, CursorOpenedByLosingRequestIsKilled) {
+    auto ars = makeARS();
+
+    auto originalNoi = expectRequest(kTestShardHost);
+    auto hedgeNoi = expectHedgedRequest();
+
+    auto future = launchAsync([&] { return ars->next(); });
+    respond(hedgeNoi, makeCursorResponse(123));
+
+    auto response = future.timed_get(kFutureTimeout);
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestHedgeHost, *response.shardHostAndPort);
+
+    // The losing request must not be canceled when the ARS goes away, or the id of the cursor it
+    // opens is never seen
+    ars.reset();
+
+    respond(originalNoi, makeCursorResponse(456));
+    expectKillCursors(kTestShardHost, 456);
+}
+
+TEST_F(AsyncRequestsSenderTest, FailedHedgedRequestWaitsForOriginal) {
+    auto ars = makeARS();
+
+    auto originalNoi = expectRequest(kTestShardHost);
+    auto hedgeNoi = expectHedgedRequest();
+
+    auto future = launchAsync([&] { return ars->next(); });
+    respond(hedgeNoi, BSON("ok" << 0 << "code" << ErrorCodes::NotMasterOrSecondary));
+    respond(originalNoi, makeCursorResponse(0));
+
+    auto response = future.timed_get(kFutureTimeout);
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestShardHost, *response.shardHostAndPort);
+}
+
+TEST_F(AsyncRequestsSenderTest, HedgeTimerCanceledByResponse) {
+    auto ars = makeARS();
+
+    auto originalNoi = expectRequest(kTestShardHost);
+
+    auto future = launchAsync([&] { return ars->next(); });
+    respond(originalNoi, makeCursorResponse(0));
+
+    auto response = future.timed_get(kFutureTimeout);
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestShardHost, *response.shardHostAndPort);
+    ars.reset();
+
+    // No hedged request is sent once the delay has passed
+    auto net = network();
+    net->enterNetwork();
+    net->runUntil(net->now() + kHedgeDelay * 2);
+    ASSERT_FALSE(net->hasReadyRequests());
+    net->exitNetwork();
+}
+
+TEST_F(AsyncRequestsSenderTest, NoHedgingForPrimaryOnlyReads) {
+    auto ars = stdx::make_unique<AsyncRequestsSender>(
+        operationContext(),
+        executor(),
+        kNss.db().toString(),
+        std::vector<AsyncRequestsSender::Request>{
+            AsyncRequestsSender::Request(kTestShardId, BSON("find" << kNss.coll()))},
+        ReadPreferenceSetting(ReadPreference::PrimaryOnly),
+        Shard::RetryPolicy::kIdempotent);
+
+    auto originalNoi = expectRequest(kTestShardHost);
+
+    auto net = network();
+    net->enterNetwork();
+    net->runUntil(net->now() + kHedgeDelay * 2);
+    ASSERT_FALSE(net->hasReadyRequests());
+    net->exitNetwork();
+
+    auto future = launchAsync([&] { return ars->next(); });
+    respond(originalNoi, makeCursorResponse(0));
+
+    auto response = future.timed_get(kFutureTimeout);
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestShardHost, *response.shardHostAndPort);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -247,10 +247,60 @@ void CatalogCache::onStaleConfigError(CachedCollectionRoutingInfo&& ccriToInvali
     } else if (itColl->second.routingInfo->getVersion() == ccri._cm->getVersion()) {
         // If the versions match, the last version of the routing information that we used is no
         // longer valid, so trigger a refresh.
+        if (itColl->second.refreshCompletionNotification) {
+            itColl->second.invalidatedDuringRefresh = true;
+        }
+
         itColl->second.needsRefresh = true;
     }
 }
 
+void CatalogCache::onChunkMetadataChanged(const NamespaceString& nss,
+                                          const ChunkVersion& version) {
+    stdx::lock_guard<stdx::mutex> lg(_mutex);
+
+    auto it = _databases.find(nss.db());
+    if (it == _databases.end()) {
+        // Nothing is routed through this database yet, so it will be loaded from scratch on first
+        // use anyways.
+        return;
+    }
+
+    auto& dbEntry = it->second;
+    auto& collections = dbEntry->collections;
+
+    auto itColl = collections.find(nss.ns());
+    if (itColl == collections.end()) {
+        // The collection was cached as unsharded, so it must have just been sharded. There is no
+        // routing table to keep serving, so just mark it for refresh on next access.
+        collections[nss.ns()].needsRefresh = true;
+        return;
+    }
+
+    auto& collEntry = itColl->second;
+    if (collEntry.needsRefresh || collEntry.refreshCompletionNotification) {
+        return;
+    }
+
+    const auto& existingVersion = collEntry.routingInfo->getVersion();
+    if (existingVersion.epoch() == version.epoch() && !existingVersion.isOlderThan(version)) {
+        return;
+    }
+
+    LOG(1) << "Chunk metadata for collection " << nss << " changed to version " << version
+           << "; refreshing routing table at version " << existingVersion;
+
+    // Only an update within the same epoch can be applied incrementally, otherwise the routing
+    // table must be rebuilt from scratch.
+    collEntry.refreshCompletionNotification = std::make_shared<Notification<Status>>();
+    _scheduleCollectionRefresh(lg,
+                               dbEntry,
+                               existingVersion.epoch() == version.epoch() ? collEntry.routingInfo
+                                                                          : nullptr,
+                               nss,
+                               1);
+}
+
 void CatalogCache::invalidateShardedCollection(const NamespaceString& nss) {
     stdx::lock_guard<stdx::mutex> lg(_mutex);
 
@@ -259,7 +309,12 @@ void CatalogCache::invalidateShardedCollection(const NamespaceString& nss) {
         return;
     }
 
-    it->second->collections[nss.ns()].needsRefresh = true;
+    auto& collEntry = it->second->collections[nss.ns()];
+    if (!collEntry.needsRefresh && collEntry.refreshCompletionNotification) {
+        collEntry.invalidatedDuringRefresh = true;
+    }
+
+    collEntry.needsRefresh = true;
 }
 
 void CatalogCache::invalidateShardedCollection(StringData ns) {
@@ -341,6 +396,7 @@ void CatalogCache::_scheduleCollectionRefresh(WithLock lk,
         } else {
             // Leave needsRefresh to true so that any subsequent get attempts will kick off
             // another round of refresh
+            collEntry.invalidatedDuringRefresh = false;
             collEntry.refreshCompletionNotification->set(status);
             collEntry.refreshCompletionNotification = nullptr;
         }
@@ -365,6 +421,18 @@ void CatalogCache::_scheduleCollectionRefresh(WithLock lk,
         invariant(it != collections.end());
         auto& collEntry = it->second;
 
+        if (collEntry.invalidatedDuringRefresh) {
+            log() << "Refresh for collection " << nss << " took " << t.millis()
+                  << " ms, but the collection was invalidated while it was running; refreshing "
+                  << "again";
+
+            // Keep the same notification, so that the callers waiting on it are only woken up once
+            // the metadata has been read after the invalidation
+            collEntry.invalidatedDuringRefresh = false;
+            _scheduleCollectionRefresh(lg, dbEntry, std::move(newRoutingInfo), nss, 1);
+            return;
+        }
+
         collEntry.needsRefresh = false;
         collEntry.refreshCompletionNotification->set(Status::OK());
         collEntry.refreshCompletionNotification = nullptr;
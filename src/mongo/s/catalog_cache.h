@@ -99,6 +99,18 @@ public:
      */
     void onStaleConfigError(CachedCollectionRoutingInfo&&);
 
+    /**
+     * Non-blocking method to be called when the chunk metadata for the specified namespace is
+     * known to have changed on the config server, with 'version' being the version of one of the
+     * changed chunks or, if only the collection entry changed, a version carrying the collection's
+     * new epoch.
+     *
+     * If the cached routing table is older than 'version', schedules an asynchronous refresh, but
+     * unlike onStaleConfigError keeps serving the cached routing table until the refresh completes.
+     * Does nothing if the database is not cached or if a refresh is already scheduled.
+     */
+    void onChunkMetadataChanged(const NamespaceString& nss, const ChunkVersion& version);
+
     /**
      * Non-blocking method, which indiscriminately causes the routing table for the specified
      * namespace to be refreshed the next time getCollectionRoutingInfo is called.
@@ -132,10 +144,18 @@ private:
         bool needsRefresh{true};
 
         // Contains a notification to be waited on for the refresh to complete (only available if
-        // needsRefresh is true)
+        // needsRefresh is true or a refresh was scheduled by onChunkMetadataChanged)
         std::shared_ptr<Notification<Status>> refreshCompletionNotification;
 
-        // Contains the cached routing information (only available if needsRefresh is false)
+        // Set when the entry is invalidated while a refresh scheduled by onChunkMetadataChanged is
+        // in progress. That refresh may have read the metadata before whatever caused the
+        // invalidation, so when it completes another refresh is scheduled instead of clearing
+        // needsRefresh.
+        bool invalidatedDuringRefresh{false};
+
+        // Contains the cached routing information (only available if needsRefresh is false, in
+        // which case it is served even while a refresh scheduled by onChunkMetadataChanged is
+        // in progress)
         std::shared_ptr<ChunkManager> routingInfo;
     };
 
@@ -160,7 +180,8 @@ private:
 
     /**
      * Non-blocking call which schedules an asynchronous refresh for the specified namespace. The
-     * namespace must be in the 'needRefresh' state.
+     * namespace must not have a refresh in progress and its refreshCompletionNotification must have
+     * been installed by the caller.
      */
     void _scheduleCollectionRefresh(WithLock,
                                     std::shared_ptr<DatabaseInfoEntry> dbEntry,
@@ -0,0 +1,347 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/catalog_cache_change_listener.h"
+
+#include "mongo/bson/util/bson_extract.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/query/getmore_request.h"
+#include "mongo/db/query/killcursors_request.h"
+#include "mongo/db/repl/optime.h"
+#include "mongo/db/service_context.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/s/catalog/type_collection.h"
+#include "mongo/s/catalog_cache.h"
+#include "mongo/s/client/shard_registry.h"
+#include "mongo/s/grid.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/exit.h"
+#include "mongo/util/log.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+
+const Milliseconds kRetryInterval(1000);
+
+const auto getCatalogCacheChangeListener =
+    ServiceContext::declareDecoration<std::unique_ptr<CatalogCacheChangeListener>>();
+
+/**
+ * Returns the timestamp of the newest entry in the config server's oplog, from which tailing
+ * starts.
+ */
+Timestamp getLastOplogTimestamp(OperationContext* opCtx, Shard* configShard) {
+    const auto response = uassertStatusOK(configShard->runCommand(
+        opCtx,
+        ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+        NamespaceString::kLocalDb.toString(),
+        BSON("find" << NamespaceString::kRsOplogNamespace.coll() << "sort"
+                    << BSON("$natural" << -1)
+                    << "limit"
+                    << 1
+                    << "projection"
+                    << BSON("ts" << 1)
+                    << "singleBatch"
+                    << true),
+        Shard::RetryPolicy::kIdempotent));
+    uassertStatusOK(response.commandStatus);
+
+    const auto cursorResponse = uassertStatusOK(CursorResponse::parseFromBSON(response.response));
+    uassert(ErrorCodes::NoMatchingDocument,
+            "The config server oplog is empty",
+            !cursorResponse.getBatch().empty());
+    return cursorResponse.getBatch().front()["ts"].timestamp();
+}
+
+/**
+ * Builds the tailable query for the oplog entries written to the sharding catalog after 'lastTs'.
+ * Only the fields needed by extractChanges are returned.
+ */
+BSONObj makeFindCommand(Timestamp lastTs) {
+    const auto applyOpsNsField = "o.applyOps.ns";
+
+    BSONObjBuilder cmdBob;
+    cmdBob.append("find", NamespaceString::kRsOplogNamespace.coll());
+    cmdBob.append("filter",
+                  BSON("ts" << BSON("$gt" << lastTs) << "$or"
+                            << BSON_ARRAY(BSON("ns" << BSON("$in" << BSON_ARRAY(
+                                                                 ChunkType::ConfigNS
+                                                                 << CollectionType::ConfigNS)))
+                                          << BSON(applyOpsNsField << ChunkType::ConfigNS))));
+    cmdBob.append("projection",
+                  BSON("ts" << 1 << "t" << 1 << "op" << 1 << "ns" << 1 << "o._id" << 1 << "o.ns"
+                            << 1
+                            << "o.lastmod"
+                            << 1
+                            << "o.lastmodEpoch"
+                            << 1
+                            << "o.applyOps.op"
+                            << 1
+                            << applyOpsNsField
+                            << 1
+                            << "o.applyOps.o.ns"
+                            << 1
+                            << "o.applyOps.o.lastmod"
+                            << 1
+                            << "o.applyOps.o.lastmodEpoch"
+                            << 1));
+    cmdBob.append("tailable", true);
+    cmdBob.append("oplogReplay", true);
+    cmdBob.append("awaitData", true);
+    return cmdBob.obj();
+}
+
+/**
+ * Appends to 'changes' the change described by a single CRUD operation 'op' on the sharding
+ * catalog, if there is one.
+ */
+void extractChangeFromOp(const BSONObj& op,
+                         std::vector<CatalogCacheChangeListener::Change>* changes) {
+    const auto opType = op["op"].str();
+    if ((opType != "i" && opType != "u") || op["o"].type() != Object) {
+        return;
+    }
+
+    const auto ns = op["ns"].str();
+    const auto o = op["o"].Obj();
+
+    if (ns == ChunkType::ConfigNS) {
+        std::string chunkNs;
+        if (!bsonExtractStringField(o, ChunkType::ns.name(), &chunkNs).isOK()) {
+            return;
+        }
+
+        auto swVersion = ChunkVersion::parseFromBSONForChunk(o);
+        if (!swVersion.isOK() || !swVersion.getValue().epoch().isSet()) {
+            return;
+        }
+
+        changes->push_back({NamespaceString(chunkNs), std::move(swVersion.getValue())});
+    } else if (ns == CollectionType::ConfigNS) {
+        // Collection entries are only interesting when they describe a new incarnation of the
+        // collection, which comes with a new epoch.
+        std::string collNs;
+        if (!bsonExtractStringField(o, CollectionType::fullNs.name(), &collNs).isOK() ||
+            o[CollectionType::epoch.name()].type() != jstOID) {
+            return;
+        }
+
+        changes->push_back(
+            {NamespaceString(collNs), ChunkVersion(0, 0, o[CollectionType::epoch.name()].OID())});
+    }
+}
+
+}  // namespace
+
+CatalogCacheChangeListener::CatalogCacheChangeListener() {
+    _thread = stdx::thread([this] { _listen(); });
+}
+
+CatalogCacheChangeListener::~CatalogCacheChangeListener() {
+    invariant(!_thread.joinable());
+}
+
+void CatalogCacheChangeListener::create(ServiceContext* serviceContext) {
+    invariant(!getCatalogCacheChangeListener(serviceContext));
+    getCatalogCacheChangeListener(serviceContext) =
+        stdx::make_unique<CatalogCacheChangeListener>();
+
+    // Register a shutdown task to terminate the listener thread.
+    registerShutdownTask(
+        [serviceContext] { CatalogCacheChangeListener::get(serviceContext)->shutdown(); });
+}
+
+CatalogCacheChangeListener* CatalogCacheChangeListener::get(ServiceContext* serviceContext) {
+    return getCatalogCacheChangeListener(serviceContext).get();
+}
+
+void CatalogCacheChangeListener::shutdown() {
+    {
+        stdx::lock_guard<stdx::mutex> scopedLock(_mutex);
+        if (_isShutdown) {
+            return;
+        }
+        _isShutdown = true;
+    }
+
+    _thread.join();
+    _thread = {};
+}
+
+std::vector<CatalogCacheChangeListener::Change> CatalogCacheChangeListener::extractChanges(
+    const BSONObj& oplogEntry) {
+    std::vector<Change> changes;
+
+    if (oplogEntry["op"].str() != "c") {
+        extractChangeFromOp(oplogEntry, &changes);
+        return changes;
+    }
+
+    const auto applyOps = oplogEntry["o"]["applyOps"];
+    if (applyOps.type() != Array) {
+        return changes;
+    }
+
+    for (const auto& op : applyOps.Obj()) {
+        if (op.type() == Object) {
+            extractChangeFromOp(op.Obj(), &changes);
+        }
+    }
+
+    return changes;
+}
+
+void CatalogCacheChangeListener::_listen() {
+    Client::initThread("CatalogCacheChangeListener");
+
+    boost::optional<Timestamp> lastTs;
+    CursorId cursorId = 0;
+
+    while (!_shutDownRequested()) {
+        auto opCtx = cc().makeOperationContext();
+
+        try {
+            auto const grid = Grid::get(opCtx.get());
+            auto const configShard = grid->shardRegistry()->getConfigShard();
+
+            if (!lastTs) {
+                lastTs = getLastOplogTimestamp(opCtx.get(), configShard.get());
+            }
+
+            // A getMore on an awaitData cursor without maxTimeMS blocks on the config server for
+            // up to a second waiting for new entries. The cursor lives on the node which was
+            // primary when it was opened, so a failover surfaces as an error below and tailing
+            // restarts from the last entry seen.
+            const BSONObj cmdObj = cursorId
+                ? GetMoreRequest(NamespaceString::kRsOplogNamespace,
+                                 cursorId,
+                                 boost::none,
+                                 boost::none,
+                                 boost::none,
+                                 boost::none)
+                      .toBSON()
+                : makeFindCommand(*lastTs);
+
+            const auto response = uassertStatusOK(
+                configShard->runCommand(opCtx.get(),
+                                        ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+                                        NamespaceString::kLocalDb.toString(),
+                                        cmdObj,
+                                        Shard::RetryPolicy::kNoRetry));
+            uassertStatusOK(response.commandStatus);
+
+            const auto cursorResponse =
+                uassertStatusOK(CursorResponse::parseFromBSON(response.response));
+            cursorId = cursorResponse.getCursorId();
+
+            // Only the last change to each collection in a batch needs to be reported, since a
+            // refresh picks up all the changes before it.
+            StringMap<ChunkVersion> latestVersions;
+            boost::optional<repl::OpTime> latestOpTime;
+            for (const auto& entry : cursorResponse.getBatch()) {
+                lastTs = entry["ts"].timestamp();
+
+                const auto changes = extractChanges(entry);
+                if (changes.empty()) {
+                    continue;
+                }
+
+                for (const auto& change : changes) {
+                    latestVersions[change.nss.ns()] = change.version;
+                }
+                latestOpTime = uassertStatusOK(repl::OpTime::parseFromOplogEntry(entry));
+            }
+
+            if (latestOpTime) {
+                // The entries read from the oplog need not be majority committed yet, whereas the
+                // refresh reads with majority read concern. Advancing the config optime makes the
+                // refresh wait for the changes to commit instead of reading a snapshot from
+                // before them.
+                grid->advanceConfigOpTime(*latestOpTime);
+
+                for (const auto& latestVersion : latestVersions) {
+                    grid->catalogCache()->onChunkMetadataChanged(
+                        NamespaceString(latestVersion.first), latestVersion.second);
+                }
+            }
+
+            if (!cursorId) {
+                // Tailable cursors are closed by the server if they reach the end of the oplog
+                // without returning anything, so back off before reopening.
+                MONGO_IDLE_THREAD_BLOCK;
+                opCtx->sleepFor(kRetryInterval);
+            }
+        } catch (const DBException& ex) {
+            cursorId = 0;
+
+            log() << "Failed to read sharding catalog changes from the config server; will retry "
+                  << "after " << kRetryInterval << causedBy(redact(ex.toStatus()));
+
+            try {
+                MONGO_IDLE_THREAD_BLOCK;
+                opCtx->sleepFor(kRetryInterval);
+            } catch (const DBException& ex) {
+                log() << "Catalog cache change listener interrupted" << causedBy(ex.toStatus());
+            }
+        }
+    }
+
+    if (!cursorId) {
+        return;
+    }
+
+    // Kill the tailable cursor instead of leaving it open on the config server until it times out
+    auto opCtx = cc().makeOperationContext();
+    try {
+        auto const configShard = Grid::get(opCtx.get())->shardRegistry()->getConfigShard();
+        const auto response = uassertStatusOK(configShard->runCommand(
+            opCtx.get(),
+            ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+            NamespaceString::kLocalDb.toString(),
+            KillCursorsRequest(NamespaceString::kRsOplogNamespace, {cursorId}).toBSON(),
+            Shard::RetryPolicy::kNoRetry));
+        uassertStatusOK(response.commandStatus);
+    } catch (const DBException& ex) {
+        LOG(1) << "Failed to kill the config server oplog cursor " << cursorId
+               << causedBy(redact(ex.toStatus()));
+    }
+}
+
+bool CatalogCacheChangeListener::_shutDownRequested() {
+    stdx::lock_guard<stdx::mutex> scopedLock(_mutex);
+    return _isShutdown;
+}
+
+}  // namespace mongo
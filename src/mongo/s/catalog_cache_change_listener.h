@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/s/chunk_version.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+
+class BSONObj;
+class ServiceContext;
+
+/**
+ * Tails the config server's oplog for writes to config.chunks and config.collections and forwards
+ * them to the CatalogCache, so that routing tables are refreshed as soon as chunks are split,
+ * merged or migrated, instead of the first request to use them getting a stale config error.
+ *
+ * Missing a notification is harmless, because stale config errors still trigger a refresh, so the
+ * listener simply starts tailing again from where it left off whenever the cursor is lost.
+ */
+class CatalogCacheChangeListener {
+    MONGO_DISALLOW_COPYING(CatalogCacheChangeListener);
+
+public:
+    /**
+     * A change to the routing metadata of a single collection, described by the version of one
+     * of its changed chunks or, for a change of the collection entry itself, by its new epoch.
+     */
+    struct Change {
+        NamespaceString nss;
+        ChunkVersion version;
+    };
+
+    CatalogCacheChangeListener();
+    ~CatalogCacheChangeListener();
+
+    /**
+     * Instantiates an instance of the CatalogCacheChangeListener, installs it on the specified
+     * service context and starts its background thread.
+     *
+     * This method is not thread-safe and must be called only once when the service is starting.
+     */
+    static void create(ServiceContext* serviceContext);
+
+    /**
+     * Retrieves the per-service instance of the CatalogCacheChangeListener (if created).
+     */
+    static CatalogCacheChangeListener* get(ServiceContext* serviceContext);
+
+    /**
+     * Signals shutdown and blocks until the listener thread has stopped.
+     */
+    void shutdown();
+
+    /**
+     * Extracts the routing metadata changes described by a single config server oplog entry,
+     * including the individual operations of an applyOps entry. Deletes are ignored, because every
+     * chunk metadata change which removes chunks also writes the chunk which replaces them and
+     * collection drops are reported through the update of the collection entry.
+     */
+    static std::vector<Change> extractChanges(const BSONObj& oplogEntry);
+
+private:
+    /**
+     * The main loop, which tails the config server's oplog. This runs in a separate thread.
+     */
+    void _listen();
+
+    /**
+     * Use to check whether or not shutdown has been requested for the running thread.
+     */
+    bool _shutDownRequested();
+
+    // The background thread which tails the oplog
+    stdx::thread _thread;
+
+    // Protects the state below
+    stdx::mutex _mutex;
+
+    // Used to shut down the background thread
+    bool _isShutdown{false};
+};
+
+}  // namespace mongo
@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/catalog_cache_change_listener.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/s/catalog/type_collection.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("TestDB", "TestColl");
+
+ChunkType makeChunk(const ChunkVersion& version) {
+    return ChunkType(kNss, {BSON("_id" << 0), BSON("_id" << 100)}, version, {"0"});
+}
+
+BSONObj makeOplogEntry(StringData opType, StringData ns, const BSONObj& o) {
+    return BSON("ts" << Timestamp(10, 1) << "t" << 1LL << "op" << opType << "ns" << ns << "o" << o);
+}
+
+TEST(CatalogCacheChangeListener, ChunkInsert) {
+    const ChunkVersion version(2, 3, OID::gen());
+    const auto changes = CatalogCacheChangeListener::extractChanges(
+        makeOplogEntry("i", ChunkType::ConfigNS, makeChunk(version).toConfigBSON()));
+
+    ASSERT_EQ(1U, changes.size());
+    ASSERT_EQ(kNss, changes[0].nss);
+    ASSERT_EQ(version, changes[0].version);
+}
+
+TEST(CatalogCacheChangeListener, ChunkOpsInsideApplyOps) {
+    const ChunkVersion version(5, 0, OID::gen());
+    const auto chunk = makeChunk(version);
+
+    const auto applyOps = BSON_ARRAY(BSON("op"
+                                          << "u"
+                                          << "ns"
+                                          << ChunkType::ConfigNS
+                                          << "o"
+                                          << chunk.toConfigBSON()
+                                          << "o2"
+                                          << BSON(ChunkType::name(chunk.getName())))
+                                     << BSON("op"
+                                             << "d"
+                                             << "ns"
+                                             << ChunkType::ConfigNS
+                                             << "o"
+                                             << BSON(ChunkType::name("SomeOtherChunk"))));
+    const auto changes = CatalogCacheChangeListener::extractChanges(
+        makeOplogEntry("c", "config.$cmd", BSON("applyOps" << applyOps)));
+
+    ASSERT_EQ(1U, changes.size());
+    ASSERT_EQ(kNss, changes[0].nss);
+    ASSERT_EQ(version, changes[0].version);
+}
+
+TEST(CatalogCacheChangeListener, CollectionEntryReportsEpoch) {
+    const OID epoch = OID::gen();
+
+    CollectionType coll;
+    coll.setNs(kNss);
+    coll.setEpoch(epoch);
+    coll.setKeyPattern(BSON("_id" << 1));
+    coll.setUnique(false);
+
+    const auto changes = CatalogCacheChangeListener::extractChanges(
+        makeOplogEntry("u", CollectionType::ConfigNS, coll.toBSON()));
+
+    ASSERT_EQ(1U, changes.size());
+    ASSERT_EQ(kNss, changes[0].nss);
+    ASSERT_EQ(ChunkVersion(0, 0, epoch), changes[0].version);
+}
+
+TEST(CatalogCacheChangeListener, IgnoresUnrelatedEntries) {
+    ASSERT(CatalogCacheChangeListener::extractChanges(
+               makeOplogEntry("i", "config.changelog", BSON("_id" << 1)))
+               .empty());
+    ASSERT(CatalogCacheChangeListener::extractChanges(
+               makeOplogEntry("d", ChunkType::ConfigNS, BSON(ChunkType::name("chunk"))))
+               .empty());
+    ASSERT(CatalogCacheChangeListener::extractChanges(
+               makeOplogEntry("c", "config.$cmd", BSON("drop" << "chunks")))
+               .empty());
+}
+
+}  // namespace
+}  // namespace mongo
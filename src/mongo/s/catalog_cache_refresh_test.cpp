@@ -36,6 +36,8 @@
 #include "mongo/s/catalog/type_database.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/catalog_cache_test_fixture.h"
+#include "mongo/s/grid.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace {
@@ -612,5 +614,112 @@ TEST_F(CatalogCacheRefreshTest, IncrementalLoadAfterMoveLastChunk) {
     ASSERT_EQ(version, cm->getVersion({"1"}));
 }
 
+TEST_F(CatalogCacheRefreshTest, ChunkMetadataChangeRefreshesWhileServingCachedRoutingInfo) {
+    const ShardKeyPattern shardKeyPattern(BSON("_id" << 1));
+
+    auto initialRoutingInfo(makeChunkManager(kNss, shardKeyPattern, nullptr, true, {}));
+    ASSERT_EQ(1, initialRoutingInfo->numChunks());
+
+    const ChunkVersion initialVersion = initialRoutingInfo->getVersion();
+    ChunkVersion version = initialVersion;
+    version.incMajor();
+
+    auto const catalogCache = Grid::get(serviceContext())->catalogCache();
+    catalogCache->onChunkMetadataChanged(kNss, version);
+
+    // The cached routing table is still served without blocking while the refresh is in progress
+    auto cachedRoutingInfo =
+        uassertStatusOK(catalogCache->getCollectionRoutingInfo(operationContext(), kNss));
+    ASSERT_EQ(initialVersion, cachedRoutingInfo.cm()->getVersion());
+
+    expectGetCollection(version.epoch(), shardKeyPattern);
+    expectFindOnConfigSendBSONObjVector([&]() {
+        ChunkType chunk1(
+            kNss, {shardKeyPattern.getKeyPattern().globalMin(), BSON("_id" << 0)}, version, {"0"});
+
+        version.incMinor();
+        ChunkType chunk2(
+            kNss, {BSON("_id" << 0), shardKeyPattern.getKeyPattern().globalMax()}, version, {"0"});
+
+        return std::vector<BSONObj>{chunk1.toConfigBSON(), chunk2.toConfigBSON()};
+    }());
+
+    auto future = launchAsync([&] {
+        auto client = serviceContext()->makeClient("Test");
+        auto opCtx = client->makeOperationContext();
+
+        while (true) {
+            auto routingInfo =
+                uassertStatusOK(catalogCache->getCollectionRoutingInfo(opCtx.get(), kNss));
+            if (!(routingInfo.cm()->getVersion() == initialVersion)) {
+                return routingInfo.cm()->numChunks();
+            }
+            sleepmillis(10);
+        }
+    });
+
+    ASSERT_EQ(2, future.timed_get(kFutureTimeout));
+}
+
+TEST_F(CatalogCacheRefreshTest, InvalidationDuringChunkMetadataChangeRefreshRefreshesAgain) {
+    const ShardKeyPattern shardKeyPattern(BSON("_id" << 1));
+
+    auto initialRoutingInfo(makeChunkManager(kNss, shardKeyPattern, nullptr, true, {}));
+    ASSERT_EQ(1, initialRoutingInfo->numChunks());
+
+    ChunkVersion version = initialRoutingInfo->getVersion();
+    version.incMajor();
+
+    auto const catalogCache = Grid::get(serviceContext())->catalogCache();
+    catalogCache->onChunkMetadataChanged(kNss, version);
+
+    // The invalidation arrives while the refresh started above is still in progress, so its result
+    // must not be served
+    catalogCache->invalidateShardedCollection(kNss);
+
+    auto future = launchAsync([&] {
+        auto client = serviceContext()->makeClient("Test");
+        auto opCtx = client->makeOperationContext();
+
+        auto routingInfo =
+            uassertStatusOK(catalogCache->getCollectionRoutingInfo(opCtx.get(), kNss));
+        return routingInfo.cm()->numChunks();
+    });
+
+    expectGetCollection(version.epoch(), shardKeyPattern);
+    expectFindOnConfigSendBSONObjVector([&]() {
+        ChunkType chunk1(
+            kNss, {shardKeyPattern.getKeyPattern().globalMin(), BSON("_id" << 0)}, version, {"0"});
+
+        version.incMinor();
+        ChunkType chunk2(
+            kNss, {BSON("_id" << 0), shardKeyPattern.getKeyPattern().globalMax()}, version, {"0"});
+
+        return std::vector<BSONObj>{chunk1.toConfigBSON(), chunk2.toConfigBSON()};
+    }());
+
+    // The second refresh is incremental from the result of the first one
+    expectGetCollection(version.epoch(), shardKeyPattern);
+    onFindCommand([&](const RemoteCommandRequest& request) {
+        const auto diffQuery =
+            assertGet(QueryRequest::makeFromFindCommand(kNss, request.cmdObj, false));
+        ASSERT_BSONOBJ_EQ(
+            BSON("ns" << kNss.ns() << "lastmod"
+                      << BSON("$gte" << Timestamp(version.majorVersion(), version.minorVersion()))),
+            diffQuery->getFilter());
+
+        version.incMajor();
+        ChunkType chunk2(kNss, {BSON("_id" << 0), BSON("_id" << 10)}, version, {"1"});
+
+        version.incMinor();
+        ChunkType chunk3(
+            kNss, {BSON("_id" << 10), shardKeyPattern.getKeyPattern().globalMax()}, version, {"0"});
+
+        return std::vector<BSONObj>{chunk2.toConfigBSON(), chunk3.toConfigBSON()};
+    });
+
+    ASSERT_EQ(3, future.timed_get(kFutureTimeout));
+}
+
 }  // namespace
 }  // namespace mongo
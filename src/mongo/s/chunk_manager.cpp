@@ -32,6 +32,7 @@
 
 #include "mongo/s/chunk_manager.h"
 
+#include <map>
 #include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
@@ -87,12 +88,12 @@ std::shared_ptr<Chunk> ChunkManager::findIntersectingChunk(const BSONObj& shardK
         }
     }
 
-    const auto it = _chunkMap.upper_bound(shardKey);
+    const auto it = _chunkMap.upperBound(shardKey);
     uassert(ErrorCodes::ShardKeyNotFound,
             str::stream() << "Cannot target single shard using key " << shardKey,
-            it != _chunkMap.end() && it->second->containsKey(shardKey));
+            it != _chunkMap.end() && (*it)->containsKey(shardKey));
 
-    return it->second;
+    return *it;
 }
 
 std::shared_ptr<Chunk> ChunkManager::findIntersectingChunkWithSimpleCollation(
@@ -166,26 +167,38 @@ void ChunkManager::getShardIdsForQuery(OperationContext* opCtx,
     // For now, we satisfy that assumption by adding a shard with no matches rather than returning
     // an empty set of shards.
     if (shardIds->empty()) {
-        shardIds->insert(_chunkMapViews.chunkRangeMap.begin()->second.shardId);
+        shardIds->insert(_chunkMapViews.shardIds[_chunkMapViews.rangeShards.front()]);
     }
 }
 
 void ChunkManager::getShardIdsForRange(const BSONObj& min,
                                        const BSONObj& max,
                                        std::set<ShardId>* shardIds) const {
-    auto it = _chunkMapViews.chunkRangeMap.upper_bound(min);
-    auto end = _chunkMapViews.chunkRangeMap.upper_bound(max);
+    const auto& rangeMaxKeys = _chunkMapViews.rangeMaxKeys;
+
+    size_t it = rangeMaxKeys.upperBound(KeyStringArray::encode(min));
+    size_t end = rangeMaxKeys.upperBound(KeyStringArray::encode(max));
 
     // The chunk range map must always cover the entire key space
-    invariant(it != _chunkMapViews.chunkRangeMap.end());
+    invariant(it != rangeMaxKeys.size());
 
     // We need to include the last chunk
-    if (end != _chunkMapViews.chunkRangeMap.cend()) {
+    if (end != rangeMaxKeys.size()) {
         ++end;
     }
 
+    // Adjacent ranges are on different shards, but a shard usually owns many ranges, so only the
+    // first range on each shard is inserted into the result
+    std::vector<bool> seenShards(_chunkMapViews.shardIds.size(), false);
+
     for (; it != end; ++it) {
-        shardIds->insert(it->second.shardId);
+        const uint32_t shardIdx = _chunkMapViews.rangeShards[it];
+        if (seenShards[shardIdx]) {
+            continue;
+        }
+
+        seenShards[shardIdx] = true;
+        shardIds->insert(_chunkMapViews.shardIds[shardIdx]);
 
         // No need to iterate through the rest of the ranges, because we already know we need to use
         // all shards.
@@ -335,8 +348,8 @@ std::string ChunkManager::toString() const {
     StringBuilder sb;
     sb << "ChunkManager: " << _nss.ns() << " key:" << _shardKeyPattern.toString() << '\n';
 
-    for (const auto& entry : _chunkMap) {
-        sb << "\t" << entry.second->toString() << '\n';
+    for (const auto& chunk : _chunkMap) {
+        sb << "\t" << chunk->toString() << '\n';
     }
 
     return sb.str();
@@ -344,16 +357,23 @@ std::string ChunkManager::toString() const {
 
 ChunkManager::ChunkMapViews ChunkManager::_constructChunkMapViews(const OID& epoch,
                                                                   const ChunkMap& chunkMap) {
+    KeyStringArray rangeMaxKeys;
+    std::vector<uint32_t> rangeShards;
+    std::vector<ShardId> shardIds;
 
-    ChunkRangeMap chunkRangeMap =
-        SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<ShardAndChunkRange>();
+    // Position of each shard in 'shardIds'
+    std::map<ShardId, uint32_t> shardIdxs;
 
     ShardVersionMap shardVersions;
 
-    ChunkMap::const_iterator current = chunkMap.cbegin();
+    // Bounds of the range constructed by the previous iteration
+    BSONObj prevRangeMin;
+    BSONObj prevRangeMax;
 
-    while (current != chunkMap.cend()) {
-        const auto& firstChunkInRange = current->second;
+    ChunkMap::const_iterator current = chunkMap.begin();
+
+    while (current != chunkMap.end()) {
+        const auto& firstChunkInRange = *current;
 
         // Tracks the max shard version for the shard on which the current range will reside
         auto shardVersionIt = shardVersions.find(firstChunkInRange->getShardId());
@@ -365,48 +385,46 @@ ChunkManager::ChunkMapViews ChunkManager::_constructChunkMapViews(const OID& epo
 
         auto& maxShardVersion = shardVersionIt->second;
 
-        current = std::find_if(
-            current,
-            chunkMap.cend(),
-            [&firstChunkInRange, &maxShardVersion](const ChunkMap::value_type& chunkMapEntry) {
-                const auto& currentChunk = chunkMapEntry.second;
-
-                if (currentChunk->getShardId() != firstChunkInRange->getShardId())
-                    return true;
-
-                if (currentChunk->getLastmod() > maxShardVersion)
-                    maxShardVersion = currentChunk->getLastmod();
+        auto rangeLast = current;
+        for (; current != chunkMap.end() &&
+             (*current)->getShardId() == firstChunkInRange->getShardId();
+             ++current) {
+            if ((*current)->getLastmod() > maxShardVersion)
+                maxShardVersion = (*current)->getLastmod();
 
-                return false;
-            });
-
-        const auto rangeLast = std::prev(current);
+            rangeLast = current;
+        }
 
         const BSONObj rangeMin = firstChunkInRange->getMin();
-        const BSONObj rangeMax = rangeLast->second->getMax();
-
-        const auto oldSize = chunkRangeMap.size();
-        const auto insertIterator = chunkRangeMap.insert(
-            chunkRangeMap.end(),
-            std::make_pair(
-                rangeMax,
-                ShardAndChunkRange{{rangeMin, rangeMax}, firstChunkInRange->getShardId()}));
+        const BSONObj rangeMax = (*rangeLast)->getMax();
+        const StringData encodedRangeMax = rangeLast.encodedMaxKey();
+
         uassert(ErrorCodes::ConflictingOperationInProgress,
                 str::stream() << "Metadata contains two chunks with the same max value "
                               << rangeMax,
-                oldSize + 1 == chunkRangeMap.size());
-
+                rangeMaxKeys.empty() || rangeMaxKeys.back() != encodedRangeMax);
 
-        if (insertIterator != chunkRangeMap.begin()) {
+        if (!rangeMaxKeys.empty()) {
             // Make sure there are no gaps in the ranges
             uassert(ErrorCodes::ConflictingOperationInProgress,
                     str::stream() << "Gap or an overlap between ranges "
-                                  << insertIterator->second.range.toString()
+                                  << ChunkRange(rangeMin, rangeMax).toString()
                                   << " and "
-                                  << std::prev(insertIterator)->second.range.toString(),
-                    SimpleBSONObjComparator::kInstance.evaluate(std::prev(insertIterator)->first ==
-                                                                rangeMin));
+                                  << ChunkRange(prevRangeMin, prevRangeMax).toString(),
+                    SimpleBSONObjComparator::kInstance.evaluate(prevRangeMax == rangeMin));
+        }
+
+        rangeMaxKeys.append(encodedRangeMax);
+
+        const auto shardIdx =
+            shardIdxs.emplace(firstChunkInRange->getShardId(), shardIds.size()).first->second;
+        if (shardIdx == shardIds.size()) {
+            shardIds.push_back(firstChunkInRange->getShardId());
         }
+        rangeShards.push_back(shardIdx);
+
+        prevRangeMin = rangeMin;
+        prevRangeMax = rangeMax;
 
         // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
         // somewhere, which should have been caught at chunk load time
@@ -414,14 +432,17 @@ ChunkManager::ChunkMapViews ChunkManager::_constructChunkMapViews(const OID& epo
     }
 
     if (!chunkMap.empty()) {
-        invariant(!chunkRangeMap.empty());
+        invariant(!rangeMaxKeys.empty());
         invariant(!shardVersions.empty());
 
-        checkAllElementsAreOfType(MinKey, chunkRangeMap.begin()->second.min());
-        checkAllElementsAreOfType(MaxKey, chunkRangeMap.rbegin()->first);
+        checkAllElementsAreOfType(MinKey, (*chunkMap.begin())->getMin());
+        checkAllElementsAreOfType(MaxKey, prevRangeMax);
     }
 
-    return {std::move(chunkRangeMap), std::move(shardVersions)};
+    return {std::move(rangeMaxKeys),
+            std::move(rangeShards),
+            std::move(shardIds),
+            std::move(shardVersions)};
 }
 
 std::shared_ptr<ChunkManager> ChunkManager::makeNew(
@@ -437,7 +458,7 @@ std::shared_ptr<ChunkManager> ChunkManager::makeNew(
                std::move(shardKeyPattern),
                std::move(defaultCollator),
                std::move(unique),
-               SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<std::shared_ptr<Chunk>>(),
+               ChunkMap(),
                {0, 0, epoch})
         .makeUpdated(chunks);
 }
@@ -445,7 +466,9 @@ std::shared_ptr<ChunkManager> ChunkManager::makeNew(
 std::shared_ptr<ChunkManager> ChunkManager::makeUpdated(
     const std::vector<ChunkType>& changedChunks) {
     const auto startingCollectionVersion = getVersion();
-    auto chunkMap = _chunkMap;
+
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    chunks.reserve(changedChunks.size());
 
     ChunkVersion collectionVersion = startingCollectionVersion;
     for (const auto& chunk : changedChunks) {
@@ -461,19 +484,7 @@ std::shared_ptr<ChunkManager> ChunkManager::makeUpdated(
         invariant(chunkVersion >= collectionVersion);
         collectionVersion = chunkVersion;
 
-        // Returns the first chunk with a max key that is > min - implies that the chunk overlaps
-        // min
-        const auto low = chunkMap.upper_bound(chunk.getMin());
-
-        // Returns the first chunk with a max key that is > max - implies that the next chunk cannot
-        // not overlap max
-        const auto high = chunkMap.upper_bound(chunk.getMax());
-
-        // Erase all chunks from the map, which overlap the chunk we got from the persistent store
-        chunkMap.erase(low, high);
-
-        // Insert only the chunk itself
-        chunkMap.insert(std::make_pair(chunk.getMax(), std::make_shared<Chunk>(chunk)));
+        chunks.push_back(std::make_shared<Chunk>(chunk));
     }
 
     // If at least one diff was applied, the metadata is correct, but it might not have changed so
@@ -492,7 +503,7 @@ std::shared_ptr<ChunkManager> ChunkManager::makeUpdated(
                          KeyPattern(getShardKeyPattern().getKeyPattern()),
                          CollatorInterface::cloneCollator(getDefaultCollator()),
                          isUnique(),
-                         std::move(chunkMap),
+                         _chunkMap.makeUpdated(chunks),
                          collectionVersion));
 }
 }  // namespace mongo
@@ -36,6 +36,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/s/chunk.h"
+#include "mongo/s/chunk_map.h"
 #include "mongo/s/chunk_version.h"
 #include "mongo/s/client/shard.h"
 #include "mongo/s/shard_key_pattern.h"
@@ -47,9 +48,6 @@ class CanonicalQuery;
 struct QuerySolutionNode;
 class OperationContext;
 
-// Ordered map from the max for each chunk to an entry describing the chunk
-using ChunkMap = BSONObjIndexedMap<std::shared_ptr<Chunk>>;
-
 // Map from a shard is to the max chunk version on that shard
 using ShardVersionMap = std::map<ShardId, ChunkVersion>;
 
@@ -78,8 +76,8 @@ public:
         bool operator!=(const ConstChunkIterator& other) const {
             return !(*this == other);
         }
-        const ChunkMap::mapped_type& operator*() const {
-            return _iter->second;
+        const std::shared_ptr<Chunk>& operator*() const {
+            return *_iter;
         }
 
     private:
@@ -160,7 +158,7 @@ public:
     ChunkVersion getVersion(const ShardId& shardId) const;
 
     ConstRangeOfChunks chunks() const {
-        return {ConstChunkIterator{_chunkMap.cbegin()}, ConstChunkIterator{_chunkMap.cend()}};
+        return {ConstChunkIterator{_chunkMap.begin()}, ConstChunkIterator{_chunkMap.end()}};
     }
 
     int numChunks() const {
@@ -236,33 +234,21 @@ public:
     std::string toString() const;
 
 private:
-    /**
-     * Represents a range of chunk keys [getMin(), getMax()) and the id of the shard on which they
-     * reside according to the metadata.
-     */
-    struct ShardAndChunkRange {
-        const BSONObj& min() const {
-            return range.getMin();
-        }
-
-        const BSONObj& max() const {
-            return range.getMax();
-        }
-
-        ChunkRange range;
-        ShardId shardId;
-    };
-
-    using ChunkRangeMap = BSONObjIndexedMap<ShardAndChunkRange>;
-
     /**
      * Contains different transformations of the chunk map for efficient querying
      */
     struct ChunkMapViews {
-        // Transformation of the chunk map containing what range of keys reside on which shard. The
-        // index is the max key of the respective range and the union of all ranges in a such
-        // constructed map must cover the complete space from [MinKey, MaxKey).
-        const ChunkRangeMap chunkRangeMap;
+        // Transformation of the chunk map containing what range of keys reside on which shard.
+        // Adjacent chunks on the same shard are coalesced into a single range. The union of all
+        // ranges must cover the complete space from [MinKey, MaxKey).
+        //
+        // 'rangeMaxKeys' holds the encoded max key of each range and 'rangeShards' the position in
+        // 'shardIds' of the shard on which the range resides.
+        const KeyStringArray rangeMaxKeys;
+        const std::vector<uint32_t> rangeShards;
+
+        // Distinct ids of the shards, which own chunks
+        const std::vector<ShardId> shardIds;
 
         // Map from shard id to the maximum chunk version for that shard. If a shard contains no
         // chunks, it won't be present in this map.
@@ -297,8 +283,8 @@ private:
     // Whether the sharding key is unique
     const bool _unique;
 
-    // Map from the max for each chunk to an entry describing the chunk. The union of all chunks'
-    // ranges must cover the complete space from [MinKey, MaxKey).
+    // All chunks of the collection indexed by their max key. The union of all chunks' ranges must
+    // cover the complete space from [MinKey, MaxKey).
     const ChunkMap _chunkMap;
 
     // Different transformations of the chunk map for efficient querying
@@ -0,0 +1,232 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/chunk_map.h"
+
+#include <algorithm>
+#include <map>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+const Ordering kAllAscending = Ordering::make(BSONObj());
+
+}  // namespace
+
+constexpr size_t ChunkMap::kMaxBlockSize;
+
+std::string KeyStringArray::encode(const BSONObj& key) {
+    // KeyString interprets field names as discriminators, so they must be stripped
+    BSONObjBuilder keyWithoutFieldNames;
+    for (const auto& elem : key) {
+        keyWithoutFieldNames.appendAs(elem, "");
+    }
+
+    const KeyString ks(KeyString::Version::V1, keyWithoutFieldNames.done(), kAllAscending);
+    return std::string(ks.getBuffer(), ks.getSize());
+}
+
+void KeyStringArray::append(StringData encodedKey) {
+    dassert(empty() || back() < encodedKey);
+    _bytes.append(encodedKey.rawData(), encodedKey.size());
+    _ends.push_back(_bytes.size());
+}
+
+size_t KeyStringArray::upperBound(StringData encodedKey) const {
+    size_t low = 0;
+    size_t high = size();
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if (encodedKey < (*this)[mid]) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return low;
+}
+
+ChunkMap::const_iterator& ChunkMap::const_iterator::operator++() {
+    if (++_idx == _map->_blocks[_blockIdx]->chunks.size()) {
+        ++_blockIdx;
+        _idx = 0;
+    }
+    return *this;
+}
+
+const std::shared_ptr<Chunk>& ChunkMap::const_iterator::operator*() const {
+    return _map->_blocks[_blockIdx]->chunks[_idx];
+}
+
+StringData ChunkMap::const_iterator::encodedMaxKey() const {
+    return _map->_blocks[_blockIdx]->maxKeys[_idx];
+}
+
+ChunkMap::const_iterator ChunkMap::upperBound(const BSONObj& key) const {
+    const std::string encodedKey = KeyStringArray::encode(key);
+
+    const size_t blockIdx = _blockMaxKeys.upperBound(encodedKey);
+    if (blockIdx == _blocks.size()) {
+        return end();
+    }
+
+    return const_iterator(this, blockIdx, _blocks[blockIdx]->maxKeys.upperBound(encodedKey));
+}
+
+ChunkMap ChunkMap::makeUpdated(const std::vector<std::shared_ptr<Chunk>>& changedChunks) const {
+    // Apply the changes among themselves in order, the same way they would be applied to the
+    // whole map, and remember the range of max keys each of them evicts. A chunk evicts all the
+    // chunks, whose max key is within (min, max] of the new chunk.
+    std::map<std::string, std::shared_ptr<Chunk>> updates;
+    std::vector<std::pair<std::string, std::string>> evictedRanges;
+
+    for (const auto& chunk : changedChunks) {
+        std::string minKey = KeyStringArray::encode(chunk->getMin());
+        std::string maxKey = KeyStringArray::encode(chunk->getMax());
+
+        updates.erase(updates.upper_bound(minKey), updates.upper_bound(maxKey));
+        updates.emplace(maxKey, chunk);
+
+        evictedRanges.emplace_back(std::move(minKey), std::move(maxKey));
+    }
+
+    // Coalesce the evicted ranges into disjoint, ascending ranges
+    std::sort(evictedRanges.begin(), evictedRanges.end());
+
+    std::vector<std::pair<std::string, std::string>> evicted;
+    for (auto& range : evictedRanges) {
+        if (!evicted.empty() && range.first <= evicted.back().second) {
+            evicted.back().second = std::max(evicted.back().second, range.second);
+        } else {
+            evicted.push_back(std::move(range));
+        }
+    }
+
+    ChunkMap updated;
+
+    // Chunks of the blocks which are being rebuilt, in ascending order of max key
+    std::vector<std::pair<std::string, std::shared_ptr<Chunk>>> pending;
+
+    auto updateIt = updates.begin();
+    auto evictedIt = evicted.begin();
+
+    for (size_t blockIdx = 0; blockIdx < _blocks.size(); ++blockIdx) {
+        const auto& block = _blocks[blockIdx];
+
+        // The block contains the chunks with max keys in (blockMin, blockMax]
+        const StringData blockMax = _blockMaxKeys[blockIdx];
+        if (blockIdx > 0) {
+            const StringData blockMin = _blockMaxKeys[blockIdx - 1];
+            while (evictedIt != evicted.end() && StringData(evictedIt->second) <= blockMin) {
+                ++evictedIt;
+            }
+        }
+
+        const bool hasEvictions =
+            evictedIt != evicted.end() && StringData(evictedIt->first) < blockMax;
+        const bool hasUpdates =
+            updateIt != updates.end() && StringData(updateIt->first) <= blockMax;
+
+        if (!hasEvictions && !hasUpdates) {
+            updated._appendChunks(pending);
+            pending.clear();
+
+            updated._appendBlock(block);
+            continue;
+        }
+
+        for (size_t i = 0; i < block->chunks.size(); ++i) {
+            const StringData maxKey = block->maxKeys[i];
+
+            while (updateIt != updates.end() && StringData(updateIt->first) < maxKey) {
+                pending.emplace_back(*updateIt++);
+            }
+
+            while (evictedIt != evicted.end() && StringData(evictedIt->second) < maxKey) {
+                ++evictedIt;
+            }
+
+            if (evictedIt != evicted.end() && StringData(evictedIt->first) < maxKey) {
+                continue;
+            }
+
+            pending.emplace_back(maxKey.toString(), block->chunks[i]);
+        }
+
+        while (updateIt != updates.end() && StringData(updateIt->first) <= blockMax) {
+            pending.emplace_back(*updateIt++);
+        }
+    }
+
+    pending.insert(pending.end(), updateIt, updates.end());
+    updated._appendChunks(pending);
+
+    return updated;
+}
+
+void ChunkMap::_appendBlock(std::shared_ptr<const Block> block) {
+    invariant(!block->chunks.empty());
+
+    _blockMaxKeys.append(block->maxKeys.back());
+    _size += block->chunks.size();
+    _blocks.push_back(std::move(block));
+}
+
+void ChunkMap::_appendChunks(
+    const std::vector<std::pair<std::string, std::shared_ptr<Chunk>>>& chunks) {
+    if (chunks.empty()) {
+        return;
+    }
+
+    // Spread the chunks evenly, so that rebuilding a block never leaves a sliver behind it
+    const size_t numBlocks = (chunks.size() + kMaxBlockSize - 1) / kMaxBlockSize;
+
+    auto it = chunks.begin();
+    for (size_t i = 0; i < numBlocks; ++i) {
+        const size_t blockSize =
+            (chunks.size() * (i + 1)) / numBlocks - (chunks.size() * i) / numBlocks;
+
+        auto block = std::make_shared<Block>();
+        block->chunks.reserve(blockSize);
+        for (size_t j = 0; j < blockSize; ++j, ++it) {
+            block->maxKeys.append(it->first);
+            block->chunks.push_back(it->second);
+        }
+
+        _appendBlock(std::move(block));
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,195 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/s/chunk.h"
+
+namespace mongo {
+
+class BSONObj;
+
+/**
+ * Contiguous array of KeyString-encoded keys, which must be appended in ascending order. Lookups
+ * are binary searches which compare the encoded keys with memcmp.
+ */
+class KeyStringArray {
+public:
+    /**
+     * Returns the KeyString encoding of 'key' under an all-ascending ordering. Field names are
+     * ignored, so a shard key and the corresponding chunk bounds encode identically.
+     */
+    static std::string encode(const BSONObj& key);
+
+    void append(StringData encodedKey);
+
+    size_t size() const {
+        return _ends.size();
+    }
+
+    bool empty() const {
+        return _ends.empty();
+    }
+
+    StringData operator[](size_t i) const {
+        const uint32_t begin = (i == 0) ? 0 : _ends[i - 1];
+        return StringData(_bytes.data() + begin, _ends[i] - begin);
+    }
+
+    StringData back() const {
+        return (*this)[size() - 1];
+    }
+
+    /**
+     * Returns the index of the first key, which is greater than 'encodedKey', or size() if there
+     * is no such key.
+     */
+    size_t upperBound(StringData encodedKey) const;
+
+private:
+    std::string _bytes;
+
+    // End offset in '_bytes' of each key
+    std::vector<uint32_t> _ends;
+};
+
+/**
+ * Ordered, immutable collection of the chunks of a sharded collection, indexed by the max key of
+ * each chunk. The union of all chunks' ranges must cover the complete space from [MinKey, MaxKey).
+ *
+ * The chunks are stored in blocks of at most kMaxBlockSize entries, whose max keys are kept
+ * KeyString-encoded in a KeyStringArray. Finding the chunk for a key is two binary searches over
+ * contiguous memory, one over the last key of each block and one within the block. Blocks are
+ * never modified once built and are shared between successive versions of the routing table, so
+ * an incremental refresh only rebuilds the blocks, which contain changed chunks.
+ */
+class ChunkMap {
+    struct Block;
+
+public:
+    static constexpr size_t kMaxBlockSize = 256;
+
+    class const_iterator {
+    public:
+        const_iterator() = default;
+
+        const_iterator& operator++();
+        const_iterator operator++(int) {
+            const_iterator prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return _blockIdx == other._blockIdx && _idx == other._idx;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+        const std::shared_ptr<Chunk>& operator*() const;
+
+        /**
+         * Returns the KeyString encoding of the max key of the chunk this iterator points to.
+         */
+        StringData encodedMaxKey() const;
+
+    private:
+        friend class ChunkMap;
+
+        const_iterator(const ChunkMap* map, size_t blockIdx, size_t idx)
+            : _map(map), _blockIdx(blockIdx), _idx(idx) {}
+
+        const ChunkMap* _map{nullptr};
+        size_t _blockIdx{0};
+        size_t _idx{0};
+    };
+
+    ChunkMap() = default;
+
+    const_iterator begin() const {
+        return const_iterator(this, 0, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, _blocks.size(), 0);
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    size_t numBlocks() const {
+        return _blocks.size();
+    }
+
+    /**
+     * Returns the first chunk whose max key is greater than 'key', or end() if there is none.
+     */
+    const_iterator upperBound(const BSONObj& key) const;
+
+    /**
+     * Returns a new ChunkMap with 'changedChunks' applied on top of this one. The changes must be
+     * sorted in ascending order by chunk version. Each change replaces all the chunks, which it
+     * overlaps at the time it is applied.
+     *
+     * Blocks, which do not contain any changed chunk, are shared with this ChunkMap.
+     */
+    ChunkMap makeUpdated(const std::vector<std::shared_ptr<Chunk>>& changedChunks) const;
+
+private:
+    struct Block {
+        KeyStringArray maxKeys;
+        std::vector<std::shared_ptr<Chunk>> chunks;
+    };
+
+    void _appendBlock(std::shared_ptr<const Block> block);
+
+    // Builds blocks out of 'chunks', each of which is paired with its encoded max key, and appends
+    // them
+    void _appendChunks(const std::vector<std::pair<std::string, std::shared_ptr<Chunk>>>& chunks);
+
+    std::vector<std::shared_ptr<const Block>> _blocks;
+
+    // The max key of the last chunk in each block
+    KeyStringArray _blockMaxKeys;
+
+    size_t _size{0};
+};
+
+}  // namespace mongo
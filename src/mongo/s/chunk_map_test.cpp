@@ -0,0 +1,180 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/chunk_map.h"
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const OID kEpoch = OID::gen();
+
+std::shared_ptr<Chunk> makeChunk(const BSONObj& min,
+                                 const BSONObj& max,
+                                 const ShardId& shardId,
+                                 int majorVersion) {
+    ChunkType chunk;
+    chunk.setNS("TestDB.TestColl");
+    chunk.setMin(min);
+    chunk.setMax(max);
+    chunk.setShard(shardId);
+    chunk.setVersion(ChunkVersion(majorVersion, 0, kEpoch));
+    return std::make_shared<Chunk>(chunk);
+}
+
+BSONObj key(int value) {
+    return BSON("x" << value);
+}
+
+/**
+ * Returns chunks [MinKey, 0), [0, 1), ..., [numChunks - 2, MaxKey).
+ */
+std::vector<std::shared_ptr<Chunk>> makeChunks(int numChunks) {
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    for (int i = 0; i < numChunks; ++i) {
+        chunks.push_back(makeChunk(i == 0 ? BSON("x" << MINKEY) : key(i - 1),
+                                   i == numChunks - 1 ? BSON("x" << MAXKEY) : key(i),
+                                   ShardId(i % 2 ? "shard0" : "shard1"),
+                                   1));
+    }
+    return chunks;
+}
+
+void assertCoversKeySpace(const ChunkMap& chunkMap) {
+    ASSERT(!chunkMap.empty());
+
+    size_t count = 0;
+    BSONObj prevMax;
+    for (const auto& chunk : chunkMap) {
+        if (count++ == 0) {
+            ASSERT_BSONOBJ_EQ(BSON("x" << MINKEY), chunk->getMin());
+        } else {
+            ASSERT_BSONOBJ_EQ(prevMax, chunk->getMin());
+        }
+        prevMax = chunk->getMax();
+    }
+
+    ASSERT_BSONOBJ_EQ(BSON("x" << MAXKEY), prevMax);
+    ASSERT_EQ(chunkMap.size(), count);
+}
+
+TEST(KeyStringArray, EncodingIgnoresFieldNamesAndPreservesOrder) {
+    ASSERT_EQ(KeyStringArray::encode(BSON("a" << 1)), KeyStringArray::encode(BSON("b" << 1)));
+    ASSERT_EQ(KeyStringArray::encode(BSON("a" << 1)), KeyStringArray::encode(BSON("a" << 1.0)));
+    ASSERT_LT(KeyStringArray::encode(BSON("a" << MINKEY)), KeyStringArray::encode(BSON("a" << -1)));
+    ASSERT_LT(KeyStringArray::encode(BSON("a" << 2)), KeyStringArray::encode(BSON("a" << 10)));
+    ASSERT_LT(KeyStringArray::encode(BSON("a" << 10)), KeyStringArray::encode(BSON("a"
+                                                                                    << "")));
+    ASSERT_LT(KeyStringArray::encode(BSON("a" << 1)),
+              KeyStringArray::encode(BSON("a" << 1 << "b" << MINKEY)));
+}
+
+TEST(KeyStringArray, UpperBound) {
+    KeyStringArray keys;
+    for (int i = 0; i < 10; i += 2) {
+        keys.append(KeyStringArray::encode(key(i)));
+    }
+
+    ASSERT_EQ(0U, keys.upperBound(KeyStringArray::encode(key(-1))));
+    ASSERT_EQ(1U, keys.upperBound(KeyStringArray::encode(key(0))));
+    ASSERT_EQ(2U, keys.upperBound(KeyStringArray::encode(key(3))));
+    ASSERT_EQ(5U, keys.upperBound(KeyStringArray::encode(key(8))));
+}
+
+TEST(ChunkMap, UpperBoundFindsContainingChunk) {
+    const int kNumChunks = 1000;
+    const auto chunkMap = ChunkMap().makeUpdated(makeChunks(kNumChunks));
+
+    ASSERT_EQ(static_cast<size_t>(kNumChunks), chunkMap.size());
+    ASSERT_GT(chunkMap.numBlocks(), 1U);
+    assertCoversKeySpace(chunkMap);
+
+    for (int i = -10; i < kNumChunks + 10; ++i) {
+        auto it = chunkMap.upperBound(key(i));
+        ASSERT(it != chunkMap.end());
+        ASSERT((*it)->containsKey(key(i)));
+    }
+
+    ASSERT(chunkMap.upperBound(BSON("x" << MAXKEY)) == chunkMap.end());
+}
+
+TEST(ChunkMap, SplitSharesUntouchedBlocks) {
+    const auto chunkMap = ChunkMap().makeUpdated(makeChunks(2000));
+
+    // Split [500, 501) into [500, 500.5) and [500.5, 501)
+    const auto updated = chunkMap.makeUpdated(
+        {makeChunk(key(500), BSON("x" << 500.5), ShardId("shard1"), 2),
+         makeChunk(BSON("x" << 500.5), key(501), ShardId("shard1"), 2)});
+
+    ASSERT_EQ(chunkMap.size() + 1, updated.size());
+    assertCoversKeySpace(updated);
+
+    auto it = updated.upperBound(BSON("x" << 500.7));
+    ASSERT_BSONOBJ_EQ(BSON("x" << 500.5), (*it)->getMin());
+
+    // Chunks away from the split are shared with the previous version
+    ASSERT_EQ((*chunkMap.upperBound(key(10))).get(), (*updated.upperBound(key(10))).get());
+    ASSERT_EQ((*chunkMap.upperBound(key(1990))).get(), (*updated.upperBound(key(1990))).get());
+}
+
+TEST(ChunkMap, MergeAndMoveReplaceOverlappedChunks) {
+    const auto chunkMap = ChunkMap().makeUpdated(makeChunks(1000));
+
+    // Merge [100, 400) into one chunk, then move part of it elsewhere through a later split
+    const auto updated =
+        chunkMap.makeUpdated({makeChunk(key(100), key(400), ShardId("shard0"), 2),
+                              makeChunk(key(100), key(200), ShardId("shard2"), 3),
+                              makeChunk(key(200), key(400), ShardId("shard0"), 3)});
+
+    ASSERT_EQ(chunkMap.size() - 300 + 2, updated.size());
+    assertCoversKeySpace(updated);
+
+    ASSERT_EQ(ShardId("shard2"), (*updated.upperBound(key(150)))->getShardId());
+    ASSERT_EQ(ShardId("shard0"), (*updated.upperBound(key(399)))->getShardId());
+}
+
+TEST(ChunkMap, LaterChangeOverridesEarlierOverlappingChange) {
+    const auto chunkMap = ChunkMap().makeUpdated(makeChunks(10));
+
+    // A chunk [0, 5) split into [0, 2) and [2, 5), each applied after the merge which created it
+    const auto updated = chunkMap.makeUpdated({makeChunk(key(0), key(5), ShardId("shard0"), 2),
+                                               makeChunk(key(0), key(2), ShardId("shard1"), 3),
+                                               makeChunk(key(2), key(5), ShardId("shard0"), 3)});
+
+    assertCoversKeySpace(updated);
+    ASSERT_EQ(ShardId("shard1"), (*updated.upperBound(key(1)))->getShardId());
+    ASSERT_BSONOBJ_EQ(key(2), (*updated.upperBound(key(2)))->getMin());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -194,7 +194,9 @@ StatusWith<Shard::CommandResponse> ShardRemote::_runCommand(OperationContext* op
                str::stream() << "Failed to run remote command request " << request.toString());
 
     TaskExecutor* executor = Grid::get(opCtx)->getExecutorPool()->getFixedExecutor();
-    auto swCallbackHandle = executor->scheduleRemoteCommand(
+    // The callback only stores the response, so let it run on the network thread rather than
+    // wait for a free executor thread before this one is woken.
+    auto swCallbackHandle = executor->scheduleRemoteCommandInline(
         request, [&response](const RemoteCommandCallbackArgs& args) { response = args.response; });
     if (!swCallbackHandle.isOK()) {
         return swCallbackHandle.getStatus();
@@ -265,6 +265,7 @@ Status ChunkManagerTargeter::init(OperationContext* opCtx) {
     }
 
     _routingInfo = std::move(routingInfoStatus.getValue());
+    _lastTargetedChunk.reset();
 
     return Status::OK();
 }
@@ -574,7 +575,20 @@ Status ChunkManagerTargeter::targetQuery(
 std::unique_ptr<ShardEndpoint> ChunkManagerTargeter::targetShardKey(const BSONObj& shardKey,
                                                                     const BSONObj& collation,
                                                                     long long estDataSize) const {
-    auto chunk = _routingInfo->cm()->findIntersectingChunk(shardKey, collation);
+    // The chunk map lookup also checks whether the collation allows targeting a single shard, so
+    // only keys with simple collation can skip it.
+    const bool hasSimpleCollation =
+        SimpleBSONObjComparator::kInstance.evaluate(collation == CollationSpec::kSimpleSpec);
+
+    std::shared_ptr<Chunk> chunk;
+    if (hasSimpleCollation && _lastTargetedChunk && _lastTargetedChunk->containsKey(shardKey)) {
+        chunk = _lastTargetedChunk;
+    } else {
+        chunk = _routingInfo->cm()->findIntersectingChunk(shardKey, collation);
+        if (hasSimpleCollation) {
+            _lastTargetedChunk = chunk;
+        }
+    }
 
     // Track autosplit stats for sharded collections
     // Note: this is only best effort accounting and is not accurate.
@@ -41,6 +41,7 @@
 
 namespace mongo {
 
+class Chunk;
 class ChunkManager;
 class OperationContext;
 class Shard;
@@ -147,6 +148,10 @@ private:
      * Also has the side effect of updating the chunks stats with an estimate of the amount of
      * data targeted at this shard key.
      *
+     * Consecutive writes in a batch commonly go to the same chunk (for example, inserts with a
+     * monotonically increasing shard key), so the last chunk found is remembered and checked
+     * before searching the chunk map.
+     *
      * If 'collation' is empty, we use the collection default collation for targeting.
      */
     std::unique_ptr<ShardEndpoint> targetShardKey(const BSONObj& doc,
@@ -167,6 +172,10 @@ private:
 
     // Map of shard->remote shard version reported from stale errors
     ShardVersionMap _remoteShardVersions;
+
+    // The chunk which the last shard key with simple collation was targeted to. Belongs to the
+    // current _routingInfo and is reset whenever that is reloaded.
+    mutable std::shared_ptr<Chunk> _lastTargetedChunk;
 };
 
 }  // namespace mongo
@@ -119,10 +119,17 @@ public:
         : BalancerControlCommand("balancerStatus", "_configsvrBalancerStatus", ActionType::find) {}
 };
 
+class BalancerDryRunCommand : public BalancerControlCommand {
+public:
+    BalancerDryRunCommand()
+        : BalancerControlCommand("balancerDryRun", "_configsvrBalancerDryRun", ActionType::find) {}
+};
+
 MONGO_INITIALIZER(ClusterBalancerControlCommands)(InitializerContext* context) {
     new BalancerStartCommand();
     new BalancerStopCommand();
     new BalancerStatusCommand();
+    new BalancerDryRunCommand();
 
     return Status::OK();
 }
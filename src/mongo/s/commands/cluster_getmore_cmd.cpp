@@ -78,17 +78,22 @@ public:
         help << "retrieve more documents for a cursor id";
     }
 
-    Status checkAuthForCommand(Client* client,
-                               const std::string& dbname,
-                               const BSONObj& cmdObj) final {
+    Status checkAuthForOperation(OperationContext* opCtx,
+                                 const std::string& dbname,
+                                 const BSONObj& cmdObj) final {
         StatusWith<GetMoreRequest> parseStatus = GetMoreRequest::parseFromBSON(dbname, cmdObj);
         if (!parseStatus.isOK()) {
             return parseStatus.getStatus();
         }
         const GetMoreRequest& request = parseStatus.getValue();
 
-        return AuthorizationSession::get(client)->checkAuthForGetMore(
+        auto authzSession = AuthorizationSession::get(opCtx->getClient());
+        auto status = authzSession->checkAuthForGetMore(
             request.nss, request.cursorid, request.term.is_initialized());
+        if (status.isOK()) {
+            AuthorizedGetMoreRequest::get(opCtx).set(cmdObj, std::move(parseStatus.getValue()));
+        }
+        return status;
     }
 
     bool run(OperationContext* opCtx,
@@ -98,7 +103,8 @@ public:
         // Counted as a getMore, not as a command.
         globalOpCounters.gotGetMore();
 
-        StatusWith<GetMoreRequest> parseStatus = GetMoreRequest::parseFromBSON(dbname, cmdObj);
+        StatusWith<GetMoreRequest> parseStatus =
+            AuthorizedGetMoreRequest::get(opCtx).take(dbname, cmdObj);
         if (!parseStatus.isOK()) {
             return appendCommandStatus(result, parseStatus.getStatus());
         }
@@ -152,7 +152,7 @@ void execCommandClient(OperationContext* opCtx,
             str::stream() << "Invalid database name: '" << dbname << "'",
             NamespaceString::validDBName(dbname, NamespaceString::DollarInDbNameBehavior::Allow));
 
-    StringMap<int> topLevelFields;
+    DuplicateTopLevelFieldChecker topLevelFields;
     for (auto&& element : request.body) {
         StringData fieldName = element.fieldNameStringData();
         if (fieldName == "help" && element.type() == Bool && element.Bool()) {
@@ -164,10 +164,7 @@ void execCommandClient(OperationContext* opCtx,
             return;
         }
 
-        uassert(ErrorCodes::FailedToParse,
-                str::stream() << "Parsed command object contains duplicate top level key: "
-                              << fieldName,
-                topLevelFields[fieldName]++ == 0);
+        topLevelFields.check(fieldName);
     }
 
     Status status = Command::checkAuthorization(c, opCtx, request);
@@ -32,12 +32,15 @@
 
 #include "mongo/s/query/async_results_merger.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/client/remote_command_targeter.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/killcursors_request.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/s/client/shard_registry.h"
@@ -51,6 +54,14 @@ namespace {
 // Maximum number of retries for network and replication notMaster errors (per host).
 const int kMaxNumFailedHostRetryAttempts = 3;
 
+// In a sorted merge, the next batch is requested from a remote as soon as it has this many or fewer
+// results buffered, so that the merge does not have to wait for it once the buffer drains. A
+// negative value only requests a batch once the merge needs it.
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryMergeReadAheadDocs, int, 10);
+
+// The widest sort pattern whose keys can be KeyString encoded, bounded by what Ordering describes.
+const int kMaxSortKeyEncodingFields = 32;
+
 /**
  * Returns the sort key out of the $sortKey metadata field in 'obj'. This object is of the form
  * {'': 'firstSortKey', '': 'secondSortKey', ...}.
@@ -72,6 +83,15 @@ int compareSortKeys(BSONObj leftSortKey, BSONObj rightSortKey, BSONObj sortKeyPa
     return leftSortKey.woCompare(rightSortKey, sortKeyPattern, considerFieldName);
 }
 
+/**
+ * Returns the KeyString encoding of 'sortKey'. Encoded keys compare bytewise the same way that
+ * compareSortKeys() orders them under the pattern from which 'ordering' was made.
+ */
+std::string encodeSortKey(const BSONObj& sortKey, Ordering ordering) {
+    const KeyString ks(KeyString::Version::V1, sortKey, ordering);
+    return std::string(ks.getBuffer(), ks.getSize());
+}
+
 }  // namespace
 
 AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
@@ -81,6 +101,10 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       _executor(executor),
       _params(params),
       _mergeQueue(MergingComparator(_remotes, _params->sort)) {
+    if (!_params->sort.isEmpty() && _params->sort.nFields() <= kMaxSortKeyEncodingFields) {
+        _sortOrdering = Ordering::make(_params->sort);
+    }
+
     size_t remoteIndex = 0;
     for (const auto& remote : _params->remotes) {
         _remotes.emplace_back(remote.hostAndPort,
@@ -250,7 +274,7 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return hasSort ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_params->tailableMode != TailableMode::kTailable);
 
@@ -264,8 +288,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     invariant(!_remotes[smallestRemote].docBuffer.empty());
     invariant(_remotes[smallestRemote].status.isOK());
 
-    ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
-    _remotes[smallestRemote].docBuffer.pop();
+    ClusterQueryResult front = _popBufferedResult(lk, smallestRemote);
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
@@ -273,18 +296,18 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
         _mergeQueue.push(smallestRemote);
     }
 
+    _readAheadIfNeeded(lk, smallestRemote);
     return front;
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock lk) {
     size_t remotesAttempted = 0;
     while (remotesAttempted < _remotes.size()) {
         // It is illegal to call this method if there is an error received from any shard.
         invariant(_remotes[_gettingFromRemote].status.isOK());
 
         if (_remotes[_gettingFromRemote].hasNext()) {
-            ClusterQueryResult front = _remotes[_gettingFromRemote].docBuffer.front();
-            _remotes[_gettingFromRemote].docBuffer.pop();
+            ClusterQueryResult front = _popBufferedResult(lk, _gettingFromRemote);
 
             if (_params->tailableMode == TailableMode::kTailable &&
                 !_remotes[_gettingFromRemote].hasNext()) {
@@ -307,6 +330,43 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
     return {};
 }
 
+ClusterQueryResult AsyncResultsMerger::_popBufferedResult(WithLock, size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+
+    ClusterQueryResult front = std::move(remote.docBuffer.front());
+    remote.docBuffer.pop();
+    if (!remote.sortKeyBuffer.empty()) {
+        remote.sortKeyBuffer.pop();
+    }
+
+    if (remote.docBuffer.empty()) {
+        remote.bufferDrainedAt = _executor->now();
+    }
+
+    return front;
+}
+
+void AsyncResultsMerger::_readAheadIfNeeded(WithLock lk, size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+
+    // Tailable awaitData cursors wait on the remotes for new results, so they are only asked for
+    // more once the caller needs them.
+    if (_params->tailableMode != TailableMode::kNormal || !_opCtx) {
+        return;
+    }
+
+    const int readAheadDocs = internalQueryMergeReadAheadDocs.load();
+    if (readAheadDocs < 0 || remote.docBuffer.size() > static_cast<size_t>(readAheadDocs)) {
+        return;
+    }
+
+    if (remote.exhausted() || remote.cbHandle.isValid() || !remote.status.isOK()) {
+        return;
+    }
+
+    remote.status = _askForNextBatch(lk, remoteIndex);
+}
+
 Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
     auto& remote = _remotes[remoteIndex];
 
@@ -332,17 +392,26 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
     executor::RemoteCommandRequest request(
         remote.getTargetHost(), _params->nsString.db().toString(), cmdObj, _metadataObj, _opCtx);
 
-    auto callbackStatus =
-        _executor->scheduleRemoteCommand(request, [this, remoteIndex](auto const& cbData) {
-            stdx::lock_guard<stdx::mutex> lk(this->_mutex);
-            this->_handleBatchResponse(lk, cbData, remoteIndex);
-        });
+    auto callback = [this, remoteIndex](auto const& cbData) {
+        stdx::lock_guard<stdx::mutex> lk(this->_mutex);
+        this->_handleBatchResponse(lk, cbData, remoteIndex);
+    };
+
+    // Handling a batch only buffers its documents and signals the merging thread, so it can run
+    // on the network thread that received it. The exception is an awaitData cursor: on an empty
+    // batch the handler immediately sends the next getMore, and doing that inline would check out
+    // a second connection to the shard while the one that carried the response is still held.
+    auto callbackStatus = _params->tailableMode == TailableMode::kTailableAndAwaitData
+        ? _executor->scheduleRemoteCommand(request, callback)
+        : _executor->scheduleRemoteCommandInline(request, callback);
 
     if (!callbackStatus.isOK()) {
         return callbackStatus.getStatus();
     }
 
     remote.cbHandle = callbackStatus.getValue();
+    remote.requestSentAt = _executor->now();
+    ++remote.numGetMores;
     return Status::OK();
 }
 
@@ -468,8 +537,17 @@ void AsyncResultsMerger::updateRemoteMetadata(RemoteCursorData* remote,
 void AsyncResultsMerger::_handleBatchResponse(WithLock lk,
                                               CbData const& cbData,
                                               size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+
     // Got a response from remote, so indicate we are no longer waiting for one.
-    _remotes[remoteIndex].cbHandle = executor::TaskExecutor::CallbackHandle();
+    remote.cbHandle = executor::TaskExecutor::CallbackHandle();
+
+    // If nothing was buffered from this remote, the merge has been waiting on it since the request
+    // was sent or since the buffer drained, whichever came later.
+    if (!remote.hasNext()) {
+        remote.waitTime +=
+            _executor->now() - std::max(remote.requestSentAt, remote.bufferDrainedAt);
+    }
 
     //  On shutdown, there is no need to process the response.
     if (_lifecycleState != kAlive) {
@@ -480,7 +558,7 @@ void AsyncResultsMerger::_handleBatchResponse(WithLock lk,
     try {
         _processBatchResults(lk, cbData.response, remoteIndex);
     } catch (DBException const& e) {
-        _remotes[remoteIndex].status = e.toStatus();
+        remote.status = e.toStatus();
     }
     _signalCurrentEventIfReady(lk);  // Wake up anyone waiting on '_currentEvent'.
 }
@@ -512,9 +590,8 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
     if (_params->isAllowPartialResults) {
         remote.status = Status::OK();
 
-        // Clear the results buffer and cursor id.
-        std::queue<ClusterQueryResult> emptyBuffer;
-        std::swap(remote.docBuffer, emptyBuffer);
+        // Results buffered before the failure, which a read-ahead request may leave behind, are
+        // still returned; clearing the cursor id ensures nothing further is asked of the remote.
         remote.cursorId = 0;
     }
 }
@@ -563,6 +640,7 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            size_t remoteIndex,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
+    const bool wasEmpty = remote.docBuffer.empty();
     updateRemoteMetadata(&remote, response);
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
@@ -576,14 +654,19 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
             return false;
         }
 
+        if (_sortOrdering) {
+            remote.sortKeyBuffer.push(encodeSortKey(extractSortKey(obj), *_sortOrdering));
+        }
+
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
         ++remote.fetchedCount;
     }
 
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the
-    // merge queue.
-    if (!_params->sort.isEmpty() && !response.getBatch().empty()) {
+    // merge queue. A remote that still had results buffered when the batch arrived is already
+    // on it.
+    if (!_params->sort.isEmpty() && wasEmpty && !response.getBatch().empty()) {
         _mergeQueue.push(remoteIndex);
     }
     return true;
@@ -668,6 +751,16 @@ executor::TaskExecutor::EventHandle AsyncResultsMerger::kill(OperationContext* o
     return _killCursorsScheduledEvent;
 }
 
+void AsyncResultsMerger::appendRemoteWaitStats(BSONArrayBuilder* builder) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    for (const auto& remote : _remotes) {
+        BSONObjBuilder remoteBob(builder->subobjStart());
+        remoteBob.append("host", remote.shardHostAndPort.toString());
+        remoteBob.appendNumber("getMores", remote.numGetMores);
+        remoteBob.appendNumber("waitMillis", durationCount<Milliseconds>(remote.waitTime));
+    }
+}
+
 //
 // AsyncResultsMerger::RemoteCursorData
 //
@@ -700,11 +793,15 @@ std::shared_ptr<Shard> AsyncResultsMerger::RemoteCursorData::getShard() {
 //
 
 bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
+    const auto& leftRemote = _remotes[lhs];
+    const auto& rightRemote = _remotes[rhs];
+
+    if (!leftRemote.sortKeyBuffer.empty()) {
+        return leftRemote.sortKeyBuffer.front() > rightRemote.sortKeyBuffer.front();
+    }
 
-    return compareSortKeys(extractSortKey(*leftDoc.getResult()),
-                           extractSortKey(*rightDoc.getResult()),
+    return compareSortKeys(extractSortKey(*leftRemote.docBuffer.front().getResult()),
+                           extractSortKey(*rightRemote.docBuffer.front().getResult()),
                            _sort) > 0;
 }
 
@@ -30,11 +30,13 @@
 
 #include <boost/optional.hpp>
 #include <queue>
+#include <string>
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/query/cluster_client_cursor_params.h"
@@ -46,6 +48,7 @@
 
 namespace mongo {
 
+class BSONArrayBuilder;
 class CursorResponse;
 
 /**
@@ -67,6 +70,10 @@ class CursorResponse;
  * This requires waiting until we have a response from every remote before returning results.
  * Without a sort, we are ready to return results as soon as we have *any* response from a remote.
  *
+ * To keep a sorted merge from stalling on the slowest remote, the next batch is requested from a
+ * remote as soon as its buffer runs low, rather than once it has been drained (see
+ * 'internalQueryMergeReadAheadDocs').
+ *
  * On any error, the caller is responsible for shutting down the ARM using the kill() method.
  *
  * Does not throw exceptions.
@@ -196,6 +203,12 @@ public:
      */
     executor::TaskExecutor::EventHandle kill(OperationContext* opCtx);
 
+    /**
+     * Appends one entry per remote with its host, the number of getMores sent to it and the total
+     * time, in milliseconds, during which the merge needed a result from it but had none buffered.
+     */
+    void appendRemoteWaitStats(BSONArrayBuilder* builder);
+
 private:
     /**
      * We instantiate one of these per remote host. It contains the buffer of results we've
@@ -249,6 +262,11 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // Used only if there is a sort that fits in an Ordering. Holds the KeyString encoding of
+        // the $sortKey of each result in 'docBuffer', in the same order, so that merging compares
+        // raw bytes.
+        std::queue<std::string> sortKeyBuffer;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -259,6 +277,16 @@ private:
         // Count of fetched docs during ARM processing of the current batch. Used to reduce the
         // batchSize in getMore when mongod returned less docs than the requested batchSize.
         long long fetchedCount = 0;
+
+        // Number of getMore requests sent to this remote.
+        long long numGetMores = 0;
+
+        // When the outstanding getMore was sent, and when 'docBuffer' last became empty.
+        Date_t requestSentAt;
+        Date_t bufferDrainedAt;
+
+        // Total time the merge spent waiting on this remote with nothing buffered from it.
+        Milliseconds waitTime{0};
     };
 
     class MergingComparator {
@@ -315,6 +343,17 @@ private:
     ClusterQueryResult _nextReadySorted(WithLock);
     ClusterQueryResult _nextReadyUnsorted(WithLock);
 
+    /**
+     * Removes and returns the first buffered result of the remote at 'remoteIndex'.
+     */
+    ClusterQueryResult _popBufferedResult(WithLock, size_t remoteIndex);
+
+    /**
+     * Asks the remote at 'remoteIndex' for its next batch if a sorted merge is about to run out of
+     * results from it and there is no request to it outstanding.
+     */
+    void _readAheadIfNeeded(WithLock, size_t remoteIndex);
+
     using CbData = executor::TaskExecutor::RemoteCommandCallbackArgs;
     using CbResponse = executor::TaskExecutor::ResponseStatus;
 
@@ -376,6 +415,10 @@ private:
     executor::TaskExecutor* _executor;
     ClusterClientCursorParams* _params;
 
+    // The ordering described by the sort pattern in '_params', used to encode sort keys. Not set
+    // if there is no sort or the pattern has more fields than an Ordering can describe.
+    boost::optional<Ordering> _sortOrdering;
+
     // The metadata obj to pass along with the command request. Used to indicate that the command is
     // ok to run on secondaries.
     BSONObj _metadataObj;
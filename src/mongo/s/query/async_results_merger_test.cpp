@@ -624,6 +624,97 @@ TEST_F(AsyncResultsMergerTest, SortedButNoSortKey) {
     executor()->waitForEvent(killEvent);
 }
 
+TEST_F(AsyncResultsMergerTest, SortedMergeReadsAheadBeforeBufferDrains) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<ClusterClientCursorParams::RemoteCursor> cursors;
+    cursors.emplace_back(kTestShardIds[0], kTestShardHosts[0], CursorResponse(_nss, 5, {}));
+    makeCursorFromExistingCursors(std::move(cursors), findCmd);
+
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: {'': 5}}"),
+                                   fromjson("{$sortKey: {'': 6}}")};
+    responses.emplace_back(_nss, CursorId(5), batch1);
+    scheduleNetworkResponses(std::move(responses),
+                             CursorResponse::ResponseType::SubsequentResponse);
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 5}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+
+    // The next batch has been requested while a result from the remote is still buffered.
+    ASSERT_TRUE(arm->ready());
+    auto request = GetMoreRequest::parseFromBSON("anydbname", getFirstPendingRequest().cmdObj);
+    ASSERT_OK(request.getStatus());
+    ASSERT_EQ(request.getValue().cursorid, 5LL);
+
+    responses.clear();
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: {'': 7}}")};
+    responses.emplace_back(_nss, CursorId(0), batch2);
+    scheduleNetworkResponses(std::move(responses),
+                             CursorResponse::ResponseType::SubsequentResponse);
+
+    // The results of both batches are returned in order, without having to wait on the remote.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 6}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 7}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, ReportsTimeSpentWaitingOnEachRemote) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<ClusterClientCursorParams::RemoteCursor> cursors;
+    cursors.emplace_back(kTestShardIds[0], kTestShardHosts[0], CursorResponse(_nss, 5, {}));
+    cursors.emplace_back(kTestShardIds[1], kTestShardHosts[1], CursorResponse(_nss, 6, {}));
+    makeCursorFromExistingCursors(std::move(cursors), findCmd);
+
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+
+    // The first shard responds right away and the second one 100 milliseconds later.
+    auto makeResponse = [&](std::vector<BSONObj> batch) {
+        CursorResponse cursorResponse(_nss, CursorId(0), std::move(batch));
+        return executor::TaskExecutor::ResponseStatus(RemoteCommandResponse(
+            cursorResponse.toBSON(CursorResponse::ResponseType::SubsequentResponse),
+            BSONObj(),
+            Milliseconds(0)));
+    };
+
+    executor::NetworkInterfaceMock* net = network();
+    net->enterNetwork();
+    const Date_t start = net->now();
+    net->scheduleResponse(
+        net->getNextReadyRequest(), start, makeResponse({fromjson("{$sortKey: {'': 5}}")}));
+    net->scheduleResponse(net->getNextReadyRequest(),
+                          start + Milliseconds(100),
+                          makeResponse({fromjson("{$sortKey: {'': 6}}")}));
+    net->runUntil(start + Milliseconds(100));
+    net->exitNetwork();
+    executor()->waitForEvent(readyEvent);
+
+    BSONArrayBuilder statsBab;
+    arm->appendRemoteWaitStats(&statsBab);
+    const auto stats = statsBab.arr();
+    ASSERT_EQ(2, stats.nFields());
+    ASSERT_EQ(kTestShardHosts[0].toString(), stats[0]["host"].String());
+    ASSERT_EQ(1, stats[0]["getMores"].numberLong());
+    ASSERT_EQ(0, stats[0]["waitMillis"].numberLong());
+    ASSERT_EQ(kTestShardHosts[1].toString(), stats[1]["host"].String());
+    ASSERT_EQ(1, stats[1]["getMores"].numberLong());
+    ASSERT_EQ(100, stats[1]["waitMillis"].numberLong());
+
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 5}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 6}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, HasFirstBatch) {
     std::vector<BSONObj> firstBatch = {
         fromjson("{_id: 1}"), fromjson("{_id: 2}"), fromjson("{_id: 3}")};
@@ -32,7 +32,9 @@
 
 #include "mongo/s/query/router_stage_merge.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/query/find_common.h"
+#include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -111,6 +113,13 @@ StatusWith<EventHandle> RouterStageMerge::getNextEvent() {
 }
 
 void RouterStageMerge::kill(OperationContext* opCtx) {
+    if (shouldLog(logger::LogSeverity::Debug(1))) {
+        BSONArrayBuilder remotesBab;
+        _arm.appendRemoteWaitStats(&remotesBab);
+        LOG(1) << "Merged cursor on " << _params->nsString.ns()
+               << " finished, time spent waiting on each remote: " << remotesBab.arr();
+    }
+
     auto killEvent = _arm.kill(opCtx);
     if (!killEvent) {
         // Mongos is shutting down.
@@ -61,6 +61,7 @@
 #include "mongo/s/catalog/replset_dist_lock_manager.h"
 #include "mongo/s/catalog/sharding_catalog_client_impl.h"
 #include "mongo/s/catalog_cache.h"
+#include "mongo/s/catalog_cache_change_listener.h"
 #include "mongo/s/client/shard_factory.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/client/sharding_network_connection_hook.h"
@@ -100,6 +101,11 @@ MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolRefreshTimeoutMS,
                                       int,
                                       ConnectionPool::kDefaultRefreshTimeout.count());
 
+// Whether routers tail the config server's oplog in order to refresh cached routing tables as soon
+// as their chunks change, instead of waiting for a stale config error. Off by default, because it
+// adds a permanently open cursor on the config server primary per router.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(catalogCacheChangeListenerEnabled, bool, false);
+
 namespace {
 
 using executor::NetworkInterface;
@@ -245,6 +251,11 @@ Status initializeGlobalShardingState(OperationContext* opCtx,
                                                   isStandaloneOrPrimary);
     }
 
+    if (serverGlobalParams.clusterRole != ClusterRole::ConfigServer &&
+        catalogCacheChangeListenerEnabled) {
+        CatalogCacheChangeListener::create(opCtx->getServiceContext());
+    }
+
     return Status::OK();
 }
 
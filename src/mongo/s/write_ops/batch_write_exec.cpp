@@ -32,6 +32,9 @@
 
 #include "mongo/s/write_ops/batch_write_exec.h"
 
+#include <memory>
+#include <set>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/base/owned_pointer_map.h"
 #include "mongo/base/status.h"
@@ -77,6 +80,133 @@ void noteStaleResponses(const std::vector<ShardError*>& staleErrors, NSTargeter*
 // applies when no writes are occurring and metadata is not changing on reload.
 const int kMaxRoundsWithoutProgress(5);
 
+/**
+ * Builds the shard requests for the batches in 'childBatches' and moves the batches over to
+ * 'pendingBatches', leaving 'childBatches' empty.
+ */
+std::vector<AsyncRequestsSender::Request> buildShardRequests(
+    OperationContext* opCtx,
+    const BatchWriteOp& batchOp,
+    OwnedShardBatchMap::MapType* childBatches,
+    OwnedShardBatchMap::MapType* pendingBatches) {
+    std::vector<AsyncRequestsSender::Request> requests;
+
+    for (auto& childBatch : *childBatches) {
+        const ShardId& targetShardId = childBatch.first;
+        TargetedWriteBatch* const nextBatch = childBatch.second;
+
+        const auto request = [&] {
+            const auto shardBatchRequest(batchOp.buildBatchRequest(*nextBatch));
+
+            BSONObjBuilder requestBuilder;
+            shardBatchRequest.serialize(&requestBuilder);
+
+            {
+                OperationSessionInfo sessionInfo;
+
+                if (opCtx->getLogicalSessionId()) {
+                    sessionInfo.setSessionId(*opCtx->getLogicalSessionId());
+                }
+
+                sessionInfo.setTxnNumber(opCtx->getTxnNumber());
+                sessionInfo.serialize(&requestBuilder);
+            }
+
+            return requestBuilder.obj();
+        }();
+
+        LOG(4) << "Sending write batch to " << targetShardId << ": " << redact(request);
+
+        requests.emplace_back(targetShardId, request);
+
+        // Recv-side is responsible for cleaning up the nextBatch when used
+        const bool inserted = pendingBatches->emplace(targetShardId, nextBatch).second;
+        invariant(inserted);
+    }
+
+    childBatches->clear();
+    return requests;
+}
+
+/**
+ * Notes the response to the child 'batch' in 'batchOp'. Returns true if the shard reported that
+ * the targeter's metadata is stale.
+ */
+bool noteShardResponse(AsyncRequestsSender::Response response,
+                       const TargetedWriteBatch& batch,
+                       BatchWriteOp* batchOp,
+                       NSTargeter* targeter,
+                       BatchWriteExecStats* stats) {
+    // First check if we were able to target a shard host.
+    if (!response.shardHostAndPort) {
+        invariant(!response.swResponse.isOK());
+
+        // Record a resolve failure
+        batchOp->noteBatchError(batch, errorFromStatus(response.swResponse.getStatus()));
+
+        // TODO: It may be necessary to refresh the cache if stale, or maybe just cancel and
+        // retarget the batch
+        LOG(4) << "Unable to send write batch to " << batch.getEndpoint().shardName
+               << causedBy(response.swResponse.getStatus());
+        return false;
+    }
+
+    const auto shardHost(std::move(*response.shardHostAndPort));
+
+    // Then check if we successfully got a response.
+    Status responseStatus = response.swResponse.getStatus();
+    BatchedCommandResponse batchedCommandResponse;
+    if (responseStatus.isOK()) {
+        std::string errMsg;
+        if (!batchedCommandResponse.parseBSON(response.swResponse.getValue().data, &errMsg) ||
+            !batchedCommandResponse.isValid(&errMsg)) {
+            responseStatus = {ErrorCodes::FailedToParse, errMsg};
+        }
+    }
+
+    if (!responseStatus.isOK()) {
+        // Error occurred dispatching, note it
+        const Status status(responseStatus.code(),
+                            str::stream() << "Write results unavailable from " << shardHost
+                                          << " due to "
+                                          << responseStatus.reason());
+
+        batchOp->noteBatchError(batch, errorFromStatus(status));
+
+        LOG(4) << "Unable to receive write results from " << shardHost << causedBy(redact(status));
+        return false;
+    }
+
+    TrackedErrors trackedErrors;
+    trackedErrors.startTracking(ErrorCodes::StaleShardVersion);
+
+    LOG(4) << "Write results received from " << shardHost.toString() << ": "
+           << redact(batchedCommandResponse.toString());
+
+    // Dispatch was ok, note response
+    batchOp->noteBatchResponse(batch, batchedCommandResponse, &trackedErrors);
+
+    // Remember that we successfully wrote to this shard
+    // NOTE: This will record lastOps for shards where we actually didn't update or delete any
+    // documents, which preserves old behavior but is conservative
+    stats->noteWriteAt(shardHost,
+                       batchedCommandResponse.isLastOpSet() ? batchedCommandResponse.getLastOp()
+                                                            : repl::OpTime(),
+                       batchedCommandResponse.isElectionIdSet()
+                           ? batchedCommandResponse.getElectionId()
+                           : OID());
+
+    // Note if anything was stale
+    const auto& staleErrors = trackedErrors.getErrors(ErrorCodes::StaleShardVersion);
+    if (staleErrors.empty()) {
+        return false;
+    }
+
+    noteStaleResponses(staleErrors, targeter);
+    ++stats->numStaleBatches;
+    return true;
+}
+
 }  // namespace
 
 void BatchWriteExec::executeBatch(OperationContext* opCtx,
@@ -90,6 +220,7 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
            << static_cast<int>(clientRequest.sizeWriteOps()) << " for " << nss.ns();
 
     BatchWriteOp batchOp(opCtx, clientRequest);
+    const bool ordered = clientRequest.getWriteCommandBase().getOrdered();
 
     // Current batch status
     bool refreshedTargeter = false;
@@ -122,7 +253,7 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
         //    exactly when the metadata changed.
         //
 
-        OwnedPointerMap<ShardId, TargetedWriteBatch> childBatchesOwned;
+        OwnedShardBatchMap childBatchesOwned;
         std::map<ShardId, TargetedWriteBatch*>& childBatches = childBatchesOwned.mutableMap();
 
         // If we've already had a targeting error, we've refreshed the metadata once and can
@@ -141,169 +272,67 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
         // Send all child batches
         //
 
-        size_t numSent = 0;
-        size_t numToSend = childBatches.size();
-        while (numSent != numToSend) {
-            // Collect batches out on the network, mapped by endpoint
-            OwnedShardBatchMap ownedPendingBatches;
-            OwnedShardBatchMap::MapType& pendingBatches = ownedPendingBatches.mutableMap();
-
-            //
-            // Construct the requests.
-            //
-
-            std::vector<AsyncRequestsSender::Request> requests;
-
-            // Get as many batches as we can at once
-            for (auto& childBatch : childBatches) {
-                TargetedWriteBatch* const nextBatch = childBatch.second;
-
-                // If the batch is nullptr, we sent it previously, so skip
-                if (!nextBatch)
-                    continue;
-
-                // If we already have a batch for this shard, wait until the next time
-                ShardId targetShardId = nextBatch->getEndpoint().shardName;
-
-                OwnedShardBatchMap::MapType::iterator pendingIt =
-                    pendingBatches.find(targetShardId);
-                if (pendingIt != pendingBatches.end())
-                    continue;
+        // Child batches out on the network, at most one per shard, mapped by shard. The batches
+        // are owned here until their responses have been noted.
+        OwnedShardBatchMap ownedPendingBatches;
+        OwnedShardBatchMap::MapType& pendingBatches = ownedPendingBatches.mutableMap();
+
+        const ReadPreferenceSetting readPref(ReadPreference::PrimaryOnly, TagSet());
+        AsyncRequestsSender ars(opCtx,
+                                Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
+                                clientRequest.getTargetingNS().db().toString(),
+                                buildShardRequests(opCtx, batchOp, &childBatches, &pendingBatches),
+                                readPref,
+                                Shard::RetryPolicy::kNoRetry);
+
+        // For unordered batches, the next child batch for a shard is sent as soon as the shard's
+        // previous child batch returns, rather than after every shard has responded. This stops
+        // once the round runs into stale metadata or a targeting error, since later child batches
+        // would most likely fail the same way until the targeter is refreshed.
+        bool pipelineChildBatches = !ordered && targetStatus.isOK();
 
-                const auto request = [&] {
-                    const auto shardBatchRequest(batchOp.buildBatchRequest(*nextBatch));
-
-                    BSONObjBuilder requestBuilder;
-                    shardBatchRequest.serialize(&requestBuilder);
-
-                    {
-                        OperationSessionInfo sessionInfo;
-
-                        if (opCtx->getLogicalSessionId()) {
-                            sessionInfo.setSessionId(*opCtx->getLogicalSessionId());
-                        }
-
-                        sessionInfo.setTxnNumber(opCtx->getTxnNumber());
-                        sessionInfo.serialize(&requestBuilder);
-                    }
-
-                    return requestBuilder.obj();
-                }();
+        //
+        // Receive the responses.
+        //
 
-                LOG(4) << "Sending write batch to " << targetShardId << ": " << redact(request);
+        while (!ars.done()) {
+            // Block until a response is available.
+            auto response = ars.next();
 
-                requests.emplace_back(targetShardId, request);
+            // Get the TargetedWriteBatch to find where to put the response
+            auto pendingIt = pendingBatches.find(response.shardId);
+            invariant(pendingIt != pendingBatches.end());
+            std::unique_ptr<TargetedWriteBatch> batch(pendingIt->second);
+            pendingBatches.erase(pendingIt);
 
-                // Indicate we're done by setting the batch to nullptr. We'll only get duplicate
-                // hostEndpoints if we have broadcast and non-broadcast endpoints for the same host,
-                // so this should be pretty efficient without moving stuff around.
-                childBatch.second = nullptr;
+            if (noteShardResponse(std::move(response), *batch, &batchOp, &targeter, stats)) {
+                pipelineChildBatches = false;
+            }
 
-                // Recv-side is responsible for cleaning up the nextBatch when used
-                pendingBatches.insert(std::make_pair(targetShardId, nextBatch));
+            if (!pipelineChildBatches || batchOp.isFinished()) {
+                continue;
             }
 
-            //
-            // Send the requests.
-            //
-
-            const ReadPreferenceSetting readPref(ReadPreference::PrimaryOnly, TagSet());
-            AsyncRequestsSender ars(opCtx,
-                                    Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
-                                    clientRequest.getTargetingNS().db().toString(),
-                                    requests,
-                                    readPref,
-                                    Shard::RetryPolicy::kNoRetry);
-            numSent += pendingBatches.size();
-
-            //
-            // Receive the responses.
-            //
-
-            while (!ars.done()) {
-                // Block until a response is available.
-                auto response = ars.next();
-
-                // Get the TargetedWriteBatch to find where to put the response
-                dassert(pendingBatches.find(response.shardId) != pendingBatches.end());
-                TargetedWriteBatch* batch = pendingBatches.find(response.shardId)->second;
-
-                // First check if we were able to target a shard host.
-                if (!response.shardHostAndPort) {
-                    invariant(!response.swResponse.isOK());
-
-                    // Record a resolve failure
-                    batchOp.noteBatchError(*batch,
-                                           errorFromStatus(response.swResponse.getStatus()));
-
-                    // TODO: It may be necessary to refresh the cache if stale, or maybe just cancel
-                    // and retarget the batch
-                    LOG(4) << "Unable to send write batch to " << batch->getEndpoint().shardName
-                           << causedBy(response.swResponse.getStatus());
-
-                    // We're done with this batch. Clean up when we can't resolve a host.
-                    auto it = childBatches.find(batch->getEndpoint().shardName);
-                    invariant(it != childBatches.end());
-                    delete it->second;
-                    it->second = nullptr;
-                    continue;
-                }
+            // Target whatever can go to the shards which are not busy, which includes the shard
+            // that has just responded.
+            std::set<ShardId> busyShards;
+            for (const auto& pendingBatch : pendingBatches) {
+                busyShards.insert(pendingBatch.first);
+            }
 
-                const auto shardHost(std::move(*response.shardHostAndPort));
-
-                // Then check if we successfully got a response.
-                Status responseStatus = response.swResponse.getStatus();
-                BatchedCommandResponse batchedCommandResponse;
-                if (responseStatus.isOK()) {
-                    std::string errMsg;
-                    if (!batchedCommandResponse.parseBSON(response.swResponse.getValue().data,
-                                                          &errMsg) ||
-                        !batchedCommandResponse.isValid(&errMsg)) {
-                        responseStatus = {ErrorCodes::FailedToParse, errMsg};
-                    }
-                }
+            OwnedShardBatchMap nextBatchesOwned;
+            std::map<ShardId, TargetedWriteBatch*>& nextBatches = nextBatchesOwned.mutableMap();
+            if (!batchOp.targetBatch(targeter, recordTargetErrors, busyShards, &nextBatches)
+                     .isOK()) {
+                // The write ops are left ready, so the next round will target them again and
+                // handle the error.
+                pipelineChildBatches = false;
+                continue;
+            }
 
-                if (responseStatus.isOK()) {
-                    TrackedErrors trackedErrors;
-                    trackedErrors.startTracking(ErrorCodes::StaleShardVersion);
-
-                    LOG(4) << "Write results received from " << shardHost.toString() << ": "
-                           << redact(batchedCommandResponse.toString());
-
-                    // Dispatch was ok, note response
-                    batchOp.noteBatchResponse(*batch, batchedCommandResponse, &trackedErrors);
-
-                    // Note if anything was stale
-                    const auto& staleErrors =
-                        trackedErrors.getErrors(ErrorCodes::StaleShardVersion);
-                    if (staleErrors.size() > 0) {
-                        noteStaleResponses(staleErrors, &targeter);
-                        ++stats->numStaleBatches;
-                    }
-
-                    // Remember that we successfully wrote to this shard
-                    // NOTE: This will record lastOps for shards where we actually didn't update
-                    // or delete any documents, which preserves old behavior but is conservative
-                    stats->noteWriteAt(shardHost,
-                                       batchedCommandResponse.isLastOpSet()
-                                           ? batchedCommandResponse.getLastOp()
-                                           : repl::OpTime(),
-                                       batchedCommandResponse.isElectionIdSet()
-                                           ? batchedCommandResponse.getElectionId()
-                                           : OID());
-                } else {
-                    // Error occurred dispatching, note it
-                    const Status status(responseStatus.code(),
-                                        str::stream() << "Write results unavailable from "
-                                                      << shardHost
-                                                      << " due to "
-                                                      << responseStatus.reason());
-
-                    batchOp.noteBatchError(*batch, errorFromStatus(status));
-
-                    LOG(4) << "Unable to receive write results from " << shardHost
-                           << causedBy(redact(status));
-                }
+            if (!nextBatches.empty()) {
+                stats->numPipelinedBatches += nextBatches.size();
+                ars.addRequests(buildShardRequests(opCtx, batchOp, &nextBatches, &pendingBatches));
             }
         }
 
@@ -56,6 +56,8 @@ class OperationContext;
  * Both the targeter and dispatcher are assumed to be dedicated to this particular
  * BatchWriteExec instance.
  *
+ * Unordered batches are pipelined per shard: each shard has at most one child batch outstanding,
+ * and its next child batch is sent as soon as that one returns.
  */
 class BatchWriteExec {
 public:
@@ -84,7 +86,11 @@ typedef std::map<ConnectionString, HostOpTime> HostOpTimeMap;
 class BatchWriteExecStats {
 public:
     BatchWriteExecStats()
-        : numRounds(0), numTargetErrors(0), numResolveErrors(0), numStaleBatches(0) {}
+        : numRounds(0),
+          numTargetErrors(0),
+          numResolveErrors(0),
+          numStaleBatches(0),
+          numPipelinedBatches(0) {}
 
     void noteWriteAt(const HostAndPort& host, repl::OpTime opTime, const OID& electionId);
 
@@ -100,6 +106,9 @@ public:
     int numResolveErrors;
     // Number of stale batches
     int numStaleBatches;
+    // Number of child batches sent to a shard as soon as its previous child batch returned,
+    // rather than in a new round
+    int numPipelinedBatches;
 
 private:
     HostOpTimeMap _writeOpTimes;
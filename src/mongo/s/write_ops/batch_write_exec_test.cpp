@@ -250,6 +250,42 @@ TEST_F(BatchWriteExecTest, SingleOpError) {
     future.timed_get(kFutureTimeout);
 }
 
+TEST_F(BatchWriteExecTest, PipelinesChildBatchesToTheSameShard) {
+    // Each document is over a third of the maximum size, so they do not all fit in one child batch
+    const std::string bigString(BSONObjMaxUserSize / 3 + 1, 'x');
+    const std::vector<BSONObj> docs{BSON("x" << 1 << "data" << bigString),
+                                    BSON("x" << 2 << "data" << bigString),
+                                    BSON("x" << 3 << "data" << bigString)};
+
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        insertOp.setWriteCommandBase([] {
+            write_ops::WriteCommandBase writeCommandBase;
+            writeCommandBase.setOrdered(false);
+            return writeCommandBase;
+        }());
+        insertOp.setDocuments(docs);
+        return insertOp;
+    }());
+    request.setWriteConcern(BSONObj());
+
+    auto future = launchAsync([&] {
+        BatchedCommandResponse response;
+        BatchWriteExecStats stats;
+        BatchWriteExec::executeBatch(operationContext(), nsTargeter, request, &response, &stats);
+        ASSERT(response.getOk());
+
+        // The second child batch is sent as soon as the first returns, in the same round
+        ASSERT_EQUALS(stats.numRounds, 1);
+        ASSERT_EQUALS(stats.numPipelinedBatches, 1);
+    });
+
+    expectInsertsReturnSuccess({docs[0], docs[1]});
+    expectInsertsReturnSuccess({docs[2]});
+
+    future.timed_get(kFutureTimeout);
+}
+
 //
 // Test retryable errors
 //
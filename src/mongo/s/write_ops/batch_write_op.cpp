@@ -30,6 +30,7 @@
 
 #include "mongo/s/write_ops/batch_write_op.h"
 
+#include <algorithm>
 #include <numeric>
 
 #include "mongo/base/error_codes.h"
@@ -230,6 +231,13 @@ BatchWriteOp::~BatchWriteOp() {
 Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
                                  bool recordTargetErrors,
                                  std::map<ShardId, TargetedWriteBatch*>* targetedBatches) {
+    return targetBatch(targeter, recordTargetErrors, {}, targetedBatches);
+}
+
+Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
+                                 bool recordTargetErrors,
+                                 const std::set<ShardId>& busyShards,
+                                 std::map<ShardId, TargetedWriteBatch*>* targetedBatches) {
     //
     // Targeting of unordered batches is fairly simple - each remaining write op is targeted,
     // and each of those targeted writes are grouped into a batch for a particular shard
@@ -264,6 +272,7 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
     //
 
     const bool ordered = _clientRequest.getWriteCommandBase().getOrdered();
+    invariant(!ordered || busyShards.empty());
 
     TargetedBatchMap batchMap;
     TargetedBatchSizeMap batchSizes;
@@ -317,6 +326,19 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
             }
         }
 
+        //
+        // If any of the targeted writes go to a shard which still has a child batch outstanding,
+        // leave the write op for when that shard is available again.
+        //
+
+        if (!busyShards.empty() &&
+            std::any_of(writes.begin(), writes.end(), [&](const TargetedWrite* write) {
+                return busyShards.count(write->endpoint.shardName) != 0;
+            })) {
+            writeOp.cancelWrites(NULL);
+            continue;
+        }
+
         //
         // If ordered and we have a previous endpoint, make sure we don't need to send these
         // targeted writes to any other endpoints.
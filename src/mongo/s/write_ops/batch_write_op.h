@@ -139,6 +139,19 @@ public:
                        bool recordTargetErrors,
                        std::map<ShardId, TargetedWriteBatch*>* targetedBatches);
 
+    /**
+     * Same as above, but for unordered batches skips (leaving them ready to be targeted again
+     * later) any write ops which would target one of 'busyShards'. This lets the caller send the
+     * next child batch to a shard as soon as that shard's previous child batch has returned,
+     * without waiting on the shards which are still busy.
+     *
+     * Must not be called with a non-empty 'busyShards' for an ordered batch.
+     */
+    Status targetBatch(const NSTargeter& targeter,
+                       bool recordTargetErrors,
+                       const std::set<ShardId>& busyShards,
+                       std::map<ShardId, TargetedWriteBatch*>* targetedBatches);
+
     /**
      * Fills a BatchCommandRequest from a TargetedWriteBatch for this BatchWriteOp.
      */
@@ -56,6 +56,7 @@
 #include "mongo/util/net/abstract_message_port.h"
 #include "mongo/util/net/listen.h"
 #include "mongo/util/net/message.h"
+#include "mongo/util/net/op_msg.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/signal_handlers.h"
 #include "mongo/util/text.h"
@@ -229,7 +230,6 @@ public:
                 if (!isFireAndForgetCommand &&
                     (request.operation() == dbQuery || request.operation() == dbGetMore ||
                      request.operation() == dbCommand || request.operation() == dbMsg)) {
-                    // TODO dbMsg moreToCome
                     // Forward the message to 'dest' and receive its reply in 'response'.
                     response.reset();
                     dest.port().call(request, response);
@@ -259,12 +259,15 @@ public:
                     _mp->say(response);
 
                     // If 'exhaust' is true, then instead of trying to receive another message from
-                    // '_mp', receive messages from 'dest' until it returns a cursor id of zero.
+                    // '_mp', receive messages from 'dest' until it returns a cursor id of zero, or
+                    // for OP_MSG, a reply without the moreToCome flag.
                     bool exhaust = false;
                     if (request.operation() == dbQuery) {
                         DbMessage d(request);
                         QueryMessage q(d);
                         exhaust = q.queryOptions & QueryOption_Exhaust;
+                    } else if (request.operation() == dbMsg) {
+                        exhaust = OpMsg::isFlagSet(request, OpMsg::kExhaustSupported);
                     }
                     while (exhaust) {
                         if (response.operation() == dbCompressed) {
@@ -277,9 +280,16 @@ public:
                             response = std::move(swm.getValue());
                         }
 
-                        MsgData::View header = response.header();
-                        QueryResult::View qr = header.view2ptr();
-                        if (qr.getCursorId()) {
+                        bool moreToCome;
+                        if (response.operation() == dbMsg) {
+                            moreToCome = OpMsg::isFlagSet(response, OpMsg::kMoreToCome);
+                        } else {
+                            MsgData::View header = response.header();
+                            QueryResult::View qr = header.view2ptr();
+                            moreToCome = qr.getCursorId();
+                        }
+
+                        if (moreToCome) {
                             response.reset();
                             dest.port().recv(response);
                             _mp->say(response);
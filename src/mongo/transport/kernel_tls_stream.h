@@ -0,0 +1,252 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <memory>
+#include <utility>
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/util/assert_util.h"
+
+#include "asio.hpp"
+#include "asio/ssl.hpp"
+
+namespace mongo {
+namespace transport {
+
+/**
+ * A server-side TLS stream in which OpenSSL reads and writes the socket itself through a socket
+ * BIO, instead of through the memory BIO pair that asio::ssl::stream feeds. Only then can OpenSSL
+ * hand the negotiated keys to the kernel (kTLS) once the handshake completes, after which the
+ * kernel encrypts and decrypts records and OpenSSL just moves plaintext. If the kernel or the
+ * cipher doesn't support kTLS, OpenSSL keeps encrypting in userspace on the same socket.
+ *
+ * It has the read_some/write_some and async_read_some/async_write_some members of asio's stream
+ * concepts, so asio::read() and asio::write() work on it. A non-blocking socket makes the
+ * synchronous operations fail with would_block rather than wait.
+ */
+template <typename Socket>
+class KernelTLSStream {
+    MONGO_DISALLOW_COPYING(KernelTLSStream);
+
+public:
+    using executor_type = typename Socket::executor_type;
+    using lowest_layer_type = typename Socket::lowest_layer_type;
+
+    KernelTLSStream(Socket socket, asio::ssl::context& context)
+        : _socket(std::move(socket)), _ssl(::SSL_new(context.native_handle()), &::SSL_free) {
+        fassert(50912, _ssl.get());
+        ::SSL_set_options(_ssl.get(), SSL_OP_ENABLE_KTLS);
+        ::SSL_set_mode(_ssl.get(),
+                       SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+        // The socket BIO doesn't take ownership of the descriptor; _socket still closes it.
+        fassert(50913, ::SSL_set_fd(_ssl.get(), _socket.native_handle()) == 1);
+        ::SSL_set_accept_state(_ssl.get());
+    }
+
+    executor_type get_executor() {
+        return _socket.get_executor();
+    }
+
+    lowest_layer_type& lowest_layer() {
+        return _socket.lowest_layer();
+    }
+
+    const lowest_layer_type& lowest_layer() const {
+        return _socket.lowest_layer();
+    }
+
+    SSL* native_handle() {
+        return _ssl.get();
+    }
+
+    /**
+     * Whether the kernel encrypts what is sent and decrypts what is received on this stream. Only
+     * meaningful once the handshake has completed.
+     */
+    bool kernelSend() const {
+        return BIO_get_ktls_send(::SSL_get_wbio(_ssl.get()));
+    }
+
+    bool kernelReceive() const {
+        return BIO_get_ktls_recv(::SSL_get_rbio(_ssl.get()));
+    }
+
+    void handshake(std::error_code& ec) {
+        _handshake(ec);
+    }
+
+    template <typename HandshakeHandler>
+    void async_handshake(HandshakeHandler&& handler) {
+        _asyncPerform([this](std::error_code& ec) { return _handshake(ec); },
+                      [handler = std::forward<HandshakeHandler>(handler)](
+                          const std::error_code& ec, size_t) mutable { handler(ec); },
+                      true);
+    }
+
+    template <typename MutableBufferSequence>
+    size_t read_some(const MutableBufferSequence& buffers, std::error_code& ec) {
+        const auto buffer =
+            asio::detail::buffer_sequence_adapter<asio::mutable_buffer,
+                                                  MutableBufferSequence>::first(buffers);
+        if (buffer.size() == 0) {
+            ec = std::error_code();
+            return 0;
+        }
+
+        size_t bytes = 0;
+        ::ERR_clear_error();
+        _check(::SSL_read_ex(_ssl.get(), buffer.data(), buffer.size(), &bytes), ec);
+        return bytes;
+    }
+
+    template <typename ConstBufferSequence>
+    size_t write_some(const ConstBufferSequence& buffers, std::error_code& ec) {
+        const auto buffer =
+            asio::detail::buffer_sequence_adapter<asio::const_buffer,
+                                                  ConstBufferSequence>::first(buffers);
+        if (buffer.size() == 0) {
+            ec = std::error_code();
+            return 0;
+        }
+
+        size_t bytes = 0;
+        ::ERR_clear_error();
+        _check(::SSL_write_ex(_ssl.get(), buffer.data(), buffer.size(), &bytes), ec);
+        return bytes;
+    }
+
+    template <typename MutableBufferSequence, typename ReadHandler>
+    void async_read_some(const MutableBufferSequence& buffers, ReadHandler&& handler) {
+        // OpenSSL may already hold the rest of a record that a previous read left behind, which
+        // a wait on the socket would never report.
+        const bool pending = ::SSL_has_pending(_ssl.get());
+        _wait = Socket::wait_read;
+        _asyncPerform([this, buffers](std::error_code& ec) { return read_some(buffers, ec); },
+                      std::forward<ReadHandler>(handler),
+                      pending);
+    }
+
+    template <typename ConstBufferSequence, typename WriteHandler>
+    void async_write_some(const ConstBufferSequence& buffers, WriteHandler&& handler) {
+        // Writing usually succeeds right away, and otherwise finds out which way to wait.
+        _asyncPerform([this, buffers](std::error_code& ec) { return write_some(buffers, ec); },
+                      std::forward<WriteHandler>(handler),
+                      true);
+    }
+
+private:
+    size_t _handshake(std::error_code& ec) {
+        ::ERR_clear_error();
+        _check(::SSL_accept(_ssl.get()), ec);
+        return 0;
+    }
+
+    /**
+     * Translates the result of an OpenSSL call into 'ec' the way asio::ssl::stream does, and
+     * remembers which way the socket has to become ready before a call that would block can be
+     * retried.
+     */
+    void _check(int result, std::error_code& ec) {
+        if (result > 0) {
+            ec = std::error_code();
+            return;
+        }
+
+        const int savedErrno = errno;
+        switch (::SSL_get_error(_ssl.get(), result)) {
+            case SSL_ERROR_WANT_READ:
+                _wait = Socket::wait_read;
+                ec = asio::error::would_block;
+                break;
+            case SSL_ERROR_WANT_WRITE:
+                _wait = Socket::wait_write;
+                ec = asio::error::would_block;
+                break;
+            case SSL_ERROR_ZERO_RETURN:
+                ec = asio::error::eof;
+                break;
+            case SSL_ERROR_SYSCALL:
+                ec = savedErrno ? std::error_code(savedErrno, asio::error::get_system_category())
+                                : std::error_code(asio::ssl::error::stream_truncated);
+                break;
+            default:
+                ec = std::error_code(static_cast<int>(::ERR_get_error()),
+                                     asio::error::get_ssl_category());
+                break;
+        }
+    }
+
+    /**
+     * Calls 'operation' once the socket is ready for it, or right away if 'tryFirst' is set, until
+     * it no longer would block, and then completes 'handler' with its result. 'handler' is never
+     * called from within this function.
+     */
+    template <typename Operation, typename Handler>
+    void _asyncPerform(Operation operation, Handler&& handler, bool tryFirst) {
+        if (tryFirst) {
+            std::error_code ec;
+            const auto bytes = operation(ec);
+            if (ec != asio::error::would_block) {
+                asio::post(_socket.get_executor(),
+                           [ handler = std::forward<Handler>(handler), ec, bytes ]() mutable {
+                               handler(ec, bytes);
+                           });
+                return;
+            }
+        }
+
+        _socket.async_wait(
+            _wait,
+            [ this, operation, handler = std::forward<Handler>(handler) ](
+                const std::error_code& waitEc) mutable {
+                if (waitEc) {
+                    return handler(waitEc, 0);
+                }
+
+                std::error_code ec;
+                const auto bytes = operation(ec);
+                if (ec == asio::error::would_block) {
+                    return _asyncPerform(std::move(operation), std::move(handler), false);
+                }
+                handler(ec, bytes);
+            });
+    }
+
+    Socket _socket;
+    std::unique_ptr<SSL, decltype(&::SSL_free)> _ssl;
+    typename Socket::wait_type _wait = Socket::wait_read;
+};
+
+}  // namespace transport
+}  // namespace mongo
@@ -40,6 +40,8 @@ enum class MessageCompressor : uint8_t {
     kNoop = 0,
     kSnappy = 1,
     kZlib = 2,
+    kZstd = 3,
+    kLz4 = 4,
     kExtended = 255,
 };
 
@@ -100,6 +102,16 @@ public:
         return _compressBytesOut.loadRelaxed();
     }
 
+    /*
+     * This returns the number of bytes saved by messages that were actually sent compressed. Output
+     * that the MessageCompressorManager discarded in favour of the uncompressed message is not
+     * counted.
+     */
+    int64_t getCompressedBytesSaved() const {
+        return (_compressBytesIn.loadRelaxed() - _compressBytesOut.loadRelaxed()) -
+            (_discardedBytesIn.loadRelaxed() - _discardedBytesOut.loadRelaxed());
+    }
+
     /*
      * This returns the number of bytes passed in the input for decompressData
      */
@@ -114,6 +126,40 @@ public:
         return _decompressBytesOut.loadRelaxed();
     }
 
+    /*
+     * This returns the total time spent in compressData, in microseconds
+     */
+    int64_t getCompressMicros() const {
+        return _compressMicros.loadRelaxed();
+    }
+
+    /*
+     * This returns the total time spent in decompressData, in microseconds
+     */
+    int64_t getDecompressMicros() const {
+        return _decompressMicros.loadRelaxed();
+    }
+
+    /*
+     * Called by the MessageCompressorManager, which times each call to compressData and
+     * decompressData, to bump the time counters
+     */
+    void counterHitCompressMicros(int64_t micros) {
+        _compressMicros.addAndFetch(micros);
+    }
+
+    void counterHitDecompressMicros(int64_t micros) {
+        _decompressMicros.addAndFetch(micros);
+    }
+
+    /*
+     * Called by the MessageCompressorManager when it sends the uncompressed message instead of
+     * the output of compressData, with the bytesIn/bytesOut of that discarded compressData call
+     */
+    void counterHitCompressDiscarded(int64_t bytesIn, int64_t bytesOut) {
+        _discardedBytesIn.addAndFetch(bytesIn);
+        _discardedBytesOut.addAndFetch(bytesOut);
+    }
 
 protected:
     /*
@@ -146,7 +192,13 @@ private:
     AtomicInt64 _compressBytesIn;
     AtomicInt64 _compressBytesOut;
 
+    AtomicInt64 _discardedBytesIn;
+    AtomicInt64 _discardedBytesOut;
+
     AtomicInt64 _decompressBytesIn;
     AtomicInt64 _decompressBytesOut;
+
+    AtomicInt64 _compressMicros;
+    AtomicInt64 _decompressMicros;
 };
 }  // namespace mongo
@@ -36,14 +36,31 @@
 #include "mongo/base/data_type_endian.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/session.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/message.h"
+#include "mongo/util/timer.h"
+
+#include <algorithm>
 
 namespace mongo {
 namespace {
 
+// When enabled, outgoing messages smaller than adaptiveMessageCompressionMinSizeBytes are sent
+// uncompressed. Larger ones use the first negotiated compressor of lz4 and snappy, which are
+// cheap, or from adaptiveMessageCompressionLargeSizeBytes on, of zstd and zlib, which compress
+// better. A message is sent uncompressed if compressing did not shrink it.
+MONGO_EXPORT_SERVER_PARAMETER(adaptiveMessageCompression, bool, false);
+MONGO_EXPORT_SERVER_PARAMETER(adaptiveMessageCompressionMinSizeBytes, int, 1024);
+MONGO_EXPORT_SERVER_PARAMETER(adaptiveMessageCompressionLargeSizeBytes, int, 64 * 1024);
+
+const MessageCompressor kMediumMessageCompressors[] = {MessageCompressor::kLz4,
+                                                       MessageCompressor::kSnappy};
+const MessageCompressor kLargeMessageCompressors[] = {MessageCompressor::kZstd,
+                                                      MessageCompressor::kZlib};
+
 // TODO(JBR): This should be changed so it 's closer to the MSGHEADER View/ConstView classes
 // than this little struct.
 struct CompressionHeader {
@@ -102,6 +119,28 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
         return {msg};
     }
 
+    const bool adaptive = adaptiveMessageCompression.load();
+    if (adaptive) {
+        const auto dataSize = msg.dataSize();
+        if (dataSize < adaptiveMessageCompressionMinSizeBytes.load()) {
+            LOG(3) << "Not compressing message of " << dataSize << " bytes";
+            return {msg};
+        }
+
+        const auto& preferred = dataSize >= adaptiveMessageCompressionLargeSizeBytes.load()
+            ? kLargeMessageCompressors
+            : kMediumMessageCompressors;
+        for (auto id : preferred) {
+            auto it = std::find_if(_negotiated.begin(), _negotiated.end(), [&](auto negotiated) {
+                return negotiated->getId() == static_cast<MessageCompressorId>(id);
+            });
+            if (it != _negotiated.end()) {
+                compressor = *it;
+                break;
+            }
+        }
+    }
+
     LOG(3) << "Compressing message with " << compressor->getName();
 
     auto inputHeader = msg.header();
@@ -129,12 +168,22 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
     compressionHeader.serialize(&output);
     ConstDataRange input(inputHeader.data(), inputHeader.data() + inputHeader.dataLen());
 
+    Timer timer;
     auto sws = compressor->compressData(input, output);
+    compressor->counterHitCompressMicros(timer.micros());
 
     if (!sws.isOK())
         return sws.getStatus();
 
     auto realCompressedSize = sws.getValue();
+    if (adaptive &&
+        realCompressedSize + CompressionHeader::size() >=
+            static_cast<size_t>(inputHeader.dataLen())) {
+        LOG(3) << "Compressing with " << compressor->getName()
+               << " did not shrink the message, sending it uncompressed";
+        compressor->counterHitCompressDiscarded(inputHeader.dataLen(), realCompressedSize);
+        return {msg};
+    }
     outMessage.setLen(realCompressedSize + CompressionHeader::size() + MsgData::MsgDataHeaderSize);
 
     return {Message(outputMessageBuffer)};
@@ -176,7 +225,9 @@ StatusWith<Message> MessageCompressorManager::decompressMessage(const Message& m
 
     DataRangeCursor output(outMessage.data(), outMessage.data() + outMessage.dataLen());
 
+    Timer timer;
     auto sws = compressor->decompressData(input, output);
+    compressor->counterHitDecompressMicros(timer.micros());
 
     if (!sws.isOK())
         return sws.getStatus();
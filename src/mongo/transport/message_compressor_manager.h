@@ -98,6 +98,10 @@ public:
      * If _negotiated is empty (meaning compression was not negotiated or is not supported), then
      * it will return a ref-count bumped copy of the input message.
      *
+     * If the adaptiveMessageCompression server parameter is set, then small messages, and messages
+     * that do not shrink, are also returned uncompressed, and the compressor is chosen from the
+     * negotiated ones by the size of the message, overriding compressorId.
+     *
      * If an error occurs in the compressor, it will return a Status error.
      */
     StatusWith<Message> compressMessage(const Message& msg,
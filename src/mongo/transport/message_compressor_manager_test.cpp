@@ -31,18 +31,24 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/platform/random.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/transport/message_compressor_lz4.h"
 #include "mongo/transport/message_compressor_manager.h"
 #include "mongo/transport/message_compressor_noop.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_snappy.h"
 #include "mongo/transport/message_compressor_zlib.h"
+#include "mongo/transport/message_compressor_zstd.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
 #include "mongo/util/net/message.h"
 
 #include <string>
 #include <vector>
+#include <zdict.h>
 
 namespace mongo {
 namespace {
@@ -165,8 +171,7 @@ void checkOverflow(std::unique_ptr<MessageCompressorBase> compressor) {
         compressor->decompressData(tooSmallRange, DataRange(scratch.data(), scratch.size())));
 }
 
-Message buildMessage() {
-    const auto data = std::string{"Hello, world!"};
+Message buildMessage(const std::string& data) {
     const auto bufferSize = MsgData::MsgDataHeaderSize + data.size();
     auto buf = SharedBuffer::allocate(bufferSize);
     MsgData::View testView(buf.get());
@@ -178,6 +183,181 @@ Message buildMessage() {
     return Message{buf};
 }
 
+Message buildMessage() {
+    return buildMessage(std::string{"Hello, world!"});
+}
+
+void setServerParameter(const std::string& name, const std::string& value) {
+    const auto& params = ServerParameterSet::getGlobal()->getMap();
+    auto it = params.find(name);
+    invariant(it != params.end());
+    invariant(it->second->setFromString(value).isOK());
+}
+
+class AdaptiveCompressionGuard {
+public:
+    AdaptiveCompressionGuard() {
+        setServerParameter("adaptiveMessageCompression", "true");
+    }
+
+    ~AdaptiveCompressionGuard() {
+        setServerParameter("adaptiveMessageCompression", "false");
+    }
+};
+
+/**
+ * A pair of managers that have negotiated 'compressors' in order, by default snappy, then zlib.
+ */
+class NegotiatedManagers {
+public:
+    NegotiatedManagers() {
+        std::vector<std::unique_ptr<MessageCompressorBase>> compressors;
+        compressors.push_back(stdx::make_unique<SnappyMessageCompressor>());
+        compressors.push_back(stdx::make_unique<ZlibMessageCompressor>());
+        _negotiate(std::move(compressors));
+    }
+
+    explicit NegotiatedManagers(std::vector<std::unique_ptr<MessageCompressorBase>> compressors) {
+        _negotiate(std::move(compressors));
+    }
+
+    MessageCompressorId idOf(StringData name) {
+        return _registry.getCompressor(name)->getId();
+    }
+
+    MessageCompressorBase* compressor(StringData name) {
+        return _registry.getCompressor(name);
+    }
+
+private:
+    void _negotiate(std::vector<std::unique_ptr<MessageCompressorBase>> compressors) {
+        std::vector<std::string> names;
+        for (const auto& compressor : compressors) {
+            names.push_back(compressor->getName());
+        }
+        _registry.setSupportedCompressors(std::move(names));
+        for (auto& compressor : compressors) {
+            _registry.registerImplementation(std::move(compressor));
+        }
+        ASSERT_OK(_registry.finalizeSupportedCompressors());
+
+        BSONObjBuilder clientOutput;
+        client.clientBegin(&clientOutput);
+        BSONObjBuilder serverOutput;
+        server.serverNegotiate(clientOutput.done(), &serverOutput);
+        client.clientFinish(serverOutput.done());
+    }
+
+    MessageCompressorRegistry _registry;
+
+public:
+    MessageCompressorManager client{&_registry};
+    MessageCompressorManager server{&_registry};
+};
+
+/**
+ * Compresses 'msg' with 'sender' and returns the id of the compressor used, or boost::none if
+ * the message was sent uncompressed. Checks that 'receiver' gets back the original message.
+ */
+boost::optional<MessageCompressorId> sendMessage(MessageCompressorManager& sender,
+                                                 MessageCompressorManager& receiver,
+                                                 const Message& msg,
+                                                 const MessageCompressorId* compressorId) {
+    auto sent = assertOk(sender.compressMessage(msg, compressorId));
+    if (sent.operation() != dbCompressed) {
+        ASSERT_EQ(msg.buf(), sent.buf());
+        return boost::none;
+    }
+
+    MessageCompressorId usedId;
+    auto received = assertOk(receiver.decompressMessage(sent, &usedId));
+    ASSERT_EQ(msg.size(), received.size());
+    ASSERT_EQ(0, memcmp(msg.buf(), received.buf(), msg.size()));
+    return usedId;
+}
+
+TEST(MessageCompressorManager, AdaptiveSkipsSmallMessages) {
+    NegotiatedManagers managers;
+    const auto smallMessage = buildMessage(std::string(100, 'a'));
+
+    ASSERT(sendMessage(managers.client, managers.server, smallMessage, nullptr));
+    AdaptiveCompressionGuard adaptive;
+    ASSERT_FALSE(sendMessage(managers.client, managers.server, smallMessage, nullptr));
+}
+
+TEST(MessageCompressorManager, AdaptivePicksCompressorBySize) {
+    NegotiatedManagers managers;
+    AdaptiveCompressionGuard adaptive;
+    const auto snappyId = managers.idOf("snappy");
+    const auto zlibId = managers.idOf("zlib");
+
+    const auto mediumMessage = buildMessage(std::string(4 * 1024, 'a'));
+    ASSERT_EQ(snappyId, *sendMessage(managers.client, managers.server, mediumMessage, nullptr));
+    ASSERT_EQ(snappyId, *sendMessage(managers.server, managers.client, mediumMessage, &zlibId));
+
+    const auto largeMessage = buildMessage(std::string(100 * 1024, 'a'));
+    ASSERT_EQ(zlibId, *sendMessage(managers.client, managers.server, largeMessage, nullptr));
+    ASSERT_EQ(zlibId, *sendMessage(managers.server, managers.client, largeMessage, &snappyId));
+}
+
+TEST(MessageCompressorManager, AdaptivePrefersLz4AndZstd) {
+    std::vector<std::unique_ptr<MessageCompressorBase>> compressors;
+    compressors.push_back(stdx::make_unique<SnappyMessageCompressor>());
+    compressors.push_back(stdx::make_unique<ZlibMessageCompressor>());
+    compressors.push_back(stdx::make_unique<ZstdMessageCompressor>());
+    compressors.push_back(stdx::make_unique<Lz4MessageCompressor>());
+    NegotiatedManagers managers(std::move(compressors));
+    AdaptiveCompressionGuard adaptive;
+    const auto lz4Id = managers.idOf("lz4");
+    const auto zstdId = managers.idOf("zstd");
+
+    const auto mediumMessage = buildMessage(std::string(4 * 1024, 'a'));
+    ASSERT_EQ(lz4Id, *sendMessage(managers.client, managers.server, mediumMessage, nullptr));
+    ASSERT_EQ(lz4Id, *sendMessage(managers.server, managers.client, mediumMessage, &zstdId));
+
+    const auto largeMessage = buildMessage(std::string(100 * 1024, 'a'));
+    ASSERT_EQ(zstdId, *sendMessage(managers.client, managers.server, largeMessage, nullptr));
+    ASSERT_EQ(zstdId, *sendMessage(managers.server, managers.client, largeMessage, &lz4Id));
+}
+
+TEST(MessageCompressorManager, AdaptiveSendsIncompressibleMessagesUncompressed) {
+    NegotiatedManagers managers;
+    AdaptiveCompressionGuard adaptive;
+
+    PseudoRandom random(1);
+    std::string data(4 * 1024, '\0');
+    for (auto& c : data) {
+        c = static_cast<char>(random.nextInt32());
+    }
+    const auto randomMessage = buildMessage(data);
+    ASSERT_FALSE(sendMessage(managers.client, managers.server, randomMessage, nullptr));
+}
+
+TEST(MessageCompressorManager, AdaptiveBytesSavedIgnoresMessagesSentUncompressed) {
+    NegotiatedManagers managers;
+    AdaptiveCompressionGuard adaptive;
+    const auto snappy = managers.compressor("snappy");
+
+    PseudoRandom random(1);
+    std::string data(4 * 1024, '\0');
+    for (auto& c : data) {
+        c = static_cast<char>(random.nextInt32());
+    }
+    const auto randomMessage = buildMessage(data);
+    ASSERT_FALSE(sendMessage(managers.client, managers.server, randomMessage, nullptr));
+    ASSERT_GT(snappy->getCompressedBytesIn(), 0);
+    ASSERT_EQ(0, snappy->getCompressedBytesSaved());
+
+    const auto compressibleMessage = buildMessage(std::string(4 * 1024, 'a'));
+    const auto bytesInBefore = snappy->getCompressedBytesIn();
+    const auto bytesOutBefore = snappy->getCompressedBytesOut();
+    ASSERT(sendMessage(managers.client, managers.server, compressibleMessage, nullptr));
+    const auto bytesSaved = (snappy->getCompressedBytesIn() - bytesInBefore) -
+        (snappy->getCompressedBytesOut() - bytesOutBefore);
+    ASSERT_GT(bytesSaved, 0);
+    ASSERT_EQ(bytesSaved, snappy->getCompressedBytesSaved());
+}
+
 TEST(MessageCompressorManager, NoCompressionRequested) {
     auto input = BSON("isMaster" << 1);
     checkServerNegotiation(input, {});
@@ -232,6 +412,16 @@ TEST(ZlibMessageCompressor, Fidelity) {
     checkFidelity(testMessage, stdx::make_unique<ZlibMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, Fidelity) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, stdx::make_unique<ZstdMessageCompressor>());
+}
+
+TEST(Lz4MessageCompressor, Fidelity) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, stdx::make_unique<Lz4MessageCompressor>());
+}
+
 TEST(SnappyMessageCompressor, Overflow) {
     checkOverflow(stdx::make_unique<SnappyMessageCompressor>());
 }
@@ -240,6 +430,98 @@ TEST(ZlibMessageCompressor, Overflow) {
     checkOverflow(stdx::make_unique<ZlibMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, Overflow) {
+    checkOverflow(stdx::make_unique<ZstdMessageCompressor>());
+}
+
+TEST(Lz4MessageCompressor, Overflow) {
+    checkOverflow(stdx::make_unique<Lz4MessageCompressor>());
+}
+
+TEST(ZstdMessageCompressor, CompressionLevelIsValidated) {
+    const auto& params = ServerParameterSet::getGlobal()->getMap();
+    auto it = params.find("zstdNetworkCompressionLevel");
+    ASSERT(it != params.end());
+    ASSERT_NOT_OK(it->second->setFromString("1000"));
+    ASSERT_OK(it->second->setFromString("1"));
+    checkOverflow(stdx::make_unique<ZstdMessageCompressor>());
+    ASSERT_OK(it->second->setFromString("3"));
+}
+
+std::string buildSample(int i) {
+    return str::stream() << "{ _id: " << i << ", user: \"user" << (i * 7919) % 1000
+                         << "\", status: \"" << (i % 3 ? "active" : "inactive")
+                         << "\", roles: [ \"readWrite\", \"dbAdmin\" ], lastLogin: " << i * 31
+                         << " }";
+}
+
+std::string trainDictionary() {
+    std::string samples;
+    std::vector<size_t> sampleSizes;
+    for (int i = 0; i < 2000; i++) {
+        auto sample = buildSample(i);
+        samples += sample;
+        sampleSizes.push_back(sample.size());
+    }
+
+    std::string dictionary(4 * 1024, '\0');
+    auto size = ZDICT_trainFromBuffer(&dictionary[0],
+                                      dictionary.size(),
+                                      samples.data(),
+                                      sampleSizes.data(),
+                                      sampleSizes.size());
+    ASSERT_FALSE(ZDICT_isError(size));
+    dictionary.resize(size);
+    return dictionary;
+}
+
+size_t compressedSize(MessageCompressorBase* compressor, const std::string& data) {
+    std::vector<char> buffer(compressor->getMaxCompressedSize(data.size()));
+    return assertOk(compressor->compressData(ConstDataRange(data.data(), data.size()),
+                                             DataRange(buffer.data(), buffer.size())));
+}
+
+TEST(ZstdMessageCompressor, DictionaryFidelity) {
+    auto testMessage = buildMessage(buildSample(100000));
+    checkFidelity(testMessage, stdx::make_unique<ZstdMessageCompressor>(trainDictionary()));
+}
+
+TEST(ZstdMessageCompressor, DictionaryShrinksSmallMessages) {
+    ZstdMessageCompressor plain;
+    ZstdMessageCompressor withDictionary(trainDictionary());
+    const auto sample = buildSample(100000);
+    ASSERT_LT(compressedSize(&withDictionary, sample), compressedSize(&plain, sample));
+}
+
+TEST(ZstdMessageCompressor, DictionaryMustMatch) {
+    ZstdMessageCompressor plain;
+    ZstdMessageCompressor withDictionary(trainDictionary());
+    const auto sample = buildSample(100000);
+    ConstDataRange sampleRange(sample.data(), sample.size());
+    std::vector<char> output(sample.size());
+    DataRange outputRange(output.data(), output.size());
+
+    std::vector<char> compressed(withDictionary.getMaxCompressedSize(sample.size()));
+    DataRange compressedRange(compressed.data(), compressed.size());
+    auto size = assertOk(withDictionary.compressData(sampleRange, compressedRange));
+    ASSERT_NOT_OK(plain.decompressData(ConstDataRange(compressed.data(), size), outputRange));
+    ASSERT_EQ(sample.size(),
+              assertOk(withDictionary.decompressData(ConstDataRange(compressed.data(), size),
+                                                     outputRange)));
+    ASSERT_EQ(0, memcmp(sample.data(), output.data(), sample.size()));
+
+    // Messages from peers that compress without a dictionary can still be read.
+    size = assertOk(plain.compressData(sampleRange, compressedRange));
+    ASSERT_EQ(sample.size(),
+              assertOk(withDictionary.decompressData(ConstDataRange(compressed.data(), size),
+                                                     outputRange)));
+    ASSERT_EQ(0, memcmp(sample.data(), output.data(), sample.size()));
+}
+
+TEST(ZstdMessageCompressor, RejectsUntrainedDictionary) {
+    ASSERT_THROWS(ZstdMessageCompressor(std::string(1024, 'a')), DBException);
+}
+
 TEST(MessageCompressorManager, SERVER_28008) {
 
     // Create a client and server that will negotiate the same compressors,
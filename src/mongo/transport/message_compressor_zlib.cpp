@@ -31,6 +31,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/init.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_zlib.h"
@@ -38,6 +39,31 @@
 #include <zlib.h>
 
 namespace mongo {
+namespace {
+
+AtomicInt32 zlibNetworkCompressionLevel(Z_DEFAULT_COMPRESSION);
+
+// The zlib level used to compress network messages, trading CPU time for smaller messages.
+class ZlibNetworkCompressionLevelParameter
+    : public ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime> {
+public:
+    ZlibNetworkCompressionLevelParameter()
+        : ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "zlibNetworkCompressionLevel",
+              &zlibNetworkCompressionLevel) {}
+
+    Status validate(const int& potentialNewValue) override {
+        if (potentialNewValue != Z_DEFAULT_COMPRESSION &&
+            (potentialNewValue < Z_BEST_SPEED || potentialNewValue > Z_BEST_COMPRESSION)) {
+            return Status(ErrorCodes::BadValue,
+                          "zlibNetworkCompressionLevel must be -1 or between 1 and 9, inclusive");
+        }
+        return Status::OK();
+    }
+} zlibNetworkCompressionLevelParameter;
+
+}  // namespace
 
 ZlibMessageCompressor::ZlibMessageCompressor() : MessageCompressorBase(MessageCompressor::kZlib) {}
 
@@ -52,7 +78,7 @@ StatusWith<std::size_t> ZlibMessageCompressor::compressData(ConstDataRange input
                           reinterpret_cast<uLongf*>(&outLength),
                           reinterpret_cast<const Bytef*>(input.data()),
                           input.length(),
-                          Z_DEFAULT_COMPRESSION);
+                          zlibNetworkCompressionLevel.load());
 
     if (ret != Z_OK) {
         return Status{ErrorCodes::BadValue, "Could not compress input"};
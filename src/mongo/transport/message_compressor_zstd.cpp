@@ -0,0 +1,235 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/base/init.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/message_compressor_registry.h"
+#include "mongo/transport/message_compressor_zstd.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+#include <fstream>
+#include <sstream>
+#include <zstd.h>
+
+namespace mongo {
+namespace {
+
+AtomicInt32 zstdNetworkCompressionLevel(ZSTD_CLEVEL_DEFAULT);
+
+// The zstd level used to compress network messages, trading CPU time for smaller messages.
+class ZstdNetworkCompressionLevelParameter
+    : public ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime> {
+public:
+    ZstdNetworkCompressionLevelParameter()
+        : ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "zstdNetworkCompressionLevel",
+              &zstdNetworkCompressionLevel) {}
+
+    Status validate(const int& potentialNewValue) override {
+        if (potentialNewValue < ZSTD_minCLevel() || potentialNewValue > ZSTD_maxCLevel()) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "zstdNetworkCompressionLevel must be between "
+                                        << ZSTD_minCLevel()
+                                        << " and "
+                                        << ZSTD_maxCLevel()
+                                        << ", inclusive");
+        }
+        return Status::OK();
+    }
+} zstdNetworkCompressionLevelParameter;
+
+// A trained zstd dictionary (see "zstd --train") used to compress and decompress network
+// messages. Small messages share little with each other, so a dictionary built from typical
+// traffic is what makes zstd worthwhile for them.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(zstdNetworkCompressionDictionaryPath, std::string, "");
+
+// The compression contexts hold a few hundred kilobytes of tables that zstd would otherwise
+// allocate for every message, so each thread keeps its own.
+ZSTD_CCtx* getThreadCCtx() {
+    thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx(ZSTD_createCCtx(),
+                                                                           &ZSTD_freeCCtx);
+    return cctx.get();
+}
+
+ZSTD_DCtx* getThreadDCtx() {
+    thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(ZSTD_createDCtx(),
+                                                                           &ZSTD_freeDCtx);
+    return dctx.get();
+}
+
+StatusWith<std::string> readDictionary(const std::string& path) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file) {
+        return {ErrorCodes::FileOpenFailed,
+                str::stream() << "Could not open zstd network compression dictionary " << path};
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    if (file.bad()) {
+        return {ErrorCodes::FileStreamFailed,
+                str::stream() << "Could not read zstd network compression dictionary " << path};
+    }
+    return contents.str();
+}
+
+}  // namespace
+
+ZstdMessageCompressor::ZstdMessageCompressor(std::string dictionary)
+    : MessageCompressorBase(MessageCompressor::kZstd), _dictionary(std::move(dictionary)) {
+    if (_dictionary.empty()) {
+        return;
+    }
+
+    _dictId = ZSTD_getDictID_fromDict(_dictionary.data(), _dictionary.size());
+    uassert(50910,
+            "The zstd network compression dictionary must be a trained zstd dictionary",
+            _dictId != 0);
+    _ddict = std::shared_ptr<ZSTD_DDict>(
+        ZSTD_createDDict(_dictionary.data(), _dictionary.size()), &ZSTD_freeDDict);
+    uassert(50911, "Could not load the zstd network compression dictionary", _ddict);
+}
+
+std::shared_ptr<ZSTD_CDict> ZstdMessageCompressor::_getCDict(int level) {
+    if (_dictionary.empty()) {
+        return nullptr;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!_cdict || _cdictLevel != level) {
+        _cdict = std::shared_ptr<ZSTD_CDict>(
+            ZSTD_createCDict(_dictionary.data(), _dictionary.size(), level), &ZSTD_freeCDict);
+        _cdictLevel = level;
+    }
+    return _cdict;
+}
+
+std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
+    return ZSTD_compressBound(inputSize);
+}
+
+StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
+                                                            DataRange output) {
+    auto cctx = getThreadCCtx();
+    if (!cctx) {
+        return Status{ErrorCodes::ExceededMemoryLimit, "Could not allocate a zstd context"};
+    }
+
+    const auto level = zstdNetworkCompressionLevel.load();
+    size_t ret;
+    if (auto cdict = _getCDict(level)) {
+        ret = ZSTD_compress_usingCDict(cctx,
+                                       const_cast<char*>(output.data()),
+                                       output.length(),
+                                       input.data(),
+                                       input.length(),
+                                       cdict.get());
+    } else {
+        ret = ZSTD_compressCCtx(cctx,
+                                const_cast<char*>(output.data()),
+                                output.length(),
+                                input.data(),
+                                input.length(),
+                                level);
+    }
+
+    if (ZSTD_isError(ret)) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Could not compress input: " << ZSTD_getErrorName(ret)};
+    }
+    counterHitCompress(input.length(), ret);
+    return {ret};
+}
+
+StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
+                                                              DataRange output) {
+    auto dctx = getThreadDCtx();
+    if (!dctx) {
+        return Status{ErrorCodes::ExceededMemoryLimit, "Could not allocate a zstd context"};
+    }
+
+    size_t ret;
+    const auto frameDictId = ZSTD_getDictID_fromFrame(input.data(), input.length());
+    if (frameDictId != 0) {
+        if (frameDictId != _dictId) {
+            return Status{ErrorCodes::BadValue,
+                          str::stream() << "Compressed message uses zstd dictionary "
+                                        << frameDictId
+                                        << " which is not loaded"};
+        }
+        ret = ZSTD_decompress_usingDDict(dctx,
+                                         const_cast<char*>(output.data()),
+                                         output.length(),
+                                         input.data(),
+                                         input.length(),
+                                         _ddict.get());
+    } else {
+        ret = ZSTD_decompressDCtx(
+            dctx, const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    }
+
+    if (ZSTD_isError(ret)) {
+        return Status{ErrorCodes::BadValue, "Compressed message was invalid or corrupted"};
+    }
+
+    counterHitDecompress(input.length(), ret);
+    return {ret};
+}
+
+
+MONGO_INITIALIZER_GENERAL(ZstdMessageCompressorInit,
+                          ("EndStartupOptionHandling"),
+                          ("AllCompressorsRegistered"))
+(InitializerContext* context) {
+    std::string dictionary;
+    if (!zstdNetworkCompressionDictionaryPath.empty()) {
+        auto swDictionary = readDictionary(zstdNetworkCompressionDictionaryPath);
+        if (!swDictionary.isOK()) {
+            return swDictionary.getStatus();
+        }
+        dictionary = std::move(swDictionary.getValue());
+        log() << "Loaded zstd network compression dictionary "
+              << zstdNetworkCompressionDictionaryPath;
+    }
+
+    auto& compressorRegistry = MessageCompressorRegistry::get();
+    try {
+        compressorRegistry.registerImplementation(
+            stdx::make_unique<ZstdMessageCompressor>(std::move(dictionary)));
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
+    return Status::OK();
+}
+}  // namespace mongo
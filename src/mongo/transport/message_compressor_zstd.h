@@ -0,0 +1,73 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "mongo/stdx/mutex.h"
+#include "mongo/transport/message_compressor_base.h"
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace mongo {
+class ZstdMessageCompressor final : public MessageCompressorBase {
+public:
+    /**
+     * If 'dictionary' is not empty it must be a trained zstd dictionary. Messages are then
+     * compressed with it, and messages compressed with it can be decompressed; every peer that
+     * negotiates zstd must have been started with the same dictionary.
+     */
+    explicit ZstdMessageCompressor(std::string dictionary = std::string());
+
+    std::size_t getMaxCompressedSize(size_t inputSize) override;
+
+    StatusWith<std::size_t> compressData(ConstDataRange input, DataRange output) override;
+
+    StatusWith<std::size_t> decompressData(ConstDataRange input, DataRange output) override;
+
+private:
+    /**
+     * Returns the compression dictionary digested for 'level', rebuilding it when
+     * zstdNetworkCompressionLevel has changed since the last call.
+     */
+    std::shared_ptr<ZSTD_CDict_s> _getCDict(int level);
+
+    const std::string _dictionary;
+    std::shared_ptr<ZSTD_DDict_s> _ddict;
+    unsigned _dictId = 0;
+
+    stdx::mutex _mutex;
+    std::shared_ptr<ZSTD_CDict_s> _cdict;
+    int _cdictLevel = 0;
+};
+
+
+}  // namespace mongo
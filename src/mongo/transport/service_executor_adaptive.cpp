@@ -38,6 +38,7 @@
 #include "mongo/transport/service_entry_point_utils.h"
 #include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/log.h"
+#include "mongo/util/net/thread_idle_callback.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/stringutils.h"
@@ -497,6 +498,12 @@ void ServiceExecutorAdaptive::_workerThreadRoutine(
         }
         auto spentRunning = state->running.markStopped();
 
+        // A whole run period without a task means this thread is idle, so give back the memory
+        // it keeps cached for the requests it serves.
+        if (state->executingCurRun == 0) {
+            markThreadIdle();
+        }
+
         // If we're still pending, let the controller know and go back around for another go
         //
         // Otherwise we can think about exiting if the last call to run_for() wasn't very
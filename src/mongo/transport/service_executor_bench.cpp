@@ -0,0 +1,207 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "asio.hpp"
+
+#include "mongo/base/initializer.h"
+#include "mongo/base/parse_number.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/service_executor_adaptive.h"
+#include "mongo/transport/service_executor_work_stealing.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
+
+/**
+ * Measures how fast a service executor moves sessions between network callbacks and tasks.
+ *
+ * Usage: service_executor_bench <adaptive|workStealing> [sessions] [seconds] [workMicros]
+ *
+ * Each simulated session loops through the steps of a ServiceStateMachine without a transport
+ * layer. A task spins for 'workMicros' as if it were running a command, then posts a callback to
+ * the io_context as the completion of sinking its reply. That callback schedules a deferred task
+ * to source the next request, which posts the completion of the source, which in turn asks to run
+ * the next command right away. The time from the end of one command to the start of the next is
+ * the session's round trip.
+ */
+
+namespace mongo {
+namespace {
+
+class Session : public std::enable_shared_from_this<Session> {
+public:
+    Session(transport::ServiceExecutor* executor,
+            asio::io_context* ioContext,
+            const AtomicWord<bool>& stop,
+            int workMicros)
+        : _executor(executor), _ioContext(ioContext), _stop(stop), _workMicros(workMicros) {}
+
+    void start() {
+        _schedule([](Session* session) { session->_process(); },
+                  transport::ServiceExecutor::kEmptyFlags);
+    }
+
+    const std::vector<long long>& latencies() const {
+        return _latencies;
+    }
+
+private:
+    template <typename Step>
+    void _schedule(Step step, transport::ServiceExecutor::ScheduleFlags flags) {
+        uassertStatusOK(
+            _executor->schedule([ self = shared_from_this(), step ] { step(self.get()); }, flags));
+    }
+
+    template <typename Step>
+    void _complete(Step step) {
+        _ioContext->post([ self = shared_from_this(), step ] { step(self.get()); });
+    }
+
+    void _source() {
+        _complete([](Session* session) {
+            session->_schedule([](Session* session) { session->_process(); },
+                               transport::ServiceExecutor::kMayRecurse);
+        });
+    }
+
+    void _process() {
+        if (_started) {
+            _latencies.push_back(_timer.micros() - _started);
+        }
+
+        const auto deadline = _timer.micros() + _workMicros;
+        while (_timer.micros() < deadline) {
+        }
+
+        if (_stop.load()) {
+            return;
+        }
+
+        _started = _timer.micros();
+        _complete([](Session* session) {
+            session->_schedule([](Session* session) { session->_source(); },
+                               transport::ServiceExecutor::kDeferredTask |
+                                   transport::ServiceExecutor::kMayYieldBeforeSchedule);
+        });
+    }
+
+    transport::ServiceExecutor* const _executor;
+    asio::io_context* const _ioContext;
+    const AtomicWord<bool>& _stop;
+    const int _workMicros;
+
+    Timer _timer;
+    long long _started = 0;
+    std::vector<long long> _latencies;
+};
+
+long long percentile(const std::vector<long long>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const auto index = static_cast<size_t>(fraction * (sorted.size() - 1));
+    return sorted[index];
+}
+
+int parseArg(int argc, char** argv, int index, int defaultValue) {
+    if (argc <= index) {
+        return defaultValue;
+    }
+    int value;
+    uassertStatusOK(parseNumberFromString(argv[index], &value));
+    return value;
+}
+
+int benchMain(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0]
+                  << " <adaptive|workStealing> [sessions] [seconds] [workMicros]" << std::endl;
+        return 2;
+    }
+    const std::string executorName = argv[1];
+    const int sessionCount = parseArg(argc, argv, 2, 1000);
+    const int seconds = parseArg(argc, argv, 3, 10);
+    const int workMicros = parseArg(argc, argv, 4, 5);
+
+    auto ioContext = std::make_shared<asio::io_context>();
+    std::unique_ptr<transport::ServiceExecutor> executor;
+    if (executorName == "adaptive") {
+        executor = stdx::make_unique<transport::ServiceExecutorAdaptive>(
+            getGlobalServiceContext(), ioContext);
+    } else if (executorName == "workStealing") {
+        executor = stdx::make_unique<transport::ServiceExecutorWorkStealing>(
+            getGlobalServiceContext(), ioContext);
+    } else {
+        std::cerr << "unknown service executor " << executorName << std::endl;
+        return 2;
+    }
+    uassertStatusOK(executor->start());
+
+    AtomicWord<bool> stop{false};
+    std::vector<std::shared_ptr<Session>> sessions;
+    for (int i = 0; i < sessionCount; ++i) {
+        sessions.push_back(
+            std::make_shared<Session>(executor.get(), ioContext.get(), stop, workMicros));
+        sessions.back()->start();
+    }
+
+    sleepsecs(seconds);
+    stop.store(true);
+    uassertStatusOK(executor->shutdown(Seconds{10}));
+
+    std::vector<long long> all;
+    for (const auto& session : sessions) {
+        all.insert(all.end(), session->latencies().begin(), session->latencies().end());
+    }
+    std::sort(all.begin(), all.end());
+
+    std::cout << executorName << ": " << sessionCount << " sessions, " << workMicros
+              << "us of work per task" << std::endl;
+    std::cout << "  throughput: " << all.size() / seconds << " round trips/s" << std::endl;
+    std::cout << "  latency p50: " << percentile(all, 0.5) << "us p99: " << percentile(all, 0.99)
+              << "us p99.9: " << percentile(all, 0.999) << "us" << std::endl;
+    return 0;
+}
+
+}  // namespace
+}  // namespace mongo
+
+int main(int argc, char** argv, char** envp) {
+    mongo::runGlobalInitializersOrDie(argc, argv, envp);
+    return mongo::benchMain(argc, argv);
+}
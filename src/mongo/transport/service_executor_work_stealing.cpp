@@ -0,0 +1,517 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kExecutor;
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/service_executor_work_stealing.h"
+
+#include <fstream>
+
+#include "mongo/db/server_parameters.h"
+#include "mongo/transport/service_entry_point_utils.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/log.h"
+#include "mongo/util/processinfo.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/stringutils.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace mongo {
+namespace transport {
+namespace {
+// The number of per-core worker threads. If the value is -1 (the default) then it will be set to
+// the number of available cores.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(workStealingServiceExecutorThreads, int, -1);
+
+// When set, workers are spread across the NUMA nodes of the machine, each one pinned to the CPUs
+// of its node, and workers steal from their own node before reaching across nodes. This is only
+// supported on Linux and is ignored elsewhere.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(workStealingServiceExecutorNumaPinning, bool, false);
+
+// An idle worker waits on the io_context for network events for at most this long before looking
+// for tasks to steal again.
+MONGO_EXPORT_SERVER_PARAMETER(workStealingServiceExecutorIdleWaitMillis, int, 10);
+
+// The maximum amount of time the controller thread will sleep before doing any stuck detection.
+MONGO_EXPORT_SERVER_PARAMETER(workStealingServiceExecutorStuckThreadTimeoutMillis, int, 250);
+
+// Tasks scheduled with MayRecurse may be called recursively if the recursion depth is below this
+// value.
+MONGO_EXPORT_SERVER_PARAMETER(workStealingServiceExecutorRecursionLimit, int, 8);
+
+// A worker runs at most this many tasks from its own queue in a row before it looks for ready
+// network events again, so that a busy worker can't hold back the sessions waiting on it. It also
+// bounds how many ready network callbacks a worker runs before going back to its queue.
+constexpr size_t kMaxTasksBetweenPolls = 64;
+
+constexpr auto kTotalQueued = "totalQueued"_sd;
+constexpr auto kTotalExecuted = "totalExecuted"_sd;
+constexpr auto kTotalStolen = "totalStolen"_sd;
+constexpr auto kTasksQueued = "tasksQueued"_sd;
+constexpr auto kDeferredTasksQueued = "deferredTasksQueued"_sd;
+constexpr auto kTotalTimeQueuedUs = "totalTimeQueuedMicros"_sd;
+constexpr auto kTasksExecuting = "tasksExecuting"_sd;
+constexpr auto kThreadsRunning = "threadsRunning"_sd;
+constexpr auto kReserveThreadsRunning = "reserveThreadsRunning"_sd;
+constexpr auto kQueueLatencyUs = "queueLatencyMicros"_sd;
+constexpr auto kExecutorLabel = "executor"_sd;
+constexpr auto kExecutorName = "workStealing"_sd;
+
+int64_t ticksToMicros(TickSource::Tick ticks, TickSource* tickSource) {
+    invariant(tickSource->getTicksPerSecond() >= 1000000);
+    static const auto ticksPerMicro = tickSource->getTicksPerSecond() / 1000000;
+    return ticks / ticksPerMicro;
+}
+
+/**
+ * Parses a kernel CPU list such as "0-3,8-11" into the CPU numbers it names.
+ */
+std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::vector<std::string> ranges;
+    splitStringDelim(list, &ranges, ',');
+    for (const auto& range : ranges) {
+        int first, last;
+        if (sscanf(range.c_str(), "%d-%d", &first, &last) == 2) {
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } else if (sscanf(range.c_str(), "%d", &first) == 1) {
+            cpus.push_back(first);
+        }
+    }
+    return cpus;
+}
+
+/**
+ * Returns the CPUs of each NUMA node that has any, or an empty list if the topology can't be
+ * determined.
+ */
+std::vector<std::vector<int>> getNumaNodeCpus() {
+    std::vector<std::vector<int>> nodes;
+#if defined(__linux__)
+    for (int node = 0;; ++node) {
+        std::ifstream in(str::stream() << "/sys/devices/system/node/node" << node << "/cpulist");
+        if (!in) {
+            break;
+        }
+        std::string list;
+        std::getline(in, list);
+        auto cpus = parseCpuList(list);
+        if (!cpus.empty()) {
+            nodes.push_back(std::move(cpus));
+        }
+    }
+#endif
+    return nodes;
+}
+
+void pinCurrentThread(const std::vector<int>& cpus) {
+#if defined(__linux__)
+    if (cpus.empty()) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    int failed = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (failed) {
+        warning() << "Failed to pin worker thread to its NUMA node: "
+                  << errnoWithDescription(failed);
+    }
+#endif
+}
+
+}  // namespace
+
+constexpr int ServiceExecutorWorkStealing::kNumLatencyBuckets;
+constexpr int64_t ServiceExecutorWorkStealing::kMaxLatencyBucketMicros;
+
+thread_local ServiceExecutorWorkStealing::Worker* ServiceExecutorWorkStealing::_localWorker =
+    nullptr;
+thread_local int ServiceExecutorWorkStealing::_localRecursionDepth = 0;
+
+int ServiceExecutorWorkStealing::latencyBucket(int64_t micros) {
+    int bucket = 0;
+    for (int64_t bound = 1; bucket < kNumLatencyBuckets - 1 && micros > bound; bound <<= 1) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+ServiceExecutorWorkStealing::ServiceExecutorWorkStealing(ServiceContext* ctx,
+                                                         std::shared_ptr<asio::io_context> ioCtx)
+    : _ioContext(std::move(ioCtx)), _tickSource(ctx->getTickSource()) {}
+
+ServiceExecutorWorkStealing::~ServiceExecutorWorkStealing() {
+    invariant(!_isRunning.load());
+}
+
+Status ServiceExecutorWorkStealing::start() {
+    invariant(!_isRunning.load());
+
+    int numWorkers = workStealingServiceExecutorThreads;
+    if (numWorkers <= 0) {
+        ProcessInfo pi;
+        numWorkers = pi.getNumAvailableCores().value_or(pi.getNumCores());
+        numWorkers = std::max(numWorkers, 2);
+        log() << "No thread count configured for executor. Using number of cores: " << numWorkers;
+    }
+
+    std::vector<std::vector<int>> nodes;
+    if (workStealingServiceExecutorNumaPinning) {
+        nodes = getNumaNodeCpus();
+        if (nodes.empty()) {
+            warning() << "Could not determine the NUMA topology, worker threads will not be pinned";
+        } else {
+            log() << "Pinning worker threads across " << nodes.size() << " NUMA node(s)";
+        }
+    }
+
+    // Worker i lives on node i % nodes.size(). Each worker steals first from the workers on its
+    // own node, then from the rest, starting just after itself so thieves don't pile onto the
+    // same victim.
+    const auto nodeOf = [&](size_t i) { return nodes.empty() ? 0 : i % nodes.size(); };
+    for (int i = 0; i < numWorkers; i++) {
+        auto worker = stdx::make_unique<Worker>();
+        if (!nodes.empty()) {
+            worker->cpus = nodes[nodeOf(i)];
+        }
+        for (bool sameNode : {true, false}) {
+            for (int offset = 1; offset < numWorkers; offset++) {
+                size_t victim = (i + offset) % numWorkers;
+                if ((nodeOf(victim) == nodeOf(i)) == sameNode) {
+                    worker->stealOrder.push_back(victim);
+                }
+            }
+        }
+        _workers.push_back(std::move(worker));
+    }
+    _reserveWorker = stdx::make_unique<Worker>();
+    for (int i = 0; i < numWorkers; i++) {
+        _reserveWorker->stealOrder.push_back(i);
+    }
+
+    _isRunning.store(true);
+    _controllerThread = stdx::thread(&ServiceExecutorWorkStealing::_controllerThreadRoutine, this);
+    for (size_t i = 0; i < _workers.size(); i++) {
+        _startWorkerThread(_workers[i].get(), i);
+    }
+
+    return Status::OK();
+}
+
+Status ServiceExecutorWorkStealing::shutdown(Milliseconds timeout) {
+    if (!_isRunning.load())
+        return Status::OK();
+
+    _isRunning.store(false);
+    _controllerThread.join();
+
+    stdx::unique_lock<stdx::mutex> lk(_threadsMutex);
+    _ioContext->stop();
+    bool result = _deathCondition.wait_for(
+        lk, timeout.toSystemDuration(), [&] { return _threadsRunning.load() == 0; });
+
+    return result
+        ? Status::OK()
+        : Status(ErrorCodes::Error::ExceededTimeLimit,
+                 "work-stealing executor couldn't shutdown all worker threads within time limit.");
+}
+
+Status ServiceExecutorWorkStealing::schedule(Task task, ScheduleFlags flags) {
+    const bool deferred = flags & kDeferredTask;
+    _totalQueued.addAndFetch(1);
+
+    // A task that may recurse runs right away if this thread is one of ours and isn't too deep.
+    if (_localWorker && (flags & kMayRecurse) &&
+        (_localRecursionDepth + 1 < workStealingServiceExecutorRecursionLimit.load())) {
+        (deferred ? _deferredTasksQueued : _tasksQueued).addAndFetch(1);
+        _runTask(_localWorker, {std::move(task), _tickSource->getTicks(), deferred});
+        return Status::OK();
+    }
+
+    // Keep the task on this thread if it's a worker, so the session stays where its state is
+    // already cached. Reserve threads have no queue of their own and hand their tasks back to the
+    // per-core workers.
+    Worker* worker = (_localWorker && _localWorker != _reserveWorker.get()) ? _localWorker
+                                                                            : _pickRemoteWorker();
+    size_t queueDepth;
+    {
+        stdx::lock_guard<stdx::mutex> lk(worker->mutex);
+        worker->queue.push_back({std::move(task), _tickSource->getTicks(), deferred});
+        queueDepth = worker->queue.size();
+    }
+    (deferred ? _deferredTasksQueued : _tasksQueued).addAndFetch(1);
+
+    // A worker only needs waking when the task isn't going to be picked up by the current thread
+    // on its next loop, or when it is already behind and an idle worker could steal from it.
+    if (worker != _localWorker || queueDepth > 1) {
+        _ioContext->post([] {});
+    }
+
+    return Status::OK();
+}
+
+ServiceExecutorWorkStealing::Worker* ServiceExecutorWorkStealing::_pickRemoteWorker() {
+    return _workers[_nextRemoteWorker.fetchAndAdd(1) % _workers.size()].get();
+}
+
+bool ServiceExecutorWorkStealing::_popTask(Worker* worker, QueuedTask* out) {
+    stdx::lock_guard<stdx::mutex> lk(worker->mutex);
+    if (worker->queue.empty()) {
+        return false;
+    }
+    *out = std::move(worker->queue.front());
+    worker->queue.pop_front();
+    return true;
+}
+
+bool ServiceExecutorWorkStealing::_stealTask(Worker* worker, QueuedTask* out) {
+    for (auto victim : worker->stealOrder) {
+        if (_popTask(_workers[victim].get(), out)) {
+            worker->stolen.addAndFetch(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ServiceExecutorWorkStealing::_runTask(Worker* worker, QueuedTask queued) {
+    (queued.deferred ? _deferredTasksQueued : _tasksQueued).subtractAndFetch(1);
+
+    const auto spentQueued = _tickSource->getTicks() - queued.scheduled;
+    worker->spentQueued.addAndFetch(spentQueued);
+    worker->latencyHistogram[latencyBucket(ticksToMicros(spentQueued, _tickSource))].addAndFetch(
+        1);
+
+    _tasksExecuting.addAndFetch(1);
+    ++_localRecursionDepth;
+    const auto guard = MakeGuard([this, worker] {
+        --_localRecursionDepth;
+        _tasksExecuting.subtractAndFetch(1);
+        worker->executed.addAndFetch(1);
+    });
+
+    queued.task();
+}
+
+bool ServiceExecutorWorkStealing::_pollNetwork(Milliseconds timeout) {
+    size_t handlersRun = 0;
+    try {
+        asio::io_context::work work(*_ioContext);
+        if (timeout > Milliseconds{0}) {
+            handlersRun = _ioContext->run_one_for(timeout.toSystemDuration());
+        } else {
+            while (handlersRun < kMaxTasksBetweenPolls && _ioContext->poll_one()) {
+                ++handlersRun;
+            }
+        }
+
+        // Once the io_context has run out of work it must be restarted before it will run any
+        // more handlers.
+        if (_ioContext->stopped() && _isRunning.load())
+            _ioContext->restart();
+    } catch (std::exception& e) {
+        log() << "Exception escaped worker thread: " << e.what();
+    } catch (...) {
+        log() << "Unknown exception escaped worker thread.";
+    }
+    return handlersRun > 0;
+}
+
+void ServiceExecutorWorkStealing::_startWorkerThread(Worker* worker, size_t id) {
+    _threadsRunning.addAndFetch(1);
+    const auto launchResult = launchServiceWorkerThread([this, worker, id] {
+        setThreadName(str::stream() << "worker-" << id);
+        log() << "Started new database worker thread " << id;
+        pinCurrentThread(worker->cpus);
+        _workerThreadRoutine(worker);
+    });
+
+    if (!launchResult.isOK()) {
+        // Tasks queued on this worker will still be run by the others stealing them.
+        warning() << "Failed to launch new worker thread: " << launchResult;
+        _threadsRunning.subtractAndFetch(1);
+    }
+}
+
+void ServiceExecutorWorkStealing::_startReserveThread() {
+    _threadsRunning.addAndFetch(1);
+    _reserveThreadsRunning.addAndFetch(1);
+    const auto launchResult = launchServiceWorkerThread([this] {
+        setThreadName("worker-reserve");
+        _workerThreadRoutine(_reserveWorker.get());
+    });
+
+    if (!launchResult.isOK()) {
+        warning() << "Failed to launch new reserve worker thread: " << launchResult;
+        _reserveThreadsRunning.subtractAndFetch(1);
+        _threadsRunning.subtractAndFetch(1);
+    }
+}
+
+void ServiceExecutorWorkStealing::_workerThreadRoutine(Worker* worker) {
+    _localWorker = worker;
+    const bool isReserve = worker == _reserveWorker.get();
+
+    const auto guard = MakeGuard([this, isReserve] {
+        _localWorker = nullptr;
+        if (isReserve)
+            _reserveThreadsRunning.subtractAndFetch(1);
+
+        stdx::lock_guard<stdx::mutex> lk(_threadsMutex);
+        _threadsRunning.subtractAndFetch(1);
+        _deathCondition.notify_one();
+    });
+
+    size_t tasksSincePoll = 0;
+    while (_isRunning.load()) {
+        // The io_context is shared by every worker, so polling it takes a lock that all of them
+        // contend on. Drain the local queue first and only then look at the network.
+        QueuedTask queued;
+        if (tasksSincePoll < kMaxTasksBetweenPolls && _popTask(worker, &queued)) {
+            ++tasksSincePoll;
+            _runTask(worker, std::move(queued));
+            continue;
+        }
+        tasksSincePoll = 0;
+
+        // Run the network callbacks that are ready; they schedule the next task of their session
+        // onto this worker's queue.
+        if (_pollNetwork(Milliseconds{0}))
+            continue;
+
+        if (_popTask(worker, &queued) || _stealTask(worker, &queued)) {
+            _runTask(worker, std::move(queued));
+            continue;
+        }
+
+        // Reserve threads only exist to unblock the per-core workers, so they go away as soon
+        // as there is nothing left to steal.
+        if (isReserve)
+            break;
+
+        _pollNetwork(Milliseconds{workStealingServiceExecutorIdleWaitMillis.load()});
+    }
+}
+
+bool ServiceExecutorWorkStealing::_hasStaleTask() const {
+    const auto timeout = Milliseconds{workStealingServiceExecutorStuckThreadTimeoutMillis.load()};
+    const auto now = _tickSource->getTicks();
+    for (const auto& worker : _workers) {
+        stdx::lock_guard<stdx::mutex> lk(worker->mutex);
+        if (!worker->queue.empty() &&
+            Microseconds{ticksToMicros(now - worker->queue.front().scheduled, _tickSource)} >=
+                timeout) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ServiceExecutorWorkStealing::_controllerThreadRoutine() {
+    setThreadName("worker-controller"_sd);
+
+    while (_isRunning.load()) {
+        stdx::this_thread::sleep_for(
+            Milliseconds{workStealingServiceExecutorStuckThreadTimeoutMillis.load()}
+                .toSystemDuration());
+
+        if (!_isRunning.load())
+            break;
+
+        // Idle workers steal anything that is queued, so a task can only sit past the timeout
+        // when every thread is busy executing. In that case assume they are blocked and start
+        // one reserve thread per worker to drain the queues.
+        if ((_tasksExecuting.load() >= _threadsRunning.load()) && _hasStaleTask()) {
+            log() << "Detected blocked worker threads, "
+                  << "starting new reserve threads to unblock service executor";
+            for (size_t i = 0; i < _workers.size(); i++) {
+                _startReserveThread();
+            }
+        }
+    }
+}
+
+void ServiceExecutorWorkStealing::appendStats(BSONObjBuilder* bob) const {
+    int64_t totalExecuted = 0;
+    int64_t totalStolen = 0;
+    TickSource::Tick totalSpentQueued = 0;
+    std::array<int64_t, kNumLatencyBuckets> latencies{};
+
+    const auto accumulate = [&](const Worker& worker) {
+        totalExecuted += worker.executed.load();
+        totalStolen += worker.stolen.load();
+        totalSpentQueued += worker.spentQueued.load();
+        for (int i = 0; i < kNumLatencyBuckets; i++) {
+            latencies[i] += worker.latencyHistogram[i].load();
+        }
+    };
+    for (const auto& worker : _workers) {
+        accumulate(*worker);
+    }
+    if (_reserveWorker) {
+        accumulate(*_reserveWorker);
+    }
+
+    BSONObjBuilder section(bob->subobjStart("serviceExecutorTaskStats"));
+    section << kExecutorLabel << kExecutorName                                          //
+            << kTotalQueued << _totalQueued.load()                                      //
+            << kTotalExecuted << totalExecuted                                          //
+            << kTotalStolen << totalStolen                                              //
+            << kTasksQueued << _tasksQueued.load()                                      //
+            << kDeferredTasksQueued << _deferredTasksQueued.load()                      //
+            << kTasksExecuting << _tasksExecuting.load()                                //
+            << kTotalTimeQueuedUs << ticksToMicros(totalSpentQueued, _tickSource)       //
+            << kThreadsRunning << _threadsRunning.load()                                //
+            << kReserveThreadsRunning << _reserveThreadsRunning.load();
+
+    // Each bucket is labelled with its upper bound in microseconds.
+    BSONObjBuilder histogram(section.subobjStart(kQueueLatencyUs));
+    int64_t bound = 1;
+    for (int i = 0; i < kNumLatencyBuckets - 1; i++, bound <<= 1) {
+        histogram.append(str::stream() << "le" << bound, latencies[i]);
+    }
+    histogram.append("inf", latencies[kNumLatencyBuckets - 1]);
+    histogram.doneFast();
+    section.doneFast();
+}
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/service_executor.h"
+#include "mongo/util/tick_source.h"
+
+#include <asio.hpp>
+
+namespace mongo {
+namespace transport {
+
+/**
+ * This is an ASIO-based ServiceExecutor that keeps one worker thread per core, each with its own
+ * run queue.
+ *
+ * A task scheduled from a worker thread goes on that worker's queue, so once a session's network
+ * callback has run on a thread, the rest of that session's work stays there and keeps its cache
+ * lines warm. Tasks scheduled from outside the executor are spread round-robin across the
+ * workers. A worker only polls the shared io_context for ready network callbacks once its queue
+ * is empty, or after running a bounded number of tasks in a row. If nothing is ready, it steals
+ * from the other workers, preferring those on its own NUMA node, and only then waits on the
+ * io_context for network events.
+ *
+ * When every worker is executing a task and queued tasks have waited longer than the stuck
+ * thread timeout, the controller thread starts reserve workers. Reserve workers only steal and
+ * exit as soon as they find nothing to do.
+ */
+class ServiceExecutorWorkStealing final : public ServiceExecutor {
+public:
+    explicit ServiceExecutorWorkStealing(ServiceContext* ctx,
+                                         std::shared_ptr<asio::io_context> ioCtx);
+    ~ServiceExecutorWorkStealing();
+
+    Status start() override;
+    Status shutdown(Milliseconds timeout) override;
+    Status schedule(Task task, ScheduleFlags flags) override;
+
+    Mode transportMode() const override {
+        return Mode::kAsynchronous;
+    }
+
+    void appendStats(BSONObjBuilder* bob) const override;
+
+    /**
+     * Queue latencies are counted in buckets whose upper bounds are powers of two microseconds,
+     * from 1us up to kMaxLatencyBucketMicros. The last bucket counts everything slower.
+     */
+    static constexpr int kNumLatencyBuckets = 22;
+    static constexpr int64_t kMaxLatencyBucketMicros = 1 << (kNumLatencyBuckets - 2);
+
+    /**
+     * Returns the histogram bucket that a task queued for 'micros' falls into.
+     */
+    static int latencyBucket(int64_t micros);
+
+private:
+    struct QueuedTask {
+        Task task;
+        TickSource::Tick scheduled;
+        bool deferred;
+    };
+
+    struct Worker {
+        // Guards the run queue. Thieves take this mutex too, but only when their own queue is
+        // empty, so it is rarely contended.
+        stdx::mutex mutex;
+        std::deque<QueuedTask> queue;
+
+        // Other workers' indexes in the order this worker tries to steal from them.
+        std::vector<size_t> stealOrder;
+        std::vector<int> cpus;
+
+        // Reporting counters. They are per worker so that hot paths only touch local cache lines.
+        std::array<AtomicWord<int64_t>, kNumLatencyBuckets> latencyHistogram;
+        AtomicWord<int64_t> executed{0};
+        AtomicWord<int64_t> stolen{0};
+        AtomicWord<TickSource::Tick> spentQueued{0};
+    };
+
+    void _startWorkerThread(Worker* worker, size_t id);
+    void _startReserveThread();
+    void _workerThreadRoutine(Worker* worker);
+    void _controllerThreadRoutine();
+
+    bool _popTask(Worker* worker, QueuedTask* out);
+    bool _stealTask(Worker* worker, QueuedTask* out);
+    void _runTask(Worker* worker, QueuedTask queued);
+    // Runs the network callbacks that are ready, or waits up to 'timeout' for one when 'timeout'
+    // is positive. Returns whether any callback ran.
+    bool _pollNetwork(Milliseconds timeout);
+
+    Worker* _pickRemoteWorker();
+    bool _hasStaleTask() const;
+
+    static thread_local Worker* _localWorker;
+    static thread_local int _localRecursionDepth;
+
+    std::shared_ptr<asio::io_context> _ioContext;
+    TickSource* const _tickSource;
+
+    // The per-core workers, fixed at start(). Reserve threads use the _reserveWorker slot, which
+    // has no tasks of its own.
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::unique_ptr<Worker> _reserveWorker;
+    AtomicWord<size_t> _nextRemoteWorker{0};
+
+    stdx::thread _controllerThread;
+    AtomicWord<bool> _isRunning{false};
+
+    mutable stdx::mutex _threadsMutex;
+    AtomicWord<int> _threadsRunning{0};
+    AtomicWord<int> _reserveThreadsRunning{0};
+    AtomicWord<int> _tasksExecuting{0};
+    AtomicWord<int> _tasksQueued{0};
+    AtomicWord<int> _deferredTasksQueued{0};
+    AtomicWord<int64_t> _totalQueued{0};
+
+    // Threads signal this condition variable when they exit so we can gracefully shutdown
+    // the executor.
+    stdx::condition_variable _deathCondition;
+};
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,267 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kDefault;
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context_noop.h"
+#include "mongo/transport/service_executor_work_stealing.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
+
+#include <asio.hpp>
+
+namespace mongo {
+namespace {
+using namespace transport;
+
+constexpr Milliseconds kStuckThreadTimeout{100};
+constexpr Milliseconds kShutdownTime{10000};
+constexpr Milliseconds kWaitTimeout{10000};
+
+void setServerParameter(const std::string& name, const std::string& value) {
+    const auto& params = ServerParameterSet::getGlobal()->getMap();
+    auto it = params.find(name);
+    invariant(it != params.end());
+    invariant(it->second->setFromString(value).isOK());
+}
+
+class ServiceExecutorWorkStealingFixture : public unittest::Test {
+protected:
+    void setUp() override {
+        auto scOwned = stdx::make_unique<ServiceContextNoop>();
+        setGlobalServiceContext(std::move(scOwned));
+        asioIoCtx = std::make_shared<asio::io_context>();
+
+        setServerParameter("workStealingServiceExecutorThreads", "2");
+        setServerParameter("workStealingServiceExecutorStuckThreadTimeoutMillis",
+                           std::to_string(durationCount<Milliseconds>(kStuckThreadTimeout)));
+    }
+
+    std::shared_ptr<asio::io_context> asioIoCtx;
+
+    stdx::mutex mutex;
+    int waitFor = -1;
+    stdx::condition_variable cond;
+    stdx::function<void()> notifyCallback = [this] {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        invariant(waitFor != -1);
+        waitFor--;
+        cond.notify_one();
+        log() << "Ran callback";
+    };
+
+    void waitForCallback(int expected, Milliseconds timeout = kWaitTimeout) {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        invariant(waitFor != -1);
+        ASSERT_TRUE(
+            cond.wait_for(lk, timeout.toSystemDuration(), [&] { return waitFor == expected; }));
+    }
+
+    std::unique_ptr<ServiceExecutorWorkStealing> makeAndStartExecutor() {
+        auto exec = stdx::make_unique<ServiceExecutorWorkStealing>(getGlobalServiceContext(),
+                                                                   asioIoCtx);
+        ASSERT_OK(exec->start());
+        return exec;
+    }
+
+    static BSONObj getStats(const ServiceExecutorWorkStealing& exec) {
+        BSONObjBuilder bob;
+        exec.appendStats(&bob);
+        return bob.obj()["serviceExecutorTaskStats"].Obj().getOwned();
+    }
+
+    /**
+     * Polls the executor's stats until 'field' reaches 'expected'.
+     */
+    static void waitForStat(const ServiceExecutorWorkStealing& exec,
+                            StringData field,
+                            long long expected) {
+        const auto deadline = Date_t::now() + kWaitTimeout;
+        while (getStats(exec)[field].numberLong() != expected) {
+            ASSERT_LT(Date_t::now(), deadline) << "Timed out waiting for " << field << " to be "
+                                               << expected << ": " << getStats(exec);
+            stdx::this_thread::sleep_for(Milliseconds{10}.toSystemDuration());
+        }
+    }
+};
+
+TEST_F(ServiceExecutorWorkStealingFixture, ScheduleAndRun) {
+    auto exec = makeAndStartExecutor();
+    auto guard = MakeGuard([&] { ASSERT_OK(exec->shutdown(kShutdownTime)); });
+
+    waitFor = 10;
+    for (int i = 0; i < 10; i++) {
+        ASSERT_OK(exec->schedule(notifyCallback, ServiceExecutor::kEmptyFlags));
+    }
+    waitForCallback(0);
+
+    waitForStat(*exec, "totalExecuted", 10);
+    const auto stats = getStats(*exec);
+    ASSERT_EQ(stats["totalQueued"].numberLong(), 10);
+    ASSERT_EQ(stats["tasksQueued"].numberLong(), 0);
+    ASSERT_EQ(stats["threadsRunning"].numberLong(), 2);
+    ASSERT_EQ(stats["reserveThreadsRunning"].numberLong(), 0);
+}
+
+/*
+ * A task scheduled from a worker goes on that worker's own queue. If the worker then blocks, the
+ * other worker must steal the task rather than leave it behind the blocked one.
+ */
+TEST_F(ServiceExecutorWorkStealingFixture, IdleWorkerStealsFromBlockedWorker) {
+    stdx::mutex blockedMutex;
+    stdx::unique_lock<stdx::mutex> blockedLock(blockedMutex);
+
+    auto exec = makeAndStartExecutor();
+    auto guard = MakeGuard([&] {
+        if (blockedLock)
+            blockedLock.unlock();
+        ASSERT_OK(exec->shutdown(kShutdownTime));
+    });
+
+    waitFor = 3;
+    ASSERT_OK(exec->schedule(
+        [this, &exec, &blockedMutex] {
+            notifyCallback();
+            invariant(exec->schedule(notifyCallback, ServiceExecutor::kEmptyFlags).isOK());
+            stdx::unique_lock<stdx::mutex> lk(blockedMutex);
+            notifyCallback();
+        },
+        ServiceExecutor::kEmptyFlags));
+
+    log() << "Waiting for the task queued behind the blocked task to be stolen";
+    waitForCallback(1);
+    ASSERT_GTE(getStats(*exec)["totalStolen"].numberLong(), 1);
+
+    blockedLock.unlock();
+    waitForCallback(0);
+}
+
+/*
+ * This tests that the controller starts reserve threads when every worker is blocked and tasks
+ * are left waiting, and that the reserve threads exit once there is nothing left to steal.
+ */
+TEST_F(ServiceExecutorWorkStealingFixture, ReserveThreadsStartAndExit) {
+    stdx::mutex blockedMutex;
+    stdx::unique_lock<stdx::mutex> blockedLock(blockedMutex);
+
+    auto exec = makeAndStartExecutor();
+    auto guard = MakeGuard([&] {
+        if (blockedLock)
+            blockedLock.unlock();
+        ASSERT_OK(exec->shutdown(kShutdownTime));
+    });
+
+    auto blockedTask = [this, &blockedMutex] {
+        notifyCallback();
+        stdx::unique_lock<stdx::mutex> lk(blockedMutex);
+        notifyCallback();
+    };
+
+    waitFor = 5;
+    log() << "Blocking both workers";
+    ASSERT_OK(exec->schedule(blockedTask, ServiceExecutor::kEmptyFlags));
+    ASSERT_OK(exec->schedule(blockedTask, ServiceExecutor::kEmptyFlags));
+    waitForCallback(3);
+
+    log() << "Scheduling a task that only a reserve thread can run";
+    ASSERT_OK(exec->schedule(notifyCallback, ServiceExecutor::kEmptyFlags));
+    waitForCallback(2);
+    waitForStat(*exec, "totalExecuted", 1);
+
+    log() << "Waiting for the reserve threads to exit";
+    waitForStat(*exec, "reserveThreadsRunning", 0);
+    ASSERT_EQ(getStats(*exec)["threadsRunning"].numberLong(), 2);
+
+    blockedLock.unlock();
+    waitForCallback(0);
+    waitForStat(*exec, "totalExecuted", 3);
+}
+
+TEST_F(ServiceExecutorWorkStealingFixture, ShutdownStopsIdleWorkers) {
+    auto exec = makeAndStartExecutor();
+
+    waitFor = 1;
+    ASSERT_OK(exec->schedule(notifyCallback, ServiceExecutor::kEmptyFlags));
+    waitForCallback(0);
+
+    ASSERT_OK(exec->shutdown(kShutdownTime));
+    ASSERT_EQ(getStats(*exec)["threadsRunning"].numberLong(), 0);
+}
+
+TEST_F(ServiceExecutorWorkStealingFixture, ShutdownTimesOutOnBlockedWorker) {
+    stdx::mutex blockedMutex;
+    stdx::unique_lock<stdx::mutex> blockedLock(blockedMutex);
+
+    auto exec = makeAndStartExecutor();
+
+    waitFor = 2;
+    ASSERT_OK(exec->schedule(
+        [this, &blockedMutex] {
+            notifyCallback();
+            stdx::unique_lock<stdx::mutex> lk(blockedMutex);
+            notifyCallback();
+        },
+        ServiceExecutor::kEmptyFlags));
+    waitForCallback(1);
+
+    ASSERT_EQ(exec->shutdown(Milliseconds{100}), ErrorCodes::ExceededTimeLimit);
+
+    // The blocked worker exits as soon as its task returns, and must be gone before the executor
+    // is destroyed.
+    blockedLock.unlock();
+    waitForCallback(0);
+    waitForStat(*exec, "threadsRunning", 0);
+}
+
+TEST(ServiceExecutorWorkStealing, LatencyBucketBoundaries) {
+    constexpr auto kLastBucket = ServiceExecutorWorkStealing::kNumLatencyBuckets - 1;
+    constexpr auto kMaxMicros = ServiceExecutorWorkStealing::kMaxLatencyBucketMicros;
+
+    // Each bucket's upper bound is inclusive.
+    ASSERT_EQ(ServiceExecutorWorkStealing::latencyBucket(0), 0);
+    ASSERT_EQ(ServiceExecutorWorkStealing::latencyBucket(1), 0);
+    ASSERT_EQ(ServiceExecutorWorkStealing::latencyBucket(2), 1);
+    ASSERT_EQ(ServiceExecutorWorkStealing::latencyBucket(3), 2);
+    ASSERT_EQ(ServiceExecutorWorkStealing::latencyBucket(4), 2);
+    ASSERT_EQ(ServiceExecutorWorkStealing::latencyBucket(5), 3);
+    ASSERT_EQ(ServiceExecutorWorkStealing::latencyBucket(1024), 10);
+    ASSERT_EQ(ServiceExecutorWorkStealing::latencyBucket(1025), 11);
+
+    ASSERT_EQ(ServiceExecutorWorkStealing::latencyBucket(kMaxMicros), kLastBucket - 1);
+    ASSERT_EQ(ServiceExecutorWorkStealing::latencyBucket(kMaxMicros + 1), kLastBucket);
+    ASSERT_EQ(ServiceExecutorWorkStealing::latencyBucket(std::numeric_limits<int64_t>::max()),
+              kLastBucket);
+}
+
+}  // namespace
+}  // namespace mongo
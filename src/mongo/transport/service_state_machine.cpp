@@ -48,6 +48,8 @@
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/message.h"
+#include "mongo/util/net/message_buffer_pool.h"
+#include "mongo/util/net/op_msg.h"
 #include "mongo/util/net/socket_exception.h"
 #include "mongo/util/net/thread_idle_callback.h"
 #include "mongo/util/quick_exit.h"
@@ -87,6 +89,24 @@ bool setExhaustMessage(Message* m, const DbResponse& dbresponse) {
     return true;
 }
 
+// Replaces 'm' with the request that produces the reply following 'response' in an OP_MSG exhaust
+// stream, and marks 'response' as having more replies to come.
+void setOpMsgExhaustMessage(Message* m, Message* response, const BSONObj& nextInvocation) {
+    OpMsg::setFlag(response, OpMsg::kMoreToCome);
+
+    OpMsgBuilder builder;
+    builder.setBody(nextInvocation);
+    Message next = builder.finish();
+
+    // Each reply in the stream claims to be a response to the one before it, so the synthetic
+    // request takes on the id of the reply it follows.
+    next.header().setId(response->header().getId());
+    OpMsg::setFlag(&next, OpMsg::kExhaustSupported);
+
+    MessageBufferPool::release(m->releaseBuffer());
+    *m = std::move(next);
+}
+
 }  // namespace
 
 using transport::TransportLayer;
@@ -259,6 +279,10 @@ void ServiceStateMachine::_sinkCallback(Status status) {
 
     invariant(state() == State::SinkWait);
 
+    // The transport layer has dropped its reference to the reply, so its buffer can serve the
+    // next one.
+    MessageBufferPool::release(_outMessage.releaseBuffer());
+
     // If there was an error sinking the message to the client, then we should print an error and
     // end the session. No need to unwind the stack, so this will runNextInGuard() and return.
     //
@@ -288,7 +312,11 @@ void ServiceStateMachine::_processMessage(ThreadGuard& guard) {
 
     auto& compressorMgr = MessageCompressorManager::forSession(_session());
 
-    _compressorId = boost::none;
+    // The requests synthesized for an exhaust stream are never compressed, so the replies keep
+    // using the compressor of the request that started the stream.
+    if (!_inExhaust) {
+        _compressorId = boost::none;
+    }
     if (_inMessage.operation() == dbCompressed) {
         MessageCompressorId compressorId;
         auto swm = compressorMgr.decompressMessage(_inMessage, &compressorId);
@@ -317,12 +345,16 @@ void ServiceStateMachine::_processMessage(ThreadGuard& guard) {
         toSink.header().setId(nextMessageId());
         toSink.header().setResponseToMsgId(_inMessage.header().getId());
 
-        // If this is an exhaust cursor, don't source more Messages
+        // If this is an exhaust cursor, don't source more Messages. The next batch is only produced
+        // once this one has been written out, so a slow reader throttles the stream.
         if (dbresponse.exhaustNS.size() > 0 && setExhaustMessage(&_inMessage, dbresponse)) {
             _inExhaust = true;
+        } else if (dbresponse.nextInvocation) {
+            setOpMsgExhaustMessage(&_inMessage, &toSink, *dbresponse.nextInvocation);
+            _inExhaust = true;
         } else {
             _inExhaust = false;
-            _inMessage.reset();
+            MessageBufferPool::release(_inMessage.releaseBuffer());
         }
 
         networkCounter.hitLogicalOut(toSink.size());
@@ -334,7 +366,8 @@ void ServiceStateMachine::_processMessage(ThreadGuard& guard) {
         }
 
         // Sink our response to the client
-        auto ticket = _session()->sinkMessage(toSink);
+        _outMessage = std::move(toSink);
+        auto ticket = _session()->sinkMessage(_outMessage);
 
         _state.store(State::SinkWait);
         if (_transportMode == transport::Mode::kSynchronous) {
@@ -347,7 +380,7 @@ void ServiceStateMachine::_processMessage(ThreadGuard& guard) {
         }
     } else {
         _state.store(State::Source);
-        _inMessage.reset();
+        MessageBufferPool::release(_inMessage.releaseBuffer());
         return scheduleNext(ServiceExecutor::kDeferredTask);
     }
 }
@@ -472,6 +505,7 @@ void ServiceStateMachine::_cleanupSession(ThreadGuard& guard) {
     _state.store(State::Ended);
 
     _inMessage.reset();
+    _outMessage.reset();
 
     // By ignoring the return value of Client::releaseCurrent() we destroy the session.
     // _dbClient is now nullptr and _dbClientPtr is invalid and should never be accessed.
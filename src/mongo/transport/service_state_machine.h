@@ -217,6 +217,7 @@ private:
     bool _inExhaust = false;
     boost::optional<MessageCompressorId> _compressorId;
     Message _inMessage;
+    Message _outMessage;
 
     AtomicWord<stdx::thread::id> _currentOwningThread;
     std::atomic_flag _isOwned = ATOMIC_FLAG_INIT;  // NOLINT
@@ -37,6 +37,9 @@
 #include "mongo/db/service_context_noop.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/mock_session.h"
+#include "mongo/transport/message_compressor_manager.h"
+#include "mongo/transport/message_compressor_noop.h"
+#include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/mock_ticket.h"
 #include "mongo/transport/service_entry_point.h"
 #include "mongo/transport/service_executor_noop.h"
@@ -72,7 +75,12 @@ public:
         if (_uassertInHandler)
             uassert(40469, "Synthetic uassert failure", false);
 
-        return DbResponse{builder.finish()};
+        DbResponse response{builder.finish()};
+        if (_exhaustRepliesRemaining > 0) {
+            --_exhaustRepliesRemaining;
+            response.nextInvocation = BSON("ping" << 1);
+        }
+        return response;
     }
 
     void endAllSessions(transport::Session::TagMask tags) override {}
@@ -93,6 +101,13 @@ public:
         _uassertInHandler = true;
     }
 
+    /**
+     * Makes the next 'count' replies ask to be followed by another, as an exhaust cursor would.
+     */
+    void setExhaustReplies(int count) {
+        _exhaustRepliesRemaining = count;
+    }
+
     bool ranHandler() {
         bool ret = _ranHandler;
         _ranHandler = false;
@@ -102,6 +117,7 @@ public:
 private:
     bool _uassertInHandler = false;
     bool _ranHandler = false;
+    int _exhaustRepliesRemaining = 0;
 };
 
 using namespace transport;
@@ -278,6 +294,69 @@ TEST_F(ServiceStateMachineFixture, TestOkaySimpleCommand) {
     checkPingOk();
 }
 
+TEST_F(ServiceStateMachineFixture, TestOpMsgExhaustStreamsRepliesWithoutRequests) {
+    _sep->setExhaustReplies(2);
+
+    auto request = buildRequest(BSON("ping" << 1));
+    request.header().setId(7);
+    _tl->setNextMessage(std::move(request));
+
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Process);
+
+    // The two replies asking for more are each followed by another without sourcing a request,
+    // and each answers the one before it.
+    int32_t responseTo = 7;
+    for (int i = 0; i < 3; ++i) {
+        _ssm->runNext();
+        ASSERT_EQ(_ssm->state(), i < 2 ? State::Process : State::Source);
+
+        auto reply = _tl->getLastSunk();
+        ASSERT_EQ(responseTo, reply.header().getResponseToMsgId());
+        ASSERT_EQ(i < 2, OpMsg::isFlagSet(reply, OpMsg::kMoreToCome));
+        ASSERT_BSONOBJ_EQ(OpMsg::parse(reply).body, BSON("ok" << 1));
+        responseTo = reply.header().getId();
+    }
+}
+
+TEST_F(ServiceStateMachineFixture, TestOpMsgExhaustRepliesStayCompressed) {
+    auto& registry = MessageCompressorRegistry::get();
+    const auto noopName = getMessageCompressorName(MessageCompressor::kNoop).toString();
+    if (!registry.getCompressor(noopName)) {
+        registry.setSupportedCompressors({noopName});
+        registry.registerImplementation(stdx::make_unique<NoopMessageCompressor>());
+    }
+    MessageCompressorManager clientCompressorMgr(&registry);
+    const auto noopId = static_cast<MessageCompressorId>(MessageCompressor::kNoop);
+
+    _sep->setExhaustReplies(2);
+
+    auto request = buildRequest(BSON("ping" << 1));
+    request.header().setId(7);
+    auto swCompressed = clientCompressorMgr.compressMessage(request, &noopId);
+    ASSERT_OK(swCompressed.getStatus());
+    _tl->setNextMessage(std::move(swCompressed.getValue()));
+
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Process);
+
+    // Every reply in the stream is compressed like the request, not just the first one.
+    for (int i = 0; i < 3; ++i) {
+        _ssm->runNext();
+        ASSERT_EQ(_ssm->state(), i < 2 ? State::Process : State::Source);
+
+        auto reply = _tl->getLastSunk();
+        ASSERT_EQ(dbCompressed, reply.operation());
+
+        MessageCompressorId usedId;
+        auto swReply = clientCompressorMgr.decompressMessage(reply, &usedId);
+        ASSERT_OK(swReply.getStatus());
+        ASSERT_EQ(noopId, usedId);
+        ASSERT_EQ(i < 2, OpMsg::isFlagSet(swReply.getValue(), OpMsg::kMoreToCome));
+        ASSERT_BSONOBJ_EQ(OpMsg::parse(swReply.getValue()).body, BSON("ok" << 1));
+    }
+}
+
 TEST_F(ServiceStateMachineFixture, TestThrowHandling) {
     _sep->setUassertInHandler();
 
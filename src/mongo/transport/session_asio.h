@@ -35,10 +35,15 @@
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/transport_layer_asio.h"
 #include "mongo/util/net/sock.h"
+#include "mongo/util/shared_buffer.h"
+#include "mongo/util/timer.h"
 #ifdef MONGO_CONFIG_SSL
 #include "mongo/util/net/ssl_manager.h"
 #include "mongo/util/net/ssl_types.h"
 #endif
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+#include "mongo/transport/kernel_tls_stream.h"
+#endif
 
 #include "asio.hpp"
 #ifdef MONGO_CONFIG_SSL
@@ -92,6 +97,11 @@ public:
         if (_sslSocket) {
             return static_cast<GenericSocket&>(_sslSocket->lowest_layer());
         }
+#endif
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+        if (_kernelTLSSocket) {
+            return static_cast<GenericSocket&>(_kernelTLSSocket->lowest_layer());
+        }
 #endif
         return _socket;
     }
@@ -106,6 +116,11 @@ public:
     }
 
     bool isOpen() const {
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+        if (_kernelTLSSocket) {
+            return _kernelTLSSocket->lowest_layer().is_open();
+        }
+#endif
 #ifdef MONGO_CONFIG_SSL
         return _sslSocket ? _sslSocket->lowest_layer().is_open() : _socket.is_open();
 #else
@@ -115,6 +130,12 @@ public:
 
     template <typename MutableBufferSequence, typename CompleteHandler>
     void read(bool sync, const MutableBufferSequence& buffers, CompleteHandler&& handler) {
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+        if (_kernelTLSSocket) {
+            return opportunisticRead(
+                sync, *_kernelTLSSocket, buffers, std::forward<CompleteHandler>(handler));
+        }
+#endif
 #ifdef MONGO_CONFIG_SSL
         if (_sslSocket) {
             return opportunisticRead(
@@ -146,6 +167,13 @@ public:
                 maybeHandshakeSSL(sync, buffers, std::move(postHandshakeCb));
             };
 
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+            // OpenSSL has to read the whole ClientHello from the socket to drive it itself, so the
+            // header that decides whether this is TLS is only peeked at.
+            if (_tl->_kernelTLS) {
+                return peekHeader(sync, buffers, std::move(handshakeRecvCb));
+            }
+#endif
             opportunisticRead(sync, _socket, buffers, std::move(handshakeRecvCb));
         } else {
 
@@ -156,8 +184,63 @@ public:
 #endif
     }
 
+    /**
+     * Returns true if messages on this session may be received with readSome() and
+     * asyncWaitForRead(). This is only the case for plain sockets once the first message has been
+     * received, since that message decides whether the connection uses TLS, and a TLS stream
+     * buffers decrypted data that a wait on the underlying socket would not see.
+     */
+    bool canReadAhead() const {
+#if defined(MONGO_CONFIG_HAVE_SSL_KTLS)
+        return _ranHandshake && !_sslSocket && !_kernelTLSSocket;
+#elif defined(MONGO_CONFIG_SSL)
+        return _ranHandshake && !_sslSocket;
+#else
+        return true;
+#endif
+    }
+
+    /**
+     * Reads whatever is available on the socket into 'buffers', up to their size, in a single
+     * call. On a non-blocking socket with no data available this fails with would_block.
+     */
+    template <typename MutableBufferSequence>
+    size_t readSome(const MutableBufferSequence& buffers, std::error_code& ec) {
+        invariant(canReadAhead());
+        return _socket.read_some(buffers, ec);
+    }
+
+    /**
+     * Calls 'handler' once the socket is readable, without reading from it.
+     */
+    template <typename CompleteHandler>
+    void asyncWaitForRead(CompleteHandler&& handler) {
+        invariant(canReadAhead());
+        _socket.async_wait(GenericSocket::wait_read, std::forward<CompleteHandler>(handler));
+    }
+
+    /**
+     * Bytes received past the end of the last message, which are the start of the next one. Only
+     * source tickets use these, and a session has at most one source ticket in flight.
+     */
+    void stashReadAhead(SharedBuffer buffer, size_t size) {
+        _readAheadBuffer = std::move(buffer);
+        _readAheadSize = size;
+    }
+
+    size_t takeReadAhead(SharedBuffer* buffer) {
+        *buffer = std::move(_readAheadBuffer);
+        return std::exchange(_readAheadSize, 0);
+    }
+
     template <typename ConstBufferSequence, typename CompleteHandler>
     void write(bool sync, const ConstBufferSequence& buffers, CompleteHandler&& handler) {
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+        if (_kernelTLSSocket) {
+            return opportunisticWrite(
+                sync, *_kernelTLSSocket, buffers, std::forward<CompleteHandler>(handler));
+        }
+#endif
 #ifdef MONGO_CONFIG_SSL
         if (_sslSocket) {
             opportunisticWrite(sync, *_sslSocket, buffers, std::forward<CompleteHandler>(handler));
@@ -212,7 +295,46 @@ private:
         }
     }
 
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+    /**
+     * Like opportunisticRead() into the message header at the start of 'buffers', except that
+     * the bytes stay on the socket.
+     */
+    template <typename MutableBufferSequence, typename CompleteHandler>
+    void peekHeader(bool sync, const MutableBufferSequence& buffers, CompleteHandler&& handler) {
+        const auto header =
+            asio::buffer(asio::buffer_cast<char*>(buffers), sizeof(MSGHEADER::Value));
+        std::error_code ec;
+        auto size = _socket.receive(
+            header, GenericSocket::message_peek | (sync ? MSG_WAITALL : 0), ec);
+        if (sync || (ec && ec != asio::error::would_block && ec != asio::error::try_again) ||
+            size == asio::buffer_size(header)) {
+            return handler(ec, size);
+        }
+
+        // A ClientHello arrives in one piece in practice, so a partial header only means waiting
+        // for the rest of a segment.
+        _socket.async_wait(GenericSocket::wait_read,
+                           [ this, buffers, handler = std::forward<CompleteHandler>(handler) ](
+                               const std::error_code& ec) mutable {
+                               if (ec) {
+                                   return handler(ec, 0);
+                               }
+                               peekHeader(false, buffers, std::move(handler));
+                           });
+    }
+#endif
+
 #ifdef MONGO_CONFIG_SSL
+    SSL* nativeSSLHandle() {
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+        if (_kernelTLSSocket) {
+            return _kernelTLSSocket->native_handle();
+        }
+#endif
+        return _sslSocket->native_handle();
+    }
+
     template <typename MutableBufferSequence, typename HandshakeCb>
     void maybeHandshakeSSL(bool sync, const MutableBufferSequence& buffer, HandshakeCb onComplete) {
         invariant(asio::buffer_size(buffer) >= sizeof(MSGHEADER::Value));
@@ -234,16 +356,32 @@ private:
                     false);
             }
 
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+            if (_tl->_kernelTLS) {
+                _kernelTLSSocket.emplace(std::move(_socket), *_tl->_sslContext);
+            } else {
+                _sslSocket.emplace(std::move(_socket), *_tl->_sslContext);
+            }
+#else
             _sslSocket.emplace(std::move(_socket), *_tl->_sslContext);
+#endif
+
+            auto handshakeCompleteCb = [
+                this,
+                onComplete = std::move(onComplete),
+                timer = Timer()
+            ](const std::error_code& ec, size_t size) {
+                getSSLHandshakeStats().record(nativeSSLHandle(),
+                                              SSLManagerInterface::ConnectionDirection::kIncoming,
+                                              timer.elapsed(),
+                                              !ec);
 
-            auto handshakeCompleteCb = [ this, onComplete = std::move(onComplete) ](
-                const std::error_code& ec, size_t size) {
                 auto& sslPeerInfo = SSLPeerInfo::forSession(shared_from_this());
 
                 if (!ec && sslPeerInfo.subjectName.empty()) {
                     auto sslManager = getSSLManager();
-                    auto swPeerInfo = sslManager->parseAndValidatePeerCertificate(
-                        _sslSocket->native_handle(), "");
+                    auto swPeerInfo =
+                        sslManager->parseAndValidatePeerCertificate(nativeSSLHandle(), "");
 
                     if (swPeerInfo.isOK()) {
                         // The value of swPeerInfo is a bit complicated:
@@ -266,9 +404,30 @@ private:
                     }
                 }
 
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+                if (!ec && _kernelTLSSocket) {
+                    LOG(2) << "Connection " << id() << " from " << remote()
+                           << " uses kernel TLS to send: " << _kernelTLSSocket->kernelSend()
+                           << ", to receive: " << _kernelTLSSocket->kernelReceive();
+                }
+#endif
+
                 onComplete(ec ? errorCodeToStatus(ec) : Status::OK(), true);
             };
 
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+            if (_kernelTLSSocket) {
+                if (sync) {
+                    std::error_code ec;
+                    _kernelTLSSocket->handshake(ec);
+                    return handshakeCompleteCb(ec, 0);
+                }
+                return _kernelTLSSocket->async_handshake(
+                    [handshakeCompleteCb = std::move(handshakeCompleteCb)](
+                        const std::error_code& ec) { handshakeCompleteCb(ec, 0); });
+            }
+#endif
+
             if (sync) {
                 std::error_code ec;
                 _sslSocket->handshake(asio::ssl::stream_base::server, buffer, ec);
@@ -295,10 +454,15 @@ private:
     HostAndPort _local;
 
     GenericSocket _socket;
+    SharedBuffer _readAheadBuffer;
+    size_t _readAheadSize = 0;
 #ifdef MONGO_CONFIG_SSL
     boost::optional<asio::ssl::stream<decltype(_socket)>> _sslSocket;
     bool _ranHandshake = false;
 #endif
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+    boost::optional<KernelTLSStream<decltype(_socket)>> _kernelTLSSocket;
+#endif
 
     TransportLayerASIO* const _tl;
 };
@@ -30,11 +30,15 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/base/system_error.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/ticket_asio.h"
 #include "mongo/util/log.h"
+#include "mongo/util/net/message_buffer_pool.h"
 
 #include "mongo/transport/session_asio.h"
 
@@ -43,6 +47,23 @@ namespace transport {
 namespace {
 constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
 
+// If set, source tickets on plain sockets read into a buffer of this many bytes, so that a small
+// message usually arrives in one recv() rather than one for its header and another for its body.
+// Zero, the default, reads the header and the body separately.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(transportLayerASIOReadAheadBytes, int, 0);
+
+Status checkMessageLength(size_t msgLen) {
+    if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+        StringBuilder sb;
+        sb << "recv(): message msgLen " << msgLen << " is invalid. "
+           << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+        const auto str = sb.str();
+        LOG(0) << str;
+        return Status(ErrorCodes::ProtocolError, str);
+    }
+    return Status::OK();
+}
+
 }  // namespace
 
 
@@ -95,13 +116,9 @@ void TransportLayerASIO::ASIOSourceTicket::_headerCallback(const std::error_code
 
     MSGHEADER::View headerView(_buffer.get());
     auto msgLen = static_cast<size_t>(headerView.getMessageLength());
-    if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
-        StringBuilder sb;
-        sb << "recv(): message msgLen " << msgLen << " is invalid. "
-           << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
-        const auto str = sb.str();
-        LOG(0) << str;
-        finishFill(Status(ErrorCodes::ProtocolError, str));
+    auto status = checkMessageLength(msgLen);
+    if (!status.isOK()) {
+        finishFill(std::move(status));
         return;
     }
 
@@ -110,7 +127,7 @@ void TransportLayerASIO::ASIOSourceTicket::_headerCallback(const std::error_code
         return;
     }
 
-    _buffer.realloc(msgLen);
+    MessageBufferPool::reserve(&_buffer, msgLen, kHeaderSize);
     MsgData::View msgView(_buffer.get());
 
     session->read(isSync(),
@@ -118,13 +135,86 @@ void TransportLayerASIO::ASIOSourceTicket::_headerCallback(const std::error_code
                   [this](const std::error_code& ec, size_t size) { _bodyCallback(ec, size); });
 }
 
+void TransportLayerASIO::ASIOSourceTicket::_readAheadWaitCallback(const std::error_code& ec) {
+    if (ec) {
+        finishFill(errorCodeToStatus(ec));
+        return;
+    }
+
+    auto session = getSession();
+    if (!session)
+        return;
+
+    _readAhead(session);
+}
+
+void TransportLayerASIO::ASIOSourceTicket::_readAhead(
+    const std::shared_ptr<ASIOSession>& session) {
+    while (true) {
+        if (_bufferSize >= kHeaderSize) {
+            MSGHEADER::View headerView(_buffer.get());
+            const auto msgLen = static_cast<size_t>(headerView.getMessageLength());
+            auto status = checkMessageLength(msgLen);
+            if (!status.isOK()) {
+                finishFill(std::move(status));
+                return;
+            }
+
+            if (_bufferSize >= msgLen) {
+                if (_bufferSize > msgLen) {
+                    const size_t leftover = _bufferSize - msgLen;
+                    auto next = MessageBufferPool::allocate(std::max(
+                        leftover, static_cast<size_t>(transportLayerASIOReadAheadBytes)));
+                    memcpy(next.get(), _buffer.get() + msgLen, leftover);
+                    session->stashReadAhead(std::move(next), leftover);
+                }
+                _target->setData(std::move(_buffer));
+                networkCounter.hitPhysicalIn(msgLen);
+                finishFill(Status::OK());
+                return;
+            }
+
+            // Messages larger than the pool's largest buffers are read to their exact end, so
+            // nothing is left over.
+            if (msgLen > _bufferCapacity) {
+                MessageBufferPool::reserve(&_buffer, msgLen, _bufferSize);
+                _bufferCapacity = _buffer.capacity();
+            }
+        }
+
+        std::error_code ec;
+        const auto size = session->readSome(
+            asio::buffer(_buffer.get() + _bufferSize, _bufferCapacity - _bufferSize), ec);
+        if ((ec == asio::error::would_block || ec == asio::error::try_again) && !isSync()) {
+            session->asyncWaitForRead(
+                [this](const std::error_code& ec) { _readAheadWaitCallback(ec); });
+            return;
+        } else if (ec) {
+            finishFill(errorCodeToStatus(ec));
+            return;
+        }
+        _bufferSize += size;
+    }
+}
+
 void TransportLayerASIO::ASIOSourceTicket::fillImpl() {
     auto session = getSession();
     if (!session)
         return;
 
+    if (transportLayerASIOReadAheadBytes >= static_cast<int>(kHeaderSize) &&
+        session->canReadAhead()) {
+        _bufferSize = session->takeReadAhead(&_buffer);
+        if (!_buffer) {
+            _buffer = MessageBufferPool::allocate(transportLayerASIOReadAheadBytes);
+        }
+        _bufferCapacity = _buffer.capacity();
+        _readAhead(session);
+        return;
+    }
+
     const auto initBufSize = kHeaderSize;
-    _buffer = SharedBuffer::allocate(initBufSize);
+    _buffer = MessageBufferPool::allocate(initBufSize);
 
     session->read(isSync(),
                   asio::buffer(_buffer.get(), initBufSize),
@@ -133,6 +223,8 @@ void TransportLayerASIO::ASIOSourceTicket::fillImpl() {
 
 void TransportLayerASIO::ASIOSinkTicket::_sinkCallback(const std::error_code& ec, size_t size) {
     networkCounter.hitPhysicalOut(_msgToSend.size());
+    // Drop our reference so that the caller holds the only one and can reuse the buffer.
+    _msgToSend.reset();
     finishFill(ec ? errorCodeToStatus(ec) : Status::OK());
 }
 
@@ -83,7 +83,17 @@ private:
     void _headerCallback(const std::error_code& ec, size_t size);
     void _bodyCallback(const std::error_code& ec, size_t size);
 
+    /**
+     * Receives the message with as few reads as possible: each read takes everything the socket
+     * has, up to the buffer's capacity, and bytes beyond the end of the message are handed back
+     * to the session for the next ticket.
+     */
+    void _readAhead(const std::shared_ptr<ASIOSession>& session);
+    void _readAheadWaitCallback(const std::error_code& ec);
+
     SharedBuffer _buffer;
+    size_t _bufferSize = 0;
+    size_t _bufferCapacity = 0;
     Message* _target;
 };
 
@@ -44,6 +44,7 @@
 #include "mongo/base/checked_cast.h"
 #include "mongo/base/system_error.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/service_entry_point.h"
@@ -63,6 +64,14 @@
 namespace mongo {
 namespace transport {
 
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+namespace {
+// When the server requires TLS, let OpenSSL read and write incoming connections' sockets itself so
+// that it can hand record encryption to the kernel after the handshake.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(sslKernelTLSOffload, bool, true);
+}  // namespace
+#endif
+
 TransportLayerASIO::Options::Options(const ServerGlobalParams* params)
     : port(params->port),
       ipList(params->bind_ip),
@@ -222,6 +231,12 @@ Status TransportLayerASIO::setup() {
             .transitional_ignore();
     }
 #endif
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+    _kernelTLS = _sslMode == SSLParams::SSLMode_requireSSL && sslKernelTLSOffload;
+    if (_kernelTLS) {
+        log() << "Incoming TLS connections will use kernel TLS offload where it is supported";
+    }
+#endif
 
     return Status::OK();
 }
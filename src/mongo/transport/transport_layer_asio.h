@@ -156,6 +156,10 @@ private:
     std::unique_ptr<asio::ssl::context> _sslContext;
     SSLParams::SSLModes _sslMode;
 #endif
+#ifdef MONGO_CONFIG_HAVE_SSL_KTLS
+    // Whether incoming TLS connections let OpenSSL drive the socket so it can use kernel TLS.
+    bool _kernelTLS = false;
+#endif
 
     std::vector<GenericAcceptor> _acceptors;
 
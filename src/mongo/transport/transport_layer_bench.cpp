@@ -0,0 +1,286 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "asio.hpp"
+
+#include "mongo/base/initializer.h"
+#include "mongo/base/parse_number.h"
+#include "mongo/config.h"
+#include "mongo/db/server_options.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/service_entry_point.h"
+#include "mongo/transport/session.h"
+#include "mongo/transport/transport_layer_asio.h"
+#include "mongo/util/log.h"
+#include "mongo/util/net/message.h"
+#include "mongo/util/net/sock.h"
+#include "mongo/util/net/sockaddr.h"
+#include "mongo/util/timer.h"
+
+#ifdef MONGO_CONFIG_HAVE_LINUX_IO_URING
+#include "mongo/transport/transport_layer_io_uring.h"
+#endif
+
+/**
+ * Measures the echo throughput and latency of a transport layer with many connections open.
+ *
+ * Usage: transport_layer_bench <asio|ioUring> [active] [idle] [seconds] [messageBytes] [port]
+ *
+ * An in-process server echoes every message back through the chosen transport layer, using
+ * asynchronous waits as the adaptive service executor does. Each active connection gets a client
+ * thread that sends one message and waits for its echo, over and over; the idle connections are
+ * opened first and never used, so that the transport layer has to carry them along.
+ */
+
+namespace mongo {
+namespace {
+
+/**
+ * Echoes every message it receives on a session until the session fails.
+ */
+class Echo : public std::enable_shared_from_this<Echo> {
+public:
+    explicit Echo(transport::SessionHandle session) : _session(std::move(session)) {}
+
+    void source() {
+        auto tl = _session->getTransportLayer();
+        tl->asyncWait(_session->sourceMessage(&_message),
+                      [self = shared_from_this()](Status status) {
+                          if (status.isOK()) {
+                              self->_sink();
+                          }
+                      });
+    }
+
+private:
+    void _sink() {
+        auto tl = _session->getTransportLayer();
+        tl->asyncWait(_session->sinkMessage(_message), [self = shared_from_this()](Status status) {
+            self->_message.reset();
+            if (status.isOK()) {
+                self->source();
+            }
+        });
+    }
+
+    const transport::SessionHandle _session;
+    Message _message;
+};
+
+class EchoServiceEntryPoint final : public ServiceEntryPoint {
+public:
+    void startSession(transport::SessionHandle session) override {
+        _sessions.fetchAndAdd(1);
+        std::make_shared<Echo>(std::move(session))->source();
+    }
+
+    void endAllSessions(transport::Session::TagMask tags) override {}
+
+    bool shutdown(Milliseconds timeout) override {
+        return true;
+    }
+
+    Stats sessionStats() const override {
+        return {};
+    }
+
+    size_t numOpenSessions() const override {
+        return _sessions.load();
+    }
+
+    DbResponse handleRequest(OperationContext* opCtx, const Message& request) override {
+        MONGO_UNREACHABLE;
+    }
+
+private:
+    AtomicWord<size_t> _sessions{0};
+};
+
+/**
+ * Runs one active client connection until 'stop' is set, recording the round trip time of every
+ * message in microseconds.
+ */
+void runClient(int port,
+               int messageBytes,
+               const AtomicWord<bool>& stop,
+               std::vector<long long>* latencies) {
+    Socket socket;
+    SockAddr farEnd("127.0.0.1", port, AF_INET);
+    uassert(50906, "could not connect to the benchmark server", socket.connect(farEnd));
+
+    auto message = SharedBuffer::allocate(messageBytes);
+    std::fill(message.get(), message.get() + messageBytes, 'x');
+    MsgData::View view(message.get());
+    view.setLen(messageBytes);
+    view.setId(0);
+    view.setResponseToMsgId(0);
+    view.setOperation(dbMsg);
+
+    std::vector<char> reply(messageBytes);
+    Timer timer;
+    while (!stop.load()) {
+        const auto start = timer.micros();
+        socket.send(message.get(), messageBytes, "transport_layer_bench");
+        socket.recv(reply.data(), messageBytes);
+        latencies->push_back(timer.micros() - start);
+    }
+}
+
+long long percentile(const std::vector<long long>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const auto index = static_cast<size_t>(fraction * (sorted.size() - 1));
+    return sorted[index];
+}
+
+int parseArg(int argc, char** argv, int index, int defaultValue) {
+    if (argc <= index) {
+        return defaultValue;
+    }
+    int value;
+    uassertStatusOK(parseNumberFromString(argv[index], &value));
+    return value;
+}
+
+int benchMain(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0]
+                  << " <asio|ioUring> [active] [idle] [seconds] [messageBytes] [port]" << std::endl;
+        return 2;
+    }
+    const std::string transportLayerName = argv[1];
+    const int active = parseArg(argc, argv, 2, 64);
+    const int idle = parseArg(argc, argv, 3, 10000);
+    const int seconds = parseArg(argc, argv, 4, 10);
+    const int messageBytes = std::max(parseArg(argc, argv, 5, 512), 16);
+    const int port = parseArg(argc, argv, 6, 27990);
+
+    // Nothing parses the server's options here, so fill in the ones the listeners read.
+    serverGlobalParams.listenBacklog = SOMAXCONN;
+
+    EchoServiceEntryPoint sep;
+    std::unique_ptr<transport::TransportLayer> tl;
+    std::shared_ptr<asio::io_context> ioContext;
+    std::vector<stdx::thread> ioThreads;
+    if (transportLayerName == "asio") {
+        transport::TransportLayerASIO::Options opts(&serverGlobalParams);
+        opts.port = port;
+        opts.ipList = "127.0.0.1";
+        opts.transportMode = transport::Mode::kAsynchronous;
+        auto asioTL = stdx::make_unique<transport::TransportLayerASIO>(opts, &sep);
+        ioContext = asioTL->getIOContext();
+        tl = std::move(asioTL);
+#ifdef MONGO_CONFIG_HAVE_LINUX_IO_URING
+    } else if (transportLayerName == "ioUring") {
+        uassertStatusOK(transport::TransportLayerIOUring::checkSupported());
+        transport::TransportLayerIOUring::Options opts;
+        opts.port = port;
+        opts.ipList = "127.0.0.1";
+        tl = stdx::make_unique<transport::TransportLayerIOUring>(opts, &sep);
+#endif
+    } else {
+        std::cerr << "unknown transport layer " << transportLayerName << std::endl;
+        return 2;
+    }
+
+    uassertStatusOK(tl->setup());
+    uassertStatusOK(tl->start());
+
+    // ASIO completes its asynchronous waits on whichever threads run its io_context, which is
+    // the service executor's job in the server.
+    std::unique_ptr<asio::io_context::work> work;
+    if (ioContext) {
+        work = stdx::make_unique<asio::io_context::work>(*ioContext);
+        for (unsigned i = 0; i < std::max(stdx::thread::hardware_concurrency(), 2u); ++i) {
+            ioThreads.emplace_back([ioContext] { ioContext->run(); });
+        }
+    }
+
+    std::vector<std::unique_ptr<Socket>> idleSockets;
+    for (int i = 0; i < idle; ++i) {
+        auto socket = stdx::make_unique<Socket>();
+        SockAddr farEnd("127.0.0.1", port, AF_INET);
+        uassert(50907, "could not open an idle connection", socket->connect(farEnd));
+        idleSockets.push_back(std::move(socket));
+    }
+
+    AtomicWord<bool> stop{false};
+    std::vector<std::vector<long long>> latencies(active);
+    std::vector<stdx::thread> clients;
+    for (int i = 0; i < active; ++i) {
+        clients.emplace_back([&, i] { runClient(port, messageBytes, stop, &latencies[i]); });
+    }
+
+    sleepsecs(seconds);
+    stop.store(true);
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    std::vector<long long> all;
+    for (auto& clientLatencies : latencies) {
+        all.insert(all.end(), clientLatencies.begin(), clientLatencies.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    std::cout << transportLayerName << ": " << active << " active, " << idle << " idle, "
+              << messageBytes << " byte messages" << std::endl;
+    std::cout << "  throughput: " << all.size() / seconds << " round trips/s" << std::endl;
+    std::cout << "  latency p50: " << percentile(all, 0.5) << "us p99: " << percentile(all, 0.99)
+              << "us p99.9: " << percentile(all, 0.999) << "us" << std::endl;
+
+    idleSockets.clear();
+    tl->shutdown();
+    if (ioContext) {
+        ioContext->stop();
+        for (auto& thread : ioThreads) {
+            thread.join();
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+}  // namespace mongo
+
+int main(int argc, char** argv, char** envp) {
+    mongo::runGlobalInitializersOrDie(argc, argv, envp);
+    return mongo::benchMain(argc, argv);
+}
@@ -0,0 +1,1258 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/transport_layer_io_uring.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <linux/io_uring.h>
+#include <netinet/in.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/optional.hpp>
+
+#include "mongo/base/checked_cast.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/stats/counters.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/transport/service_entry_point.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/net/hostandport.h"
+#include "mongo/util/net/message_buffer_pool.h"
+#include "mongo/util/net/sock.h"
+#include "mongo/util/net/sockaddr.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
+// The number of provided buffers the kernel receives into, rounded up to a power of two, and the
+// size of each. They are shared by all connections and are recycled as soon as their contents
+// have been copied out, so they only need to cover the data in flight between two ring passes.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(transportLayerIOUringBufferCount, int, 1024);
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(transportLayerIOUringBufferSize, int, 16 * 1024);
+
+constexpr unsigned kRingEntries = 4096;
+constexpr unsigned kMaxBufferCount = 32768;
+constexpr uint16_t kBufferGroup = 0;
+
+// A connection stops receiving once this many complete messages wait on it, which only a client
+// that pipelines its requests gets to, and starts again when half of them have been sourced.
+constexpr size_t kMaxReadyMessages = 16;
+
+// The low bits of an operation's user_data say what it is and the rest whose it is: the id of a
+// connection, or the index of a listening socket for accepts.
+enum OpKind : uint64_t { kWake = 0, kAccept = 1, kReceive = 2, kSend = 3, kCancel = 4 };
+constexpr int kOpKindBits = 3;
+
+uint64_t makeUserData(uint64_t id, OpKind kind) {
+    return (id << kOpKindBits) | kind;
+}
+
+int ioUringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(
+        ::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int ioUringRegister(int fd, unsigned opcode, void* arg, unsigned nrArgs) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+}
+
+Status errnoToStatus(int err, StringData context) {
+    return {ErrorCodes::SocketException,
+            str::stream() << context << ": " << errnoWithDescription(err)};
+}
+
+Status unsupportedStatus(StringData reason) {
+    return {ErrorCodes::InvalidOptions,
+            str::stream() << "The io_uring transport layer is not supported: " << reason};
+}
+
+}  // namespace
+
+/**
+ * An io_uring instance with its submission and completion queues mapped, and a ring of buffers
+ * provided to it for receiving into.
+ */
+class TransportLayerIOUring::Ring {
+    MONGO_DISALLOW_COPYING(Ring);
+
+public:
+    static StatusWith<std::unique_ptr<Ring>> create(unsigned entries,
+                                                     unsigned bufferCount,
+                                                     size_t bufferSize) {
+        io_uring_params params{};
+        params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+        params.cq_entries = entries * 4;
+        const int fd = ioUringSetup(entries, &params);
+        if (fd < 0) {
+            return errnoToStatus(errno, "io_uring_setup");
+        }
+
+        std::unique_ptr<Ring> ring(new Ring(fd));
+        auto status = ring->_map(params);
+        if (!status.isOK()) {
+            return status;
+        }
+
+        status = ring->_provideBuffers(bufferCount, bufferSize);
+        if (!status.isOK()) {
+            return status;
+        }
+
+        return {std::move(ring)};
+    }
+
+    ~Ring() {
+        ::close(_fd);
+        if (_sqes) {
+            ::munmap(_sqes, _sqesSize);
+        }
+        if (_rings) {
+            ::munmap(_rings, _ringsSize);
+        }
+        if (_bufRing) {
+            ::munmap(_bufRing, _bufRingSize);
+        }
+        if (_buffers) {
+            ::munmap(_buffers, _buffersSize);
+        }
+    }
+
+    /**
+     * Returns a cleared submission queue entry, submitting the queue first if it is full.
+     */
+    io_uring_sqe* getSqe() {
+        if (_sqLocalTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries) {
+            _enter(0);
+            invariant(_sqLocalTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) < _sqEntries);
+        }
+
+        const auto index = _sqLocalTail & _sqMask;
+        auto sqe = &_sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        _sqArray[index] = index;
+        ++_sqLocalTail;
+        return sqe;
+    }
+
+    /**
+     * Submits every entry prepared since the last call and waits for at least one completion.
+     */
+    void submitAndWait() {
+        _enter(1);
+    }
+
+    /**
+     * Calls 'handler' with the user_data, result and flags of every available completion.
+     */
+    template <typename Handler>
+    void reap(Handler&& handler) {
+        auto head = *_cqHead;
+        const auto tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            const auto& cqe = _cqes[head & _cqMask];
+            handler(cqe.user_data, cqe.res, cqe.flags);
+        }
+        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    const char* buffer(uint16_t bid) const {
+        return _buffers + static_cast<size_t>(bid) * _bufferSize;
+    }
+
+    /**
+     * Hands a provided buffer back to the kernel once publishBuffers() is called.
+     */
+    void recycleBuffer(uint16_t bid) {
+        // The kernel's tail overlays the first entry, so the entries start at the ring itself. Do
+        // not go through io_uring_buf_ring::bufs, which C++ places after an empty struct.
+        auto& buf = reinterpret_cast<io_uring_buf*>(_bufRing)[_bufTail & (_bufferCount - 1)];
+        buf.addr = reinterpret_cast<uint64_t>(buffer(bid));
+        buf.len = _bufferSize;
+        buf.bid = bid;
+        ++_bufTail;
+    }
+
+    void publishBuffers() {
+        __atomic_store_n(&_bufRing->tail, _bufTail, __ATOMIC_RELEASE);
+    }
+
+private:
+    explicit Ring(int fd) : _fd(fd) {}
+
+    Status _map(const io_uring_params& params) {
+        if (!(params.features & IORING_FEAT_SINGLE_MMAP)) {
+            return unsupportedStatus("the kernel does not map both queues at once");
+        }
+
+        _ringsSize = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                              params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+        _rings = ::mmap(nullptr,
+                        _ringsSize,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE,
+                        _fd,
+                        IORING_OFF_SQ_RING);
+        if (_rings == MAP_FAILED) {
+            _rings = nullptr;
+            return errnoToStatus(errno, "mmap of the io_uring queues");
+        }
+
+        _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        auto sqes = ::mmap(nullptr,
+                           _sqesSize,
+                           PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE,
+                           _fd,
+                           IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return errnoToStatus(errno, "mmap of the io_uring submission entries");
+        }
+        _sqes = static_cast<io_uring_sqe*>(sqes);
+
+        auto base = static_cast<char*>(_rings);
+        _sqHead = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+        _sqTail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+        _sqMask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+        _sqArray = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+        _sqEntries = params.sq_entries;
+        _sqLocalTail = *_sqTail;
+
+        _cqHead = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+        _cqTail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+        _cqMask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+        _cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+        return Status::OK();
+    }
+
+    Status _provideBuffers(unsigned bufferCount, size_t bufferSize) {
+        _bufferCount = bufferCount;
+        _bufferSize = bufferSize;
+
+        _bufRingSize = bufferCount * sizeof(io_uring_buf);
+        auto bufRing = ::mmap(
+            nullptr, _bufRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (bufRing == MAP_FAILED) {
+            return errnoToStatus(errno, "mmap of the provided buffer ring");
+        }
+        _bufRing = static_cast<io_uring_buf_ring*>(bufRing);
+
+        _buffersSize = bufferCount * bufferSize;
+        auto buffers = ::mmap(
+            nullptr, _buffersSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buffers == MAP_FAILED) {
+            return errnoToStatus(errno, "mmap of the provided buffers");
+        }
+        _buffers = static_cast<char*>(buffers);
+
+        io_uring_buf_reg reg{};
+        reg.ring_addr = reinterpret_cast<uint64_t>(_bufRing);
+        reg.ring_entries = bufferCount;
+        reg.bgid = kBufferGroup;
+        if (ioUringRegister(_fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+            return errnoToStatus(errno, "registering the provided buffer ring");
+        }
+
+        for (unsigned bid = 0; bid < bufferCount; ++bid) {
+            recycleBuffer(bid);
+        }
+        publishBuffers();
+        return Status::OK();
+    }
+
+    void _enter(unsigned minComplete) {
+        __atomic_store_n(_sqTail, _sqLocalTail, __ATOMIC_RELEASE);
+        const auto toSubmit = _sqLocalTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+        const auto flags = minComplete ? IORING_ENTER_GETEVENTS : 0;
+        if (ioUringEnter(_fd, toSubmit, minComplete, flags) < 0) {
+            // EINTR and EAGAIN/EBUSY (completions backed up) just mean the caller should reap
+            // what is there and come back; anything else is a bug in how the ring is used.
+            const auto err = errno;
+            if (err != EINTR && err != EAGAIN && err != EBUSY) {
+                severe() << "io_uring_enter failed: " << errnoWithDescription(err);
+                fassertFailed(50900);
+            }
+        }
+    }
+
+    const int _fd;
+
+    void* _rings = nullptr;
+    size_t _ringsSize = 0;
+    io_uring_sqe* _sqes = nullptr;
+    size_t _sqesSize = 0;
+
+    unsigned* _sqHead = nullptr;
+    unsigned* _sqTail = nullptr;
+    unsigned* _sqArray = nullptr;
+    unsigned _sqMask = 0;
+    unsigned _sqEntries = 0;
+    unsigned _sqLocalTail = 0;
+
+    unsigned* _cqHead = nullptr;
+    unsigned* _cqTail = nullptr;
+    unsigned _cqMask = 0;
+    io_uring_cqe* _cqes = nullptr;
+
+    io_uring_buf_ring* _bufRing = nullptr;
+    size_t _bufRingSize = 0;
+    char* _buffers = nullptr;
+    size_t _buffersSize = 0;
+    unsigned _bufferCount = 0;
+    size_t _bufferSize = 0;
+    uint16_t _bufTail = 0;
+};
+
+/**
+ * The state of one accepted socket, shared by its session and the ring thread. The socket is
+ * closed once both are done with it.
+ */
+class TransportLayerIOUring::Connection {
+    MONGO_DISALLOW_COPYING(Connection);
+
+public:
+    Connection(uint64_t id, int fd) : id(id), fd(fd) {}
+
+    ~Connection() {
+        ::close(fd);
+    }
+
+    const uint64_t id;
+    const int fd;
+
+    stdx::mutex mutex;
+
+    // Guarded by mutex.
+    bool ended = false;                   // end() was called for the session
+    Status receiveStatus = Status::OK();  // why receiving stopped for good, once it has
+    bool receivePaused = false;           // too many complete messages are waiting in 'ready'
+    std::deque<SharedBuffer> ready;       // complete messages waiting to be sourced
+    Message* sourceTarget = nullptr;      // the message a waiting source ticket fills
+    TicketCallback sourceCallback;
+    Message sinkMessage;                  // a reply the ring thread finishes sending
+    size_t sinkOffset = 0;
+    TicketCallback sinkCallback;
+
+    // Guarded by TransportLayerIOUring::_mutex.
+    bool posted = false;
+
+    // Owned by the ring thread.
+    bool receiveArmed = false;
+    bool cancelArmed = false;
+    bool sendArmed = false;
+    unsigned opsInFlight = 0;
+    SharedBuffer partial;      // the message being received
+    size_t partialSize = 0;    // how much of it has been received
+    size_t partialLength = 0;  // its length, once its header has been received
+};
+
+class TransportLayerIOUring::IOUringSession : public Session {
+    MONGO_DISALLOW_COPYING(IOUringSession);
+
+public:
+    IOUringSession(TransportLayerIOUring* tl,
+                   ConnectionHandle conn,
+                   HostAndPort local,
+                   HostAndPort remote)
+        : _tl(tl), _conn(std::move(conn)), _local(std::move(local)), _remote(std::move(remote)) {}
+
+    ~IOUringSession() {
+        _tl->_endConnection(_conn.get());
+    }
+
+    TransportLayer* getTransportLayer() const override {
+        return _tl;
+    }
+
+    const HostAndPort& remote() const override {
+        return _remote;
+    }
+
+    const HostAndPort& local() const override {
+        return _local;
+    }
+
+    const ConnectionHandle& conn() const {
+        return _conn;
+    }
+
+private:
+    TransportLayerIOUring* const _tl;
+    const ConnectionHandle _conn;
+    const HostAndPort _local;
+    const HostAndPort _remote;
+};
+
+class TransportLayerIOUring::IOUringTicket : public TicketImpl {
+    MONGO_DISALLOW_COPYING(IOUringTicket);
+
+public:
+    IOUringTicket(const std::shared_ptr<IOUringSession>& session, Date_t expiration)
+        : _session(session), _sessionId(session->id()), _expiration(expiration) {}
+
+    SessionId sessionId() const override {
+        return _sessionId;
+    }
+
+    Date_t expiration() const override {
+        return _expiration;
+    }
+
+    /**
+     * Fills this ticket, calling 'callback' exactly once with the result, possibly before this
+     * returns.
+     */
+    void fill(TicketCallback callback) {
+        auto session = _session.lock();
+        if (!session) {
+            return callback(TransportLayer::TicketSessionClosedStatus);
+        }
+        if (_expiration != Ticket::kNoExpirationDate && _expiration < Date_t::now()) {
+            return callback(Ticket::ExpiredStatus);
+        }
+        fillImpl(session, std::move(callback));
+    }
+
+protected:
+    virtual void fillImpl(const std::shared_ptr<IOUringSession>& session,
+                          TicketCallback callback) = 0;
+
+private:
+    std::weak_ptr<IOUringSession> _session;
+    const SessionId _sessionId;
+    const Date_t _expiration;
+};
+
+class TransportLayerIOUring::IOUringSourceTicket : public IOUringTicket {
+public:
+    IOUringSourceTicket(const std::shared_ptr<IOUringSession>& session,
+                        Date_t expiration,
+                        Message* msg)
+        : IOUringTicket(session, expiration), _target(msg) {}
+
+protected:
+    void fillImpl(const std::shared_ptr<IOUringSession>& session,
+                  TicketCallback callback) override {
+        checked_cast<TransportLayerIOUring*>(session->getTransportLayer())
+            ->_source(session->conn(), _target, std::move(callback));
+    }
+
+private:
+    Message* const _target;
+};
+
+class TransportLayerIOUring::IOUringSinkTicket : public IOUringTicket {
+public:
+    IOUringSinkTicket(const std::shared_ptr<IOUringSession>& session,
+                      Date_t expiration,
+                      const Message& msg)
+        : IOUringTicket(session, expiration), _msgToSend(msg) {}
+
+protected:
+    void fillImpl(const std::shared_ptr<IOUringSession>& session,
+                  TicketCallback callback) override {
+        // Hand the reply over so that no reference to its buffer is left once the sink is done,
+        // and the caller can reuse it.
+        checked_cast<TransportLayerIOUring*>(session->getTransportLayer())
+            ->_sink(session->conn(), std::move(_msgToSend), std::move(callback));
+    }
+
+private:
+    Message _msgToSend;
+};
+
+TransportLayerIOUring::Options::Options(const ServerGlobalParams* params)
+    : port(params->port),
+      ipList(params->bind_ip),
+      useUnixSockets(!params->noUnixSocket),
+      enableIPv6(params->enableIPv6) {}
+
+Status TransportLayerIOUring::checkSupported() {
+    // Multishot receive cannot be probed for directly, but it arrived in the same release (Linux
+    // 6.0) as IORING_SETUP_SINGLE_ISSUER, which io_uring_setup() rejects if it does not know it.
+    io_uring_params params{};
+    params.flags = IORING_SETUP_SINGLE_ISSUER;
+    const int fd = ioUringSetup(4, &params);
+    if (fd < 0) {
+        const auto err = errno;
+        if (err == EINVAL) {
+            return unsupportedStatus("it needs Linux 6.0 or newer");
+        }
+        return unsupportedStatus(errnoWithDescription(err));
+    }
+    ON_BLOCK_EXIT([fd] { ::close(fd); });
+
+    const auto features = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL;
+    if ((params.features & features) != features) {
+        return unsupportedStatus("the kernel lacks required io_uring features");
+    }
+
+    constexpr unsigned kProbeOps = 256;
+    std::vector<char> probeStorage(sizeof(io_uring_probe) + kProbeOps * sizeof(io_uring_probe_op));
+    auto probe = reinterpret_cast<io_uring_probe*>(probeStorage.data());
+    if (ioUringRegister(fd, IORING_REGISTER_PROBE, probe, kProbeOps) < 0) {
+        return unsupportedStatus(errnoWithDescription(errno));
+    }
+    for (auto op : {IORING_OP_ACCEPT,
+                    IORING_OP_RECV,
+                    IORING_OP_SEND,
+                    IORING_OP_READ,
+                    IORING_OP_ASYNC_CANCEL}) {
+        if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+            return unsupportedStatus(str::stream() << "the kernel lacks io_uring operation "
+                                                   << static_cast<int>(op));
+        }
+    }
+
+    return Status::OK();
+}
+
+TransportLayerIOUring::TransportLayerIOUring(const Options& opts, ServiceEntryPoint* sep)
+    : _sep(sep), _listenerOptions(opts) {}
+
+TransportLayerIOUring::~TransportLayerIOUring() {
+    shutdown();
+    for (auto fd : _listenFds) {
+        ::close(fd);
+    }
+    if (_wakeFd >= 0) {
+        ::close(_wakeFd);
+    }
+}
+
+Ticket TransportLayerIOUring::sourceMessage(const SessionHandle& session,
+                                            Message* message,
+                                            Date_t expiration) {
+    auto ioUringSession = checked_pointer_cast<IOUringSession>(session);
+    return {this, stdx::make_unique<IOUringSourceTicket>(ioUringSession, expiration, message)};
+}
+
+Ticket TransportLayerIOUring::sinkMessage(const SessionHandle& session,
+                                          const Message& message,
+                                          Date_t expiration) {
+    auto ioUringSession = checked_pointer_cast<IOUringSession>(session);
+    return {this, stdx::make_unique<IOUringSinkTicket>(ioUringSession, expiration, message)};
+}
+
+Status TransportLayerIOUring::wait(Ticket&& ticket) {
+    auto ownedTicket = getOwnedTicketImpl(std::move(ticket));
+
+    stdx::mutex mutex;
+    stdx::condition_variable cv;
+    boost::optional<Status> result;
+    checked_cast<IOUringTicket*>(ownedTicket.get())->fill([&](Status status) {
+        stdx::lock_guard<stdx::mutex> lk(mutex);
+        result = std::move(status);
+        cv.notify_one();
+    });
+
+    stdx::unique_lock<stdx::mutex> lk(mutex);
+    cv.wait(lk, [&] { return static_cast<bool>(result); });
+    return *result;
+}
+
+void TransportLayerIOUring::asyncWait(Ticket&& ticket, TicketCallback callback) {
+    auto ownedTicket = std::shared_ptr<TicketImpl>(getOwnedTicketImpl(std::move(ticket)));
+    auto ioUringTicket = checked_cast<IOUringTicket*>(ownedTicket.get());
+
+    ioUringTicket->fill([ callback = std::move(callback),
+                          ownedTicket = std::move(ownedTicket) ](Status status) {
+        callback(std::move(status));
+    });
+}
+
+void TransportLayerIOUring::end(const SessionHandle& session) {
+    auto ioUringSession = checked_pointer_cast<IOUringSession>(session);
+    _endConnection(ioUringSession->conn().get());
+}
+
+Status TransportLayerIOUring::setup() {
+    std::vector<std::string> listenAddrs;
+    if (_listenerOptions.ipList.empty()) {
+        listenAddrs = {"127.0.0.1"};
+        if (_listenerOptions.enableIPv6) {
+            listenAddrs.emplace_back("::1");
+        }
+    } else {
+        boost::split(
+            listenAddrs, _listenerOptions.ipList, boost::is_any_of(","), boost::token_compress_on);
+    }
+
+    if (_listenerOptions.useUnixSockets) {
+        listenAddrs.emplace_back(makeUnixSockPath(_listenerOptions.port));
+    }
+
+    for (auto& ip : listenAddrs) {
+        if (ip.empty()) {
+            warning() << "Skipping empty bind address";
+            continue;
+        }
+
+        const auto addrs = SockAddr::createAll(
+            ip, _listenerOptions.port, _listenerOptions.enableIPv6 ? AF_UNSPEC : AF_INET);
+        if (addrs.empty()) {
+            warning() << "Found no addresses for " << ip;
+            continue;
+        }
+
+        for (const auto& addr : addrs) {
+            if (addr.getType() == AF_UNIX) {
+                if (::unlink(ip.c_str()) == -1 && errno != ENOENT) {
+                    error() << "Failed to unlink socket file " << ip << " "
+                            << errnoWithDescription(errno);
+                    fassertFailedNoTrace(50901);
+                }
+            }
+            if (addr.getType() == AF_INET6 && !_listenerOptions.enableIPv6) {
+                error() << "Specified ipv6 bind address, but ipv6 is disabled";
+                fassertFailedNoTrace(50902);
+            }
+
+            const int fd = ::socket(addr.getType(), SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd < 0) {
+                return errnoToStatus(errno, "socket");
+            }
+            _listenFds.push_back(fd);
+
+            const int on = 1;
+            if (::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) < 0) {
+                return errnoToStatus(errno, "setsockopt(SO_REUSEADDR)");
+            }
+            if (addr.getType() == AF_INET6 &&
+                ::setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &on, sizeof(on)) < 0) {
+                return errnoToStatus(errno, "setsockopt(IPV6_V6ONLY)");
+            }
+            if (::bind(fd, addr.raw(), addr.addressSize) < 0) {
+                return errnoToStatus(errno, str::stream() << "bind() to " << addr.toString());
+            }
+
+            if (addr.getType() == AF_UNIX) {
+                if (::chmod(ip.c_str(), serverGlobalParams.unixSocketPermissions) == -1) {
+                    error() << "Failed to chmod socket file " << ip << " "
+                            << errnoWithDescription(errno);
+                    fassertFailedNoTrace(50903);
+                }
+            }
+        }
+    }
+
+    if (_listenFds.empty()) {
+        return Status(ErrorCodes::SocketException, "No available addresses/ports to bind to");
+    }
+
+    unsigned bufferCount = 1;
+    while (bufferCount < kMaxBufferCount &&
+           bufferCount < static_cast<unsigned>(transportLayerIOUringBufferCount)) {
+        bufferCount *= 2;
+    }
+    const auto bufferSize = std::max(static_cast<size_t>(transportLayerIOUringBufferSize),
+                                     MessageBufferPool::kMinBufferSize);
+
+    auto swRing = Ring::create(kRingEntries, bufferCount, bufferSize);
+    if (!swRing.isOK()) {
+        return swRing.getStatus();
+    }
+    _ring = std::move(swRing.getValue());
+
+    _wakeFd = ::eventfd(0, EFD_CLOEXEC);
+    if (_wakeFd < 0) {
+        return errnoToStatus(errno, "eventfd");
+    }
+
+    return Status::OK();
+}
+
+Status TransportLayerIOUring::start() {
+    for (auto fd : _listenFds) {
+        if (::listen(fd, serverGlobalParams.listenBacklog) < 0) {
+            return errnoToStatus(errno, "listen");
+        }
+    }
+
+    _running.store(true);
+    _ringThread = stdx::thread([this] {
+        setThreadName("ioUring");
+        _ringLoop();
+    });
+
+    log() << "waiting for connections on port " << listenerPort() << " using io_uring";
+
+    return Status::OK();
+}
+
+void TransportLayerIOUring::shutdown() {
+    if (!_running.swap(false)) {
+        return;
+    }
+
+    const uint64_t one = 1;
+    if (::write(_wakeFd, &one, sizeof(one)) < 0) {
+        severe() << "Failed to wake the io_uring thread: " << errnoWithDescription(errno);
+        fassertFailed(50904);
+    }
+    _ringThread.join();
+}
+
+int TransportLayerIOUring::listenerPort() const {
+    for (auto fd : _listenFds) {
+        sockaddr_storage storage;
+        socklen_t len = sizeof(storage);
+        if (::getsockname(fd, reinterpret_cast<sockaddr*>(&storage), &len) == 0 &&
+            (storage.ss_family == AF_INET || storage.ss_family == AF_INET6)) {
+            return SockAddr(storage, len).getPort();
+        }
+    }
+    return _listenerOptions.port;
+}
+
+void TransportLayerIOUring::_source(const ConnectionHandle& conn,
+                                    Message* target,
+                                    TicketCallback callback) {
+    stdx::unique_lock<stdx::mutex> lk(conn->mutex);
+    if (conn->ended) {
+        lk.unlock();
+        return callback(TransportLayer::TicketSessionClosedStatus);
+    }
+
+    if (conn->ready.empty()) {
+        if (!conn->receiveStatus.isOK()) {
+            auto status = conn->receiveStatus;
+            lk.unlock();
+            return callback(std::move(status));
+        }
+
+        // The ring thread fills the ticket when the next message is complete.
+        invariant(!conn->sourceCallback);
+        conn->sourceTarget = target;
+        conn->sourceCallback = std::move(callback);
+        return;
+    }
+
+    auto buffer = std::move(conn->ready.front());
+    conn->ready.pop_front();
+    const bool resume = conn->receivePaused && conn->ready.size() <= kMaxReadyMessages / 2;
+    if (resume) {
+        conn->receivePaused = false;
+    }
+    lk.unlock();
+
+    if (resume) {
+        _post(conn);
+    }
+
+    target->setData(std::move(buffer));
+    networkCounter.hitPhysicalIn(target->size());
+    callback(Status::OK());
+}
+
+void TransportLayerIOUring::_sink(const ConnectionHandle& conn,
+                                  Message msg,
+                                  TicketCallback callback) {
+    {
+        stdx::lock_guard<stdx::mutex> lk(conn->mutex);
+        if (conn->ended) {
+            return callback(TransportLayer::TicketSessionClosedStatus);
+        }
+        invariant(!conn->sinkCallback);
+    }
+
+    // Send on this thread for as long as the socket takes the reply without blocking, which is
+    // usually all of it, rather than paying for a round trip through the ring thread.
+    const auto size = static_cast<size_t>(msg.size());
+    size_t sent = 0;
+    while (sent < size) {
+        const auto n = ::send(conn->fd, msg.buf() + sent, size - sent, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n >= 0) {
+            sent += n;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else if (errno != EINTR) {
+            auto status = errnoToStatus(errno, "send");
+            msg.reset();
+            return callback(std::move(status));
+        }
+    }
+
+    if (sent == size) {
+        networkCounter.hitPhysicalOut(size);
+        msg.reset();
+        return callback(Status::OK());
+    }
+
+    {
+        stdx::unique_lock<stdx::mutex> lk(conn->mutex);
+        if (conn->ended) {
+            lk.unlock();
+            msg.reset();
+            return callback(TransportLayer::TicketSessionClosedStatus);
+        }
+        conn->sinkMessage = std::move(msg);
+        conn->sinkOffset = sent;
+        conn->sinkCallback = std::move(callback);
+    }
+    _post(conn);
+}
+
+void TransportLayerIOUring::_endConnection(Connection* conn) {
+    TicketCallback sourceCallback;
+    {
+        stdx::lock_guard<stdx::mutex> lk(conn->mutex);
+        if (conn->ended) {
+            return;
+        }
+        conn->ended = true;
+        sourceCallback = std::move(conn->sourceCallback);
+        conn->sourceTarget = nullptr;
+    }
+
+    // This ends the receive and any send the ring thread has in flight for the socket, which it
+    // closes once nothing refers to it.
+    ::shutdown(conn->fd, SHUT_RDWR);
+
+    if (sourceCallback) {
+        sourceCallback(TransportLayer::TicketSessionClosedStatus);
+    }
+}
+
+void TransportLayerIOUring::_post(const ConnectionHandle& conn) {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    if (_ringStopped) {
+        lk.unlock();
+        return _failConnection(conn, TransportLayer::ShutdownStatus);
+    }
+    if (conn->posted) {
+        return;
+    }
+    conn->posted = true;
+    _posted.push_back(conn);
+
+    // The ring thread looks at _posted before it next waits, so it only needs a wakeup from
+    // other threads.
+    if (_wakePending || stdx::this_thread::get_id() == _ringThread.get_id()) {
+        return;
+    }
+    _wakePending = true;
+    lk.unlock();
+
+    const uint64_t one = 1;
+    if (::write(_wakeFd, &one, sizeof(one)) < 0) {
+        severe() << "Failed to wake the io_uring thread: " << errnoWithDescription(errno);
+        fassertFailed(50905);
+    }
+}
+
+void TransportLayerIOUring::_failConnection(const ConnectionHandle& conn, const Status& status) {
+    TicketCallback sourceCallback;
+    TicketCallback sinkCallback;
+    {
+        stdx::lock_guard<stdx::mutex> lk(conn->mutex);
+        if (conn->receiveStatus.isOK()) {
+            conn->receiveStatus = status;
+        }
+        if (conn->ready.empty()) {
+            sourceCallback = std::move(conn->sourceCallback);
+            conn->sourceTarget = nullptr;
+        }
+        sinkCallback = std::move(conn->sinkCallback);
+        conn->sinkMessage.reset();
+    }
+
+    if (sourceCallback) {
+        sourceCallback(status);
+    }
+    if (sinkCallback) {
+        sinkCallback(status);
+    }
+}
+
+void TransportLayerIOUring::_ringLoop() {
+    _armWake();
+    for (size_t listener = 0; listener < _listenFds.size(); ++listener) {
+        _armAccept(listener);
+    }
+
+    std::vector<ConnectionHandle> posted;
+    while (true) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            posted.swap(_posted);
+            _wakePending = false;
+            for (auto&& conn : posted) {
+                conn->posted = false;
+            }
+        }
+
+        if (!_running.load()) {
+            break;
+        }
+
+        for (auto&& conn : posted) {
+            _service(conn);
+        }
+        posted.clear();
+
+        _ring->submitAndWait();
+        _ring->reap([this](uint64_t userData, int res, uint32_t flags) {
+            _handleCompletion(userData, res, flags);
+        });
+        _ring->publishBuffers();
+    }
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _ringStopped = true;
+    }
+
+    // Nothing completes the operations still in flight anymore, so fail their tickets. The ring
+    // cancels the operations themselves when it is destroyed.
+    for (auto&& entry : _inFlight) {
+        posted.push_back(entry.second);
+    }
+    _inFlight.clear();
+    for (auto&& conn : posted) {
+        ::shutdown(conn->fd, SHUT_RDWR);
+        _failConnection(conn, TransportLayer::ShutdownStatus);
+    }
+}
+
+void TransportLayerIOUring::_service(const ConnectionHandle& conn) {
+    stdx::lock_guard<stdx::mutex> lk(conn->mutex);
+    if (conn->ended || !conn->receiveStatus.isOK()) {
+        // The socket has been shut down, which ends whatever is still in flight on it.
+        return;
+    }
+
+    if (!conn->receivePaused && !conn->receiveArmed) {
+        _armReceive(conn);
+    } else if (conn->receivePaused && conn->receiveArmed && !conn->cancelArmed) {
+        _armCancel(conn);
+    }
+
+    if (conn->sinkCallback && !conn->sendArmed) {
+        _armSend(conn);
+    }
+}
+
+void TransportLayerIOUring::_track(const ConnectionHandle& conn) {
+    if (conn->opsInFlight++ == 0) {
+        _inFlight.emplace(conn->id, conn);
+    }
+}
+
+void TransportLayerIOUring::_completeOp(const ConnectionHandle& conn) {
+    invariant(conn->opsInFlight > 0);
+    if (--conn->opsInFlight == 0) {
+        _inFlight.erase(conn->id);
+    }
+}
+
+void TransportLayerIOUring::_armReceive(const ConnectionHandle& conn) {
+    auto sqe = _ring->getSqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = conn->fd;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = kBufferGroup;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->user_data = makeUserData(conn->id, kReceive);
+    conn->receiveArmed = true;
+    _track(conn);
+}
+
+void TransportLayerIOUring::_armCancel(const ConnectionHandle& conn) {
+    auto sqe = _ring->getSqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = makeUserData(conn->id, kReceive);
+    sqe->user_data = makeUserData(conn->id, kCancel);
+    conn->cancelArmed = true;
+    _track(conn);
+}
+
+void TransportLayerIOUring::_armSend(const ConnectionHandle& conn) {
+    auto sqe = _ring->getSqe();
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = conn->fd;
+    sqe->addr = reinterpret_cast<uint64_t>(conn->sinkMessage.buf() + conn->sinkOffset);
+    sqe->len = conn->sinkMessage.size() - conn->sinkOffset;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = makeUserData(conn->id, kSend);
+    conn->sendArmed = true;
+    _track(conn);
+}
+
+void TransportLayerIOUring::_armAccept(size_t listener) {
+    auto sqe = _ring->getSqe();
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = _listenFds[listener];
+    sqe->accept_flags = SOCK_CLOEXEC;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->user_data = makeUserData(listener, kAccept);
+}
+
+void TransportLayerIOUring::_armWake() {
+    auto sqe = _ring->getSqe();
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = _wakeFd;
+    sqe->addr = reinterpret_cast<uint64_t>(&_wakeValue);
+    sqe->len = sizeof(_wakeValue);
+    sqe->user_data = makeUserData(0, kWake);
+}
+
+void TransportLayerIOUring::_handleCompletion(uint64_t userData, int res, uint32_t flags) {
+    const auto kind = static_cast<OpKind>(userData & ((1 << kOpKindBits) - 1));
+    const auto id = userData >> kOpKindBits;
+    if (kind == kWake) {
+        return _armWake();
+    } else if (kind == kAccept) {
+        return _handleAccept(id, res, flags);
+    }
+
+    auto it = _inFlight.find(id);
+    invariant(it != _inFlight.end());
+    auto conn = it->second;
+
+    if (kind == kReceive) {
+        _handleReceive(conn, res, flags);
+    } else if (kind == kSend) {
+        _handleSend(conn, res);
+    } else {
+        conn->cancelArmed = false;
+        _completeOp(conn);
+    }
+}
+
+void TransportLayerIOUring::_handleAccept(size_t listener, int res, uint32_t flags) {
+    if (!(flags & IORING_CQE_F_MORE)) {
+        _armAccept(listener);
+    }
+
+    if (res < 0) {
+        log() << "Error accepting new connection: " << errnoWithDescription(-res);
+        return;
+    }
+
+    const int fd = res;
+    sockaddr_storage localStorage;
+    socklen_t localLen = sizeof(localStorage);
+    sockaddr_storage remoteStorage;
+    socklen_t remoteLen = sizeof(remoteStorage);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&localStorage), &localLen) < 0) {
+        log() << "Error accepting new connection: " << errnoWithDescription(errno);
+        ::close(fd);
+        return;
+    }
+
+    HostAndPort remote;
+    if (::getpeername(fd, reinterpret_cast<sockaddr*>(&remoteStorage), &remoteLen) == 0) {
+        remote = HostAndPort(SockAddr(remoteStorage, remoteLen));
+    } else {
+        LOG(3) << "Unable to get remote endpoint address: " << errnoWithDescription(errno);
+    }
+
+    if (localStorage.ss_family == AF_INET || localStorage.ss_family == AF_INET6) {
+        disableNagle(fd);
+    }
+
+    auto conn = std::make_shared<Connection>(_nextConnectionId++, fd);
+    std::shared_ptr<IOUringSession> session(new IOUringSession(
+        this, conn, HostAndPort(SockAddr(localStorage, localLen)), std::move(remote)));
+
+    _armReceive(conn);
+    _sep->startSession(std::move(session));
+}
+
+void TransportLayerIOUring::_handleReceive(const ConnectionHandle& conn, int res, uint32_t flags) {
+    Status status = Status::OK();
+    if (res > 0) {
+        invariant(flags & IORING_CQE_F_BUFFER);
+        const auto bid = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+        status = _assemble(conn, _ring->buffer(bid), res);
+        _ring->recycleBuffer(bid);
+    } else if (res == 0) {
+        status = {ErrorCodes::SocketException, "connection closed by peer"};
+    } else if (res != -ENOBUFS && res != -ECANCELED) {
+        // ENOBUFS means every provided buffer was in use; they are all recycled by the end of
+        // this pass, so the receive is simply armed again.
+        status = errnoToStatus(-res, "recv");
+    }
+
+    if (!status.isOK()) {
+        // Shutting the socket down ends a multishot receive that is still armed.
+        ::shutdown(conn->fd, SHUT_RD);
+        _failConnection(conn, status);
+    }
+
+    if (flags & IORING_CQE_F_MORE) {
+        return;
+    }
+
+    conn->receiveArmed = false;
+    _service(conn);
+    _completeOp(conn);
+}
+
+Status TransportLayerIOUring::_assemble(const ConnectionHandle& conn,
+                                        const char* data,
+                                        size_t size) {
+    std::vector<SharedBuffer> complete;
+    while (size > 0) {
+        if (conn->partialSize < kHeaderSize) {
+            if (!conn->partial) {
+                conn->partial = MessageBufferPool::allocate(kHeaderSize);
+            }
+
+            const auto n = std::min(size, kHeaderSize - conn->partialSize);
+            std::memcpy(conn->partial.get() + conn->partialSize, data, n);
+            conn->partialSize += n;
+            data += n;
+            size -= n;
+            if (conn->partialSize < kHeaderSize) {
+                break;
+            }
+
+            const auto msgLen =
+                static_cast<size_t>(MSGHEADER::View(conn->partial.get()).getMessageLength());
+            if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+                StringBuilder sb;
+                sb << "recv(): message msgLen " << msgLen << " is invalid. "
+                   << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+                const auto str = sb.str();
+                LOG(0) << str;
+                return Status(ErrorCodes::ProtocolError, str);
+            }
+            MessageBufferPool::reserve(&conn->partial, msgLen, kHeaderSize);
+            conn->partialLength = msgLen;
+        }
+
+        const auto n = std::min(size, conn->partialLength - conn->partialSize);
+        std::memcpy(conn->partial.get() + conn->partialSize, data, n);
+        conn->partialSize += n;
+        data += n;
+        size -= n;
+        if (conn->partialSize == conn->partialLength) {
+            complete.push_back(std::move(conn->partial));
+            conn->partial = SharedBuffer();
+            conn->partialSize = 0;
+        }
+    }
+
+    if (complete.empty()) {
+        return Status::OK();
+    }
+
+    Message* target = nullptr;
+    TicketCallback callback;
+    SharedBuffer delivered;
+    bool pause = false;
+    {
+        stdx::lock_guard<stdx::mutex> lk(conn->mutex);
+        for (auto&& buffer : complete) {
+            conn->ready.push_back(std::move(buffer));
+        }
+
+        if (conn->sourceCallback) {
+            target = conn->sourceTarget;
+            callback = std::move(conn->sourceCallback);
+            conn->sourceTarget = nullptr;
+            delivered = std::move(conn->ready.front());
+            conn->ready.pop_front();
+        }
+
+        if (conn->ready.size() >= kMaxReadyMessages && !conn->receivePaused) {
+            conn->receivePaused = true;
+            pause = true;
+        }
+    }
+
+    if (pause) {
+        _service(conn);
+    }
+
+    if (callback) {
+        target->setData(std::move(delivered));
+        networkCounter.hitPhysicalIn(target->size());
+        callback(Status::OK());
+    }
+    return Status::OK();
+}
+
+void TransportLayerIOUring::_handleSend(const ConnectionHandle& conn, int res) {
+    conn->sendArmed = false;
+
+    Status status = Status::OK();
+    TicketCallback callback;
+    {
+        stdx::lock_guard<stdx::mutex> lk(conn->mutex);
+        if (!conn->sinkCallback) {
+            // The connection failed while the send was in flight.
+            return _completeOp(conn);
+        }
+
+        if (res < 0) {
+            status = errnoToStatus(-res, "send");
+        } else {
+            conn->sinkOffset += res;
+            if (conn->sinkOffset < static_cast<size_t>(conn->sinkMessage.size())) {
+                _armSend(conn);
+                return _completeOp(conn);
+            }
+            networkCounter.hitPhysicalOut(conn->sinkMessage.size());
+        }
+
+        callback = std::move(conn->sinkCallback);
+        conn->sinkMessage.reset();
+    }
+
+    _completeOp(conn);
+    callback(std::move(status));
+}
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,173 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/server_options.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/transport/ticket_impl.h"
+#include "mongo/transport/transport_layer.h"
+
+namespace mongo {
+
+class ServiceEntryPoint;
+
+namespace transport {
+
+/**
+ * A TransportLayer implementation based on Linux io_uring, which it drives through the raw
+ * io_uring syscalls.
+ *
+ * One ring thread accepts connections and keeps a multishot receive armed on every socket. The
+ * kernel receives into a ring of provided buffers shared by all connections, so an idle connection
+ * holds no receive buffer; the ring thread copies each completion into the message it belongs to
+ * and hands complete messages to source tickets. Replies are sent by the thread that sinks them for
+ * as long as the socket accepts them without blocking, and only what is left is sent by the ring.
+ * Everything the ring thread prepares in one pass is submitted with the same io_uring_enter() call
+ * that waits for the next completions.
+ *
+ * Tickets may be waited on synchronously or asynchronously. asyncWait() callbacks run on the ring
+ * thread, or on the calling thread when the ticket can be filled at once.
+ */
+class TransportLayerIOUring final : public TransportLayer {
+    MONGO_DISALLOW_COPYING(TransportLayerIOUring);
+
+public:
+    struct Options {
+        explicit Options(const ServerGlobalParams* params);
+        Options() = default;
+
+        int port = ServerGlobalParams::DefaultDBPort;  // port to bind to
+        std::string ipList;                            // addresses to bind to
+        bool useUnixSockets = true;                    // whether to allow UNIX sockets in ipList
+        bool enableIPv6 = false;                       // whether to allow IPv6 sockets in ipList
+    };
+
+    /**
+     * Returns OK if the running kernel supports every io_uring feature this TransportLayer needs,
+     * and otherwise the reason it does not.
+     */
+    static Status checkSupported();
+
+    TransportLayerIOUring(const Options& opts, ServiceEntryPoint* sep);
+
+    ~TransportLayerIOUring();
+
+    Ticket sourceMessage(const SessionHandle& session,
+                         Message* message,
+                         Date_t expiration = Ticket::kNoExpirationDate) final;
+
+    Ticket sinkMessage(const SessionHandle& session,
+                       const Message& message,
+                       Date_t expiration = Ticket::kNoExpirationDate) final;
+
+    Status wait(Ticket&& ticket) final;
+
+    void asyncWait(Ticket&& ticket, TicketCallback callback) final;
+
+    void end(const SessionHandle& session) final;
+
+    Status setup() final;
+    Status start() final;
+
+    void shutdown() final;
+
+    /**
+     * Returns the port the first listening socket is bound to, which the kernel picks when
+     * Options::port is 0.
+     */
+    int listenerPort() const;
+
+private:
+    class Ring;
+    class Connection;
+    class IOUringSession;
+    class IOUringTicket;
+    class IOUringSourceTicket;
+    class IOUringSinkTicket;
+
+    using ConnectionHandle = std::shared_ptr<Connection>;
+
+    void _source(const ConnectionHandle& conn, Message* target, TicketCallback callback);
+    void _sink(const ConnectionHandle& conn, Message msg, TicketCallback callback);
+    void _endConnection(Connection* conn);
+
+    // Fails the tickets waiting on 'conn', and its future source tickets once the messages it has
+    // already received are sourced.
+    void _failConnection(const ConnectionHandle& conn, const Status& status);
+
+    // Asks the ring thread to look at 'conn' on its next pass.
+    void _post(const ConnectionHandle& conn);
+
+    void _ringLoop();
+
+    // The rest are called on the ring thread only.
+    void _service(const ConnectionHandle& conn);
+    void _armReceive(const ConnectionHandle& conn);
+    void _armCancel(const ConnectionHandle& conn);
+    void _armSend(const ConnectionHandle& conn);
+    void _armAccept(size_t listener);
+    void _armWake();
+    void _track(const ConnectionHandle& conn);
+    void _completeOp(const ConnectionHandle& conn);
+    void _handleCompletion(uint64_t userData, int res, uint32_t flags);
+    void _handleAccept(size_t listener, int res, uint32_t flags);
+    void _handleReceive(const ConnectionHandle& conn, int res, uint32_t flags);
+    void _handleSend(const ConnectionHandle& conn, int res);
+    Status _assemble(const ConnectionHandle& conn, const char* data, size_t size);
+
+    ServiceEntryPoint* const _sep;
+    Options _listenerOptions;
+
+    std::unique_ptr<Ring> _ring;
+    std::vector<int> _listenFds;
+    int _wakeFd = -1;
+    uint64_t _wakeValue = 0;
+
+    stdx::thread _ringThread;
+    AtomicWord<bool> _running{false};
+
+    stdx::mutex _mutex;
+    std::vector<ConnectionHandle> _posted;  // Guarded by _mutex.
+    bool _wakePending = false;              // Guarded by _mutex.
+    bool _ringStopped = false;              // Guarded by _mutex.
+
+    // Owned by the ring thread: each connection with an operation in flight, by its id.
+    stdx::unordered_map<uint64_t, ConnectionHandle> _inFlight;
+    uint64_t _nextConnectionId = 1;
+};
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,289 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/service_entry_point.h"
+#include "mongo/transport/transport_layer_io_uring.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/log.h"
+#include "mongo/util/net/sock.h"
+#include "mongo/util/net/sockaddr.h"
+#include "mongo/util/net/socket_exception.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Echoes every message back on the session it arrived on, either from a thread per session as
+ * the synchronous service executor does, or through a chain of asyncWait() callbacks.
+ */
+class EchoServiceEntryPoint : public ServiceEntryPoint {
+public:
+    explicit EchoServiceEntryPoint(bool async) : _async(async) {}
+
+    ~EchoServiceEntryPoint() {
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    void startSession(transport::SessionHandle session) override {
+        _started.fetchAndAdd(1);
+        if (_async) {
+            _sourceAsync(std::move(session), std::make_shared<Message>());
+            return;
+        }
+
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _threads.emplace_back([this, session]() mutable {
+            auto tl = session->getTransportLayer();
+            while (true) {
+                Message message;
+                if (!tl->wait(session->sourceMessage(&message)).isOK() ||
+                    !tl->wait(session->sinkMessage(message)).isOK()) {
+                    break;
+                }
+            }
+            session.reset();
+            _sessionEnded();
+        });
+    }
+
+    void endAllSessions(transport::Session::TagMask tags) override {}
+
+    bool shutdown(Milliseconds timeout) override {
+        return true;
+    }
+
+    Stats sessionStats() const override {
+        return {};
+    }
+
+    size_t numOpenSessions() const override {
+        return _started.load() - _ended.load();
+    }
+
+    DbResponse handleRequest(OperationContext* opCtx, const Message& request) override {
+        MONGO_UNREACHABLE;
+    }
+
+    void waitForSessionsToEnd(size_t count) {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _cond.wait(lk, [&] { return _ended.load() >= count; });
+    }
+
+private:
+    void _sourceAsync(transport::SessionHandle session, std::shared_ptr<Message> message) {
+        auto tl = session->getTransportLayer();
+        tl->asyncWait(session->sourceMessage(message.get()), [=](Status status) {
+            if (!status.isOK()) {
+                _sessionEnded();
+                return;
+            }
+            tl->asyncWait(session->sinkMessage(*message), [=](Status status) {
+                message->reset();
+                if (!status.isOK()) {
+                    _sessionEnded();
+                    return;
+                }
+                _sourceAsync(session, message);
+            });
+        });
+    }
+
+    void _sessionEnded() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _ended.fetchAndAdd(1);
+        _cond.notify_all();
+    }
+
+    const bool _async;
+    AtomicWord<size_t> _started{0};
+    AtomicWord<size_t> _ended{0};
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _cond;
+    std::vector<stdx::thread> _threads;
+};
+
+std::vector<char> makeMessage(int32_t length, int32_t id) {
+    std::vector<char> message(length);
+    for (int32_t i = 0; i < length; ++i) {
+        message[i] = static_cast<char>(id + i);
+    }
+    MsgData::View view(message.data());
+    view.setLen(length);
+    view.setId(id);
+    view.setResponseToMsgId(0);
+    view.setOperation(dbMsg);
+    return message;
+}
+
+class TransportLayerIOUringTest : public unittest::Test {
+protected:
+    void setUp() override {
+        auto status = transport::TransportLayerIOUring::checkSupported();
+        if (!status.isOK()) {
+            log() << "Skipping io_uring transport layer test: " << status;
+            return;
+        }
+        _supported = true;
+    }
+
+    bool supported() const {
+        return _supported;
+    }
+
+    std::unique_ptr<transport::TransportLayerIOUring> startTransportLayer(
+        ServiceEntryPoint* sep) {
+        transport::TransportLayerIOUring::Options opts;
+        opts.port = 0;
+        opts.ipList = "127.0.0.1";
+        opts.useUnixSockets = false;
+        auto tl = stdx::make_unique<transport::TransportLayerIOUring>(opts, sep);
+        ASSERT_OK(tl->setup());
+        ASSERT_OK(tl->start());
+        return tl;
+    }
+
+    std::unique_ptr<Socket> connect(const transport::TransportLayerIOUring& tl) {
+        auto socket = stdx::make_unique<Socket>();
+        SockAddr farEnd("127.0.0.1", tl.listenerPort(), AF_INET);
+        ASSERT(socket->connect(farEnd));
+        return socket;
+    }
+
+    /**
+     * Sends messages of many sizes, including one larger than a provided buffer, in fragments
+     * that split their headers and bodies, and checks that they come back intact and in order.
+     */
+    void runPipelinedEcho(bool async) {
+        EchoServiceEntryPoint sep(async);
+        auto tl = startTransportLayer(&sep);
+        auto socket = connect(*tl);
+
+        std::vector<char> stream;
+        for (int32_t i = 0; i < 40; ++i) {
+            auto message = makeMessage(16 + (i * 37) % 300, i);
+            stream.insert(stream.end(), message.begin(), message.end());
+        }
+        auto large = makeMessage(5 * 1024 * 1024, 40);
+        stream.insert(stream.end(), large.begin(), large.end());
+
+        stdx::thread writer([&] {
+            size_t offset = 0;
+            size_t fragment = 1;
+            while (offset < stream.size()) {
+                const auto size = std::min(fragment, stream.size() - offset);
+                socket->send(stream.data() + offset, size, "pipelined echo");
+                offset += size;
+                fragment = fragment * 3 % 70001 + 1;
+            }
+        });
+
+        std::vector<char> echoed(stream.size());
+        socket->recv(echoed.data(), echoed.size());
+        writer.join();
+        ASSERT(echoed == stream);
+
+        socket.reset();
+        sep.waitForSessionsToEnd(1);
+        tl->shutdown();
+    }
+
+private:
+    bool _supported = false;
+};
+
+TEST_F(TransportLayerIOUringTest, PipelinedEchoSync) {
+    if (supported()) {
+        runPipelinedEcho(false);
+    }
+}
+
+TEST_F(TransportLayerIOUringTest, PipelinedEchoAsync) {
+    if (supported()) {
+        runPipelinedEcho(true);
+    }
+}
+
+TEST_F(TransportLayerIOUringTest, InvalidMessageLengthEndsSession) {
+    if (!supported()) {
+        return;
+    }
+
+    EchoServiceEntryPoint sep(false);
+    auto tl = startTransportLayer(&sep);
+    auto socket = connect(*tl);
+
+    auto message = makeMessage(16, 1);
+    MsgData::View(message.data()).setLen(3);
+    socket->send(message.data(), message.size(), "invalid message");
+
+    char c;
+    ASSERT_THROWS(socket->recv(&c, 1), SocketException);
+    sep.waitForSessionsToEnd(1);
+    tl->shutdown();
+}
+
+TEST_F(TransportLayerIOUringTest, ShutdownEndsIdleSessions) {
+    if (!supported()) {
+        return;
+    }
+
+    EchoServiceEntryPoint sep(true);
+    auto tl = startTransportLayer(&sep);
+    std::vector<std::unique_ptr<Socket>> sockets;
+    for (int i = 0; i < 8; ++i) {
+        sockets.push_back(connect(*tl));
+    }
+
+    // Make sure every connection has been accepted before shutting down.
+    for (auto& socket : sockets) {
+        auto message = makeMessage(32, 2);
+        std::vector<char> echoed(message.size());
+        socket->send(message.data(), message.size(), "idle session");
+        socket->recv(echoed.data(), echoed.size());
+    }
+
+    tl->shutdown();
+    sep.waitForSessionsToEnd(sockets.size());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -26,27 +26,67 @@
  *    it in the license file.
  */
 
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
 #include "mongo/platform/basic.h"
 
 #include "mongo/transport/transport_layer_manager.h"
 
+#include "asio.hpp"
+
 #include "mongo/base/status.h"
+#include "mongo/config.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/service_executor_adaptive.h"
 #include "mongo/transport/service_executor_synchronous.h"
+#include "mongo/transport/service_executor_work_stealing.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer_asio.h"
 #include "mongo/transport/transport_layer_legacy.h"
+#include "mongo/util/log.h"
+#include "mongo/util/net/ssl_options.h"
 #include "mongo/util/net/ssl_types.h"
 #include "mongo/util/time_support.h"
 #include <limits>
 
 #include <iostream>
 
+#ifdef MONGO_CONFIG_HAVE_LINUX_IO_URING
+#include "mongo/transport/transport_layer_io_uring.h"
+#endif
+
 namespace mongo {
 namespace transport {
+namespace {
+
+/**
+ * Returns whether the io_uring transport layer can serve this process, logging why not if it
+ * cannot so that the caller can fall back to ASIO.
+ */
+bool canUseIOUring() {
+#ifdef MONGO_CONFIG_SSL
+    if (sslGlobalParams.sslMode.load() != SSLParams::SSLMode_disabled) {
+        warning() << "The io_uring transport layer does not support SSL, using asio instead";
+        return false;
+    }
+#endif
+
+#ifdef MONGO_CONFIG_HAVE_LINUX_IO_URING
+    auto status = TransportLayerIOUring::checkSupported();
+    if (!status.isOK()) {
+        warning() << status.reason() << ", using asio instead";
+        return false;
+    }
+    return true;
+#else
+    warning() << "This build does not include the io_uring transport layer, using asio instead";
+    return false;
+#endif
+}
+
+}  // namespace
 
 TransportLayerManager::TransportLayerManager() = default;
 
@@ -128,9 +168,14 @@ std::unique_ptr<TransportLayer> TransportLayerManager::createWithConfig(
     const ServerGlobalParams* config, ServiceContext* ctx) {
     std::unique_ptr<TransportLayer> transportLayer;
     auto sep = ctx->getServiceEntryPoint();
-    if (config->transportLayer == "asio") {
+    auto transportLayerName = config->transportLayer;
+    if (transportLayerName == "ioUring" && !canUseIOUring()) {
+        transportLayerName = "asio";
+    }
+
+    if (transportLayerName == "asio") {
         transport::TransportLayerASIO::Options opts(config);
-        if (config->serviceExecutor == "adaptive") {
+        if (config->serviceExecutor == "adaptive" || config->serviceExecutor == "workStealing") {
             opts.transportMode = transport::Mode::kAsynchronous;
         } else if (config->serviceExecutor == "synchronous") {
             opts.transportMode = transport::Mode::kSynchronous;
@@ -143,11 +188,33 @@ std::unique_ptr<TransportLayer> TransportLayerManager::createWithConfig(
         if (config->serviceExecutor == "adaptive") {
             ctx->setServiceExecutor(stdx::make_unique<ServiceExecutorAdaptive>(
                 ctx, transportLayerASIO->getIOContext()));
+        } else if (config->serviceExecutor == "workStealing") {
+            ctx->setServiceExecutor(stdx::make_unique<ServiceExecutorWorkStealing>(
+                ctx, transportLayerASIO->getIOContext()));
         } else if (config->serviceExecutor == "synchronous") {
             ctx->setServiceExecutor(stdx::make_unique<ServiceExecutorSynchronous>(ctx));
         }
         transportLayer = std::move(transportLayerASIO);
-    } else if (serverGlobalParams.transportLayer == "legacy") {
+#ifdef MONGO_CONFIG_HAVE_LINUX_IO_URING
+    } else if (transportLayerName == "ioUring") {
+        transportLayer = stdx::make_unique<TransportLayerIOUring>(
+            TransportLayerIOUring::Options(config), sep);
+
+        // The ring thread does all of the network I/O, so the executors only need an io_context
+        // to schedule work on.
+        if (config->serviceExecutor == "adaptive") {
+            ctx->setServiceExecutor(stdx::make_unique<ServiceExecutorAdaptive>(
+                ctx, std::make_shared<asio::io_context>()));
+        } else if (config->serviceExecutor == "workStealing") {
+            ctx->setServiceExecutor(stdx::make_unique<ServiceExecutorWorkStealing>(
+                ctx, std::make_shared<asio::io_context>()));
+        } else if (config->serviceExecutor == "synchronous") {
+            ctx->setServiceExecutor(stdx::make_unique<ServiceExecutorSynchronous>(ctx));
+        } else {
+            MONGO_UNREACHABLE;
+        }
+#endif
+    } else if (transportLayerName == "legacy") {
         transport::TransportLayerLegacy::Options opts(config);
         transportLayer = stdx::make_unique<transport::TransportLayerLegacy>(opts, sep);
         ctx->setServiceExecutor(stdx::make_unique<ServiceExecutorSynchronous>(ctx));
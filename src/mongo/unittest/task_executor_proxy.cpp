@@ -101,6 +101,11 @@ StatusWith<executor::TaskExecutor::CallbackHandle> TaskExecutorProxy::scheduleRe
     return _executor->scheduleRemoteCommand(request, cb);
 }
 
+StatusWith<executor::TaskExecutor::CallbackHandle> TaskExecutorProxy::scheduleRemoteCommandInline(
+    const executor::RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb) {
+    return _executor->scheduleRemoteCommandInline(request, cb);
+}
+
 void TaskExecutorProxy::cancel(const CallbackHandle& cbHandle) {
     _executor->cancel(cbHandle);
 }
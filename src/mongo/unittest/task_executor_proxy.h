@@ -65,6 +65,8 @@ public:
     virtual StatusWith<CallbackHandle> scheduleWorkAt(Date_t when, const CallbackFn& work) override;
     virtual StatusWith<CallbackHandle> scheduleRemoteCommand(
         const executor::RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb) override;
+    virtual StatusWith<CallbackHandle> scheduleRemoteCommandInline(
+        const executor::RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb) override;
     virtual void cancel(const CallbackHandle& cbHandle) override;
     virtual void wait(const CallbackHandle& cbHandle) override;
     virtual void appendConnectionStats(executor::ConnectionPoolStats* stats) const override;
@@ -462,6 +462,13 @@ public:
         return _buf;
     }
 
+    /**
+     * Gives up this message's reference to its buffer, leaving the message empty.
+     */
+    SharedBuffer releaseBuffer() {
+        return std::move(_buf);
+    }
+
     ConstSharedBuffer sharedBuffer() const {
         return _buf;
     }
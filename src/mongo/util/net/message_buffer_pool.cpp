@@ -0,0 +1,126 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/net/message_buffer_pool.h"
+
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include "mongo/base/static_assert.h"
+
+namespace mongo {
+namespace {
+
+constexpr size_t kNumSizeClasses = 8;
+MONGO_STATIC_ASSERT(MessageBufferPool::kMinBufferSize << (kNumSizeClasses - 1) ==
+                    MessageBufferPool::kMaxBufferSize);
+
+struct SizeClass {
+    std::array<SharedBuffer, MessageBufferPool::kBuffersPerSizeClass> buffers;
+    size_t count = 0;
+};
+
+thread_local std::array<SizeClass, kNumSizeClasses> threadPool;
+thread_local size_t threadPoolBytes = 0;
+
+size_t sizeOfClass(size_t sizeClass) {
+    return MessageBufferPool::kMinBufferSize << sizeClass;
+}
+
+}  // namespace
+
+constexpr size_t MessageBufferPool::kMinBufferSize;
+constexpr size_t MessageBufferPool::kMaxBufferSize;
+constexpr size_t MessageBufferPool::kBuffersPerSizeClass;
+constexpr size_t MessageBufferPool::kMaxCachedBytesPerThread;
+
+SharedBuffer MessageBufferPool::allocate(size_t minSize) {
+    if (minSize > kMaxBufferSize) {
+        return SharedBuffer::allocate(minSize);
+    }
+
+    size_t firstClass = 0;
+    while (sizeOfClass(firstClass) < minSize) {
+        ++firstClass;
+    }
+
+    for (size_t sizeClass = firstClass; sizeClass < kNumSizeClasses; ++sizeClass) {
+        auto& cached = threadPool[sizeClass];
+        if (cached.count > 0) {
+            threadPoolBytes -= sizeOfClass(sizeClass);
+            return std::move(cached.buffers[--cached.count]);
+        }
+    }
+
+    return SharedBuffer::allocate(sizeOfClass(firstClass));
+}
+
+void MessageBufferPool::release(SharedBuffer buffer) {
+    if (!buffer || buffer.isShared()) {
+        return;
+    }
+
+    const auto capacity = buffer.capacity();
+    for (size_t sizeClass = 0; sizeClass < kNumSizeClasses; ++sizeClass) {
+        if (sizeOfClass(sizeClass) != capacity) {
+            continue;
+        }
+
+        auto& cached = threadPool[sizeClass];
+        if (cached.count < kBuffersPerSizeClass &&
+            threadPoolBytes + capacity <= kMaxCachedBytesPerThread) {
+            cached.buffers[cached.count++] = std::move(buffer);
+            threadPoolBytes += capacity;
+        }
+        return;
+    }
+}
+
+void MessageBufferPool::reserve(SharedBuffer* buffer, size_t minSize, size_t bytesInUse) {
+    if (buffer->capacity() >= minSize) {
+        return;
+    }
+
+    auto larger = allocate(minSize);
+    std::memcpy(larger.get(), buffer->get(), bytesInUse);
+    release(std::exchange(*buffer, std::move(larger)));
+}
+
+void MessageBufferPool::clear() {
+    for (auto& cached : threadPool) {
+        while (cached.count > 0) {
+            cached.buffers[--cached.count] = {};
+        }
+    }
+    threadPoolBytes = 0;
+}
+
+}  // namespace mongo
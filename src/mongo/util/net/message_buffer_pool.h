@@ -0,0 +1,81 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "mongo/util/shared_buffer.h"
+
+namespace mongo {
+
+/**
+ * A per-thread cache of the buffers that received messages and replies are built in.
+ *
+ * Buffers come in power-of-two size classes from kMinBufferSize to kMaxBufferSize, which are the
+ * sizes BufBuilder grows through, and each thread keeps up to kBuffersPerSizeClass of each, but no
+ * more than kMaxCachedBytesPerThread in all. A thread serving a session therefore usually gets
+ * back the buffers its previous request on that session was received and answered in, already
+ * grown to the right size. Buffers of other sizes, and buffers still referenced elsewhere, are
+ * simply freed. A thread's cache is freed when it calls markThreadIdle() and when it exits.
+ */
+class MessageBufferPool {
+public:
+    static constexpr size_t kMinBufferSize = 512;
+    static constexpr size_t kMaxBufferSize = 64 * 1024;
+    static constexpr size_t kBuffersPerSizeClass = 2;
+    static constexpr size_t kMaxCachedBytesPerThread = 128 * 1024;
+
+    /**
+     * Returns an unshared buffer with a capacity of at least 'minSize' bytes: the smallest cached
+     * one that is large enough, or else a newly allocated one whose capacity is rounded up to a
+     * size class.
+     */
+    static SharedBuffer allocate(size_t minSize);
+
+    /**
+     * Makes 'buffer', which must be unshared, at least 'minSize' bytes, keeping its first
+     * 'bytesInUse' bytes. If it is too small, its contents move to a buffer from allocate() and it
+     * is released.
+     */
+    static void reserve(SharedBuffer* buffer, size_t minSize, size_t bytesInUse);
+
+    /**
+     * Returns 'buffer' to this thread's cache if it is unshared, its capacity is a size class,
+     * that class is not full and the cache would stay within kMaxCachedBytesPerThread; frees it
+     * otherwise.
+     */
+    static void release(SharedBuffer buffer);
+
+    /**
+     * Frees every buffer in this thread's cache.
+     */
+    static void clear();
+};
+
+}  // namespace mongo
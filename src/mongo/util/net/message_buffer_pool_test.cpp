@@ -0,0 +1,187 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/net/message_buffer_pool.h"
+
+#include <vector>
+
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+// Each pool is thread-local, so every test runs on a new thread to start from an empty pool.
+void runWithEmptyPool(stdx::function<void()> test) {
+    stdx::thread thread(std::move(test));
+    thread.join();
+}
+
+TEST(MessageBufferPoolTest, AllocateRoundsUpToSizeClass) {
+    runWithEmptyPool([] {
+        ASSERT_EQ(512U, MessageBufferPool::allocate(0).capacity());
+        ASSERT_EQ(512U, MessageBufferPool::allocate(512).capacity());
+        ASSERT_EQ(1024U, MessageBufferPool::allocate(513).capacity());
+        ASSERT_EQ(64U * 1024, MessageBufferPool::allocate(40 * 1024).capacity());
+        ASSERT_EQ(100U * 1024, MessageBufferPool::allocate(100 * 1024).capacity());
+    });
+}
+
+TEST(MessageBufferPoolTest, ReleasedBufferIsReused) {
+    runWithEmptyPool([] {
+        auto buffer = MessageBufferPool::allocate(2000);
+        const void* data = buffer.get();
+        MessageBufferPool::release(std::move(buffer));
+        ASSERT_EQ(data, MessageBufferPool::allocate(1500).get());
+    });
+}
+
+TEST(MessageBufferPoolTest, AllocatePrefersSmallestCachedBuffer) {
+    runWithEmptyPool([] {
+        auto small = MessageBufferPool::allocate(1024);
+        auto large = MessageBufferPool::allocate(16 * 1024);
+        const void* smallData = small.get();
+        const void* largeData = large.get();
+        MessageBufferPool::release(std::move(large));
+        MessageBufferPool::release(std::move(small));
+
+        ASSERT_EQ(smallData, MessageBufferPool::allocate(100).get());
+        ASSERT_EQ(largeData, MessageBufferPool::allocate(100).get());
+    });
+}
+
+TEST(MessageBufferPoolTest, CachedBufferTooSmallIsNotUsed) {
+    runWithEmptyPool([] {
+        auto buffer = MessageBufferPool::allocate(1024);
+        const void* data = buffer.get();
+        MessageBufferPool::release(std::move(buffer));
+
+        auto larger = MessageBufferPool::allocate(4096);
+        ASSERT_NE(data, larger.get());
+        ASSERT_EQ(4096U, larger.capacity());
+        ASSERT_EQ(data, MessageBufferPool::allocate(1024).get());
+    });
+}
+
+TEST(MessageBufferPoolTest, SharedBufferIsNotCached) {
+    runWithEmptyPool([] {
+        auto buffer = MessageBufferPool::allocate(512);
+        auto otherReference = buffer;
+        MessageBufferPool::release(std::move(buffer));
+        ASSERT_NE(otherReference.get(), MessageBufferPool::allocate(512).get());
+    });
+}
+
+TEST(MessageBufferPoolTest, BufferOutsideSizeClassesIsNotCached) {
+    runWithEmptyPool([] {
+        MessageBufferPool::release(SharedBuffer::allocate(1000));
+        ASSERT_EQ(512U, MessageBufferPool::allocate(512).capacity());
+
+        const auto hugeSize = MessageBufferPool::kMaxBufferSize * 2;
+        MessageBufferPool::release(MessageBufferPool::allocate(hugeSize));
+        ASSERT_EQ(MessageBufferPool::kMaxBufferSize,
+                  MessageBufferPool::allocate(MessageBufferPool::kMaxBufferSize).capacity());
+    });
+}
+
+TEST(MessageBufferPoolTest, SizeClassHoldsLimitedNumberOfBuffers) {
+    runWithEmptyPool([] {
+        std::vector<SharedBuffer> buffers;
+        for (size_t i = 0; i < MessageBufferPool::kBuffersPerSizeClass + 1; ++i) {
+            buffers.push_back(MessageBufferPool::allocate(512));
+        }
+        std::vector<const void*> data;
+        for (auto&& buffer : buffers) {
+            data.push_back(buffer.get());
+            MessageBufferPool::release(std::move(buffer));
+        }
+
+        // The last buffer released did not fit, and the cache hands out the most recent first.
+        for (size_t i = 0; i < MessageBufferPool::kBuffersPerSizeClass; ++i) {
+            ASSERT_EQ(data[MessageBufferPool::kBuffersPerSizeClass - 1 - i],
+                      MessageBufferPool::allocate(512).get());
+        }
+    });
+}
+
+TEST(MessageBufferPoolTest, CacheHoldsLimitedNumberOfBytes) {
+    runWithEmptyPool([] {
+        const auto largest = MessageBufferPool::kMaxBufferSize;
+        const auto count = MessageBufferPool::kMaxCachedBytesPerThread / largest;
+        ASSERT_LTE(count, MessageBufferPool::kBuffersPerSizeClass);
+
+        std::vector<SharedBuffer> buffers;
+        for (size_t i = 0; i < count; ++i) {
+            buffers.push_back(MessageBufferPool::allocate(largest));
+        }
+        for (auto&& buffer : buffers) {
+            MessageBufferPool::release(std::move(buffer));
+        }
+
+        // The cache is full, so a small buffer is not kept and the large ones are handed out.
+        MessageBufferPool::release(MessageBufferPool::allocate(512));
+        for (size_t i = 0; i < count; ++i) {
+            buffers[i] = MessageBufferPool::allocate(512);
+            ASSERT_EQ(largest, buffers[i].capacity());
+        }
+        ASSERT_EQ(512U, MessageBufferPool::allocate(512).capacity());
+    });
+}
+
+TEST(MessageBufferPoolTest, ClearFreesCachedBuffers) {
+    runWithEmptyPool([] {
+        auto buffer = MessageBufferPool::allocate(4096);
+        MessageBufferPool::release(std::move(buffer));
+        MessageBufferPool::clear();
+        ASSERT_EQ(512U, MessageBufferPool::allocate(512).capacity());
+    });
+}
+
+TEST(MessageBufferPoolTest, ReserveKeepsContents) {
+    runWithEmptyPool([] {
+        auto buffer = MessageBufferPool::allocate(16);
+        memcpy(buffer.get(), "0123456789abcdef", 16);
+        const void* data = buffer.get();
+
+        MessageBufferPool::reserve(&buffer, 512, 16);
+        ASSERT_EQ(data, buffer.get());
+
+        MessageBufferPool::reserve(&buffer, 3000, 16);
+        ASSERT_EQ(4096U, buffer.capacity());
+        ASSERT_EQ(0, memcmp(buffer.get(), "0123456789abcdef", 16));
+
+        // The buffer that was outgrown went back to the cache.
+        ASSERT_EQ(data, MessageBufferPool::allocate(512).get());
+    });
+}
+
+}  // namespace
+}  // namespace mongo
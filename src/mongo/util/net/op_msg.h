@@ -47,6 +47,11 @@ struct OpMsg {
     static constexpr uint32_t kChecksumPresent = 1 << 0;
     static constexpr uint32_t kMoreToCome = 1 << 1;
 
+    // Set by a client on a find or getMore to let the server stream the rest of the cursor back as
+    // a series of kMoreToCome replies without waiting for further getMores. Being in the high,
+    // optional half of the flags, it is ignored by servers that do not understand it.
+    static constexpr uint32_t kExhaustSupported = 1 << 16;
+
     /**
      * Returns the unvalidated flags for the given message if it is an OP_MSG message.
      * Returns 0 for other message kinds since they are the equivalent of no flags set.
@@ -165,6 +170,14 @@ public:
         skipHeaderAndFlags();
     }
 
+    /**
+     * Builds the message in 'buffer', which must not be shared, rather than a new allocation.
+     */
+    explicit OpMsgBuilder(SharedBuffer buffer) : _buf(0) {
+        _buf.useSharedBuffer(std::move(buffer));
+        skipHeaderAndFlags();
+    }
+
     /**
      * See the documentation for DocSequenceBuilder below.
      */
@@ -28,7 +28,9 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/client/dbclientcursor.h"
 #include "mongo/client/dbclientinterface.h"
+#include "mongo/db/query/cursor_response.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/unittest/integration_test.h"
 #include "mongo/unittest/unittest.h"
@@ -166,4 +168,122 @@ TEST(OpMsg, CloseConnectionOnFireAndForgetNotMasterError) {
     ASSERT(foundSecondary);
 }
 
+const char kExhaustCollection[] = "exhaust";
+const char kExhaustNs[] = "test.exhaust";
+
+/**
+ * Returns a connection to the fixture with 'numDocs' documents in the exhaust test collection, or
+ * null if the fixture is not a standalone mongod. Only mongod streams exhaust cursors.
+ */
+std::unique_ptr<DBClientBase> connectAndInsertExhaustDocs(int numDocs) {
+    const auto connStr = unittest::getFixtureConnectionString();
+    if (connStr.type() != ConnectionString::MASTER) {
+        return nullptr;
+    }
+
+    std::string errMsg;
+    auto conn = std::unique_ptr<DBClientBase>(connStr.connect("integration_test", errMsg));
+    uassert(ErrorCodes::SocketException, errMsg, conn);
+
+    BSONObj isMaster;
+    ASSERT(conn->runCommand("admin", BSON("isMaster" << 1), isMaster));
+    if (isMaster["msg"].str() == "isdbgrid") {
+        return nullptr;
+    }
+
+    conn->dropCollection(kExhaustNs);
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < numDocs; i++) {
+        docs.push_back(BSON("_id" << i));
+    }
+    conn->insert(kExhaustNs, docs);
+    return conn;
+}
+
+/**
+ * Sends 'findCmd' as an OP_MSG exhaust request and reads replies until the server stops streaming.
+ * Returns the number of documents in each batch and checks that the stream is well formed.
+ */
+std::vector<size_t> streamExhaustFind(DBClientBase* conn, const BSONObj& findCmd) {
+    auto request = OpMsgRequest::fromDBAndBody("test", findCmd).serialize();
+    OpMsg::setFlag(&request, OpMsg::kExhaustSupported);
+
+    Message reply;
+    ASSERT(conn->call(request, reply));
+
+    std::vector<size_t> batchSizes;
+    while (true) {
+        auto response = uassertStatusOK(CursorResponse::parseFromBSON(
+            conn->parseCommandReplyMessage(conn->getServerAddress(), reply)->getCommandReply()));
+        batchSizes.push_back(response.getBatch().size());
+
+        // Only the reply that closes the cursor ends the stream.
+        const bool moreToCome = OpMsg::isFlagSet(reply, OpMsg::kMoreToCome);
+        ASSERT_EQ(response.getCursorId() != 0, moreToCome);
+        if (!moreToCome) {
+            break;
+        }
+
+        // Each reply after the first is a response to the one before it.
+        const auto lastReplyId = reply.header().getId();
+        ASSERT(conn->recv(reply, lastReplyId));
+    }
+    return batchSizes;
+}
+
+TEST(OpMsg, ExhaustFindStreamsEveryBatch) {
+    auto conn = connectAndInsertExhaustDocs(5);
+    if (!conn) {
+        return;
+    }
+
+    const auto batchSizes =
+        streamExhaustFind(conn.get(), BSON("find" << kExhaustCollection << "batchSize" << 2));
+    ASSERT(batchSizes == std::vector<size_t>({2, 2, 1}));
+
+    // The connection is usable again once the stream has ended.
+    ASSERT_EQ(conn->count(kExhaustNs), 5u);
+}
+
+TEST(OpMsg, ExhaustFindWithEmptyFirstBatchKeepsStreaming) {
+    auto conn = connectAndInsertExhaustDocs(5);
+    if (!conn) {
+        return;
+    }
+
+    const auto batchSizes =
+        streamExhaustFind(conn.get(), BSON("find" << kExhaustCollection << "batchSize" << 0));
+    ASSERT(batchSizes == std::vector<size_t>({0, 5}));
+}
+
+TEST(OpMsg, DBClientCursorStreamsExhaustFind) {
+    auto conn = connectAndInsertExhaustDocs(50);
+    if (!conn) {
+        return;
+    }
+
+    auto cursor = conn->query(kExhaustNs, Query(), 0, 0, nullptr, QueryOption_Exhaust, 10);
+    ASSERT(cursor);
+
+    int numDocs = 0;
+    int numBatches = 0;
+    while (true) {
+        ++numBatches;
+        while (cursor->moreInCurrentBatch()) {
+            ASSERT_EQ(cursor->next()["_id"].numberInt(), numDocs);
+            ++numDocs;
+        }
+        if (cursor->getCursorId() == 0) {
+            break;
+        }
+
+        // The server is already sending the next batch.
+        ASSERT(cursor->connectionHasPendingReplies());
+        cursor->exhaustReceiveMore();
+    }
+    ASSERT_FALSE(cursor->connectionHasPendingReplies());
+    ASSERT_EQ(numDocs, 50);
+    ASSERT_EQ(numBatches, 6);
+}
+
 }  // namespace mongo
@@ -749,6 +749,24 @@ TEST(OpMsgSerializer, BodyAndInPlaceSequenceInPlaceWithReset) {
                    });
 }
 
+TEST(OpMsgSerializer, BodyInProvidedBuffer) {
+    auto buffer = SharedBuffer::allocate(1024);
+    const void* data = buffer.get();
+
+    OpMsgBuilder builder(std::move(buffer));
+    builder.beginBody().append("ping", 1);
+    auto msg = builder.finish();
+
+    ASSERT_EQ(data, static_cast<const void*>(msg.buf()));
+    ASSERT_EQ(1024U, msg.sharedBuffer().capacity());
+    testSerializer(msg,
+                   OpMsgBytes{
+                       kNoFlags,  //
+                       kBodySection,
+                       fromjson("{ping: 1}"),
+                   });
+}
+
 TEST(OpMsgSerializer, ReplaceFlagsWorks) {
     {
         auto msg = OpMsgBytes{~0u}.done();
@@ -59,6 +59,7 @@
 #include "mongo/util/net/ssl_types.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/text.h"
+#include "mongo/util/timer.h"
 
 #ifdef MONGO_CONFIG_SSL
 #include <openssl/asn1.h>
@@ -642,6 +643,39 @@ BSONObj SSLConfiguration::getServerStatusBSON() const {
 
 SSLManagerInterface::~SSLManagerInterface() {}
 
+void SSLHandshakeStats::record(SSL* ssl,
+                               SSLManagerInterface::ConnectionDirection direction,
+                               Microseconds elapsed,
+                               bool succeeded) {
+    auto& counters =
+        direction == SSLManagerInterface::ConnectionDirection::kIncoming ? _incoming : _outgoing;
+    if (!succeeded) {
+        counters.failed.addAndFetch(1);
+    } else if (::SSL_session_reused(ssl)) {
+        counters.resumed.addAndFetch(1);
+    } else {
+        counters.full.addAndFetch(1);
+    }
+    counters.totalMicros.addAndFetch(durationCount<Microseconds>(elapsed));
+}
+
+void SSLHandshakeStats::append(BSONObjBuilder* bob) const {
+    BSONObjBuilder handshakes(bob->subobjStart("handshakes"));
+    for (auto&& direction : {std::make_pair("incoming", &_incoming),
+                             std::make_pair("outgoing", &_outgoing)}) {
+        BSONObjBuilder section(handshakes.subobjStart(direction.first));
+        section.append("full", direction.second->full.load());
+        section.append("resumed", direction.second->resumed.load());
+        section.append("failed", direction.second->failed.load());
+        section.append("totalTimeMicros", direction.second->totalMicros.load());
+    }
+}
+
+SSLHandshakeStats& getSSLHandshakeStats() {
+    static SSLHandshakeStats stats;
+    return stats;
+}
+
 SSLManager::SSLManager(const SSLParams& params, bool isServer)
     : _serverContext(nullptr, free_ssl_context),
       _clientContext(nullptr, free_ssl_context),
@@ -1289,10 +1323,13 @@ SSLConnection* SSLManager::connect(Socket* socket) {
     if (ret != 1)
         _handleSSLError(SSL_get_error(sslConn.get(), ret), ret);
 
+    Timer handshakeTimer;
     do {
         ret = ::SSL_connect(sslConn->ssl);
     } while (!_doneWithSSLOp(sslConn.get(), ret));
 
+    getSSLHandshakeStats().record(
+        sslConn->ssl, ConnectionDirection::kOutgoing, handshakeTimer.elapsed(), ret == 1);
     if (ret != 1)
         _handleSSLError(SSL_get_error(sslConn.get(), ret), ret);
 
@@ -1304,10 +1341,13 @@ SSLConnection* SSLManager::accept(Socket* socket, const char* initialBytes, int
         stdx::make_unique<SSLConnection>(_serverContext.get(), socket, initialBytes, len);
 
     int ret;
+    Timer handshakeTimer;
     do {
         ret = ::SSL_accept(sslConn->ssl);
     } while (!_doneWithSSLOp(sslConn.get(), ret));
 
+    getSSLHandshakeStats().record(
+        sslConn->ssl, ConnectionDirection::kIncoming, handshakeTimer.elapsed(), ret == 1);
     if (ret != 1)
         _handleSSLError(SSL_get_error(sslConn.get(), ret), ret);
 
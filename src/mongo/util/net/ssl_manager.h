@@ -38,7 +38,9 @@
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/decorable.h"
+#include "mongo/util/duration.h"
 #include "mongo/util/net/sock.h"
 #include "mongo/util/net/ssl_types.h"
 #include "mongo/util/time_support.h"
@@ -188,6 +190,42 @@ public:
         SSL* ssl, const std::string& remoteHost) = 0;
 };
 
+/**
+ * Counts the TLS handshakes this process takes part in, for each direction, and the time spent in
+ * them. Resumed handshakes skip the certificate exchange and key agreement, so comparing them
+ * with full handshakes shows how well session resumption is working.
+ */
+class SSLHandshakeStats {
+    MONGO_DISALLOW_COPYING(SSLHandshakeStats);
+
+public:
+    SSLHandshakeStats() = default;
+
+    /**
+     * Records a handshake on 'ssl' that took 'elapsed'. If it did not succeed, 'ssl' is not
+     * inspected.
+     */
+    void record(SSL* ssl,
+                SSLManagerInterface::ConnectionDirection direction,
+                Microseconds elapsed,
+                bool succeeded);
+
+    void append(BSONObjBuilder* bob) const;
+
+private:
+    struct Counters {
+        AtomicInt64 full;
+        AtomicInt64 resumed;
+        AtomicInt64 failed;
+        AtomicInt64 totalMicros;
+    };
+
+    Counters _incoming;
+    Counters _outgoing;
+};
+
+SSLHandshakeStats& getSSLHandshakeStats();
+
 // Access SSL functions through this instance.
 SSLManagerInterface* getSSLManager();
 
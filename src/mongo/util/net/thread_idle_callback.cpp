@@ -34,6 +34,7 @@
 
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
+#include "mongo/util/net/message_buffer_pool.h"
 
 namespace mongo {
 namespace {
@@ -48,6 +49,8 @@ void registerThreadIdleCallback(ThreadIdleCallback callback) {
 }
 
 void markThreadIdle() {
+    MessageBufferPool::clear();
+
     if (!threadIdleCallback) {
         return;
     }
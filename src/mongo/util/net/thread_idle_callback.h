@@ -37,8 +37,8 @@ namespace mongo {
 typedef void (*ThreadIdleCallback)();
 
 /**
- * Informs the registered listener that this thread believes it may go idle for an extended period.
- * The caller should avoid calling markThreadIdle at a high rate, as it can both be moderately
+ * Informs the registered listener that this thread believes it may go idle for an extended period,
+ * and frees the message buffers this thread has cached in MessageBufferPool. The caller should avoid calling markThreadIdle at a high rate, as it can both be moderately
  * costly itself and in terms of distributed overhead for subsequent malloc/free calls.
  */
 void markThreadIdle();
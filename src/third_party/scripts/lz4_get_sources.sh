@@ -0,0 +1,17 @@
+#!/bin/bash
+set -o verbose
+set -o errexit
+
+# This script creates a copy of sources for lz4
+# The lz4 sources come from the copy that SpiderMonkey already ships in mfbt, so
+# that the server and the shell's JavaScript engine agree on a single version.
+
+VERSION=1.2.0
+NAME=lz4
+SRC_DIR=`git rev-parse --show-toplevel`/src/third_party/mozjs-45/extract/mfbt
+DEST_DIR=`git rev-parse --show-toplevel`/src/third_party/$NAME-$VERSION
+
+mkdir $DEST_DIR || true
+cp $SRC_DIR/lz4.c $SRC_DIR/lz4.h $DEST_DIR
+
+echo "Done"
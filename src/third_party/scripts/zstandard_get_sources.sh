@@ -0,0 +1,37 @@
+#!/bin/bash
+set -o verbose
+set -o errexit
+
+# This script fetches and creates a copy of sources for zstandard
+# Only the library sources are kept, the command line tools, contrib and
+# tests are not used by the server.
+
+VERSION=1.5.7
+NAME=zstd
+TARBALL=$NAME-$VERSION.tar.gz
+TARBALL_DIR=$NAME-$VERSION
+TEMP_DIR=/tmp/temp-$NAME-$VERSION
+DEST_DIR=`git rev-parse --show-toplevel`/src/third_party/zstandard-$VERSION/$NAME
+
+if [ ! -f $TARBALL ]; then
+    echo "Get tarball"
+    wget https://github.com/facebook/$NAME/releases/download/v$VERSION/$TARBALL
+fi
+
+echo $TARBALL
+tar -zxvf $TARBALL
+
+rm -rf $TEMP_DIR
+mv $TARBALL_DIR $TEMP_DIR
+
+rm -rf $DEST_DIR
+mkdir -p $DEST_DIR/lib
+cp $TEMP_DIR/LICENSE $TEMP_DIR/COPYING $DEST_DIR
+cp -r $TEMP_DIR/lib/common $TEMP_DIR/lib/compress $TEMP_DIR/lib/decompress $DEST_DIR/lib
+cp -r $TEMP_DIR/lib/dictBuilder $DEST_DIR/lib
+cp $TEMP_DIR/lib/zstd.h $TEMP_DIR/lib/zstd_errors.h $TEMP_DIR/lib/zdict.h $DEST_DIR/lib
+
+# The assembly decoder is disabled with ZSTD_DISABLE_ASM
+rm -f $DEST_DIR/lib/decompress/*.S
+
+echo "Done"
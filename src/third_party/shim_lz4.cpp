@@ -0,0 +1,3 @@
+// This file intentionally blank.  shim_lz4.cpp is part of the
+// third_party/lz4 library, which is just a placeholder for forwarding
+// library dependencies.